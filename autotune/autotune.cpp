@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+// Benchmark for finding the minimum matrix sizes at which OpenMP based parallelisation
+// of element-wise expressions is faster than single-threaded evaluation.
+// The results are written as a header with ARMA_OPENMP_THRESHOLD* definitions,
+// which can be included before the Armadillo header.
+
+
+// force parallelisation of all element-wise expressions; the single-threaded timings are obtained separately (see below)
+
+#define ARMA_OPENMP_THRESHOLD       1
+#define ARMA_OPENMP_THRESHOLD_HEAVY 1
+#define ARMA_OPENMP_THRESHOLD_CHEAP 1
+
+#include <armadillo>
+#include <fstream>
+#include <iomanip>
+
+#if !defined(ARMA_USE_OPENMP)
+  #error "the autotune benchmark requires OpenMP (eg. compile with -fopenmp)"
+#endif
+
+using namespace arma;
+
+
+// minimum duration of each timing run, in seconds
+static constexpr double min_duration = 0.002;
+
+// number of timing runs; the fastest run is used
+static constexpr uword n_runs = 5;
+
+// minimum speedup required to regard parallelisation as worthwhile
+static constexpr double min_speedup = 1.1;
+
+
+template<typename functor>
+inline
+double
+time_per_call(const functor& F)
+  {
+  double best = datum::inf;
+  
+  wall_clock timer;
+  
+  for(uword run=0; run < n_runs; ++run)
+    {
+    uword  n_calls = 0;
+    double elapsed = 0.0;
+    
+    timer.tic();
+    
+    do
+      {
+      F();
+      ++n_calls;
+      elapsed = timer.toc();
+      }
+    while(elapsed < min_duration);
+    
+    best = (std::min)(best, elapsed / double(n_calls));
+    }
+  
+  return best;
+  }
+
+
+
+template<typename functor>
+inline
+double
+time_per_call_serial(const functor& F)
+  {
+  // element-wise expressions are not parallelised when evaluated within an active OpenMP parallel region,
+  // so the single-threaded code path is timed from within a region in which the other thread is idle
+  
+  double result = 0.0;
+  
+  #pragma omp parallel num_threads(2)
+    {
+    #pragma omp master
+      {
+      result = time_per_call(F);
+      }
+    }
+  
+  return result;
+  }
+
+
+
+//! returns the smallest tested size for which parallelisation is worthwhile for the tested size and all larger tested sizes;
+//! returns zero if parallelisation is not worthwhile for the largest tested size
+template<typename functor>
+inline
+uword
+find_crossover(const char* name, const uvec& sizes, const functor& F)
+  {
+  std::cout << '\n' << name << '\n';
+  std::cout << "     n_elem      serial    parallel     speedup\n";
+  
+  uword crossover = 0;
+  
+  for(uword i=0; i < sizes.n_elem; ++i)
+    {
+    const uword N = sizes[i];
+    
+    vec A(N, fill::randu);
+    vec B(N, fill::randu);
+    vec C(N, fill::zeros);
+    
+    const auto G = [&]() { F(C, A, B); };
+    
+    const double t_serial   = time_per_call_serial(G);
+    const double t_parallel = time_per_call(G);
+    
+    const double speedup = t_serial / t_parallel;
+    
+    std::cout << std::setw(11) << N << ' ' << std::setw(11) << t_serial << ' ' << std::setw(11) << t_parallel << ' ' << std::setw(11) << speedup << '\n';
+    
+    if(speedup >= min_speedup)
+      {
+      if(crossover == 0)  { crossover = N; }
+      }
+    else
+      {
+      crossover = 0;
+      }
+    }
+  
+  std::cout << "crossover: " << crossover << '\n';
+  
+  return crossover;
+  }
+
+
+
+int
+main(int argc, char** argv)
+  {
+  const std::string filename = (argc >= 2) ? std::string(argv[1]) : std::string("arma_autotune.hpp");
+  
+  const int n_threads = mp_thread_limit::get();
+  
+  std::cout << "Armadillo version: " << arma_version::as_string() << '\n';
+  std::cout << "number of threads: " << n_threads << '\n';
+  
+  if(n_threads < 2)
+    {
+    std::cerr << "error: at least 2 threads are required; check OMP_NUM_THREADS" << '\n';
+    return -1;
+    }
+  
+  uvec sizes = regspace<uvec>(4, 22);
+  
+  sizes.transform( [](uword k) { return uword(1) << k; } );
+  
+  const uword cheap    = find_crossover("cheap: C = A + B",     sizes, [](vec& C, const vec& A, const vec& B) { C = A + B;   } );
+  const uword moderate = find_crossover("moderate: C = sqrt(A)", sizes, [](vec& C, const vec& A, const vec&  ) { C = sqrt(A); } );
+  const uword heavy    = find_crossover("heavy: C = exp(A)",     sizes, [](vec& C, const vec& A, const vec&  ) { C = exp(A);  } );
+  
+  std::ofstream f(filename);
+  
+  if(f.good() == false)
+    {
+    std::cerr << "error: can't write " << filename << '\n';
+    return -1;
+    }
+  
+  f << "// generated by the Armadillo autotune benchmark; number of threads: " << n_threads << '\n';
+  f << "// include this file before the Armadillo header" << '\n';
+  f << '\n';
+  
+  // if parallelisation is not worthwhile at the largest tested size, use a threshold beyond the tested range
+  
+  const uword beyond = 2 * sizes.tail(1)[0];
+  
+  f << "#define ARMA_OPENMP_THRESHOLD       " << ( (moderate > 0) ? moderate : beyond ) << '\n';
+  f << "#define ARMA_OPENMP_THRESHOLD_HEAVY " << ( (heavy    > 0) ? heavy    : beyond ) << '\n';
+  
+  if(cheap > 0)
+    {
+    f << "#define ARMA_OPENMP_THRESHOLD_CHEAP " << cheap << '\n';
+    }
+  else
+    {
+    f << "// parallelisation of inexpensive operations was not found to be worthwhile" << '\n';
+    f << "// #define ARMA_OPENMP_THRESHOLD_CHEAP" << '\n';
+    }
+  
+  f.close();
+  
+  std::cout << '\n' << "thresholds written to " << filename << '\n';
+  
+  return 0;
+  }
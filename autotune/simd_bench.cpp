@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+// Benchmark of the explicit SIMD kernels used for element-wise operations and reductions.
+// Each operation is timed with every instruction set supported by the CPU,
+// as well as with the kernels disabled (ie. using the scalar code).
+// Throughput is reported in millions of elements per second.
+
+
+// the kernels are benchmarked on a single thread
+#define ARMA_DONT_USE_OPENMP
+
+// include the polynomial approximations of exp() and log()
+#define ARMA_USE_SIMD_MATH
+
+#include <armadillo>
+#include <iomanip>
+
+#if !defined(ARMA_USE_SIMD)
+  #error "the SIMD benchmark requires ARMA_USE_SIMD, which is only available with GCC and Clang on x86-64 and AArch64"
+#endif
+
+using namespace arma;
+
+
+// minimum duration of each timing run, in seconds
+static constexpr double min_duration = 0.01;
+
+// number of timing runs; the fastest run is used
+static constexpr uword n_runs = 5;
+
+
+template<typename functor>
+inline
+double
+time_per_call(const functor& F)
+  {
+  double best = datum::inf;
+  
+  wall_clock timer;
+  
+  for(uword run=0; run < n_runs; ++run)
+    {
+    uword  n_calls = 0;
+    double elapsed = 0.0;
+    
+    timer.tic();
+    
+    do
+      {
+      F();
+      ++n_calls;
+      elapsed = timer.toc();
+      }
+    while(elapsed < min_duration);
+    
+    best = (std::min)(best, elapsed / double(n_calls));
+    }
+  
+  return best;
+  }
+
+
+
+template<typename eT>
+inline
+void
+run_benchmarks(const uword N, const std::vector<uword>& isas)
+  {
+  typedef Mat<eT> mat_type;
+  
+  const mat_type A(N, 1, fill::randu);
+  const mat_type B(N, 1, fill::randu);
+        mat_type C(N, 1, fill::zeros);
+  
+  const eT k = eT(0.5);
+  
+  eT sink = eT(0);
+  
+  const std::vector< std::pair< std::string, std::function<void()> > > ops =
+    {
+    { "A + B",       [&]() { C = A + B;                  } },
+    { "A % B",       [&]() { C = A % B;                  } },
+    { "A / B",       [&]() { C = A / B;                  } },
+    { "A * k",       [&]() { C = A * k;                  } },
+    { "k - A",       [&]() { C = k - A;                  } },
+    { "abs(A)",      [&]() { C = abs(A);                 } },
+    { "sqrt(A)",     [&]() { C = sqrt(A);                } },
+    { "square(A)",   [&]() { C = square(A);              } },
+    { "exp(A)",      [&]() { C = exp(A);                 } },
+    { "log(A)",      [&]() { C = log(A);                 } },
+    { "clamp(A)",    [&]() { C = clamp(A, eT(0.25), k);  } },
+    { "C += B",      [&]() { C += B;                     } },
+    { "C *= k",      [&]() { C *= k;                     } },
+    { "accu(A)",     [&]() { sink += accu(A);            } }
+    };
+  
+  std::cout << std::endl;
+  std::cout << (is_float<eT>::value ? "float" : "double") << ", N = " << N << std::endl;
+  
+  std::cout << std::setw(12) << "operation";
+  for(const uword isa : isas)  { std::cout << std::setw(12) << simd::isa_name(isa); }
+  std::cout << std::endl;
+  
+  for(const auto& op : ops)
+    {
+    std::cout << std::setw(12) << op.first;
+    
+    for(const uword isa : isas)
+      {
+      simd::set_isa(isa);
+      
+      const double t = time_per_call(op.second);
+      
+      std::cout << std::setw(12) << std::fixed << std::setprecision(1) << (double(N) / t) / 1e6;
+      }
+    
+    std::cout << std::endl;
+    }
+  
+  if(sink == eT(-1))  { std::cout << sink << std::endl; }  // prevent the accumulations from being optimised away
+  }
+
+
+
+int
+main(int argc, char** argv)
+  {
+  const uword default_isa = simd::get_isa();
+  
+  std::vector<uword> isas;
+  
+  for(const uword isa : { simd::isa_none, simd::isa_sse2, simd::isa_neon, simd::isa_avx2, simd::isa_avx512 })
+    {
+    if(simd::has_isa(isa))  { isas.push_back(isa); }
+    }
+  
+  std::cout << "Armadillo version: " << arma_version::as_string() << std::endl;
+  std::cout << "default instruction set: " << simd::isa_name(default_isa) << std::endl;
+  std::cout << "throughput in millions of elements per second" << std::endl;
+  
+  std::vector<uword> sizes = { 1000, 100000, 10000000 };
+  
+  if(argc > 1)
+    {
+    sizes.clear();
+    
+    for(int i=1; i < argc; ++i)  { sizes.push_back( uword(std::strtoull(argv[i], nullptr, 10)) ); }
+    }
+  
+  for(const uword N : sizes)
+    {
+    run_benchmarks<float >(N, isas);
+    run_benchmarks<double>(N, isas);
+    }
+  
+  simd::set_isa(default_isa);
+  
+  return 0;
+  }
@@ -2017,23 +2017,24 @@ Cube<eT>::each_slice(const std::function< void(Mat<eT>&) >& F, const bool use_mp
   {
   arma_debug_sigprint();
   
-  if((use_mp == false) || (arma_config::openmp == false))
+  if((use_mp == false) || (arma_config::mp == false))
     {
     return (*this).each_slice(F);
     }
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const uword local_n_slices = n_slices;
-    const int   n_threads      = mp_thread_limit::get();
+    const int   n_threads      = mp_thread_limit::get_loop();
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice_id=0; slice_id < local_n_slices; ++slice_id)
+    const auto worker = [&](const uword slice_id)
       {
       Mat<eT> tmp('j', slice_memptr(slice_id), n_rows, n_cols);
       
       F(tmp);
-      }
+      };
+    
+    mp_loop::run(local_n_slices, n_threads, worker);
     }
   #endif
   
@@ -2049,23 +2050,24 @@ Cube<eT>::each_slice(const std::function< void(const Mat<eT>&) >& F, const bool
   {
   arma_debug_sigprint();
   
-  if((use_mp == false) || (arma_config::openmp == false))
+  if((use_mp == false) || (arma_config::mp == false))
     {
     return (*this).each_slice(F);
     }
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const uword local_n_slices = n_slices;
-    const int   n_threads      = mp_thread_limit::get();
+    const int   n_threads      = mp_thread_limit::get_loop();
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice_id=0; slice_id < local_n_slices; ++slice_id)
+    const auto worker = [&](const uword slice_id)
       {
       Mat<eT> tmp('j', slice_memptr(slice_id), n_rows, n_cols);
       
       F(tmp);
-      }
+      };
+    
+    mp_loop::run(local_n_slices, n_threads, worker);
     }
   #endif
   
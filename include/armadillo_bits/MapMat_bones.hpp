@@ -41,7 +41,7 @@ class MapMat
   
   private:
   
-  typedef typename std::map<uword, eT> map_type;
+  typedef MapMat_map<eT> map_type;
   
   arma_aligned map_type* map_ptr;
   
@@ -125,6 +125,61 @@ class MapMat
 
 
 
+// this class is for internal use only; subject to change and/or removal without notice
+// 
+// hash table storing the non-zero elements of MapMat, keyed by linear index;
+// open addressing with linear probing is used, with the keys and values stored together in one contiguous array;
+// the table size is a power of 2; erased elements are removed via backward shifting, so there are no tombstones
+template<typename eT>
+class MapMat_map
+  {
+  public:
+  
+  struct slot_type
+    {
+    uword key;
+    eT    val;
+    };
+  
+  static constexpr uword empty_key = uword(ARMA_MAX_UWORD);  // linear indices are always less than ARMA_MAX_UWORD
+  
+  arma_aligned uword      n_used;
+  arma_aligned uword      n_slots;
+  arma_aligned uword      n_shift;
+  arma_aligned slot_type* slots;
+  
+  inline ~MapMat_map();
+  inline  MapMat_map();
+  
+  inline            MapMat_map(const MapMat_map<eT>& x);
+  inline MapMat_map& operator=(const MapMat_map<eT>& x);
+  
+  arma_inline uword size()  const;
+  arma_inline bool  empty() const;
+  
+  inline void clear();
+  inline void reserve(const uword n_elem);
+  
+  arma_inline const eT* find(const uword key) const;
+  arma_inline       eT* find(const uword key);
+  
+  arma_inline eT& operator[](const uword key);  // creates the element if it doesn't exist
+  
+  inline void erase(const uword key);
+  
+  inline void get_sorted(uword* out_keys, eT* out_vals) const;
+  
+  
+  private:
+  
+  arma_inline uword home(const uword key) const;
+  arma_inline uword locate(const uword key) const;
+  
+  inline void rehash(const uword new_n_slots);
+  };
+
+
+
 template<typename eT>
 class MapMat_val
   {
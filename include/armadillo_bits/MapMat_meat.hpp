@@ -154,6 +154,8 @@ MapMat<eT>::operator=(const SpMat<eT>& x)
   
   map_type& map_ref = (*map_ptr);
   
+  map_ref.reserve(x.n_nonzero);
+  
   for(uword col = 0; col < x_n_cols; ++col)
     {
     const uword start = x_col_ptrs[col    ];
@@ -166,7 +168,7 @@ MapMat<eT>::operator=(const SpMat<eT>& x)
       
       const uword index = (x_n_rows * col) + row;
       
-      map_ref.emplace_hint(map_ref.cend(), index, val);
+      map_ref[index] = val;
       }
     }
   }
@@ -348,11 +350,13 @@ MapMat<eT>::eye(const uword in_n_rows, const uword in_n_cols)
   
   map_type& map_ref = (*map_ptr);
   
+  map_ref.reserve(N);
+  
   for(uword i=0; i<N; ++i)
     {
     const uword index = (in_n_rows * i) + i;
     
-    map_ref.emplace_hint(map_ref.cend(), index, eT(1));
+    map_ref[index] = eT(1);
     }
   }
 
@@ -423,10 +427,9 @@ MapMat<eT>::operator[](const uword index) const
   {
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -452,10 +455,9 @@ MapMat<eT>::operator()(const uword index) const
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -481,10 +483,9 @@ MapMat<eT>::at(const uword in_row, const uword in_col) const
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -514,10 +515,9 @@ MapMat<eT>::operator()(const uword in_row, const uword in_col) const
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it     = map_ref.find(index);
-  typename map_type::const_iterator it_end = map_ref.end();
+  const eT* val_ptr = map_ref.find(index);
   
-  return (it != it_end) ? eT((*it).second) : eT(0);
+  return (val_ptr != nullptr) ? eT(*val_ptr) : eT(0);
   }
 
 
@@ -593,12 +593,14 @@ MapMat<eT>::sprandu(const uword in_n_rows, const uword in_n_cols, const double d
   
   map_type& map_ref = (*map_ptr);
   
+  map_ref.reserve(N);
+  
   for(uword i=0; i < N; ++i)
     {
     const uword index = indx_mem[i];
     const eT    val   = vals_mem[i];
     
-    map_ref.emplace_hint(map_ref.cend(), index, val);
+    map_ref[index] = val;
     }
   }
 
@@ -633,22 +635,21 @@ MapMat<eT>::print(const std::string& extra_text) const
   
   if(n_nonzero > 0)
     {
-    typename map_type::const_iterator it = map_ref.begin();
-
+    podarray<uword> indices(n_nonzero);
+    podarray<eT>    vals   (n_nonzero);
+    
+    map_ref.get_sorted(indices.memptr(), vals.memptr());
+    
     for(uword i=0; i < n_nonzero; ++i)
       {
-      const std::pair<uword, eT>& entry = (*it);
-      
-      const uword index = entry.first;
-      const eT    val   = entry.second;
+      const uword index = indices[i];
+      const eT    val   = vals[i];
       
       const uword row = index % n_rows;
       const uword col = index / n_rows;
       
       get_cout_stream() << '(' << row << ", " << col << ") ";
       get_cout_stream() << val << '\n';
-      
-      ++it;
       }
     }
   
@@ -678,21 +679,18 @@ MapMat<eT>::get_locval_format(umat& locs, Col<eT>& vals) const
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::const_iterator it = map_ref.begin();
-  
   const uword N = uword(map_ref.size());
   
   locs.set_size(2,N);
   vals.set_size(N);
   
-  eT* vals_mem = vals.memptr();
+  podarray<uword> indices(N);
+  
+  map_ref.get_sorted(indices.memptr(), vals.memptr());
   
   for(uword i=0; i<N; ++i)
     {
-    const std::pair<uword, eT>& entry = (*it);
-    
-    const uword index = entry.first;
-    const eT    val   = entry.second;
+    const uword index = indices[i];
     
     const uword row = index % n_rows;
     const uword col = index / n_rows;
@@ -701,10 +699,6 @@ MapMat<eT>::get_locval_format(umat& locs, Col<eT>& vals) const
     
     locs_colptr[0] = row;
     locs_colptr[1] = col;
-    
-    vals_mem[i] = val;
-    
-    ++it;
     }
   }
 
@@ -791,14 +785,7 @@ MapMat<eT>::set_val(const uword index, const eT& in_val)
     {
     map_type& map_ref = (*map_ptr);
     
-    if( (map_ref.empty() == false) && (index > uword(map_ref.crbegin()->first)) )
-      {
-      map_ref.emplace_hint(map_ref.cend(), index, in_val);
-      }
-    else
-      {
-      map_ref.operator[](index) = in_val;
-      }
+    map_ref.operator[](index) = in_val;
     }
   else
     {
@@ -817,10 +804,321 @@ MapMat<eT>::erase_val(const uword index)
   
   map_type& map_ref = (*map_ptr);
   
-  typename map_type::iterator it     = map_ref.find(index);
-  typename map_type::iterator it_end = map_ref.end();
+  map_ref.erase(index);
+  }
+
+
+
+
+
+
+// MapMat_map
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>::~MapMat_map()
+  {
+  arma_debug_sigprint_this(this);
+  
+  memory::release(slots);
+  
+  // try to expose buggy user code that accesses deleted objects
+  slots = nullptr;
+  }
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>::MapMat_map()
+  : n_used (0)
+  , n_slots(0)
+  , n_shift(0)
+  , slots  (nullptr)
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>::MapMat_map(const MapMat_map<eT>& x)
+  : n_used (0)
+  , n_slots(0)
+  , n_shift(0)
+  , slots  (nullptr)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(x);
+  }
+
+
+
+template<typename eT>
+inline
+MapMat_map<eT>&
+MapMat_map<eT>::operator=(const MapMat_map<eT>& x)
+  {
+  arma_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  (*this).clear();
+  
+  if(x.n_used == 0)  { return *this; }
+  
+  slots = memory::acquire<slot_type>(x.n_slots);
+  
+  n_used  = x.n_used;
+  n_slots = x.n_slots;
+  n_shift = x.n_shift;
+  
+  for(uword i=0; i < n_slots; ++i)  { slots[i] = x.slots[i]; }
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+MapMat_map<eT>::size() const
+  {
+  return n_used;
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+MapMat_map<eT>::empty() const
+  {
+  return (n_used == 0);
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::clear()
+  {
+  arma_debug_sigprint();
+  
+  memory::release(slots);
+  
+  n_used  = 0;
+  n_slots = 0;
+  n_shift = 0;
+  slots   = nullptr;
+  }
+
+
+
+//! ensure that at least n_elem elements can be stored without rehashing
+template<typename eT>
+inline
+void
+MapMat_map<eT>::reserve(const uword n_elem)
+  {
+  arma_debug_sigprint();
+  
+  uword new_n_slots = (n_slots > 0) ? n_slots : uword(16);
+  
+  // keep the load factor at or below 3/4
+  while( (new_n_slots - (new_n_slots/4)) < n_elem )  { new_n_slots *= 2; }
+  
+  if(new_n_slots > n_slots)  { (*this).rehash(new_n_slots); }
+  }
+
+
+
+template<typename eT>
+arma_inline
+const eT*
+MapMat_map<eT>::find(const uword key) const
+  {
+  if(n_used == 0)  { return nullptr; }
+  
+  const uword i = (*this).locate(key);
+  
+  return (slots[i].key == key) ? &(slots[i].val) : nullptr;
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT*
+MapMat_map<eT>::find(const uword key)
+  {
+  if(n_used == 0)  { return nullptr; }
+  
+  const uword i = (*this).locate(key);
   
-  if(it != it_end)  { map_ref.erase(it); }
+  return (slots[i].key == key) ? &(slots[i].val) : nullptr;
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT&
+MapMat_map<eT>::operator[](const uword key)
+  {
+  if( (n_used + 1) > (n_slots - (n_slots/4)) )  { (*this).reserve(n_used + 1); }
+  
+  slot_type& slot = slots[ (*this).locate(key) ];
+  
+  if(slot.key != key)
+    {
+    slot.key = key;
+    slot.val = eT(0);
+    
+    ++n_used;
+    }
+  
+  return slot.val;
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::erase(const uword key)
+  {
+  arma_debug_sigprint();
+  
+  if(n_used == 0)  { return; }
+  
+  uword i = (*this).locate(key);
+  
+  if(slots[i].key != key)  { return; }
+  
+  // backward shift deletion:
+  // move subsequent elements in the same cluster into the hole,
+  // unless doing so would move an element before its home slot
+  
+  const uword mask = n_slots - 1;
+  
+  uword j = i;
+  
+  while(true)
+    {
+    j = (j + 1) & mask;
+    
+    const uword j_key = slots[j].key;
+    
+    if(j_key == empty_key)  { break; }
+    
+    const uword k = (*this).home(j_key);
+    
+    const bool keep = (i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j));
+    
+    if(keep == false)
+      {
+      slots[i] = slots[j];
+      
+      i = j;
+      }
+    }
+  
+  slots[i].key = empty_key;
+  
+  --n_used;
+  }
+
+
+
+//! write all elements, sorted by key
+template<typename eT>
+inline
+void
+MapMat_map<eT>::get_sorted(uword* out_keys, eT* out_vals) const
+  {
+  arma_debug_sigprint();
+  
+  uword count = 0;
+  
+  for(uword i=0; i < n_slots; ++i)
+    {
+    const uword key = slots[i].key;
+    
+    if(key != empty_key)  { out_keys[count] = key; ++count; }
+    }
+  
+  std::sort(out_keys, out_keys + count);
+  
+  for(uword i=0; i < count; ++i)  { out_vals[i] = *((*this).find(out_keys[i])); }
+  }
+
+
+
+//! home slot of the given key, via Fibonacci hashing;
+//! the multiplication scatters linear indices that have a common stride (eg. elements in the same row)
+template<typename eT>
+arma_inline
+uword
+MapMat_map<eT>::home(const uword key) const
+  {
+  return ( uword( (u64(key >> 3) * u64(0x9E3779B97F4A7C15ULL)) >> (n_shift + 3) ) << 3 ) | (key & uword(7));
+  }
+
+
+
+//! slot that holds the given key, or the empty slot where the key would be inserted
+template<typename eT>
+arma_inline
+uword
+MapMat_map<eT>::locate(const uword key) const
+  {
+  const uword mask = n_slots - 1;
+  
+  uword i = (*this).home(key);
+  
+  while( (slots[i].key != key) && (slots[i].key != empty_key) )  { i = (i + 1) & mask; }
+  
+  return i;
+  }
+
+
+
+template<typename eT>
+inline
+void
+MapMat_map<eT>::rehash(const uword new_n_slots)
+  {
+  arma_debug_sigprint();
+  
+  slot_type* old_slots   = slots;
+  const uword old_n_slots = n_slots;
+  
+  slots = memory::acquire<slot_type>(new_n_slots);
+  
+  for(uword i=0; i < new_n_slots; ++i)  { slots[i].key = empty_key; }
+  
+  uword new_n_bits = 0;
+  
+  while( (uword(1) << new_n_bits) < new_n_slots )  { ++new_n_bits; }
+  
+  n_slots = new_n_slots;
+  n_shift = uword(64) - new_n_bits;
+  
+  for(uword i=0; i < old_n_slots; ++i)
+    {
+    const slot_type& old_slot = old_slots[i];
+    
+    if(old_slot.key != empty_key)  { slots[ (*this).locate(old_slot.key) ] = old_slot; }
+    }
+  
+  memory::release(old_slots);
   }
 
 
@@ -965,22 +1263,21 @@ MapMat_val<eT>::operator*=(const eT in_val)
   
   typename MapMat<eT>::map_type& map_ref = *(parent.map_ptr);
   
-  typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-  typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+  eT* val_ptr = map_ref.find(index);
   
-  if(it != it_end)
+  if(val_ptr != nullptr)
     {
     if(in_val != eT(0))
       {
-      eT& val = (*it).second;
+      eT& val = (*val_ptr);
       
       val *= in_val;
       
-      if(val == eT(0))  { map_ref.erase(it); }
+      if(val == eT(0))  { map_ref.erase(index); }
       }
     else
       {
-      map_ref.erase(it);
+      map_ref.erase(index);
       }
     }
   }
@@ -996,16 +1293,15 @@ MapMat_val<eT>::operator/=(const eT in_val)
   
   typename MapMat<eT>::map_type& map_ref = *(parent.map_ptr);
   
-  typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-  typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+  eT* val_ptr = map_ref.find(index);
   
-  if(it != it_end)
+  if(val_ptr != nullptr)
     {
-    eT& val = (*it).second;
+    eT& val = (*val_ptr);
     
     val /= in_val;
     
-    if(val == eT(0))  { map_ref.erase(it); }
+    if(val == eT(0))  { map_ref.erase(index); }
     }
   else
     {
@@ -1476,22 +1772,21 @@ SpMat_MapMat_val<eT>::mul(const eT in_val)
     
     typename MapMat<eT>::map_type& map_ref = *(m_parent.map_ptr);
     
-    typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-    typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+    eT* val_ptr = map_ref.find(index);
     
-    if(it != it_end)
+    if(val_ptr != nullptr)
       {
       if(in_val != eT(0))
         {
-        eT& val = (*it).second;
+        eT& val = (*val_ptr);
         
         val *= in_val;
         
-        if(val == eT(0))  { map_ref.erase(it); }
+        if(val == eT(0))  { map_ref.erase(index); }
         }
       else
         {
-        map_ref.erase(it);
+        map_ref.erase(index);
         }
       
       s_parent.sync_state = 1;
@@ -1537,16 +1832,15 @@ SpMat_MapMat_val<eT>::div(const eT in_val)
     
     typename MapMat<eT>::map_type& map_ref = *(m_parent.map_ptr);
     
-    typename MapMat<eT>::map_type::iterator it     = map_ref.find(index);
-    typename MapMat<eT>::map_type::iterator it_end = map_ref.end();
+    eT* val_ptr = map_ref.find(index);
     
-    if(it != it_end)
+    if(val_ptr != nullptr)
       {
-      eT& val = (*it).second;
+      eT& val = (*val_ptr);
       
       val /= in_val;
       
-      if(val == eT(0))  { map_ref.erase(it); }
+      if(val == eT(0))  { map_ref.erase(index); }
       
       s_parent.sync_state = 1;
       
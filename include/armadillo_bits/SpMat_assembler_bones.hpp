@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_assembler
+//! @{
+
+
+
+//! construction of sparse matrices from (row, column, value) triplets, which can be added concurrently by multiple threads;
+//! each thread appends to its own buffer, so add() does not use locks;
+//! the buffered triplets are converted to CSC format by finalise(), where duplicate locations are summed
+template<typename eT>
+class SpMat_assembler
+  {
+  public:
+  
+  typedef eT                                elem_type;  //!< the type of elements stored in the matrix
+  typedef typename get_pod_type<eT>::result  pod_type;  //!< if eT is std::complex<T>, pod_type is T; otherwise pod_type is eT
+  
+  //! maximum number of threads with their own buffer; additional threads share a buffer protected by a mutex
+  static constexpr uword n_buffers = 256;
+  
+  const uword n_rows;  //!< number of rows of the assembled matrix (read-only)
+  const uword n_cols;  //!< number of columns of the assembled matrix (read-only)
+  
+  inline ~SpMat_assembler();
+  inline  SpMat_assembler(const uword in_n_rows, const uword in_n_cols);
+  inline explicit SpMat_assembler(const SizeMat& s);
+  
+  inline      SpMat_assembler(const SpMat_assembler&) = delete;
+  inline void       operator=(const SpMat_assembler&) = delete;
+  
+  inline void add(const uword in_row, const uword in_col, const eT in_val);
+  
+  inline void reserve(const uword n_triplets);
+  
+  arma_warn_unused inline uword get_n_triplets() const;
+  
+  inline void reset();
+  
+  inline void      finalise(SpMat<eT>& out);
+  inline SpMat<eT> finalise();
+  
+  
+  private:
+  
+  struct triplet_type
+    {
+    uword row;
+    uword col;
+    eT    val;
+    };
+  
+  struct buffer_type
+    {
+    std::vector<triplet_type> triplets;
+    
+    char padding[64];  // keeps the bookkeeping of adjacent buffers in separate cache lines
+    };
+  
+  //! unique identifier of the current set of buffers; threads use it to recognise the buffer they have claimed earlier
+  arma_aligned uword serial;
+  
+  arma_aligned std::unique_ptr<buffer_type[]> buffers;
+  arma_aligned std::atomic<uword>             n_claimed;
+  
+  arma_aligned buffer_type shared_buffer;
+  
+  #if defined(ARMA_USE_STD_MUTEX)
+    arma_aligned std::mutex shared_mutex;
+  #endif
+  
+  inline buffer_type* get_buffer();
+  
+  inline static uword get_serial();
+  
+  inline static void prefix_sum(uword* x, const uword N, const int n_threads);
+  
+  inline static void sort_col(uword* rows, eT* vals, const uword N, std::vector< std::pair<uword, eT> >& tmp);
+  };
+
+
+
+//! @}
@@ -0,0 +1,562 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_assembler
+//! @{
+
+
+
+template<typename eT>
+inline
+SpMat_assembler<eT>::~SpMat_assembler()
+  {
+  arma_debug_sigprint_this(this);
+  
+  arma_type_check(( is_supported_elem_type<eT>::value == false ));
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_assembler<eT>::SpMat_assembler(const uword in_n_rows, const uword in_n_cols)
+  : n_rows   (in_n_rows)
+  , n_cols   (in_n_cols)
+  , serial   (get_serial())
+  , buffers  (new buffer_type[n_buffers])
+  , n_claimed(0)
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_assembler<eT>::SpMat_assembler(const SizeMat& s)
+  : n_rows   (s.n_rows)
+  , n_cols   (s.n_cols)
+  , serial   (get_serial())
+  , buffers  (new buffer_type[n_buffers])
+  , n_claimed(0)
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+//! add in_val to the element at (in_row, in_col);
+//! can be called concurrently from multiple threads
+template<typename eT>
+inline
+void
+SpMat_assembler<eT>::add(const uword in_row, const uword in_col, const eT in_val)
+  {
+  arma_conform_check_bounds( ((in_row >= n_rows) || (in_col >= n_cols)), "SpMat_assembler::add(): index out of bounds" );
+  
+  if(in_val == eT(0))  { return; }
+  
+  const triplet_type triplet = { in_row, in_col, in_val };
+  
+  buffer_type* buffer = (*this).get_buffer();
+  
+  if(buffer != nullptr)  { buffer->triplets.push_back(triplet); return; }
+  
+  #if defined(ARMA_USE_STD_MUTEX)
+    const std::lock_guard<std::mutex> lock(shared_mutex);
+  #endif
+  
+  shared_buffer.triplets.push_back(triplet);
+  }
+
+
+
+//! reserve space for n_triplets in the buffer used by the calling thread
+template<typename eT>
+inline
+void
+SpMat_assembler<eT>::reserve(const uword n_triplets)
+  {
+  arma_debug_sigprint();
+  
+  buffer_type* buffer = (*this).get_buffer();
+  
+  if(buffer != nullptr)  { buffer->triplets.reserve(n_triplets); return; }
+  
+  #if defined(ARMA_USE_STD_MUTEX)
+    const std::lock_guard<std::mutex> lock(shared_mutex);
+  #endif
+  
+  shared_buffer.triplets.reserve(shared_buffer.triplets.size() + n_triplets);
+  }
+
+
+
+//! number of buffered triplets, including duplicate locations;
+//! must not be called concurrently with add()
+template<typename eT>
+inline
+uword
+SpMat_assembler<eT>::get_n_triplets() const
+  {
+  arma_debug_sigprint();
+  
+  const uword n_used = (std::min)(uword(n_claimed), uword(n_buffers));
+  
+  uword count = uword(shared_buffer.triplets.size());
+  
+  for(uword i=0; i < n_used; ++i)  { count += uword(buffers[i].triplets.size()); }
+  
+  return count;
+  }
+
+
+
+//! remove all buffered triplets and release the memory used by the buffers;
+//! must not be called concurrently with add()
+template<typename eT>
+inline
+void
+SpMat_assembler<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  const uword n_used = (std::min)(uword(n_claimed), uword(n_buffers));
+  
+  for(uword i=0; i < n_used; ++i)  { std::vector<triplet_type>().swap(buffers[i].triplets); }
+  
+  std::vector<triplet_type>().swap(shared_buffer.triplets);
+  
+  // threads have to claim buffers anew
+  serial    = get_serial();
+  n_claimed = 0;
+  }
+
+
+
+//! convert the buffered triplets to a sparse matrix in CSC format, summing the values at duplicate locations;
+//! the assembler is reset afterwards, so that it can be reused;
+//! must not be called concurrently with add()
+template<typename eT>
+inline
+void
+SpMat_assembler<eT>::finalise(SpMat<eT>& out)
+  {
+  arma_debug_sigprint();
+  
+  std::vector< const std::vector<triplet_type>* > lists;
+  
+  const uword n_used = (std::min)(uword(n_claimed), uword(n_buffers));
+  
+  for(uword i=0; i < n_used; ++i)
+    {
+    if(buffers[i].triplets.empty() == false)  { lists.push_back( &(buffers[i].triplets) ); }
+    }
+  
+  if(shared_buffer.triplets.empty() == false)  { lists.push_back( &(shared_buffer.triplets) ); }
+  
+  const uword n_lists = uword(lists.size());
+  
+  podarray<uword> list_start(n_lists + 1);
+  
+  list_start[0] = 0;
+  
+  for(uword i=0; i < n_lists; ++i)  { list_start[i+1] = list_start[i] + uword(lists[i]->size()); }
+  
+  const uword N = list_start[n_lists];
+  
+  if(N == 0)  { out.zeros(n_rows, n_cols); (*this).reset(); return; }
+  
+  const int n_threads = (mp_gate<eT>::eval_loop(N)) ? mp_thread_limit::get_loop() : int(1);
+  
+  // the triplets are split into contiguous ranges, which may span several buffers;
+  // each range has its own array of column counts, so the number of ranges is limited to keep the memory usage proportional to N
+  
+  const uword n_ranges = (std::min)( uword(n_threads), (std::max)(uword(1), N / (std::max)(uword(1), n_cols)) );
+  
+  const auto range_bounds = [&](const uword range_id, uword& start, uword& endp1, uword& list_id)
+    {
+    const uword range_size = N / n_ranges;
+    const uword n_extra    = N % n_ranges;
+    
+    start = range_id * range_size + (std::min)(range_id, n_extra);
+    endp1 = start + range_size + ( (range_id < n_extra) ? uword(1) : uword(0) );
+    
+    list_id = uword( std::upper_bound(list_start.memptr(), list_start.memptr() + n_lists + 1, start) - list_start.memptr() ) - 1;
+    };
+  
+  // 1. count the triplets in each column, separately for each range
+  
+  podarray<uword> counts(n_ranges * n_cols);
+  
+  counts.zeros();
+  
+  const auto count_worker = [&](const uword range_id)
+    {
+    uword start, endp1, list_id;
+    
+    range_bounds(range_id, start, endp1, list_id);
+    
+    uword* range_counts = counts.memptr() + (range_id * n_cols);
+    
+    for(uword i = start; i < endp1; ++i)
+      {
+      while(i >= list_start[list_id+1])  { ++list_id; }
+      
+      ++range_counts[ (*lists[list_id])[i - list_start[list_id]].col ];
+      }
+    };
+  
+  mp_loop::run(n_ranges, n_threads, count_worker);
+  
+  // 2. start of each column in the staging arrays, and the position within each column where each range starts writing
+  
+  podarray<uword> col_start(n_cols + 1);
+  
+  col_start[0] = 0;
+  
+  const auto col_total_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col = start; col < endp1; ++col)
+      {
+      uword total = 0;
+      
+      for(uword range_id=0; range_id < n_ranges; ++range_id)  { total += counts[range_id * n_cols + col]; }
+      
+      col_start[col+1] = total;
+      }
+    };
+  
+  mp_loop::run_chunked(n_cols, n_threads, col_total_worker);
+  
+  SpMat_assembler<eT>::prefix_sum(col_start.memptr(), n_cols + 1, n_threads);
+  
+  const auto col_offset_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col = start; col < endp1; ++col)
+      {
+      uword pos = col_start[col];
+      
+      for(uword range_id=0; range_id < n_ranges; ++range_id)
+        {
+        uword& count = counts[range_id * n_cols + col];
+        
+        const uword tmp = count;
+        
+        count = pos;
+        
+        pos += tmp;
+        }
+      }
+    };
+  
+  mp_loop::run_chunked(n_cols, n_threads, col_offset_worker);
+  
+  // 3. bucket the triplets by column
+  
+  podarray<uword> stage_rows(N);
+  podarray<eT>    stage_vals(N);
+  
+  const auto scatter_worker = [&](const uword range_id)
+    {
+    uword start, endp1, list_id;
+    
+    range_bounds(range_id, start, endp1, list_id);
+    
+    uword* range_pos = counts.memptr() + (range_id * n_cols);
+    
+    for(uword i = start; i < endp1; ++i)
+      {
+      while(i >= list_start[list_id+1])  { ++list_id; }
+      
+      const triplet_type& triplet = (*lists[list_id])[i - list_start[list_id]];
+      
+      const uword pos = range_pos[triplet.col]++;
+      
+      stage_rows[pos] = triplet.row;
+      stage_vals[pos] = triplet.val;
+      }
+    };
+  
+  mp_loop::run(n_ranges, n_threads, scatter_worker);
+  
+  (*this).reset();
+  
+  // 4. sort each column by row, and sum the values at duplicate locations;
+  // elements which sum to zero are removed
+  
+  podarray<uword> col_nnz(n_cols + 1);
+  
+  col_nnz[0] = 0;
+  
+  const auto reduce_worker = [&](const uword start, const uword endp1)
+    {
+    std::vector< std::pair<uword, eT> > tmp;
+    
+    for(uword col = start; col < endp1; ++col)
+      {
+      uword* rows = stage_rows.memptr() + col_start[col];
+      eT*    vals = stage_vals.memptr() + col_start[col];
+      
+      const uword col_N = col_start[col+1] - col_start[col];
+      
+      SpMat_assembler<eT>::sort_col(rows, vals, col_N, tmp);
+      
+      uword count = 0;
+      
+      for(uword i=0; i < col_N; ++i)
+        {
+        if( (count > 0) && (rows[count-1] == rows[i]) )
+          {
+          vals[count-1] += vals[i];
+          }
+        else
+          {
+          if( (count > 0) && (vals[count-1] == eT(0)) )  { --count; }
+          
+          rows[count] = rows[i];
+          vals[count] = vals[i];
+          
+          ++count;
+          }
+        }
+      
+      if( (count > 0) && (vals[count-1] == eT(0)) )  { --count; }
+      
+      col_nnz[col+1] = count;
+      }
+    };
+  
+  mp_loop::run_chunked(n_cols, n_threads, reduce_worker);
+  
+  // 5. generate the CSC representation
+  
+  SpMat_assembler<eT>::prefix_sum(col_nnz.memptr(), n_cols + 1, n_threads);
+  
+  out.reserve(n_rows, n_cols, col_nnz[n_cols]);
+  
+  arrayops::copy( access::rwp(out.col_ptrs), col_nnz.memptr(), n_cols + 1 );
+  
+  uword* out_row_indices = access::rwp(out.row_indices);
+  eT*    out_values      = access::rwp(out.values);
+  
+  const auto copy_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col = start; col < endp1; ++col)
+      {
+      const uword count = col_nnz[col+1] - col_nnz[col];
+      
+      arrayops::copy( &(out_row_indices[col_nnz[col]]), &(stage_rows[col_start[col]]), count );
+      arrayops::copy( &(out_values     [col_nnz[col]]), &(stage_vals[col_start[col]]), count );
+      }
+    };
+  
+  mp_loop::run_chunked(n_cols, n_threads, copy_worker);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat<eT>
+SpMat_assembler<eT>::finalise()
+  {
+  arma_debug_sigprint();
+  
+  SpMat<eT> out;
+  
+  (*this).finalise(out);
+  
+  return out;
+  }
+
+
+
+//! buffer claimed by the calling thread, or nullptr if all buffers have been claimed (or thread_local is not available)
+template<typename eT>
+inline
+typename SpMat_assembler<eT>::buffer_type*
+SpMat_assembler<eT>::get_buffer()
+  {
+  #if defined(ARMA_USE_THREAD_LOCAL)
+    {
+    // each thread remembers the buffers it has claimed in the most recently used assemblers;
+    // serial numbers are never reused, so entries of destroyed or reset assemblers can't be matched
+    
+    struct cache_entry
+      {
+      uword        serial = 0;
+      buffer_type* buffer = nullptr;
+      };
+    
+    static constexpr uword n_entries = 8;
+    
+    static thread_local cache_entry cache[n_entries];
+    
+    uword oldest = 0;
+    
+    for(uword i=0; i < n_entries; ++i)
+      {
+      if(cache[i].serial == serial)  { return cache[i].buffer; }
+      
+      if(cache[i].serial < cache[oldest].serial)  { oldest = i; }
+      }
+    
+    // the entry with the lowest serial belongs to the least recently created assembler
+    
+    const uword buffer_id = n_claimed.fetch_add(1);
+    
+    cache[oldest].serial = serial;
+    cache[oldest].buffer = (buffer_id < uword(n_buffers)) ? &(buffers[buffer_id]) : nullptr;
+    
+    return cache[oldest].buffer;
+    }
+  #else
+    {
+    return nullptr;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+uword
+SpMat_assembler<eT>::get_serial()
+  {
+  // serial numbers start at 1, so that they never match the initial state of the per-thread cache in get_buffer()
+  static std::atomic<uword> counter(0);
+  
+  return ++counter;
+  }
+
+
+
+//! inclusive prefix sum; when using multiple threads, each thread first sums its own chunk
+template<typename eT>
+inline
+void
+SpMat_assembler<eT>::prefix_sum(uword* x, const uword N, const int n_threads)
+  {
+  arma_debug_sigprint();
+  
+  const uword n_chunks = (std::min)(uword((std::max)(int(1), n_threads)), N);
+  
+  if(n_chunks <= 1)
+    {
+    for(uword i=1; i < N; ++i)  { x[i] += x[i-1]; }
+    
+    return;
+    }
+  
+  const uword chunk_size = N / n_chunks;
+  const uword n_extra    = N % n_chunks;
+  
+  podarray<uword> chunk_start(n_chunks + 1);
+  podarray<uword> chunk_total(n_chunks + 1);
+  
+  for(uword chunk_id=0; chunk_id <= n_chunks; ++chunk_id)
+    {
+    chunk_start[chunk_id] = chunk_id * chunk_size + (std::min)(chunk_id, n_extra);
+    }
+  
+  const auto sum_worker = [&](const uword chunk_id)
+    {
+    uword total = 0;
+    
+    for(uword i = chunk_start[chunk_id]; i < chunk_start[chunk_id+1]; ++i)  { total += x[i]; }
+    
+    chunk_total[chunk_id+1] = total;
+    };
+  
+  mp_loop::run(n_chunks, n_threads, sum_worker);
+  
+  chunk_total[0] = 0;
+  
+  for(uword chunk_id=1; chunk_id <= n_chunks; ++chunk_id)  { chunk_total[chunk_id] += chunk_total[chunk_id-1]; }
+  
+  const auto scan_worker = [&](const uword chunk_id)
+    {
+    uword running = chunk_total[chunk_id];
+    
+    for(uword i = chunk_start[chunk_id]; i < chunk_start[chunk_id+1]; ++i)  { running += x[i]; x[i] = running; }
+    };
+  
+  mp_loop::run(n_chunks, n_threads, scan_worker);
+  }
+
+
+
+//! sort the elements of one column by row index; the order of elements with the same row index is preserved
+template<typename eT>
+inline
+void
+SpMat_assembler<eT>::sort_col(uword* rows, eT* vals, const uword N, std::vector< std::pair<uword, eT> >& tmp)
+  {
+  bool is_sorted = true;
+  
+  for(uword i=1; i < N; ++i)
+    {
+    if(rows[i-1] > rows[i])  { is_sorted = false; break; }
+    }
+  
+  if(is_sorted)  { return; }
+  
+  if(N <= 16)
+    {
+    // insertion sort
+    
+    for(uword i=1; i < N; ++i)
+      {
+      const uword row = rows[i];
+      const eT    val = vals[i];
+      
+      uword j = i;
+      
+      while( (j > 0) && (rows[j-1] > row) )
+        {
+        rows[j] = rows[j-1];
+        vals[j] = vals[j-1];
+        --j;
+        }
+      
+      rows[j] = row;
+      vals[j] = val;
+      }
+    
+    return;
+    }
+  
+  tmp.resize(N);
+  
+  for(uword i=0; i < N; ++i)  { tmp[i] = std::pair<uword, eT>(rows[i], vals[i]); }
+  
+  std::stable_sort( tmp.begin(), tmp.end(), [](const std::pair<uword, eT>& A, const std::pair<uword, eT>& B) { return (A.first < B.first); } );
+  
+  for(uword i=0; i < N; ++i)
+    {
+    rows[i] = tmp[i].first;
+    vals[i] = tmp[i].second;
+    }
+  }
+
+
+
+//! @}
@@ -374,6 +374,8 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   inline void reset();
   inline void reset_cache();
   
+  inline void use_trans_cache(const bool flag = true);
+  
   //! don't use this unless you're writing internal Armadillo code
   inline void reserve(const uword in_rows, const uword in_cols, const uword new_n_nonzero);
   
@@ -649,6 +651,18 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   //! don't use this unless you're writing internal Armadillo code
   arma_inline bool is_alias(const SpMat<eT>& X) const;
   
+  //! row-wise index of the non-zero elements, equivalent to the CSC structure of the transpose
+  struct trans_index_type
+    {
+    podarray<uword> row_ptrs;     // start of each row in col_indices and csc_pos; has n_rows+1 elements
+    podarray<uword> col_indices;  // column of each non-zero element, in row-major order
+    podarray<uword> csc_pos;      // position of each non-zero element in values and row_indices
+    };
+  
+  //! don't use this unless you're writing internal Armadillo code;
+  //! returns nullptr if the transposed index has not been enabled via use_trans_cache()
+  inline const trans_index_type* get_trans_index() const;
+  
   
   protected:
   
@@ -702,6 +716,7 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   
   arma_inline void invalidate_cache() const;
   arma_inline void invalidate_csc()   const;
+  arma_inline void invalidate_trans() const;
   
   inline void sync_cache()        const;
   inline void sync_cache_simple() const;
@@ -709,6 +724,18 @@ class SpMat : public SpBase< eT, SpMat<eT> >
   inline void sync_csc_simple()   const;
   
   
+  // transposed index related
+  
+  arma_aligned mutable state_type        trans_state;
+  // 0: transposed index not used
+  // 1: transposed index enabled, but needs to be constructed from CSC
+  // 2: transposed index is valid
+  
+  arma_aligned mutable trans_index_type* trans_index = nullptr;
+  
+  inline void sync_trans_simple() const;
+  
+  
   friend class SpValProxy< SpMat<eT> >;  // allow SpValProxy to call insert_element() and delete_element()
   friend class SpSubview<eT>;
   friend class SpRow<eT>;
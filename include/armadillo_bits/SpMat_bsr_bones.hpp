@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_bsr
+//! @{
+
+
+
+//! sparse matrix stored in block compressed sparse row (BSR) format, with square blocks of fixed size;
+//! each non-zero block is stored as a dense matrix in column-major order, so that products with dense matrices use dense block operations;
+//! blocks at the bottom and right edges are padded with zeros when the matrix size is not a multiple of the block size
+template<typename eT>
+class SpMat_bsr
+  {
+  public:
+  
+  typedef eT                                elem_type;  //!< the type of elements stored in the matrix
+  typedef typename get_pod_type<eT>::result  pod_type;  //!< if eT is std::complex<T>, pod_type is T; otherwise pod_type is eT
+  
+  const uword n_rows       = 0;  //!< number of rows (read-only)
+  const uword n_cols       = 0;  //!< number of columns (read-only)
+  const uword block_size   = 1;  //!< number of rows and columns in each block (read-only)
+  const uword n_block_rows = 0;  //!< number of rows of blocks (read-only)
+  const uword n_block_cols = 0;  //!< number of columns of blocks (read-only)
+  const uword n_blocks     = 0;  //!< number of stored blocks (read-only)
+  
+  const uword* const block_row_ptrs    = nullptr;  //!< start of each row of blocks in block_col_indices; has n_block_rows+1 elements (read-only)
+  const uword* const block_col_indices = nullptr;  //!< column of each stored block; sorted within each row of blocks (read-only)
+  const eT*    const values            = nullptr;  //!< elements of the stored blocks; has n_blocks*block_size*block_size elements (read-only)
+  
+  inline ~SpMat_bsr();
+  inline  SpMat_bsr();
+  
+  inline            SpMat_bsr(const SpMat_bsr& x);
+  inline SpMat_bsr& operator=(const SpMat_bsr& x);
+  
+  inline            SpMat_bsr(SpMat_bsr&& x);
+  inline SpMat_bsr& operator=(SpMat_bsr&& x);
+  
+  template<typename T1> inline SpMat_bsr(const SpBase<eT,T1>& X, const uword in_block_size);
+  
+  inline SpMat_bsr(const uword* aux_block_row_ptrs, const uword* aux_block_col_indices, const eT* aux_values, const uword in_n_rows, const uword in_n_cols, const uword in_block_size, const bool copy_aux_mem = true);
+  
+  inline void reset();
+  
+  arma_warn_unused inline bool is_view() const;
+  
+  arma_warn_unused inline SpMat<eT> to_spmat() const;
+  
+  arma_warn_unused inline SpMat_bsr t()  const;
+  arma_warn_unused inline SpMat_bsr st() const;
+  
+  arma_warn_unused inline eT at        (const uword in_row, const uword in_col) const;
+  arma_warn_unused inline eT operator()(const uword in_row, const uword in_col) const;
+  
+  inline void times      (Mat<eT>& out, const Mat<eT>& B) const;  //!< out = (*this) * B
+  inline void trans_times(Mat<eT>& out, const Mat<eT>& B) const;  //!< out = (*this).st() * B
+  
+  
+  //! iterator over the non-zero elements, in the order of storage
+  class const_iterator
+    {
+    public:
+    
+    inline const_iterator(const SpMat_bsr& in_M, const uword in_block, const uword in_offset);
+    
+    arma_inline eT    operator*() const;
+    arma_inline uword row()       const;
+    arma_inline uword col()       const;
+    
+    inline const_iterator& operator++();
+    inline const_iterator  operator++(int);
+    
+    arma_inline bool operator==(const const_iterator& rhs) const;
+    arma_inline bool operator!=(const const_iterator& rhs) const;
+    
+    
+    private:
+    
+    const SpMat_bsr* M;
+    uword block;          // index of the current block
+    uword offset;         // position within the current block
+    uword current_brow;   // row of blocks which contains the current block
+    
+    inline void advance();
+    };
+  
+  inline const_iterator begin() const;
+  inline const_iterator end()   const;
+  
+  
+  private:
+  
+  Col<uword> mem_block_row_ptrs;
+  Col<uword> mem_block_col_indices;
+  Col<eT>    mem_values;
+  
+  inline void set_mem_ptrs();
+  
+  inline void set_size_info(const uword in_n_rows, const uword in_n_cols, const uword in_block_size, const uword in_n_blocks);
+  
+  inline void init_from_spmat(const SpMat<eT>& A, const uword in_block_size);
+  
+  template<const uword fixed_block_size>
+  inline void times_kernel(Mat<eT>& out, const Mat<eT>& B, const uword brow_start, const uword brow_endp1) const;
+  };
+
+
+
+//! @}
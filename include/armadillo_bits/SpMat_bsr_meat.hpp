@@ -0,0 +1,813 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_bsr
+//! @{
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>::~SpMat_bsr()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>::SpMat_bsr()
+  {
+  arma_debug_sigprint_this(this);
+  
+  reset();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>::SpMat_bsr(const SpMat_bsr<eT>& x)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(x);
+  }
+
+
+
+//! the copy always owns its storage, even if x refers to external memory
+template<typename eT>
+inline
+SpMat_bsr<eT>&
+SpMat_bsr<eT>::operator=(const SpMat_bsr<eT>& x)
+  {
+  arma_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  Col<uword> new_block_row_ptrs   (x.block_row_ptrs,    x.n_block_rows + 1);
+  Col<uword> new_block_col_indices(x.block_col_indices, x.n_blocks);
+  Col<eT>    new_values           (x.values,            x.n_blocks * x.block_size * x.block_size);
+  
+  mem_block_row_ptrs.steal_mem(new_block_row_ptrs);
+  mem_block_col_indices.steal_mem(new_block_col_indices);
+  mem_values.steal_mem(new_values);
+  
+  set_size_info(x.n_rows, x.n_cols, x.block_size, x.n_blocks);
+  
+  set_mem_ptrs();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>::SpMat_bsr(SpMat_bsr<eT>&& x)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(std::move(x));
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>&
+SpMat_bsr<eT>::operator=(SpMat_bsr<eT>&& x)
+  {
+  arma_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  const bool x_is_view = x.is_view();
+  
+  mem_block_row_ptrs    = std::move(x.mem_block_row_ptrs);
+  mem_block_col_indices = std::move(x.mem_block_col_indices);
+  mem_values            = std::move(x.mem_values);
+  
+  set_size_info(x.n_rows, x.n_cols, x.block_size, x.n_blocks);
+  
+  if(x_is_view)
+    {
+    access::rw(block_row_ptrs)    = x.block_row_ptrs;
+    access::rw(block_col_indices) = x.block_col_indices;
+    access::rw(values)            = x.values;
+    }
+  else
+    {
+    set_mem_ptrs();
+    }
+  
+  x.reset();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+SpMat_bsr<eT>::SpMat_bsr(const SpBase<eT,T1>& X, const uword in_block_size)
+  {
+  arma_debug_sigprint_this(this);
+  
+  arma_conform_check( (in_block_size == 0), "SpMat_bsr(): block_size must be greater than zero" );
+  
+  const unwrap_spmat<T1> U(X.get_ref());
+  
+  init_from_spmat(U.M, in_block_size);
+  }
+
+
+
+//! use the given arrays in BSR format; if copy_aux_mem is false, the arrays are used directly (without copying),
+//! and must remain valid and unchanged during the lifetime of the object
+template<typename eT>
+inline
+SpMat_bsr<eT>::SpMat_bsr(const uword* aux_block_row_ptrs, const uword* aux_block_col_indices, const eT* aux_values, const uword in_n_rows, const uword in_n_cols, const uword in_block_size, const bool copy_aux_mem)
+  {
+  arma_debug_sigprint_this(this);
+  
+  arma_conform_check( (in_block_size == 0), "SpMat_bsr(): block_size must be greater than zero" );
+  
+  const uword in_n_block_rows = (in_n_rows + in_block_size - 1) / in_block_size;
+  
+  set_size_info(in_n_rows, in_n_cols, in_block_size, aux_block_row_ptrs[in_n_block_rows]);
+  
+  if(copy_aux_mem)
+    {
+    mem_block_row_ptrs    = Col<uword>(aux_block_row_ptrs,    n_block_rows + 1);
+    mem_block_col_indices = Col<uword>(aux_block_col_indices, n_blocks);
+    mem_values            = Col<eT>   (aux_values,            n_blocks * block_size * block_size);
+    
+    set_mem_ptrs();
+    }
+  else
+    {
+    access::rw(block_row_ptrs)    = aux_block_row_ptrs;
+    access::rw(block_col_indices) = aux_block_col_indices;
+    access::rw(values)            = aux_values;
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_bsr<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  mem_block_row_ptrs.zeros(1);
+  mem_block_col_indices.reset();
+  mem_values.reset();
+  
+  set_size_info(0, 0, 1, 0);
+  
+  set_mem_ptrs();
+  }
+
+
+
+//! true if the storage refers to external memory
+template<typename eT>
+inline
+bool
+SpMat_bsr<eT>::is_view() const
+  {
+  return (block_row_ptrs != mem_block_row_ptrs.memptr());
+  }
+
+
+
+template<typename eT>
+inline
+SpMat<eT>
+SpMat_bsr<eT>::to_spmat() const
+  {
+  arma_debug_sigprint();
+  
+  const uword bs  = block_size;
+  const uword bs2 = bs * bs;
+  
+  // count the non-zero elements in each column
+  podarray<uword> col_counts(n_cols + 1);
+  
+  col_counts.zeros();
+  
+  for(uword k=0; k < n_blocks; ++k)
+    {
+    const eT*   block     = &(values[k * bs2]);
+    const uword col_start = block_col_indices[k] * bs;
+    
+    for(uword i=0; i < bs2; ++i)  { if(block[i] != eT(0))  { ++col_counts[col_start + (i / bs) + 1]; } }
+    }
+  
+  for(uword c=0; c < n_cols; ++c)  { col_counts[c + 1] += col_counts[c]; }
+  
+  SpMat<eT> out;
+  
+  out.reserve(n_rows, n_cols, col_counts[n_cols]);
+  
+  uword* out_col_ptrs    = access::rwp(out.col_ptrs);
+  uword* out_row_indices = access::rwp(out.row_indices);
+  eT*    out_values      = access::rwp(out.values);
+  
+  arrayops::copy(out_col_ptrs, col_counts.memptr(), n_cols + 1);
+  
+  // processing the rows of blocks in order gives sorted row indices within each column
+  for(uword brow=0; brow < n_block_rows; ++brow)
+    {
+    const uword row_start = brow * bs;
+    
+    for(uword k=block_row_ptrs[brow]; k < block_row_ptrs[brow + 1]; ++k)
+      {
+      const eT*   block     = &(values[k * bs2]);
+      const uword col_start = block_col_indices[k] * bs;
+      
+      for(uword j=0; j < bs; ++j)
+      for(uword i=0; i < bs; ++i)
+        {
+        const eT val = block[j*bs + i];
+        
+        if(val != eT(0))
+          {
+          const uword dest = col_counts[col_start + j]++;
+          
+          out_row_indices[dest] = row_start + i;
+          out_values     [dest] = val;
+          }
+        }
+      }
+    }
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>
+SpMat_bsr<eT>::t() const
+  {
+  arma_debug_sigprint();
+  
+  SpMat_bsr<eT> out = (*this).st();
+  
+  if(is_cx<eT>::yes)
+    {
+    eT* out_values = out.mem_values.memptr();
+    
+    for(uword i=0; i < out.mem_values.n_elem; ++i)  { out_values[i] = access::alt_conj(out_values[i]); }
+    }
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>
+SpMat_bsr<eT>::st() const
+  {
+  arma_debug_sigprint();
+  
+  const uword bs  = block_size;
+  const uword bs2 = bs * bs;
+  
+  Col<uword> new_block_row_ptrs   (n_block_cols + 1, arma_zeros_indicator()  );
+  Col<uword> new_block_col_indices(n_blocks,         arma_nozeros_indicator());
+  Col<eT>    new_values           (n_blocks * bs2,   arma_nozeros_indicator());
+  
+  uword* new_ptrs = new_block_row_ptrs.memptr();
+  
+  for(uword k=0; k < n_blocks; ++k)  { ++new_ptrs[block_col_indices[k] + 1]; }
+  
+  for(uword bc=0; bc < n_block_cols; ++bc)  { new_ptrs[bc + 1] += new_ptrs[bc]; }
+  
+  podarray<uword> pos(n_block_cols);
+  
+  arrayops::copy(pos.memptr(), new_ptrs, n_block_cols);
+  
+  for(uword brow=0; brow < n_block_rows; ++brow)
+  for(uword k=block_row_ptrs[brow]; k < block_row_ptrs[brow + 1]; ++k)
+    {
+    const uword dest = pos[block_col_indices[k]]++;
+    
+    new_block_col_indices[dest] = brow;
+    
+    const eT* block     = &(values[k * bs2]);
+          eT* new_block = &(new_values[dest * bs2]);
+    
+    for(uword j=0; j < bs; ++j)
+    for(uword i=0; i < bs; ++i)
+      {
+      new_block[i*bs + j] = block[j*bs + i];
+      }
+    }
+  
+  SpMat_bsr<eT> out;
+  
+  out.mem_block_row_ptrs.steal_mem(new_block_row_ptrs);
+  out.mem_block_col_indices.steal_mem(new_block_col_indices);
+  out.mem_values.steal_mem(new_values);
+  
+  out.set_size_info(n_cols, n_rows, bs, n_blocks);
+  
+  out.set_mem_ptrs();
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+eT
+SpMat_bsr<eT>::at(const uword in_row, const uword in_col) const
+  {
+  if(n_blocks == 0)  { return eT(0); }
+  
+  const uword bs = block_size;
+  
+  const uword brow = in_row / bs;
+  const uword bcol = in_col / bs;
+  
+  const uword* start = &(block_col_indices[block_row_ptrs[brow    ]]);
+  const uword* endp1 = &(block_col_indices[block_row_ptrs[brow + 1]]);
+  
+  const uword* loc = std::lower_bound(start, endp1, bcol);
+  
+  if( (loc == endp1) || ((*loc) != bcol) )  { return eT(0); }
+  
+  const uword k = uword(loc - block_col_indices);
+  
+  return values[k*bs*bs + (in_col - bcol*bs)*bs + (in_row - brow*bs)];
+  }
+
+
+
+template<typename eT>
+inline
+eT
+SpMat_bsr<eT>::operator()(const uword in_row, const uword in_col) const
+  {
+  arma_conform_check_bounds( ((in_row >= n_rows) || (in_col >= n_cols)), "SpMat_bsr::operator(): index out of bounds" );
+  
+  return (*this).at(in_row, in_col);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_bsr<eT>::times(Mat<eT>& out, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_assert_mul_size(n_rows, n_cols, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  if( (n_blocks == 0) || (B.n_elem == 0) )  { out.zeros(n_rows, B.n_cols); return; }
+  
+  out.set_size(n_rows, B.n_cols);
+  
+  // pad B with zero rows, so that blocks at the right edge can be processed in the same way as other blocks
+  const uword padded_n_rows = n_block_cols * block_size;
+  
+  Mat<eT> B_padded;
+  
+  if(padded_n_rows != B.n_rows)
+    {
+    B_padded.zeros(padded_n_rows, B.n_cols);
+    
+    B_padded.rows(0, B.n_rows - 1) = B;
+    }
+  
+  const Mat<eT>& BB = (padded_n_rows != B.n_rows) ? B_padded : B;
+  
+  const int n_threads = ( (n_block_rows >= 2) && mp_gate<eT>::eval_loop(n_blocks * block_size) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  const auto worker = [&](const uword start, const uword endp1)
+    {
+    switch(block_size)
+      {
+      case 2:  (*this).template times_kernel<2>(out, BB, start, endp1);  break;
+      case 3:  (*this).template times_kernel<3>(out, BB, start, endp1);  break;
+      case 4:  (*this).template times_kernel<4>(out, BB, start, endp1);  break;
+      case 8:  (*this).template times_kernel<8>(out, BB, start, endp1);  break;
+      default: (*this).template times_kernel<0>(out, BB, start, endp1);
+      }
+    };
+  
+  mp_loop::run_chunked(n_block_rows, n_threads, worker);
+  }
+
+
+
+//! compute rows of blocks [brow_start, brow_endp1) of out = (*this) * B;
+//! fixed_block_size is either the block size known at compile time, or zero
+template<typename eT>
+template<const uword fixed_block_size>
+inline
+void
+SpMat_bsr<eT>::times_kernel(Mat<eT>& out, const Mat<eT>& B, const uword brow_start, const uword brow_endp1) const
+  {
+  const uword bs  = (fixed_block_size > 0) ? fixed_block_size : block_size;
+  const uword bs2 = bs * bs;
+  
+  podarray<eT> acc_mem(bs);
+  
+  eT* acc = acc_mem.memptr();
+  
+  for(uword j=0; j < B.n_cols; ++j)
+    {
+    const eT*   x = B.colptr(j);
+          eT* y = out.colptr(j);
+    
+    for(uword brow=brow_start; brow < brow_endp1; ++brow)
+      {
+      for(uword i=0; i < bs; ++i)  { acc[i] = eT(0); }
+      
+      const uword k_endp1 = block_row_ptrs[brow + 1];
+      
+      for(uword k=block_row_ptrs[brow]; k < k_endp1; ++k)
+        {
+        const eT* block = &(values[k * bs2]);
+        const eT* x_seg = &(x[block_col_indices[k] * bs]);
+        
+        for(uword c=0; c < bs; ++c)
+          {
+          const eT  x_val     = x_seg[c];
+          const eT* block_col = &(block[c * bs]);
+          
+          for(uword i=0; i < bs; ++i)  { acc[i] += block_col[i] * x_val; }
+          }
+        }
+      
+      const uword row_start = brow * bs;
+      const uword n_valid   = (std::min)(bs, n_rows - row_start);
+      
+      for(uword i=0; i < n_valid; ++i)  { y[row_start + i] = acc[i]; }
+      }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_bsr<eT>::trans_times(Mat<eT>& out, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_assert_mul_size(n_cols, n_rows, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  if( (n_blocks == 0) || (B.n_elem == 0) )  { out.zeros(n_cols, B.n_cols); return; }
+  
+  const uword bs  = block_size;
+  const uword bs2 = bs * bs;
+  
+  const uword padded_B_n_rows   = n_block_rows * bs;
+  const uword padded_out_n_rows = n_block_cols * bs;
+  
+  Mat<eT> B_padded;
+  
+  if(padded_B_n_rows != B.n_rows)
+    {
+    B_padded.zeros(padded_B_n_rows, B.n_cols);
+    
+    B_padded.rows(0, B.n_rows - 1) = B;
+    }
+  
+  const Mat<eT>& BB = (padded_B_n_rows != B.n_rows) ? B_padded : B;
+  
+  out.zeros(padded_out_n_rows, B.n_cols);
+  
+  // the columns of the output are computed independently
+  const int n_threads = ( (B.n_cols >= 2) && mp_gate<eT>::eval_loop(n_blocks * bs) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  const auto worker = [&](const uword start, const uword endp1)
+    {
+    for(uword j=start; j < endp1; ++j)
+      {
+      const eT*   x = BB.colptr(j);
+            eT* y = out.colptr(j);
+      
+      for(uword brow=0; brow < n_block_rows; ++brow)
+        {
+        const eT* x_seg = &(x[brow * bs]);
+        
+        for(uword k=block_row_ptrs[brow]; k < block_row_ptrs[brow + 1]; ++k)
+          {
+          const eT* block = &(values[k * bs2]);
+                eT* y_seg = &(y[block_col_indices[k] * bs]);
+          
+          for(uword c=0; c < bs; ++c)
+            {
+            const eT* block_col = &(block[c * bs]);
+            
+            eT acc = eT(0);
+            
+            for(uword i=0; i < bs; ++i)  { acc += block_col[i] * x_seg[i]; }
+            
+            y_seg[c] += acc;
+            }
+          }
+        }
+      }
+    };
+  
+  mp_loop::run_chunked(B.n_cols, n_threads, worker);
+  
+  if(padded_out_n_rows != n_cols)  { out.resize(n_cols, B.n_cols); }
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_bsr<eT>::const_iterator
+SpMat_bsr<eT>::begin() const
+  {
+  return const_iterator(*this, 0, 0);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_bsr<eT>::const_iterator
+SpMat_bsr<eT>::end() const
+  {
+  return const_iterator(*this, n_blocks, 0);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_bsr<eT>::set_mem_ptrs()
+  {
+  access::rw(block_row_ptrs)    = mem_block_row_ptrs.memptr();
+  access::rw(block_col_indices) = mem_block_col_indices.memptr();
+  access::rw(values)            = mem_values.memptr();
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_bsr<eT>::set_size_info(const uword in_n_rows, const uword in_n_cols, const uword in_block_size, const uword in_n_blocks)
+  {
+  access::rw(n_rows)       = in_n_rows;
+  access::rw(n_cols)       = in_n_cols;
+  access::rw(block_size)   = in_block_size;
+  access::rw(n_block_rows) = (in_n_rows + in_block_size - 1) / in_block_size;
+  access::rw(n_block_cols) = (in_n_cols + in_block_size - 1) / in_block_size;
+  access::rw(n_blocks)     = in_n_blocks;
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_bsr<eT>::init_from_spmat(const SpMat<eT>& A, const uword in_block_size)
+  {
+  arma_debug_sigprint();
+  
+  const uword bs  = in_block_size;
+  const uword bs2 = bs * bs;
+  
+  const uword A_n_rows = A.n_rows;
+  const uword A_n_cols = A.n_cols;
+  
+  const uword A_n_block_rows = (A_n_rows + bs - 1) / bs;
+  const uword A_n_block_cols = (A_n_cols + bs - 1) / bs;
+  
+  const uword* A_col_ptrs    = A.col_ptrs;
+  const uword* A_row_indices = A.row_indices;
+  const eT*    A_values      = A.values;
+  
+  // mark[brow] is the last column of blocks which has a block in row of blocks brow
+  podarray<uword> mark(A_n_block_rows);
+  
+  mark.fill(A_n_block_cols);
+  
+  Col<uword> new_block_row_ptrs(A_n_block_rows + 1, arma_zeros_indicator());
+  
+  uword* new_ptrs = new_block_row_ptrs.memptr();
+  
+  for(uword bcol=0; bcol < A_n_block_cols; ++bcol)
+    {
+    const uword col_endp1 = (std::min)((bcol + 1) * bs, A_n_cols);
+    
+    for(uword i=A_col_ptrs[bcol * bs]; i < A_col_ptrs[col_endp1]; ++i)
+      {
+      const uword brow = A_row_indices[i] / bs;
+      
+      if(mark[brow] != bcol)  { mark[brow] = bcol; ++new_ptrs[brow + 1]; }
+      }
+    }
+  
+  for(uword brow=0; brow < A_n_block_rows; ++brow)  { new_ptrs[brow + 1] += new_ptrs[brow]; }
+  
+  const uword new_n_blocks = new_ptrs[A_n_block_rows];
+  
+  Col<uword> new_block_col_indices(new_n_blocks,       arma_nozeros_indicator());
+  Col<eT>    new_values           (new_n_blocks * bs2, arma_zeros_indicator()  );
+  
+  podarray<uword> next_block(A_n_block_rows);
+  podarray<uword>  cur_block(A_n_block_rows);
+  
+  arrayops::copy(next_block.memptr(), new_ptrs, A_n_block_rows);
+  
+  mark.fill(A_n_block_cols);
+  
+  // processing the columns of blocks in order gives sorted column indices within each row of blocks
+  for(uword bcol=0; bcol < A_n_block_cols; ++bcol)
+    {
+    const uword col_start = bcol * bs;
+    const uword col_endp1 = (std::min)(col_start + bs, A_n_cols);
+    
+    for(uword col=col_start; col < col_endp1; ++col)
+    for(uword i=A_col_ptrs[col]; i < A_col_ptrs[col + 1]; ++i)
+      {
+      const uword row  = A_row_indices[i];
+      const uword brow = row / bs;
+      
+      if(mark[brow] != bcol)
+        {
+        mark[brow] = bcol;
+        
+        cur_block[brow] = next_block[brow]++;
+        
+        new_block_col_indices[cur_block[brow]] = bcol;
+        }
+      
+      new_values[cur_block[brow]*bs2 + (col - col_start)*bs + (row - brow*bs)] = A_values[i];
+      }
+    }
+  
+  mem_block_row_ptrs.steal_mem(new_block_row_ptrs);
+  mem_block_col_indices.steal_mem(new_block_col_indices);
+  mem_values.steal_mem(new_values);
+  
+  set_size_info(A_n_rows, A_n_cols, bs, new_n_blocks);
+  
+  set_mem_ptrs();
+  }
+
+
+
+// 
+// 
+// 
+
+
+
+template<typename eT>
+inline
+SpMat_bsr<eT>::const_iterator::const_iterator(const SpMat_bsr<eT>& in_M, const uword in_block, const uword in_offset)
+  : M           (&in_M    )
+  , block       (in_block )
+  , offset      (in_offset)
+  , current_brow(0        )
+  {
+  current_brow = (in_block < in_M.n_blocks) ? uword(std::upper_bound(in_M.block_row_ptrs, in_M.block_row_ptrs + in_M.n_block_rows + 1, in_block) - in_M.block_row_ptrs) - 1 : in_M.n_block_rows;
+  
+  // skip zeros within blocks
+  const uword bs2 = in_M.block_size * in_M.block_size;
+  
+  while( (block < M->n_blocks) && (M->values[block*bs2 + offset] == eT(0)) )  { advance(); }
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_bsr<eT>::const_iterator::advance()
+  {
+  ++offset;
+  
+  if(offset == (M->block_size * M->block_size))
+    {
+    offset = 0;
+    
+    ++block;
+    
+    while( (current_brow < M->n_block_rows) && (M->block_row_ptrs[current_brow + 1] <= block) )  { ++current_brow; }
+    }
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+SpMat_bsr<eT>::const_iterator::operator*() const
+  {
+  return M->values[block * M->block_size * M->block_size + offset];
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+SpMat_bsr<eT>::const_iterator::row() const
+  {
+  return current_brow * M->block_size + (offset % M->block_size);
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+SpMat_bsr<eT>::const_iterator::col() const
+  {
+  return M->block_col_indices[block] * M->block_size + (offset / M->block_size);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_bsr<eT>::const_iterator&
+SpMat_bsr<eT>::const_iterator::operator++()
+  {
+  const uword bs2 = M->block_size * M->block_size;
+  
+  do  { advance(); }  while( (block < M->n_blocks) && (M->values[block*bs2 + offset] == eT(0)) );
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_bsr<eT>::const_iterator
+SpMat_bsr<eT>::const_iterator::operator++(int)
+  {
+  const_iterator tmp(*this);
+  
+  ++(*this);
+  
+  return tmp;
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+SpMat_bsr<eT>::const_iterator::operator==(const const_iterator& rhs) const
+  {
+  return ( (block == rhs.block) && (offset == rhs.offset) );
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+SpMat_bsr<eT>::const_iterator::operator!=(const const_iterator& rhs) const
+  {
+  return ( (block != rhs.block) || (offset != rhs.offset) );
+  }
+
+
+
+//! @}
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_csr
+//! @{
+
+
+
+//! sparse matrix stored in compressed sparse row (CSR) format;
+//! the storage can be owned by the object, or can refer to external memory (eg. the memory of an SpMat, which is the CSR format of its transpose)
+template<typename eT>
+class SpMat_csr
+  {
+  public:
+  
+  typedef eT                                elem_type;  //!< the type of elements stored in the matrix
+  typedef typename get_pod_type<eT>::result  pod_type;  //!< if eT is std::complex<T>, pod_type is T; otherwise pod_type is eT
+  
+  const uword n_rows    = 0;  //!< number of rows (read-only)
+  const uword n_cols    = 0;  //!< number of columns (read-only)
+  const uword n_nonzero = 0;  //!< number of stored elements (read-only)
+  
+  const uword* const row_ptrs    = nullptr;  //!< start of each row in col_indices and values; has n_rows+1 elements (read-only)
+  const uword* const col_indices = nullptr;  //!< column of each stored element; sorted within each row (read-only)
+  const eT*    const values      = nullptr;  //!< value of each stored element (read-only)
+  
+  inline ~SpMat_csr();
+  inline  SpMat_csr();
+  
+  inline            SpMat_csr(const SpMat_csr& x);
+  inline SpMat_csr& operator=(const SpMat_csr& x);
+  
+  inline            SpMat_csr(SpMat_csr&& x);
+  inline SpMat_csr& operator=(SpMat_csr&& x);
+  
+  template<typename T1> inline explicit SpMat_csr(const SpBase<eT,T1>& X);
+  template<typename T1> inline SpMat_csr&  operator=(const SpBase<eT,T1>& X);
+  
+  inline SpMat_csr(const uword* aux_row_ptrs, const uword* aux_col_indices, const eT* aux_values, const uword in_n_rows, const uword in_n_cols, const bool copy_aux_mem = true);
+  
+  inline void reset();
+  
+  arma_warn_unused inline bool is_view() const;
+  
+  arma_warn_unused inline SpMat<eT> to_spmat() const;
+  
+  arma_warn_unused inline SpMat_csr t()  const;
+  arma_warn_unused inline SpMat_csr st() const;
+  
+  arma_warn_unused inline eT at        (const uword in_row, const uword in_col) const;
+  arma_warn_unused inline eT operator()(const uword in_row, const uword in_col) const;
+  
+  arma_warn_unused inline sp_csc_ref<eT> get_trans_ref() const;
+  
+  inline void times      (Mat<eT>& out, const Mat<eT>& B) const;  //!< out = (*this) * B
+  inline void trans_times(Mat<eT>& out, const Mat<eT>& B) const;  //!< out = (*this).st() * B
+  
+  
+  class const_iterator
+    {
+    public:
+    
+    inline const_iterator(const SpMat_csr& in_M, const uword in_pos);
+    
+    arma_inline eT    operator*() const;
+    arma_inline uword row()       const;
+    arma_inline uword col()       const;
+    
+    inline const_iterator& operator++();
+    inline const_iterator  operator++(int);
+    
+    arma_inline bool operator==(const const_iterator& rhs) const;
+    arma_inline bool operator!=(const const_iterator& rhs) const;
+    
+    
+    private:
+    
+    const SpMat_csr* M;
+    uword pos;
+    uword current_row;
+    };
+  
+  inline const_iterator begin() const;
+  inline const_iterator end()   const;
+  
+  inline const_iterator begin_row(const uword row_num) const;
+  inline const_iterator end_row  (const uword row_num) const;
+  
+  
+  private:
+  
+  Col<uword> mem_row_ptrs;
+  Col<uword> mem_col_indices;
+  Col<eT>    mem_values;
+  
+  inline void set_mem_ptrs();
+  
+  inline void init_from_csc(const uword in_n_rows, const uword in_n_cols, const uword* in_col_ptrs, const uword* in_row_indices, const eT* in_values);
+  
+  
+  public:
+  
+  //! convert between compressed row and compressed column storage, or equivalently, transpose compressed storage;
+  //! in_ptrs has n_major+1 elements; out_ptrs must have n_minor+1 elements; the indices in the output are sorted
+  inline static void transpose_storage(const uword n_major, const uword n_minor, const uword* in_ptrs, const uword* in_indices, const eT* in_values, uword* out_ptrs, uword* out_indices, eT* out_values);
+  };
+
+
+
+//! @}
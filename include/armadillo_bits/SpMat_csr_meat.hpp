@@ -0,0 +1,575 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_csr
+//! @{
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::~SpMat_csr()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr()
+  {
+  arma_debug_sigprint_this(this);
+  
+  reset();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr(const SpMat_csr<eT>& x)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(x);
+  }
+
+
+
+//! the copy always owns its storage, even if x refers to external memory
+template<typename eT>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator=(const SpMat_csr<eT>& x)
+  {
+  arma_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  Col<uword> new_row_ptrs   (x.row_ptrs,    x.n_rows + 1);
+  Col<uword> new_col_indices(x.col_indices, x.n_nonzero );
+  Col<eT>    new_values     (x.values,      x.n_nonzero );
+  
+  mem_row_ptrs.steal_mem(new_row_ptrs);
+  mem_col_indices.steal_mem(new_col_indices);
+  mem_values.steal_mem(new_values);
+  
+  access::rw(n_rows)    = x.n_rows;
+  access::rw(n_cols)    = x.n_cols;
+  access::rw(n_nonzero) = x.n_nonzero;
+  
+  set_mem_ptrs();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr(SpMat_csr<eT>&& x)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(std::move(x));
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator=(SpMat_csr<eT>&& x)
+  {
+  arma_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  const bool x_is_view = x.is_view();
+  
+  mem_row_ptrs    = std::move(x.mem_row_ptrs);
+  mem_col_indices = std::move(x.mem_col_indices);
+  mem_values      = std::move(x.mem_values);
+  
+  access::rw(n_rows)    = x.n_rows;
+  access::rw(n_cols)    = x.n_cols;
+  access::rw(n_nonzero) = x.n_nonzero;
+  
+  if(x_is_view)
+    {
+    access::rw(row_ptrs)    = x.row_ptrs;
+    access::rw(col_indices) = x.col_indices;
+    access::rw(values)      = x.values;
+    }
+  else
+    {
+    set_mem_ptrs();
+    }
+  
+  x.reset();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+SpMat_csr<eT>::SpMat_csr(const SpBase<eT,T1>& X)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(X);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+SpMat_csr<eT>&
+SpMat_csr<eT>::operator=(const SpBase<eT,T1>& X)
+  {
+  arma_debug_sigprint();
+  
+  const unwrap_spmat<T1> U(X.get_ref());
+  const SpMat<eT>&   A = U.M;
+  
+  init_from_csc(A.n_rows, A.n_cols, A.col_ptrs, A.row_indices, A.values);
+  
+  return *this;
+  }
+
+
+
+//! use the given arrays in CSR format; if copy_aux_mem is false, the arrays are used directly (without copying),
+//! and must remain valid and unchanged during the lifetime of the object
+template<typename eT>
+inline
+SpMat_csr<eT>::SpMat_csr(const uword* aux_row_ptrs, const uword* aux_col_indices, const eT* aux_values, const uword in_n_rows, const uword in_n_cols, const bool copy_aux_mem)
+  : n_rows   (in_n_rows              )
+  , n_cols   (in_n_cols              )
+  , n_nonzero(aux_row_ptrs[in_n_rows])
+  {
+  arma_debug_sigprint_this(this);
+  
+  if(copy_aux_mem)
+    {
+    mem_row_ptrs    = Col<uword>(aux_row_ptrs,    n_rows + 1);
+    mem_col_indices = Col<uword>(aux_col_indices, n_nonzero );
+    mem_values      = Col<eT>   (aux_values,      n_nonzero );
+    
+    set_mem_ptrs();
+    }
+  else
+    {
+    access::rw(row_ptrs)    = aux_row_ptrs;
+    access::rw(col_indices) = aux_col_indices;
+    access::rw(values)      = aux_values;
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  mem_row_ptrs.zeros(1);
+  mem_col_indices.reset();
+  mem_values.reset();
+  
+  access::rw(n_rows)    = 0;
+  access::rw(n_cols)    = 0;
+  access::rw(n_nonzero) = 0;
+  
+  set_mem_ptrs();
+  }
+
+
+
+//! true if the storage refers to external memory
+template<typename eT>
+inline
+bool
+SpMat_csr<eT>::is_view() const
+  {
+  return (row_ptrs != mem_row_ptrs.memptr());
+  }
+
+
+
+template<typename eT>
+inline
+SpMat<eT>
+SpMat_csr<eT>::to_spmat() const
+  {
+  arma_debug_sigprint();
+  
+  SpMat<eT> out;
+  
+  out.reserve(n_rows, n_cols, n_nonzero);
+  
+  if(n_nonzero == 0)  { return out; }
+  
+  SpMat_csr<eT>::transpose_storage(n_rows, n_cols, row_ptrs, col_indices, values, access::rwp(out.col_ptrs), access::rwp(out.row_indices), access::rwp(out.values));
+  
+  // external storage may contain explicitly stored zeros
+  bool has_zeros = false;
+  
+  for(uword i=0; i < n_nonzero; ++i)  { if(values[i] == eT(0))  { has_zeros = true; break; } }
+  
+  if(has_zeros)  { out.remove_zeros(); }
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>
+SpMat_csr<eT>::t() const
+  {
+  arma_debug_sigprint();
+  
+  SpMat_csr<eT> out = (*this).st();
+  
+  if(is_cx<eT>::yes)
+    {
+    eT* out_values = out.mem_values.memptr();
+    
+    for(uword i=0; i < out.n_nonzero; ++i)  { out_values[i] = access::alt_conj(out_values[i]); }
+    }
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>
+SpMat_csr<eT>::st() const
+  {
+  arma_debug_sigprint();
+  
+  // the CSR format of this matrix is the CSC format of its transpose
+  SpMat_csr<eT> out;
+  
+  out.init_from_csc(n_cols, n_rows, row_ptrs, col_indices, values);
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+eT
+SpMat_csr<eT>::at(const uword in_row, const uword in_col) const
+  {
+  if(n_nonzero == 0)  { return eT(0); }
+  
+  const uword* start = &(col_indices[row_ptrs[in_row    ]]);
+  const uword* endp1 = &(col_indices[row_ptrs[in_row + 1]]);
+  
+  const uword* loc = std::lower_bound(start, endp1, in_col);
+  
+  return ( (loc != endp1) && ((*loc) == in_col) ) ? values[loc - col_indices] : eT(0);
+  }
+
+
+
+template<typename eT>
+inline
+eT
+SpMat_csr<eT>::operator()(const uword in_row, const uword in_col) const
+  {
+  arma_conform_check_bounds( ((in_row >= n_rows) || (in_col >= n_cols)), "SpMat_csr::operator(): index out of bounds" );
+  
+  return (*this).at(in_row, in_col);
+  }
+
+
+
+//! reference to the storage, interpreted as the CSC format of the transpose
+template<typename eT>
+inline
+sp_csc_ref<eT>
+SpMat_csr<eT>::get_trans_ref() const
+  {
+  return sp_csc_ref<eT>(n_cols, n_rows, row_ptrs, col_indices, values);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::times(Mat<eT>& out, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_assert_mul_size(n_rows, n_cols, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  // each row of the output is computed independently
+  sparse_dense_helper::trans_times(out, get_trans_ref(), B);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::trans_times(Mat<eT>& out, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_assert_mul_size(n_cols, n_rows, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  sparse_dense_helper::times(out, get_trans_ref(), B);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::begin() const
+  {
+  return const_iterator(*this, 0);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::end() const
+  {
+  return const_iterator(*this, n_nonzero);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::begin_row(const uword row_num) const
+  {
+  arma_conform_check_bounds( (row_num >= n_rows), "SpMat_csr::begin_row(): index out of bounds" );
+  
+  return const_iterator(*this, row_ptrs[row_num]);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::end_row(const uword row_num) const
+  {
+  arma_conform_check_bounds( (row_num >= n_rows), "SpMat_csr::end_row(): index out of bounds" );
+  
+  return const_iterator(*this, row_ptrs[row_num + 1]);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::set_mem_ptrs()
+  {
+  access::rw(row_ptrs)    = mem_row_ptrs.memptr();
+  access::rw(col_indices) = mem_col_indices.memptr();
+  access::rw(values)      = mem_values.memptr();
+  }
+
+
+
+//! set to the CSR format of the matrix given in CSC format
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::init_from_csc(const uword in_n_rows, const uword in_n_cols, const uword* in_col_ptrs, const uword* in_row_indices, const eT* in_values)
+  {
+  arma_debug_sigprint();
+  
+  const uword in_n_nonzero = in_col_ptrs[in_n_cols];
+  
+  Col<uword> new_row_ptrs   (in_n_rows + 1, arma_nozeros_indicator());
+  Col<uword> new_col_indices(in_n_nonzero,  arma_nozeros_indicator());
+  Col<eT>    new_values     (in_n_nonzero,  arma_nozeros_indicator());
+  
+  SpMat_csr<eT>::transpose_storage(in_n_cols, in_n_rows, in_col_ptrs, in_row_indices, in_values, new_row_ptrs.memptr(), new_col_indices.memptr(), new_values.memptr());
+  
+  mem_row_ptrs.steal_mem(new_row_ptrs);
+  mem_col_indices.steal_mem(new_col_indices);
+  mem_values.steal_mem(new_values);
+  
+  access::rw(n_rows)    = in_n_rows;
+  access::rw(n_cols)    = in_n_cols;
+  access::rw(n_nonzero) = in_n_nonzero;
+  
+  set_mem_ptrs();
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_csr<eT>::transpose_storage(const uword n_major, const uword n_minor, const uword* in_ptrs, const uword* in_indices, const eT* in_values, uword* out_ptrs, uword* out_indices, eT* out_values)
+  {
+  arma_debug_sigprint();
+  
+  const uword nnz = in_ptrs[n_major];
+  
+  arrayops::fill_zeros(out_ptrs, n_minor + 1);
+  
+  for(uword i=0; i < nnz; ++i)  { ++out_ptrs[in_indices[i] + 1]; }
+  
+  for(uword i=0; i < n_minor; ++i)  { out_ptrs[i + 1] += out_ptrs[i]; }
+  
+  podarray<uword> pos(n_minor);
+  
+  arrayops::copy(pos.memptr(), out_ptrs, n_minor);
+  
+  // processing the major dimension in order gives sorted indices in the output
+  for(uword major=0; major < n_major; ++major)
+    {
+    const uword i_endp1 = in_ptrs[major + 1];
+    
+    for(uword i=in_ptrs[major]; i < i_endp1; ++i)
+      {
+      const uword dest = pos[in_indices[i]]++;
+      
+      out_indices[dest] = major;
+      out_values [dest] = in_values[i];
+      }
+    }
+  }
+
+
+
+// 
+// 
+// 
+
+
+
+template<typename eT>
+inline
+SpMat_csr<eT>::const_iterator::const_iterator(const SpMat_csr<eT>& in_M, const uword in_pos)
+  : M          (&in_M )
+  , pos        (in_pos)
+  , current_row(0     )
+  {
+  // find the row which contains the element at in_pos, skipping empty rows
+  current_row = (in_pos < in_M.n_nonzero) ? uword(std::upper_bound(in_M.row_ptrs, in_M.row_ptrs + in_M.n_rows + 1, in_pos) - in_M.row_ptrs) - 1 : in_M.n_rows;
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+SpMat_csr<eT>::const_iterator::operator*() const
+  {
+  return M->values[pos];
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+SpMat_csr<eT>::const_iterator::row() const
+  {
+  return current_row;
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+SpMat_csr<eT>::const_iterator::col() const
+  {
+  return M->col_indices[pos];
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator&
+SpMat_csr<eT>::const_iterator::operator++()
+  {
+  ++pos;
+  
+  while( (current_row < M->n_rows) && (M->row_ptrs[current_row + 1] <= pos) )  { ++current_row; }
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_csr<eT>::const_iterator
+SpMat_csr<eT>::const_iterator::operator++(int)
+  {
+  const_iterator tmp(*this);
+  
+  ++(*this);
+  
+  return tmp;
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+SpMat_csr<eT>::const_iterator::operator==(const const_iterator& rhs) const
+  {
+  return (pos == rhs.pos);
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+SpMat_csr<eT>::const_iterator::operator!=(const const_iterator& rhs) const
+  {
+  return (pos != rhs.pos);
+  }
+
+
+
+//! @}
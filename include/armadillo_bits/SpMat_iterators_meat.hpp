@@ -405,6 +405,20 @@ SpMat<eT>::const_row_iterator::const_row_iterator(const SpMat<eT>& in_M, uword i
     return;
     }
   
+  const typename SpMat<eT>::trans_index_type* ti = in_M.get_trans_index();
+  
+  if(ti != nullptr)
+    {
+    const uword* row_ptrs = ti->row_ptrs.memptr();
+    
+    internal_row = uword(std::upper_bound(row_ptrs, row_ptrs + in_M.n_rows + 1, initial_pos) - row_ptrs) - 1;
+    
+    iterator_base::internal_col = ti->col_indices[initial_pos];
+    actual_pos                  = ti->csc_pos[initial_pos];
+    
+    return;
+    }
+  
   // We don't count zeros in our position count, so we have to find the nonzero
   // value corresponding to the given initial position.  We assume initial_pos
   // is valid.
@@ -475,6 +489,44 @@ SpMat<eT>::const_row_iterator::const_row_iterator(const SpMat<eT>& in_M, uword i
   , internal_row(0)
   , actual_pos(0)
   {
+  const typename SpMat<eT>::trans_index_type* ti = in_M.get_trans_index();
+  
+  if(ti != nullptr)
+    {
+    // the elements of each row are contiguous in the transposed index
+    
+    const uword* row_ptrs = ti->row_ptrs.memptr();
+    
+    uword pos = in_M.n_nonzero;
+    
+    if(in_row < in_M.n_rows)
+      {
+      const uword* start_ptr = ti->col_indices.memptr() + row_ptrs[in_row    ];
+      const uword*   end_ptr = ti->col_indices.memptr() + row_ptrs[in_row + 1];
+      
+      pos = row_ptrs[in_row] + uword(std::lower_bound(start_ptr, end_ptr, in_col) - start_ptr);
+      }
+    
+    iterator_base::internal_pos = pos;
+    
+    if(pos == in_M.n_nonzero)
+      {
+      internal_row = in_M.n_rows;
+      iterator_base::internal_col = 0;
+      }
+    else
+      {
+      internal_row = in_row;
+      
+      while(row_ptrs[internal_row + 1] <= pos)  { ++internal_row; }
+      
+      iterator_base::internal_col = ti->col_indices[pos];
+      actual_pos                  = ti->csc_pos[pos];
+      }
+    
+    return;
+    }
+  
   // Start our search in the given row.  We need to find two things:
   //
   //   1. The first nonzero element (iterating by rows) after (in_row, in_col).
@@ -570,6 +622,20 @@ SpMat<eT>::const_row_iterator::operator++()
     return *this;
     }
   
+  if(iterator_base::M->trans_state == 2)
+    {
+    const typename SpMat<eT>::trans_index_type& ti = *(iterator_base::M->trans_index);
+    
+    const uword pos = iterator_base::internal_pos;
+    
+    while(ti.row_ptrs[internal_row + 1] <= pos)  { ++internal_row; }
+    
+    iterator_base::internal_col = ti.col_indices[pos];
+    actual_pos                  = ti.csc_pos[pos];
+    
+    return *this;
+    }
+  
   // Otherwise, we need to search.  We can start in the next column and use
   // lower_bound() to find the next element.
   uword next_min_row = iterator_base::M->n_rows;
@@ -709,6 +775,20 @@ SpMat<eT>::const_row_iterator::operator--()
   
   iterator_base::internal_pos--;
   
+  if(iterator_base::M->trans_state == 2)
+    {
+    const typename SpMat<eT>::trans_index_type& ti = *(iterator_base::M->trans_index);
+    
+    const uword pos = iterator_base::internal_pos;
+    
+    while(ti.row_ptrs[internal_row] > pos)  { --internal_row; }
+    
+    iterator_base::internal_col = ti.col_indices[pos];
+    actual_pos                  = ti.csc_pos[pos];
+    
+    return *this;
+    }
+  
   // We have to search backwards.  We'll do this by going backwards over columns
   // and seeing if we find an element in the same row.
   uword max_row = 0;
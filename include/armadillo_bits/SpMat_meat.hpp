@@ -54,6 +54,8 @@ SpMat<eT>::~SpMat()
   if(values     )  { memory::release(access::rw(values));      }
   if(row_indices)  { memory::release(access::rw(row_indices)); }
   if(col_ptrs   )  { memory::release(access::rw(col_ptrs));    }
+  
+  if(trans_index)  { delete trans_index; }
   }
 
 
@@ -1287,41 +1289,52 @@ SpMat<eT>::operator=(const SpSubview<eT>& X)
     
     if(X.n_rows == X.m.n_rows)
       {
+      // the elements of the subview are contiguous in the parent matrix
+      
+      const uword  sv_col_start = X.aux_col1;
+      const uword* m_col_ptrs   = &(X.m.col_ptrs[sv_col_start]);
+      const uword  m_start      = m_col_ptrs[0];
+      
+      arrayops::copy(access::rwp(values),      &(X.m.values[m_start]),      n_nonzero);
+      arrayops::copy(access::rwp(row_indices), &(X.m.row_indices[m_start]), n_nonzero);
+      
+      for(uword c=0; c < n_cols; ++c)  { access::rw(col_ptrs[c + 1]) = m_col_ptrs[c + 1] - m_col_ptrs[c]; }
+      }
+    else
+    if( (X.n_rows == 1) && (X.m.get_trans_index() != nullptr) )
+      {
+      // extract the row directly from the transposed index
+      
+      const typename SpMat<eT>::trans_index_type& ti = *(X.m.get_trans_index());
+      
       const uword sv_col_start = X.aux_col1;
-      const uword sv_col_end   = X.aux_col1 + X.n_cols - 1;
+      const uword sv_col_endp1 = X.aux_col1 + X.n_cols;
+      
+      const uword* start_ptr = ti.col_indices.memptr() + ti.row_ptrs[X.aux_row1    ];
+      const uword*   end_ptr = ti.col_indices.memptr() + ti.row_ptrs[X.aux_row1 + 1];
       
-      typename SpMat<eT>::const_col_iterator m_it     = X.m.begin_col_no_sync(sv_col_start);
-      typename SpMat<eT>::const_col_iterator m_it_end = X.m.end_col_no_sync(sv_col_end);
+      const uword* pos_ptr = std::lower_bound(start_ptr, end_ptr, sv_col_start);
+      
+      const uword* csc_pos = ti.csc_pos.memptr() + ti.row_ptrs[X.aux_row1];
       
       uword count = 0;
       
-      while(m_it != m_it_end)
+      for(; (pos_ptr != end_ptr) && ((*pos_ptr) < sv_col_endp1); ++pos_ptr)
         {
-        const uword m_it_col_adjusted = m_it.col() - sv_col_start;
-        
-        access::rw(row_indices[count]) = m_it.row();
-        access::rw(values[count]) = (*m_it);
-        ++access::rw(col_ptrs[m_it_col_adjusted + 1]);
+        access::rw(row_indices[count]) = 0;
+        access::rw(values[count])      = X.m.values[ csc_pos[pos_ptr - start_ptr] ];
         
-        count++;
+        ++access::rw(col_ptrs[(*pos_ptr) - sv_col_start + 1]);
         
-        ++m_it;
+        ++count;
         }
       }
     else
       {
-      typename SpSubview<eT>::const_iterator it     = X.begin();
-      typename SpSubview<eT>::const_iterator it_end = X.end();
+      // column pointers are set by extract()
+      SpSubview<eT>::extract(*this, X);
       
-      while(it != it_end)
-        {
-        const uword it_pos = it.pos();
-        
-        access::rw(row_indices[it_pos]) = it.row();
-        access::rw(values[it_pos]) = (*it);
-        ++access::rw(col_ptrs[it.col() + 1]);
-        ++it;
-        }
+      return *this;
       }
     
     // Now sum column pointers.
@@ -4547,6 +4560,68 @@ SpMat<eT>::reset_cache()
 
 
 
+//! enable or disable the transposed index, which is used by row iterators, row extraction and transposes;
+//! the index is constructed on first use, and is discarded whenever the matrix is modified
+template<typename eT>
+inline
+void
+SpMat<eT>::use_trans_cache(const bool flag)
+  {
+  arma_debug_sigprint();
+  
+  if(flag)
+    {
+    if(trans_state == 0)  { trans_state = 1; }
+    }
+  else
+    {
+    invalidate_trans();
+    
+    trans_state = 0;
+    }
+  }
+
+
+
+template<typename eT>
+inline
+const typename SpMat<eT>::trans_index_type*
+SpMat<eT>::get_trans_index() const
+  {
+  arma_debug_sigprint();
+  
+  if(trans_state == 0)  { return nullptr; }
+  
+  sync_csc();
+  
+  // see the note in sync_cache() regarding the locking approach
+  
+  #if defined(ARMA_USE_OPENMP)
+    if(trans_state == 1)
+      {
+      #pragma omp critical (arma_SpMat_cache)
+        {
+        sync_trans_simple();
+        }
+      }
+  #elif defined(ARMA_USE_STD_MUTEX)
+    if(trans_state == 1)
+      {
+      const std::lock_guard<std::mutex> lock(cache_mutex);
+      
+      sync_trans_simple();
+      }
+  #else
+    {
+    sync_trans_simple();
+    }
+  #endif
+  
+  return trans_index;
+  }
+
+
+
 template<typename eT>
 inline
 void
@@ -5187,80 +5262,108 @@ SpMat<eT>::init(const MapMat<eT>& x)
   
   if(x_n_nz == 0)  { return; }
   
-  typename MapMat<eT>::map_type& x_map_ref = *(x.map_ptr);
+  typedef typename MapMat<eT>::map_type::slot_type slot_type;
+  
+  const typename MapMat<eT>::map_type& x_map_ref = *(x.map_ptr);
+  
+  const uword      x_n_slots = x_map_ref.n_slots;
+  const slot_type* x_slots   = x_map_ref.slots;
   
-  typename MapMat<eT>::map_type::const_iterator x_it = x_map_ref.begin();
+  constexpr uword empty_key = MapMat<eT>::map_type::empty_key;
   
-  uword x_col             = 0;
-  uword x_col_index_start = 0;
-  uword x_col_index_endp1 = x_n_rows;
+  // the elements in the hash table are in no particular order;
+  // they are first bucketed by column (counting sort), and then sorted by row within each column
   
-  for(uword i=0; i < x_n_nz; ++i)
+  uword* t_col_ptrs    = access::rwp(col_ptrs);
+  uword* t_row_indices = access::rwp(row_indices);
+  eT*    t_values      = access::rwp(values);
+  
+  for(uword i=0; i < x_n_slots; ++i)
     {
-    const std::pair<uword, eT>& x_entry = (*x_it);
-    
-    const uword x_index = x_entry.first;
-    const eT    x_val   = x_entry.second;
+    const uword x_index = x_slots[i].key;
     
-    // have we gone past the curent column?
-    if(x_index >= x_col_index_endp1)
-      {
-      x_col = x_index / x_n_rows;
-      
-      x_col_index_start = x_col * x_n_rows;
-      x_col_index_endp1 = x_col_index_start + x_n_rows;
-      }
-    
-    const uword x_row = x_index - x_col_index_start;
+    if(x_index != empty_key)  { ++t_col_ptrs[ (x_index / x_n_rows) + 1 ]; }
+    }
+  
+  for(uword i = 0; i < x_n_cols; ++i)
+    {
+    t_col_ptrs[i + 1] += t_col_ptrs[i];
+    }
+  
+  podarray<uword> pos(x_n_cols);
+  
+  arrayops::copy(pos.memptr(), t_col_ptrs, x_n_cols);
+  
+  for(uword i=0; i < x_n_slots; ++i)
+    {
+    const uword x_index = x_slots[i].key;
     
-    // // sanity check
-    // 
-    // const uword tmp_x_row = x_index % x_n_rows;
-    // const uword tmp_x_col = x_index / x_n_rows;
-    // 
-    // if(x_row != tmp_x_row)  { cout << "x_row != tmp_x_row" << endl; exit(-1); }
-    // if(x_col != tmp_x_col)  { cout << "x_col != tmp_x_col" << endl; exit(-1); }
+    if(x_index == empty_key)  { continue; }
     
-    access::rw(values[i])      = x_val;
-    access::rw(row_indices[i]) = x_row;
+    const uword x_col = x_index / x_n_rows;
+    const uword x_row = x_index - (x_col * x_n_rows);
     
-    access::rw(col_ptrs[ x_col + 1 ])++;
+    const uword j = pos[x_col]++;
     
-    ++x_it;
+    t_row_indices[j] = x_row;
+    t_values[j]      = x_slots[i].val;
     }
   
+  std::vector< std::pair<uword, eT> > tmp;
   
-  for(uword i = 0; i < x_n_cols; ++i)
+  for(uword col = 0; col < x_n_cols; ++col)
     {
-    access::rw(col_ptrs[i + 1]) += col_ptrs[i];
+    const uword start = t_col_ptrs[col    ];
+    const uword end   = t_col_ptrs[col + 1];
+    
+    bool is_sorted = true;
+    
+    for(uword j = start+1; j < end; ++j)
+      {
+      if(t_row_indices[j-1] > t_row_indices[j])  { is_sorted = false; break; }
+      }
+    
+    if(is_sorted)  { continue; }
+    
+    const uword N = end - start;
+    
+    if(N <= 16)
+      {
+      // insertion sort
+      
+      for(uword j = start+1; j < end; ++j)
+        {
+        const uword row = t_row_indices[j];
+        const eT    val = t_values[j];
+        
+        uword k = j;
+        
+        while( (k > start) && (t_row_indices[k-1] > row) )
+          {
+          t_row_indices[k] = t_row_indices[k-1];
+          t_values[k]      = t_values[k-1];
+          --k;
+          }
+        
+        t_row_indices[k] = row;
+        t_values[k]      = val;
+        }
+      }
+    else
+      {
+      tmp.resize(N);
+      
+      for(uword j=0; j < N; ++j)  { tmp[j] = std::pair<uword, eT>(t_row_indices[start+j], t_values[start+j]); }
+      
+      std::sort( tmp.begin(), tmp.end(), [](const std::pair<uword, eT>& A, const std::pair<uword, eT>& B) { return (A.first < B.first); } );
+      
+      for(uword j=0; j < N; ++j)
+        {
+        t_row_indices[start+j] = tmp[j].first;
+        t_values[start+j]      = tmp[j].second;
+        }
+      }
     }
-  
-  
-  // // OLD METHOD
-  // 
-  // for(uword i=0; i < x_n_nz; ++i)
-  //   {
-  //   const std::pair<uword, eT>& x_entry = (*x_it);
-  //   
-  //   const uword x_index = x_entry.first;
-  //   const eT    x_val   = x_entry.second;
-  // 
-  // const uword x_row = x_index % x_n_rows;
-  // const uword x_col = x_index / x_n_rows;
-  // 
-  // access::rw(values[i])      = x_val;
-  // access::rw(row_indices[i]) = x_row;
-  // 
-  // access::rw(col_ptrs[ x_col + 1 ])++;
-  // 
-  // ++x_it;
-  // }
-  // 
-  // 
-  // for(uword i = 0; i < x_n_cols; ++i)
-  // {
-  // access::rw(col_ptrs[i + 1]) += col_ptrs[i];
-  // }
   }
 
 
@@ -5818,6 +5921,10 @@ SpMat<eT>::steal_mem_simple(SpMat<eT>& x)
   if(row_indices)  { memory::release(access::rw(row_indices)); }
   if(col_ptrs   )  { memory::release(access::rw(col_ptrs));    }
   
+  invalidate_trans();
+  
+  x.invalidate_trans();
+  
   access::rw(n_rows)    = x.n_rows;
   access::rw(n_cols)    = x.n_cols;
   access::rw(n_elem)    = x.n_elem;
@@ -6692,6 +6799,8 @@ SpMat<eT>::invalidate_cache() const
   {
   arma_debug_sigprint();
   
+  invalidate_trans();
+  
   if(sync_state == 0)  { return; }
   
   cache.reset();
@@ -6708,11 +6817,28 @@ SpMat<eT>::invalidate_csc() const
   {
   arma_debug_sigprint();
   
+  invalidate_trans();
+  
   sync_state = 1;
   }
 
 
 
+template<typename eT>
+arma_inline
+void
+SpMat<eT>::invalidate_trans() const
+  {
+  if(trans_state != 2)  { return; }
+  
+  delete trans_index;
+  
+  trans_index = nullptr;
+  trans_state = 1;
+  }
+
+
+
 template<typename eT>
 inline
 void
@@ -6839,6 +6965,59 @@ SpMat<eT>::sync_csc_simple() const
 
 
 
+template<typename eT>
+inline
+void
+SpMat<eT>::sync_trans_simple() const
+  {
+  arma_debug_sigprint();
+  
+  if(trans_state != 1)  { return; }
+  
+  arma_debug_print("SpMat::sync_trans_simple(): constructing transposed index");
+  
+  trans_index_type* ti = new trans_index_type;
+  
+  podarray<uword>& t_row_ptrs    = ti->row_ptrs;
+  podarray<uword>& t_col_indices = ti->col_indices;
+  podarray<uword>& t_csc_pos     = ti->csc_pos;
+  
+  t_row_ptrs.zeros(n_rows + 1);
+  t_col_indices.set_size(n_nonzero);
+  t_csc_pos.set_size(n_nonzero);
+  
+  uword* t_row_ptrs_mem = t_row_ptrs.memptr();
+  
+  for(uword i=0; i < n_nonzero; ++i)  { ++t_row_ptrs_mem[row_indices[i] + 1]; }
+  
+  for(uword row=0; row < n_rows; ++row)  { t_row_ptrs_mem[row + 1] += t_row_ptrs_mem[row]; }
+  
+  podarray<uword> next(n_rows);
+  
+  uword* next_mem = next.memptr();
+  
+  arrayops::copy(next_mem, t_row_ptrs_mem, n_rows);
+  
+  for(uword col=0; col < n_cols; ++col)
+    {
+    const uword index_start = col_ptrs[col    ];
+    const uword index_end   = col_ptrs[col + 1];
+    
+    for(uword i=index_start; i < index_end; ++i)
+      {
+      const uword dest = next_mem[row_indices[i]]++;
+      
+      t_col_indices[dest] = col;
+      t_csc_pos[dest]     = i;
+      }
+    }
+  
+  trans_index = ti;
+  trans_state = 2;
+  }
+
+
+
 
 //
 // SpMat_aux
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_sell
+//! @{
+
+
+
+//! sparse matrix stored in SELL-C-sigma format:
+//! rows are sorted by their number of non-zero elements within windows of sigma rows, and are then grouped into chunks of C rows;
+//! each chunk is padded to the length of its longest row and is stored in column-major order,
+//! so that the rows of a chunk are processed together by SIMD instructions during multiplication with dense vectors
+template<typename eT>
+class SpMat_sell
+  {
+  public:
+  
+  typedef eT                                elem_type;  //!< the type of elements stored in the matrix
+  typedef typename get_pod_type<eT>::result  pod_type;  //!< if eT is std::complex<T>, pod_type is T; otherwise pod_type is eT
+  
+  static constexpr uword default_chunk_size = 8;
+  static constexpr uword default_sigma      = 256;
+  
+  const uword n_rows     = 0;  //!< number of rows (read-only)
+  const uword n_cols     = 0;  //!< number of columns (read-only)
+  const uword n_nonzero  = 0;  //!< number of non-zero elements, excluding padding (read-only)
+  const uword chunk_size = default_chunk_size;  //!< number of rows in each chunk (C) (read-only)
+  const uword sigma      = default_sigma;       //!< number of rows in each sorting window (read-only)
+  const uword n_chunks   = 0;  //!< number of chunks (read-only)
+  
+  inline ~SpMat_sell();
+  inline  SpMat_sell();
+  
+  inline             SpMat_sell(const SpMat_sell& x);
+  inline SpMat_sell& operator= (const SpMat_sell& x);
+  
+  inline             SpMat_sell(SpMat_sell&& x);
+  inline SpMat_sell& operator= (SpMat_sell&& x);
+  
+  template<typename T1> inline explicit SpMat_sell(const SpBase<eT,T1>& X, const uword in_chunk_size = default_chunk_size, const uword in_sigma = default_sigma);
+  
+  inline void reset();
+  
+  arma_warn_unused inline uword get_n_padded() const;
+  
+  arma_warn_unused inline SpMat<eT> to_spmat() const;
+  
+  arma_warn_unused inline SpMat_sell t()  const;
+  arma_warn_unused inline SpMat_sell st() const;
+  
+  arma_warn_unused inline eT at        (const uword in_row, const uword in_col) const;
+  arma_warn_unused inline eT operator()(const uword in_row, const uword in_col) const;
+  
+  inline void times      (Mat<eT>& out, const Mat<eT>& B) const;  //!< out = (*this) * B
+  inline void trans_times(Mat<eT>& out, const Mat<eT>& B) const;  //!< out = (*this).st() * B
+  
+  
+  //! iterator over the non-zero elements, in the order of storage (ie. rows in sorted order)
+  class const_iterator
+    {
+    public:
+    
+    inline const_iterator(const SpMat_sell& in_M, const uword in_slot);
+    
+    arma_inline eT    operator*() const;
+    arma_inline uword row()       const;
+    arma_inline uword col()       const;
+    
+    inline const_iterator& operator++();
+    inline const_iterator  operator++(int);
+    
+    arma_inline bool operator==(const const_iterator& rhs) const;
+    arma_inline bool operator!=(const const_iterator& rhs) const;
+    
+    
+    private:
+    
+    const SpMat_sell* M;
+    uword slot;     // position of the current row within the sorted rows
+    uword offset;   // position within the current row
+    
+    arma_inline uword get_index() const;
+    };
+  
+  inline const_iterator begin() const;
+  inline const_iterator end()   const;
+  
+  
+  private:
+  
+  Col<uword> chunk_ptrs;    // start of each chunk in col_indices and values; has n_chunks+1 elements
+  Col<uword> slot_rows;     // row stored at each slot (ie. position within the sorted rows); n_rows indicates a padding slot
+  Col<uword> slot_lengths;  // number of non-zero elements of the row at each slot
+  Col<uword> row_slots;     // slot of each row
+  Col<uword> col_indices;   // padded with indices of zero elements
+  Col<eT>    values;        // padded with zeros
+  
+  inline void set_size_info(const uword in_n_rows, const uword in_n_cols, const uword in_n_nonzero, const uword in_chunk_size, const uword in_sigma);
+  
+  inline void init_from_spmat(const SpMat<eT>& A, const uword in_chunk_size, const uword in_sigma);
+  
+  template<const uword fixed_chunk_size>
+  inline void times_kernel(Mat<eT>& out, const Mat<eT>& B, const uword chunk_start, const uword chunk_endp1) const;
+  };
+
+
+
+//! @}
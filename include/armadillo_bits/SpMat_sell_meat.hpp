@@ -0,0 +1,640 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup SpMat_sell
+//! @{
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>::~SpMat_sell()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>::SpMat_sell()
+  {
+  arma_debug_sigprint_this(this);
+  
+  reset();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>::SpMat_sell(const SpMat_sell<eT>& x)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(x);
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>&
+SpMat_sell<eT>::operator=(const SpMat_sell<eT>& x)
+  {
+  arma_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  chunk_ptrs   = x.chunk_ptrs;
+  slot_rows    = x.slot_rows;
+  slot_lengths = x.slot_lengths;
+  row_slots    = x.row_slots;
+  col_indices  = x.col_indices;
+  values       = x.values;
+  
+  set_size_info(x.n_rows, x.n_cols, x.n_nonzero, x.chunk_size, x.sigma);
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>::SpMat_sell(SpMat_sell<eT>&& x)
+  {
+  arma_debug_sigprint_this(this);
+  
+  (*this).operator=(std::move(x));
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>&
+SpMat_sell<eT>::operator=(SpMat_sell<eT>&& x)
+  {
+  arma_debug_sigprint();
+  
+  if(this == &x)  { return *this; }
+  
+  chunk_ptrs   = std::move(x.chunk_ptrs);
+  slot_rows    = std::move(x.slot_rows);
+  slot_lengths = std::move(x.slot_lengths);
+  row_slots    = std::move(x.row_slots);
+  col_indices  = std::move(x.col_indices);
+  values       = std::move(x.values);
+  
+  set_size_info(x.n_rows, x.n_cols, x.n_nonzero, x.chunk_size, x.sigma);
+  
+  x.reset();
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+SpMat_sell<eT>::SpMat_sell(const SpBase<eT,T1>& X, const uword in_chunk_size, const uword in_sigma)
+  {
+  arma_debug_sigprint_this(this);
+  
+  arma_conform_check( ((in_chunk_size == 0) || (in_sigma == 0)), "SpMat_sell(): chunk_size and sigma must be greater than zero" );
+  
+  const unwrap_spmat<T1> U(X.get_ref());
+  
+  init_from_spmat(U.M, in_chunk_size, in_sigma);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_sell<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  chunk_ptrs.zeros(1);
+  slot_rows.reset();
+  slot_lengths.reset();
+  row_slots.reset();
+  col_indices.reset();
+  values.reset();
+  
+  set_size_info(0, 0, 0, default_chunk_size, default_sigma);
+  }
+
+
+
+//! number of stored elements, including padding
+template<typename eT>
+inline
+uword
+SpMat_sell<eT>::get_n_padded() const
+  {
+  return values.n_elem;
+  }
+
+
+
+template<typename eT>
+inline
+SpMat<eT>
+SpMat_sell<eT>::to_spmat() const
+  {
+  arma_debug_sigprint();
+  
+  const uword C = chunk_size;
+  
+  Col<uword> csr_row_ptrs   (n_rows + 1, arma_nozeros_indicator());
+  Col<uword> csr_col_indices(n_nonzero,  arma_nozeros_indicator());
+  Col<eT>    csr_values     (n_nonzero,  arma_nozeros_indicator());
+  
+  csr_row_ptrs[0] = 0;
+  
+  for(uword row=0; row < n_rows; ++row)  { csr_row_ptrs[row + 1] = csr_row_ptrs[row] + slot_lengths[row_slots[row]]; }
+  
+  for(uword row=0; row < n_rows; ++row)
+    {
+    const uword slot   = row_slots[row];
+    const uword base   = chunk_ptrs[slot / C] + (slot % C);
+    const uword length = slot_lengths[slot];
+    const uword dest   = csr_row_ptrs[row];
+    
+    for(uword l=0; l < length; ++l)
+      {
+      csr_col_indices[dest + l] = col_indices[base + l*C];
+      csr_values     [dest + l] =      values[base + l*C];
+      }
+    }
+  
+  const SpMat_csr<eT> tmp(csr_row_ptrs.memptr(), csr_col_indices.memptr(), csr_values.memptr(), n_rows, n_cols, false);
+  
+  return tmp.to_spmat();
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>
+SpMat_sell<eT>::t() const
+  {
+  arma_debug_sigprint();
+  
+  return SpMat_sell<eT>( (*this).to_spmat().t(), chunk_size, sigma );
+  }
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>
+SpMat_sell<eT>::st() const
+  {
+  arma_debug_sigprint();
+  
+  return SpMat_sell<eT>( (*this).to_spmat().st(), chunk_size, sigma );
+  }
+
+
+
+template<typename eT>
+inline
+eT
+SpMat_sell<eT>::at(const uword in_row, const uword in_col) const
+  {
+  const uword C = chunk_size;
+  
+  const uword slot   = row_slots[in_row];
+  const uword base   = chunk_ptrs[slot / C] + (slot % C);
+  const uword length = slot_lengths[slot];
+  
+  for(uword l=0; l < length; ++l)
+    {
+    const uword col = col_indices[base + l*C];
+    
+    if(col == in_col)  { return values[base + l*C]; }
+    if(col >  in_col)  { break; }
+    }
+  
+  return eT(0);
+  }
+
+
+
+template<typename eT>
+inline
+eT
+SpMat_sell<eT>::operator()(const uword in_row, const uword in_col) const
+  {
+  arma_conform_check_bounds( ((in_row >= n_rows) || (in_col >= n_cols)), "SpMat_sell::operator(): index out of bounds" );
+  
+  return (*this).at(in_row, in_col);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_sell<eT>::times(Mat<eT>& out, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_assert_mul_size(n_rows, n_cols, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  out.set_size(n_rows, B.n_cols);
+  
+  if(out.n_elem == 0)  { return; }
+  
+  const int n_threads = ( (n_chunks >= 2) && mp_gate<eT>::eval_loop(get_n_padded()) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  const auto worker = [&](const uword start, const uword endp1)
+    {
+    switch(chunk_size)
+      {
+      case 4:  (*this).template times_kernel< 4>(out, B, start, endp1);  break;
+      case 8:  (*this).template times_kernel< 8>(out, B, start, endp1);  break;
+      case 16: (*this).template times_kernel<16>(out, B, start, endp1);  break;
+      default: (*this).template times_kernel< 0>(out, B, start, endp1);
+      }
+    };
+  
+  mp_loop::run_chunked(n_chunks, n_threads, worker);
+  }
+
+
+
+//! compute the rows in chunks [chunk_start, chunk_endp1) of out = (*this) * B;
+//! fixed_chunk_size is either the chunk size known at compile time, or zero
+template<typename eT>
+template<const uword fixed_chunk_size>
+inline
+void
+SpMat_sell<eT>::times_kernel(Mat<eT>& out, const Mat<eT>& B, const uword chunk_start, const uword chunk_endp1) const
+  {
+  const uword C = (fixed_chunk_size > 0) ? fixed_chunk_size : chunk_size;
+  
+  podarray<eT> acc_mem(C);
+  
+  eT* acc = acc_mem.memptr();
+  
+  const uword* ptrs      = chunk_ptrs.memptr();
+  const uword* rows      = slot_rows.memptr();
+  const uword* cols      = col_indices.memptr();
+  const eT*    vals      = values.memptr();
+  
+  for(uword j=0; j < B.n_cols; ++j)
+    {
+    const eT* x =   B.colptr(j);
+          eT* y = out.colptr(j);
+    
+    for(uword k=chunk_start; k < chunk_endp1; ++k)
+      {
+      for(uword i=0; i < C; ++i)  { acc[i] = eT(0); }
+      
+      const uword base   = ptrs[k];
+      const uword length = (ptrs[k + 1] - base) / C;
+      
+      for(uword l=0; l < length; ++l)
+        {
+        const uword* cols_l = &(cols[base + l*C]);
+        const eT*    vals_l = &(vals[base + l*C]);
+        
+        for(uword i=0; i < C; ++i)  { acc[i] += vals_l[i] * x[cols_l[i]]; }
+        }
+      
+      const uword* rows_k = &(rows[k*C]);
+      
+      for(uword i=0; i < C; ++i)
+        {
+        const uword row = rows_k[i];
+        
+        if(row < n_rows)  { y[row] = acc[i]; }
+        }
+      }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_sell<eT>::trans_times(Mat<eT>& out, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_assert_mul_size(n_cols, n_rows, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  out.zeros(n_cols, B.n_cols);
+  
+  if( (n_nonzero == 0) || (out.n_elem == 0) )  { return; }
+  
+  const uword C       = chunk_size;
+  const uword n_slots = slot_rows.n_elem;
+  
+  // the columns of the output are computed independently
+  const int n_threads = ( (B.n_cols >= 2) && mp_gate<eT>::eval_loop(n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  const auto worker = [&](const uword start, const uword endp1)
+    {
+    for(uword j=start; j < endp1; ++j)
+      {
+      const eT* x =   B.colptr(j);
+            eT* y = out.colptr(j);
+      
+      for(uword slot=0; slot < n_slots; ++slot)
+        {
+        const uword row = slot_rows[slot];
+        
+        if(row == n_rows)  { continue; }
+        
+        const eT    x_val  = x[row];
+        const uword base   = chunk_ptrs[slot / C] + (slot % C);
+        const uword length = slot_lengths[slot];
+        
+        for(uword l=0; l < length; ++l)  { y[col_indices[base + l*C]] += values[base + l*C] * x_val; }
+        }
+      }
+    };
+  
+  mp_loop::run_chunked(B.n_cols, n_threads, worker);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_sell<eT>::const_iterator
+SpMat_sell<eT>::begin() const
+  {
+  return const_iterator(*this, 0);
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_sell<eT>::const_iterator
+SpMat_sell<eT>::end() const
+  {
+  return const_iterator(*this, slot_rows.n_elem);
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_sell<eT>::set_size_info(const uword in_n_rows, const uword in_n_cols, const uword in_n_nonzero, const uword in_chunk_size, const uword in_sigma)
+  {
+  access::rw(n_rows)     = in_n_rows;
+  access::rw(n_cols)     = in_n_cols;
+  access::rw(n_nonzero)  = in_n_nonzero;
+  access::rw(chunk_size) = in_chunk_size;
+  access::rw(sigma)      = in_sigma;
+  access::rw(n_chunks)   = (in_n_rows + in_chunk_size - 1) / in_chunk_size;
+  }
+
+
+
+template<typename eT>
+inline
+void
+SpMat_sell<eT>::init_from_spmat(const SpMat<eT>& A, const uword in_chunk_size, const uword in_sigma)
+  {
+  arma_debug_sigprint();
+  
+  const SpMat_csr<eT> csr(A);
+  
+  const uword C = in_chunk_size;
+  
+  const uword A_n_rows    = A.n_rows;
+  const uword A_n_chunks  = (A_n_rows + C - 1) / C;
+  const uword A_n_slots   = A_n_chunks * C;
+  
+  const uword* csr_row_ptrs = csr.row_ptrs;
+  
+  Col<uword> new_slot_rows   (A_n_slots,      arma_nozeros_indicator());
+  Col<uword> new_slot_lengths(A_n_slots,      arma_zeros_indicator()  );
+  Col<uword> new_row_slots   (A_n_rows,       arma_nozeros_indicator());
+  Col<uword> new_chunk_ptrs  (A_n_chunks + 1, arma_nozeros_indicator());
+  
+  uword* slot_rows_mem = new_slot_rows.memptr();
+  
+  for(uword slot=0; slot < A_n_slots; ++slot)  { slot_rows_mem[slot] = (slot < A_n_rows) ? slot : A_n_rows; }
+  
+  // sort rows by decreasing length within each window of sigma rows; the sort is stable to retain locality
+  const auto longer = [csr_row_ptrs](const uword a, const uword b) { return ( (csr_row_ptrs[a+1] - csr_row_ptrs[a]) > (csr_row_ptrs[b+1] - csr_row_ptrs[b]) ); };
+  
+  if(in_sigma > 1)
+    {
+    for(uword start=0; start < A_n_rows; start += in_sigma)
+      {
+      const uword endp1 = (std::min)(start + in_sigma, A_n_rows);
+      
+      std::stable_sort(slot_rows_mem + start, slot_rows_mem + endp1, longer);
+      }
+    }
+  
+  for(uword slot=0; slot < A_n_rows; ++slot)
+    {
+    const uword row = slot_rows_mem[slot];
+    
+    new_row_slots[row]     = slot;
+    new_slot_lengths[slot] = csr_row_ptrs[row + 1] - csr_row_ptrs[row];
+    }
+  
+  new_chunk_ptrs[0] = 0;
+  
+  for(uword k=0; k < A_n_chunks; ++k)
+    {
+    // after sorting, the first row of a chunk is usually the longest
+    uword max_length = 0;
+    
+    for(uword i=0; i < C; ++i)  { max_length = (std::max)(max_length, new_slot_lengths[k*C + i]); }
+    
+    new_chunk_ptrs[k + 1] = new_chunk_ptrs[k] + max_length * C;
+    }
+  
+  const uword n_padded = new_chunk_ptrs[A_n_chunks];
+  
+  Col<uword> new_col_indices(n_padded, arma_zeros_indicator());
+  Col<eT>    new_values     (n_padded, arma_zeros_indicator());
+  
+  const int n_threads = ( (A_n_chunks >= 2) && mp_gate<eT>::eval_loop(n_padded) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  const auto fill_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword slot=start*C; slot < endp1*C; ++slot)
+      {
+      const uword row = slot_rows_mem[slot];
+      
+      if(row == A_n_rows)  { continue; }
+      
+      const uword base   = new_chunk_ptrs[slot / C] + (slot % C);
+      const uword src    = csr_row_ptrs[row];
+      const uword length = new_slot_lengths[slot];
+      
+      for(uword l=0; l < length; ++l)
+        {
+        new_col_indices[base + l*C] = csr.col_indices[src + l];
+        new_values     [base + l*C] = csr.values     [src + l];
+        }
+      }
+    };
+  
+  mp_loop::run_chunked(A_n_chunks, n_threads, fill_worker);
+  
+  chunk_ptrs.steal_mem(new_chunk_ptrs);
+  slot_rows.steal_mem(new_slot_rows);
+  slot_lengths.steal_mem(new_slot_lengths);
+  row_slots.steal_mem(new_row_slots);
+  col_indices.steal_mem(new_col_indices);
+  values.steal_mem(new_values);
+  
+  set_size_info(A_n_rows, A.n_cols, A.n_nonzero, C, in_sigma);
+  }
+
+
+
+// 
+// 
+// 
+
+
+
+template<typename eT>
+inline
+SpMat_sell<eT>::const_iterator::const_iterator(const SpMat_sell<eT>& in_M, const uword in_slot)
+  : M     (&in_M  )
+  , slot  (in_slot)
+  , offset(0      )
+  {
+  // skip empty rows
+  while( (slot < M->slot_rows.n_elem) && (M->slot_lengths[slot] == 0) )  { ++slot; }
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+SpMat_sell<eT>::const_iterator::get_index() const
+  {
+  const uword C = M->chunk_size;
+  
+  return M->chunk_ptrs[slot / C] + offset*C + (slot % C);
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+SpMat_sell<eT>::const_iterator::operator*() const
+  {
+  return M->values[get_index()];
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+SpMat_sell<eT>::const_iterator::row() const
+  {
+  return M->slot_rows[slot];
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+SpMat_sell<eT>::const_iterator::col() const
+  {
+  return M->col_indices[get_index()];
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_sell<eT>::const_iterator&
+SpMat_sell<eT>::const_iterator::operator++()
+  {
+  ++offset;
+  
+  if(offset >= M->slot_lengths[slot])
+    {
+    offset = 0;
+    
+    ++slot;
+    
+    while( (slot < M->slot_rows.n_elem) && (M->slot_lengths[slot] == 0) )  { ++slot; }
+    }
+  
+  return *this;
+  }
+
+
+
+template<typename eT>
+inline
+typename SpMat_sell<eT>::const_iterator
+SpMat_sell<eT>::const_iterator::operator++(int)
+  {
+  const_iterator tmp(*this);
+  
+  ++(*this);
+  
+  return tmp;
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+SpMat_sell<eT>::const_iterator::operator==(const const_iterator& rhs) const
+  {
+  return ( (slot == rhs.slot) && (offset == rhs.offset) );
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+SpMat_sell<eT>::const_iterator::operator!=(const const_iterator& rhs) const
+  {
+  return ( (slot != rhs.slot) || (offset != rhs.offset) );
+  }
+
+
+
+//! @}
@@ -76,9 +76,9 @@ class SpSubview : public SpBase< eT, SpSubview<eT> >
   template<typename T1> inline const SpSubview& operator%=(const SpBase<eT, T1>& x);
   template<typename T1> inline const SpSubview& operator/=(const SpBase<eT, T1>& x);
   
-  /*
   inline static void extract(SpMat<eT>& out, const SpSubview& in);
   
+  /*
   inline static void  plus_inplace(Mat<eT>& out, const subview& in);
   inline static void minus_inplace(Mat<eT>& out, const subview& in);
   inline static void schur_inplace(Mat<eT>& out, const subview& in);
@@ -121,6 +121,8 @@ class SpSubview : public SpBase< eT, SpSubview<eT> >
   
   inline bool check_overlap(const SpSubview& x) const;
   
+  arma_inline void get_col_bounds(const uword in_col, uword& out_start, uword& out_endp1) const;
+  
   arma_warn_unused inline bool is_vec() const;
   
   inline       SpSubview_row<eT> row(const uword row_num);
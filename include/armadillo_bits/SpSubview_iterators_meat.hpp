@@ -65,45 +65,33 @@ SpSubview<eT>::const_iterator::const_iterator(const SpSubview<eT>& in_M, const u
     return;
     }
 
-  // Figure out the row and column of the position.
-  // lskip_pos holds the number of values which aren't part of this subview.
-  const uword aux_col = iterator_base::M->aux_col1;
-  const uword aux_row = iterator_base::M->aux_row1;
-  const uword ln_rows = iterator_base::M->n_rows;
-  const uword ln_cols = iterator_base::M->n_cols;
+  // Find the column containing the given position, using the bounds of the subview within each column.
+  // skip_pos holds the number of values before the position which aren't part of this subview.
+  const SpSubview<eT>& sv = in_M;
 
-  uword cur_pos   = 0; // off by one because we might be searching for pos 0
-  uword lskip_pos = iterator_base::M->m.col_ptrs[aux_col];
-  uword cur_col   = 0;
+  const uword ln_cols = sv.n_cols;
 
-  while(cur_pos < (iterator_base::internal_pos + 1))
+  uword count = 0;
+
+  for(uword cur_col=0; cur_col < ln_cols; ++cur_col)
     {
-    // Have we stepped forward a column (or multiple columns)?
-    while(((lskip_pos + cur_pos) >= iterator_base::M->m.col_ptrs[cur_col + aux_col + 1]) && (cur_col < ln_cols))
-      {
-      ++cur_col;
-      }
+    uword start, endp1;
 
-    // See if the current position is in the subview.
-    const uword row_index = iterator_base::M->m.row_indices[cur_pos + lskip_pos];
-    if(row_index < aux_row)
-      {
-      ++lskip_pos; // not valid
-      }
-    else if(row_index < (aux_row + ln_rows))
-      {
-      ++cur_pos; // valid, in the subview
-      }
-    else
+    sv.get_col_bounds(cur_col, start, endp1);
+
+    if(initial_pos < (count + (endp1 - start)))
       {
-      // skip to end of column
-      const uword next_colptr = iterator_base::M->m.col_ptrs[cur_col + aux_col + 1];
-      lskip_pos += (next_colptr - (cur_pos + lskip_pos));
+      iterator_base::internal_col = cur_col;
+      skip_pos                    = start - count;
+      return;
       }
+
+    count += (endp1 - start);
     }
 
-  iterator_base::internal_col = cur_col;
-  skip_pos                    = lskip_pos;
+  // the position is at or beyond the end of the subview
+  iterator_base::internal_col = ln_cols;
+  skip_pos                    = sv.m.n_nonzero - initial_pos;
   }
 
 
@@ -122,124 +110,48 @@ SpSubview<eT>::const_iterator::const_iterator(const SpSubview<eT>& in_M, const u
     return;
     }
 
-  // We have a destination we want to be just after, but don't know what position that is.
-  // Because we have to count the points in this subview and not in this subview, this becomes a little difficult and slow.
-  const uword aux_col = iterator_base::M->aux_col1;
-  const uword aux_row = iterator_base::M->aux_row1;
-  const uword ln_rows = iterator_base::M->n_rows;
-  const uword ln_cols = iterator_base::M->n_cols;
+  // Find the first element of the subview at or after the destination (in column-major order),
+  // using the bounds of the subview within each column.
+  const SpSubview<eT>& sv = in_M;
 
-  uword cur_pos = 0;
-  skip_pos = iterator_base::M->m.col_ptrs[aux_col];
-  uword cur_col = 0;
+  const uword aux_row = sv.aux_row1;
+  const uword ln_cols = sv.n_cols;
 
-  // Skip any empty columns.
-  while(((skip_pos + cur_pos) >= iterator_base::M->m.col_ptrs[cur_col + aux_col + 1]) && (cur_col < ln_cols))
-    {
-    ++cur_col;
-    }
+  const uword* m_row_indices = sv.m.row_indices;
+
+  uword count = 0;
 
-  while(cur_col < in_col)
+  for(uword cur_col=0; cur_col < ln_cols; ++cur_col)
     {
-    // See if the current position is in the subview.
-    const uword row_index = iterator_base::M->m.row_indices[cur_pos + skip_pos];
-    if(row_index < aux_row)
-      {
-      ++skip_pos;
-      }
-    else if(row_index < (aux_row + ln_rows))
-      {
-      ++cur_pos;
-      }
-    else
-      {
-      // skip to end of column
-      const uword next_colptr = iterator_base::M->m.col_ptrs[cur_col + aux_col + 1];
-      skip_pos += (next_colptr - (cur_pos + skip_pos));
-      }
+    uword start, endp1;
 
-    // Have we stepped forward a column (or multiple columns)?
-    while(((skip_pos + cur_pos) >= iterator_base::M->m.col_ptrs[cur_col + aux_col + 1]) && (cur_col < ln_cols))
-      {
-      ++cur_col;
-      }
-    }
+    sv.get_col_bounds(cur_col, start, endp1);
 
-  // Now we are either on the right column or ahead of it.
-  if(cur_col == in_col)
-    {
-    // We have to find the right row index.
-    uword row_index = iterator_base::M->m.row_indices[cur_pos + skip_pos];
-    while((row_index < (in_row + aux_row)))
+    if(cur_col >= in_col)
       {
-      if(row_index < aux_row)
-        {
-        ++skip_pos;
-        }
-      else
-        {
-        ++cur_pos;
-        }
+      uword first = start;
 
-      // Ensure we didn't step forward a column; if we did, we need to stop.
-      while(((skip_pos + cur_pos) >= iterator_base::M->m.col_ptrs[cur_col + aux_col + 1]) && (cur_col < ln_cols))
+      if( (cur_col == in_col) && (in_row > 0) )
         {
-        ++cur_col;
+        first = uword( std::lower_bound(m_row_indices + start, m_row_indices + endp1, aux_row + in_row) - m_row_indices );
         }
 
-      if(cur_col != in_col)
+      if(first < endp1)
         {
-        break;
+        iterator_base::internal_col = cur_col;
+        iterator_base::internal_pos = count + (first - start);
+        skip_pos                    = first - iterator_base::internal_pos;
+        return;
         }
-
-      row_index = iterator_base::M->m.row_indices[cur_pos + skip_pos];
-      }
-    }
-
-  // Now we need to find the next valid position in the subview.
-  uword row_index;
-  while(true)
-    {
-    const uword next_colptr = iterator_base::M->m.col_ptrs[cur_col + aux_col + 1];
-    row_index = iterator_base::M->m.row_indices[cur_pos + skip_pos];
-
-    // Are we at the last position?
-    if(cur_col >= ln_cols)
-      {
-      cur_col = ln_cols;
-      // Make sure we will be pointing at the last element in the parent matrix.
-      skip_pos = iterator_base::M->m.n_nonzero - iterator_base::M->n_nonzero;
-      break;
-      }
-
-    if(row_index < aux_row)
-      {
-      ++skip_pos;
       }
-    else if(row_index < (aux_row + ln_rows))
-      {
-      break; // found
-      }
-    else
-      {
-      skip_pos += (next_colptr - (cur_pos + skip_pos));
-      }
-
-    // Did we move any columns?
-    while(((skip_pos + cur_pos) >= iterator_base::M->m.col_ptrs[cur_col + aux_col + 1]) && (cur_col < ln_cols))
-      {
-      ++cur_col;
-      }
-    }
 
-  // It is possible we have moved another column.
-  while(((skip_pos + cur_pos) >= iterator_base::M->m.col_ptrs[cur_col + aux_col + 1]) && (cur_col < ln_cols))
-    {
-    ++cur_col;
+    count += (endp1 - start);
     }
 
-  iterator_base::internal_pos = cur_pos;
-  iterator_base::internal_col = cur_col;
+  // Make sure we will be pointing at the last element in the parent matrix.
+  iterator_base::internal_col = ln_cols;
+  iterator_base::internal_pos = sv.n_nonzero;
+  skip_pos                    = sv.m.n_nonzero - sv.n_nonzero;
   }
 
 
@@ -315,7 +227,11 @@ SpSubview<eT>::const_iterator::operator++()
 
     if(row_index < aux_row)
       {
-      ++lskip_pos;
+      // jump to the first element of the column which is within the subview
+      const uword* start_ptr = &(iterator_base::M->m.row_indices[cur_pos + lskip_pos]);
+      const uword* endp1_ptr = &(iterator_base::M->m.row_indices[iterator_base::M->m.col_ptrs[cur_col + aux_col + 1]]);
+
+      lskip_pos += uword(std::lower_bound(start_ptr, endp1_ptr, aux_row) - start_ptr);
       }
     else if(row_index < (aux_row + ln_rows))
       {
@@ -355,49 +271,35 @@ inline
 typename SpSubview<eT>::const_iterator&
 SpSubview<eT>::const_iterator::operator--()
   {
-  const uword aux_col = iterator_base::M->aux_col1;
-  const uword aux_row = iterator_base::M->aux_row1;
-  const uword ln_rows = iterator_base::M->n_rows;
+  const SpSubview<eT>& sv = *(iterator_base::M);
 
-  uword cur_col  = iterator_base::internal_col;
-  uword cur_pos  = iterator_base::internal_pos - 1;
+  // position of the current element within the parent matrix (one past the last element for the end iterator)
+  const uword cur_abs_pos = skip_pos + iterator_base::internal_pos;
+  const uword new_pos     = iterator_base::internal_pos - 1;
 
-  // Special condition for end of iterator.
-  if((skip_pos + cur_pos + 1) == iterator_base::M->m.n_nonzero)
-    {
-    // We are at the last element.  So we need to set skip_pos back to what it
-    // would be if we didn't manually modify it back in operator++().
-    skip_pos = iterator_base::M->m.col_ptrs[cur_col + aux_col] - iterator_base::internal_pos;
-    }
-
-  uword row_index;
+  uword cur_col = (std::min)(iterator_base::internal_col, sv.n_cols - 1);
 
+  // find the closest preceding element within the subview, using the bounds of the subview within each column
   while(true)
     {
-    const uword colptr = iterator_base::M->m.col_ptrs[cur_col + aux_col];
-    row_index = iterator_base::M->m.row_indices[cur_pos + skip_pos];
+    uword start, endp1;
 
-    // Did we move back any columns?
-    while((skip_pos + cur_pos) < iterator_base::M->m.col_ptrs[cur_col + aux_col])
-      {
-      --cur_col;
-      }
+    sv.get_col_bounds(cur_col, start, endp1);
 
-    if(row_index < aux_row)
-      {
-      skip_pos -= (colptr - (cur_pos + skip_pos) + 1);
-      }
-    else if(row_index < (aux_row + ln_rows))
-      {
-      break; // found
-      }
-    else
+    const uword last_p1 = (std::min)(endp1, cur_abs_pos);
+
+    if(last_p1 > start)
       {
-      --skip_pos;
+      skip_pos = (last_p1 - 1) - new_pos;
+      break;
       }
+
+    if(cur_col == 0)  { break; }  // decrementing begin() is undefined
+
+    --cur_col;
     }
 
-  iterator_base::internal_pos = cur_pos;
+  iterator_base::internal_pos = new_pos;
   iterator_base::internal_col = cur_col;
 
   return *this;
@@ -52,19 +52,26 @@ SpSubview<eT>::SpSubview(const SpMat<eT>& in_m, const uword in_row1, const uword
     count = m.col_ptrs[aux_col1 + n_cols] - m.col_ptrs[aux_col1];
     }
   else
+  if( (n_rows == 1) && (m.get_trans_index() != nullptr) )
     {
-    arma_debug_print("counting non-zeros in sparse subview");
+    const typename SpMat<eT>::trans_index_type& ti = *(m.get_trans_index());
+    
+    const uword* start_ptr = ti.col_indices.memptr() + ti.row_ptrs[in_row1    ];
+    const uword*   end_ptr = ti.col_indices.memptr() + ti.row_ptrs[in_row1 + 1];
     
-    uword lend     = m.col_ptrs[in_col1 + in_n_cols];
-    uword lend_row = in_row1 + in_n_rows;
+    count = uword( std::lower_bound(start_ptr, end_ptr, in_col1 + in_n_cols) - std::lower_bound(start_ptr, end_ptr, in_col1) );
+    }
+  else
+    {
+    arma_debug_print("counting non-zeros in sparse subview");
     
-    for(uword i = m.col_ptrs[in_col1]; i < lend; ++i)
+    for(uword col=0; col < in_n_cols; ++col)
       {
-      const uword m_row_indices_i = m.row_indices[i];
+      uword start, endp1;
       
-      const bool condition = (m_row_indices_i >= in_row1) && (m_row_indices_i < lend_row);
+      get_col_bounds(col, start, endp1);
       
-      count += condition ? uword(1) : uword(0);
+      count += (endp1 - start);
       }
     }
   
@@ -1231,6 +1238,136 @@ SpSubview<eT>::check_overlap(const SpSubview<eT>& x) const
 
 
 
+//! positions in m.row_indices and m.values of the elements of column in_col which are within the subview;
+//! the row indices within each column are sorted, so the bounds are found via binary search
+template<typename eT>
+arma_inline
+void
+SpSubview<eT>::get_col_bounds(const uword in_col, uword& out_start, uword& out_endp1) const
+  {
+  const uword col_start = m.col_ptrs[aux_col1 + in_col    ];
+  const uword col_endp1 = m.col_ptrs[aux_col1 + in_col + 1];
+  
+  if( (n_rows == m.n_rows) || (col_start == col_endp1) )  { out_start = col_start; out_endp1 = col_endp1; return; }
+  
+  const uword* start_ptr = m.row_indices + col_start;
+  const uword* endp1_ptr = m.row_indices + col_endp1;
+  
+  const uword row_endp1 = aux_row1 + n_rows;
+  
+  const uword* lo_ptr = start_ptr;
+  const uword* hi_ptr = endp1_ptr;
+  
+  if( (col_endp1 - col_start) <= uword(32) )
+    {
+    // for short columns a linear scan is faster than a binary search
+    uword lo_count = 0;
+    uword hi_count = 0;
+    
+    for(const uword* ptr = start_ptr; ptr != endp1_ptr; ++ptr)
+      {
+      const uword row = (*ptr);
+      
+      lo_count += (row < aux_row1 ) ? uword(1) : uword(0);
+      hi_count += (row < row_endp1) ? uword(1) : uword(0);
+      }
+    
+    lo_ptr = start_ptr + lo_count;
+    hi_ptr = start_ptr + hi_count;
+    }
+  else
+    {
+    lo_ptr = std::lower_bound(start_ptr, endp1_ptr, aux_row1 );
+    hi_ptr = std::lower_bound(lo_ptr,    endp1_ptr, row_endp1);
+    }
+  
+  out_start = col_start + uword(lo_ptr - start_ptr);
+  out_endp1 = col_start + uword(hi_ptr - start_ptr);
+  }
+
+
+
+//! out must have been initialised with the size and the number of non-zeros of the subview;
+//! for subviews spanning many columns, the columns are copied in parallel
+template<typename eT>
+inline
+void
+SpSubview<eT>::extract(SpMat<eT>& out, const SpSubview<eT>& in)
+  {
+  arma_debug_sigprint();
+  
+  const uword in_n_cols = in.n_cols;
+  const uword row_start = in.aux_row1;
+  
+  const int n_threads = ( (in_n_cols > 1) && mp_gate<eT>::eval_loop(in.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  podarray<uword> starts(in_n_cols);
+  
+  uword* starts_mem   = starts.memptr();
+  uword* out_col_ptrs = access::rwp(out.col_ptrs);
+  
+  const auto bounds_worker = [&](const uword col_start, const uword col_endp1)
+    {
+    for(uword col=col_start; col < col_endp1; ++col)
+      {
+      uword start, endp1;
+      
+      in.get_col_bounds(col, start, endp1);
+      
+      starts_mem[col]       = start;
+      out_col_ptrs[col + 1] = endp1 - start;
+      }
+    };
+  
+  const auto copy_worker = [&](const uword col_start, const uword col_endp1)
+    {
+    const uword* m_row_indices = in.m.row_indices;
+    const eT*    m_values      = in.m.values;
+    
+    uword* out_row_indices = access::rwp(out.row_indices);
+    eT*    out_values      = access::rwp(out.values);
+    
+    for(uword col=col_start; col < col_endp1; ++col)
+      {
+      const uword out_start = out_col_ptrs[col];
+      const uword N         = out_col_ptrs[col + 1] - out_start;
+      const uword m_start   = starts_mem[col];
+      
+      arrayops::copy(&(out_values[out_start]), &(m_values[m_start]), N);
+      
+      for(uword i=0; i < N; ++i)  { out_row_indices[out_start + i] = m_row_indices[m_start + i] - row_start; }
+      }
+    };
+  
+  out_col_ptrs[0] = 0;
+  
+  if(n_threads > 1)
+    {
+    arma_debug_print("SpSubview::extract(): parallel");
+    
+    mp_loop::run_chunked(in_n_cols, n_threads, bounds_worker);
+    }
+  else
+    {
+    bounds_worker(uword(0), in_n_cols);
+    }
+  
+  for(uword col=0; col < in_n_cols; ++col)  { out_col_ptrs[col + 1] += out_col_ptrs[col]; }
+  
+  arma_check( (out_col_ptrs[in_n_cols] != out.n_nonzero), "internal error: SpSubview::extract(): mismatch in number of non-zeros" );
+  
+  if(n_threads > 1)
+    {
+    mp_loop::run_weighted(in_n_cols, out_col_ptrs, n_threads, copy_worker);
+    }
+  else
+    {
+    copy_worker(uword(0), in_n_cols);
+    }
+  }
+
+
+
 template<typename eT>
 inline
 bool
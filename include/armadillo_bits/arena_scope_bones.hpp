@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup arena_scope
+//! @{
+
+
+#if defined(ARMA_USE_ARENA_ALLOC) && !defined(ARMA_USE_THREAD_LOCAL)
+  #undef ARMA_USE_ARENA_ALLOC
+  #pragma message ("WARNING: use of arena alloc disabled; thread_local not available")
+#endif
+
+
+//! thread-local pool of size-classed memory blocks, used by memory::acquire() and memory::release();
+//! pooling is only active on threads which currently have an arena_scope instance
+class arena_pool
+  {
+  public:
+  
+  // the header immediately preceding each block records the size class and the start of the underlying allocation
+  struct header_type
+    {
+    void* base;
+    uword size_class;
+    };
+  
+  // minimum space reserved for the header; it is a multiple of the alignment provided by memory::acquire_raw()
+  static constexpr size_t header_size = (arma_config::mem_align > 32) ? size_t(arma_config::mem_align) : size_t(32);
+  
+  static constexpr uword min_log2  = 6;   // smallest size class is 64 bytes
+  static constexpr uword max_log2  = 25;  // blocks larger than 32 MB are not pooled
+  static constexpr uword n_classes = 1 + 4*(max_log2 - min_log2);
+  
+  struct state_type
+    {
+    uword depth = 0;
+    void* free_list[n_classes] = {};
+    
+    inline ~state_type();
+    inline void drain();
+    };
+  
+  inline static state_type* get_state();
+  inline static bool&       get_destroyed_flag();
+  
+  inline static uword  size_class(const size_t n_bytes);
+  inline static size_t class_size(const uword  c);
+  
+  inline static size_t       header_padding(const size_t n_bytes_block);
+  inline static header_type* get_header(void* mem);
+  
+  inline static void* acquire(const size_t n_bytes);
+  inline static void  release(void* mem);
+  };
+
+
+
+//! while an instance of arena_scope exists, memory released on the calling thread
+//! is retained for reuse by subsequent allocations on the same thread;
+//! the retained memory is freed when the outermost arena_scope is destroyed
+class arena_scope
+  {
+  public:
+  
+  inline ~arena_scope();
+  inline  arena_scope();
+  
+  inline static bool is_active();
+  
+  inline      arena_scope(const arena_scope&) = delete;
+  inline void operator=  (const arena_scope&) = delete;
+  };
+
+
+
+//! @}
@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup arena_scope
+//! @{
+
+
+
+inline
+arena_pool::state_type::~state_type()
+  {
+  drain();
+  
+  depth = 0;
+  
+  arena_pool::get_destroyed_flag() = true;
+  }
+
+
+
+inline
+void
+arena_pool::state_type::drain()
+  {
+  for(uword c=0; c < n_classes; ++c)
+    {
+    void* mem = free_list[c];
+    
+    while(mem != nullptr)
+      {
+      void* next = *( (void**)(mem) );
+      
+      memory::release_raw( arena_pool::get_header(mem)->base );
+      
+      mem = next;
+      }
+    
+    free_list[c] = nullptr;
+    }
+  }
+
+
+
+//! state of the calling thread, or nullptr if the state has already been destroyed during thread exit
+//! (eg. when memory of a thread_local or static object constructed before the state is released afterwards)
+inline
+arena_pool::state_type*
+arena_pool::get_state()
+  {
+  if(arena_pool::get_destroyed_flag())  { return nullptr; }
+  
+  #if defined(ARMA_USE_THREAD_LOCAL)
+    {
+    static thread_local state_type state;
+    
+    return &state;
+    }
+  #else
+    {
+    // not reachable in practice: arena_scope_bones.hpp disables ARMA_USE_ARENA_ALLOC when thread_local is not available
+    static state_type state;
+    
+    return &state;
+    }
+  #endif
+  }
+
+
+
+//! the flag is trivially destructible, so it remains usable after the state of the thread has been destroyed
+inline
+bool&
+arena_pool::get_destroyed_flag()
+  {
+  #if defined(ARMA_USE_THREAD_LOCAL)
+    {
+    static thread_local bool flag = false;
+    
+    return flag;
+    }
+  #else
+    {
+    static bool flag = false;
+    
+    return flag;
+    }
+  #endif
+  }
+
+
+
+inline
+uword
+arena_pool::size_class(const size_t n_bytes)
+  {
+  if(n_bytes <= (size_t(1) << min_log2))  { return 0; }
+  
+  const size_t m = n_bytes - 1;
+  
+  uword k = 0;
+  
+  while( (m >> (k+1)) != 0 )  { ++k; }
+  
+  if(k >= max_log2)  { return n_classes; }
+  
+  // each power of two is split into 4 classes, limiting the internal fragmentation to 25%
+  
+  const uword s = uword( (m >> (k-2)) & size_t(3) );
+  
+  return uword(1) + uword(4)*(k - min_log2) + s;
+  }
+
+
+
+inline
+size_t
+arena_pool::class_size(const uword c)
+  {
+  if(c == 0)  { return (size_t(1) << min_log2); }
+  
+  const uword g = (c-1) / 4;
+  const uword s = (c-1) % 4;
+  
+  return ( size_t(5 + s) << (min_log2 - 2 + g) );
+  }
+
+
+
+//! space before a block of the given size, such that the block has the same alignment as the underlying allocation;
+//! memory::acquire_raw() aligns allocations at or above ARMA_MEM_HUGEPAGE_THRESHOLD to the huge page size
+inline
+size_t
+arena_pool::header_padding(const size_t n_bytes_block)
+  {
+  const size_t threshold = size_t(arma_config::mem_hugepage_threshold);
+  
+  const bool use_hugepage = (threshold > 0) && ( (threshold <= header_size) || (n_bytes_block >= (threshold - header_size)) );
+  
+  return (use_hugepage) ? memory::hugepage_size : header_size;
+  }
+
+
+
+inline
+arena_pool::header_type*
+arena_pool::get_header(void* mem)
+  {
+  return ( ((header_type*)(mem)) - 1 );
+  }
+
+
+
+inline
+void*
+arena_pool::acquire(const size_t n_bytes)
+  {
+  state_type* state = arena_pool::get_state();
+  
+  const uword c = ( (state != nullptr) && (state->depth > 0) ) ? arena_pool::size_class(n_bytes) : n_classes;
+  
+  if(c < n_classes)
+    {
+    void* mem = state->free_list[c];
+    
+    if(mem != nullptr)
+      {
+      state->free_list[c] = *( (void**)(mem) );
+      
+      return mem;
+      }
+    }
+  
+  const size_t n_bytes_block = (c < n_classes) ? arena_pool::class_size(c) : n_bytes;
+  const size_t n_bytes_pad   = arena_pool::header_padding(n_bytes_block);
+  
+  if( n_bytes_block > (std::numeric_limits<size_t>::max() - n_bytes_pad) )  { return nullptr; }
+  
+  unsigned char* base = (unsigned char*)memory::acquire_raw(n_bytes_pad + n_bytes_block);
+  
+  if(base == nullptr)  { return nullptr; }
+  
+  #if defined(MADV_NOHUGEPAGE)
+    {
+    // only the end of the padding is used (by the header), so there is no point in backing the padding with a huge page
+    if( (n_bytes_pad >= memory::hugepage_size) && ((std::size_t(base) % memory::hugepage_size) == 0) )  { madvise((void*)(base), n_bytes_pad, MADV_NOHUGEPAGE); }
+    }
+  #endif
+  
+  void* mem = (void*)(base + n_bytes_pad);
+  
+  header_type* header = arena_pool::get_header(mem);
+  
+  header->base       = (void*)(base);
+  header->size_class = c;
+  
+  return mem;
+  }
+
+
+
+inline
+void
+arena_pool::release(void* mem)
+  {
+  const header_type* header = arena_pool::get_header(mem);
+  
+  const uword c = header->size_class;
+  
+  if(c < n_classes)
+    {
+    state_type* state = arena_pool::get_state();
+    
+    if( (state != nullptr) && (state->depth > 0) )
+      {
+      // blocks released on another thread end up in the pool of that thread
+      
+      *( (void**)(mem) ) = state->free_list[c];
+      
+      state->free_list[c] = mem;
+      
+      return;
+      }
+    }
+  
+  memory::release_raw(header->base);
+  }
+
+
+
+//
+
+
+
+inline
+arena_scope::~arena_scope()
+  {
+  arma_debug_sigprint_this(this);
+  
+  #if defined(ARMA_USE_ARENA_ALLOC)
+    {
+    arena_pool::state_type* state = arena_pool::get_state();
+    
+    if(state == nullptr)  { return; }
+    
+    if(state->depth > 0)  { --(state->depth); }
+    
+    if(state->depth == 0)  { state->drain(); }
+    }
+  #endif
+  }
+
+
+
+inline
+arena_scope::arena_scope()
+  {
+  arma_debug_sigprint_this(this);
+  
+  #if defined(ARMA_USE_ARENA_ALLOC)
+    {
+    arena_pool::state_type* state = arena_pool::get_state();
+    
+    if(state != nullptr)  { ++(state->depth); }
+    }
+  #endif
+  }
+
+
+
+inline
+bool
+arena_scope::is_active()
+  {
+  #if defined(ARMA_USE_ARENA_ALLOC)
+    {
+    const arena_pool::state_type* state = arena_pool::get_state();
+    
+    return ( (state != nullptr) && (state->depth > 0) );
+    }
+  #else
+    {
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! @}
@@ -30,6 +30,20 @@ struct arma_config
   #endif
   
   
+  #if defined(ARMA_MEM_ALIGNMENT)
+    static constexpr uword mem_align = ( (sword(ARMA_MEM_ALIGNMENT) >= 16) && ((uword(ARMA_MEM_ALIGNMENT) & (uword(ARMA_MEM_ALIGNMENT) - 1)) == 0) ) ? uword(ARMA_MEM_ALIGNMENT) : 32;
+  #else
+    static constexpr uword mem_align = 32;
+  #endif
+  
+  
+  #if defined(ARMA_MEM_HUGEPAGE_THRESHOLD)
+    static constexpr uword mem_hugepage_threshold = (sword(ARMA_MEM_HUGEPAGE_THRESHOLD) > 0) ? uword(ARMA_MEM_HUGEPAGE_THRESHOLD) : 0;
+  #else
+    static constexpr uword mem_hugepage_threshold = 0;
+  #endif
+  
+  
   #if defined(ARMA_OPENMP_THRESHOLD)
     static constexpr uword mp_threshold = (sword(ARMA_OPENMP_THRESHOLD) > 0) ? uword(ARMA_OPENMP_THRESHOLD) : 320;
   #else
@@ -37,6 +51,20 @@ struct arma_config
   #endif
   
   
+  #if defined(ARMA_OPENMP_THRESHOLD_HEAVY)
+    static constexpr uword mp_threshold_heavy = (sword(ARMA_OPENMP_THRESHOLD_HEAVY) > 0) ? uword(ARMA_OPENMP_THRESHOLD_HEAVY) : 160;
+  #else
+    static constexpr uword mp_threshold_heavy = 160;
+  #endif
+  
+  
+  #if defined(ARMA_OPENMP_THRESHOLD_CHEAP)
+    static constexpr uword mp_threshold_cheap = (sword(ARMA_OPENMP_THRESHOLD_CHEAP) > 0) ? uword(ARMA_OPENMP_THRESHOLD_CHEAP) : 0;
+  #else
+    static constexpr uword mp_threshold_cheap = 0;  // zero indicates that parallelisation of inexpensive operations is disabled
+  #endif
+  
+  
   #if defined(ARMA_OPENMP_THREADS)
     static constexpr uword mp_threads = (sword(ARMA_OPENMP_THREADS) > 0) ? uword(ARMA_OPENMP_THREADS) : 8;
   #else
@@ -209,6 +237,34 @@ struct arma_config
   #endif
   
   
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    static constexpr bool mp_executor = true;
+  #else
+    static constexpr bool mp_executor = false;
+  #endif
+  
+  
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
+    static constexpr bool mp = true;
+  #else
+    static constexpr bool mp = false;
+  #endif
+  
+  
+  #if defined(ARMA_USE_SIMD)
+    static constexpr bool simd = true;
+  #else
+    static constexpr bool simd = false;
+  #endif
+  
+  
+  #if defined(ARMA_USE_SIMD_MATH)
+    static constexpr bool simd_math = true;
+  #else
+    static constexpr bool simd_math = false;
+  #endif
+  
+  
   #if defined(ARMA_USE_FORTRAN_HIDDEN_ARGS)
     static constexpr bool hidden_args = true;
   #else
@@ -52,10 +52,17 @@ template<typename eT> class SpSubview;
 template<typename eT> class SpSubview_col;
 template<typename eT> class SpSubview_row;
 
+template<typename eT> class SpMat_csr;
+template<typename eT> class SpMat_bsr;
+template<typename eT> class SpMat_sell;
+
+template<typename eT> struct sp_csc_ref;
+
 template<typename eT> class diagview;
 template<typename eT> class spdiagview;
 
 template<typename eT> class MapMat;
+template<typename eT> class MapMat_map;
 template<typename eT> class MapMat_val;
 template<typename eT> class SpMat_MapMat_val;
 template<typename eT> class SpSubview_MapMat_val;
@@ -72,6 +79,8 @@ template<typename eT, typename T1> class subview_cube_slices;
 
 template<typename eT, typename T1> class SpSubview_col_list;
 
+template<typename eT, typename fn_type, typename fn_t_type> class matfree_op;
+
 
 class SizeMat;
 class SizeCube;
@@ -463,6 +472,26 @@ struct superlu_opts : public spsolve_opts_base
   };
 
 
+struct spchol_opts : public spsolve_opts_base
+  {
+  typedef enum {NATURAL, AMD} permutation_type;
+  
+  typedef enum {LLT, LDLT} factor_type;
+  
+  bool             allow_ugly;
+  permutation_type permutation;
+  factor_type      factor;
+  
+  inline spchol_opts()
+    : spsolve_opts_base(2)
+    {
+    allow_ugly  = false;
+    permutation = AMD;
+    factor      = LLT;
+    }
+  };
+
+
 //! @}
 
 
@@ -473,15 +502,76 @@ struct superlu_opts : public spsolve_opts_base
 
 struct eigs_opts
   {
+  typedef enum {LANCZOS, LOBPCG} method_type;
+  
   double       tol;     // tolerance
   unsigned int maxiter; // max iterations
   unsigned int subdim;  // subspace dimension
+  method_type  method;     // eigensolver used by eigs_sym()
+  unsigned int blocksize;  // block size for LOBPCG; 0: automatic
+  bool         precond;    // use diagonal (Jacobi) preconditioning in LOBPCG
+  bool         warm_start; // use the given eigenvectors as the initial block in LOBPCG
   
   inline eigs_opts()
     {
-    tol     = 0.0;
-    maxiter = 1000;
-    subdim  = 0;
+    tol        = 0.0;
+    maxiter    = 1000;
+    subdim     = 0;
+    method     = LANCZOS;
+    blocksize  = 0;
+    precond    = false;
+    warm_start = false;
+    }
+  };
+
+
+struct spsolve_iter_opts
+  {
+  typedef enum {NONE, JACOBI, ILU0, IC0} precond_type;
+  
+  double       tol;            // tolerance for the relative residual; 0: automatic
+  unsigned int maxiter;        // max iterations for each column of B
+  unsigned int restart;        // restart length for GMRES
+  precond_type precond;        // preconditioner
+  bool         warm_start;     // use the given X as the initial guess
+  bool         reuse_precond;  // reuse the preconditioner held in the workspace
+  
+  inline spsolve_iter_opts()
+    {
+    tol           = 0.0;
+    maxiter       = 1000;
+    restart       = 30;
+    precond       = NONE;
+    warm_start    = false;
+    reuse_precond = false;
+    }
+  };
+
+
+struct spsolve_iter_info
+  {
+  unsigned int n_iter;     // iterations used; maximum over the columns of B
+  double       residual;   // relative residual norm(B - A*X) / norm(B); maximum over the columns of B
+  bool         converged;
+  
+  inline spsolve_iter_info()
+    {
+    n_iter    = 0;
+    residual  = 0.0;
+    converged = false;
+    }
+  };
+
+
+struct rsvd_opts
+  {
+  unsigned int oversample;  // number of extra sample vectors in addition to k
+  unsigned int power_iter;  // number of power iterations; not used by rsvd_stream
+  
+  inline rsvd_opts()
+    {
+    oversample = 10;
+    power_iter = 2;
     }
   };
 
@@ -135,6 +135,8 @@ arrayops::clamp(eT* mem, const uword n_elem, const eT min_val, const eT max_val,
   {
   arma_ignore(junk);
   
+  if(simd::clamp(mem, mem, n_elem, min_val, max_val))  { return; }
+  
   for(uword i=0; i<n_elem; ++i)
     {
     eT& val = mem[i];
@@ -325,6 +327,8 @@ inline
 void
 arrayops::inplace_plus(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::binary<simd_op::plus>(dest, dest, src, n_elem))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -362,6 +366,8 @@ inline
 void
 arrayops::inplace_minus(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::binary<simd_op::minus>(dest, dest, src, n_elem))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -399,6 +405,8 @@ inline
 void
 arrayops::inplace_mul(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::binary<simd_op::schur>(dest, dest, src, n_elem))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -436,6 +444,8 @@ inline
 void
 arrayops::inplace_div(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::binary<simd_op::div>(dest, dest, src, n_elem))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -694,6 +704,8 @@ inline
 void
 arrayops::inplace_plus(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::unary<simd_op::scalar_plus>(dest, dest, n_elem, val))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -713,6 +725,8 @@ inline
 void
 arrayops::inplace_minus(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::unary<simd_op::scalar_minus_post>(dest, dest, n_elem, val))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -732,6 +746,8 @@ inline
 void
 arrayops::inplace_mul(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::unary<simd_op::scalar_times>(dest, dest, n_elem, val))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -751,6 +767,8 @@ inline
 void
 arrayops::inplace_div(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::unary<simd_op::scalar_div_post>(dest, dest, n_elem, val))  { return; }
+  
   if(memory::is_aligned(dest))
     {
     memory::mark_as_aligned(dest);
@@ -898,6 +916,10 @@ inline
 eT
 arrayops::accumulate(const eT* src, const uword n_elem)
   {
+  eT acc_simd = eT(0);
+  
+  if(simd::accumulate(acc_simd, src, n_elem))  { return acc_simd; }
+  
   #if defined(__FAST_MATH__)
     {
     eT acc = eT(0);
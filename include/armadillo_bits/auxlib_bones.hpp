@@ -337,6 +337,9 @@ class auxlib
   template<typename T1>
   inline static bool solve_trimat_rcond(Mat<typename T1::elem_type>& out, typename T1::pod_type& out_rcond, const Mat<typename T1::elem_type>& A, const Base<typename T1::elem_type,T1>& B_expr, const uword layout);
   
+  template<typename eT>
+  inline static bool solve_trimat_inplace(Mat<eT>& X, const Mat<eT>& A, const uword N, const uword layout, const bool trans, const bool unit_diag);
+  
   //
   
   template<typename T1>
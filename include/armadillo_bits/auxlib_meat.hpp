@@ -5849,6 +5849,53 @@ auxlib::solve_trimat_rcond(Mat<typename T1::elem_type>& out, typename T1::pod_ty
 
 
 
+//! solve op(A)*X = B in place (X initially holds B), using only the top-left N x N part of triangular matrix A;
+//! layout 0: upper, 1: lower; trans: use the (conjugate) transpose of A; unit_diag: the diagonal of A is taken as ones
+template<typename eT>
+inline
+bool
+auxlib::solve_trimat_inplace(Mat<eT>& X, const Mat<eT>& A, const uword N, const uword layout, const bool trans, const bool unit_diag)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_LAPACK)
+    {
+    arma_conform_check( ((N > A.n_rows) || (N > A.n_cols) || (X.n_rows != N)), "solve(): incompatible matrix dimensions" );
+    
+    if((N == 0) || X.is_empty())  { return true; }
+    
+    arma_conform_assert_blas_size(A,X);
+    
+    char     uplo  = (layout == 0) ? 'U' : 'L';
+    char     trns  = (trans) ? ((is_cx<eT>::yes) ? 'C' : 'T') : 'N';
+    char     diag  = (unit_diag) ? 'U' : 'N';
+    blas_int n     = blas_int(N);
+    blas_int nrhs  = blas_int(X.n_cols);
+    blas_int lda   = blas_int(A.n_rows);
+    blas_int ldb   = blas_int(X.n_rows);
+    blas_int info  = 0;
+    
+    arma_debug_print("lapack::trtrs()");
+    lapack::trtrs(&uplo, &trns, &diag, &n, &nrhs, A.memptr(), &lda, X.memptr(), &ldb, &info);
+    
+    return (info == 0);
+    }
+  #else
+    {
+    arma_ignore(X);
+    arma_ignore(A);
+    arma_ignore(N);
+    arma_ignore(layout);
+    arma_ignore(trans);
+    arma_ignore(unit_diag);
+    arma_stop_logic_error("solve(): use of LAPACK must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
 //! solve a system of linear equations via LU decomposition (real band matrix)
 template<typename T1>
 inline
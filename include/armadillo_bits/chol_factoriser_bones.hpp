@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup chol_factoriser
+//! @{
+
+
+
+//! Cholesky factorisation A = L*L.t() of a symmetric positive definite real matrix,
+//! which can be modified in O(n^2) operations instead of being recomputed
+template<typename eT>
+class chol_factoriser
+  {
+  private:
+  
+  Mat<eT> L_mat;  // lower triangular factor
+  bool    valid = false;
+  
+  inline bool update_worker(const uword start, Col<eT>& x, const bool downdate);
+  
+  
+  public:
+  
+  typedef eT elem_type;
+  
+  inline  chol_factoriser();
+  
+  inline void reset();
+  
+  inline uword n_rows() const;
+  
+  inline const Mat<eT>& L() const;
+  
+  template<typename T1> inline bool factorise(const Base<eT,T1>& A_expr);
+  
+  template<typename T1> inline bool update  (const Base<eT,T1>& x_expr);  //!< A + x*x.t()
+  template<typename T1> inline bool downdate(const Base<eT,T1>& x_expr);  //!< A - x*x.t()
+  
+  template<typename T1> inline bool append(const Base<eT,T1>& c_expr);  //!< add a row and column, given by c; the last element of c is the new diagonal element
+  
+  inline bool remove(const uword k);  //!< remove row and column k
+  
+  template<typename T1> inline bool solve(Mat<eT>& X, const Base<eT,T1>& B_expr) const;
+  
+  inline eT rcond() const;
+  };
+
+
+
+//! @}
@@ -0,0 +1,356 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup chol_factoriser
+//! @{
+
+
+
+template<typename eT>
+inline
+chol_factoriser<eT>::chol_factoriser()
+  {
+  arma_debug_sigprint_this(this);
+  
+  arma_type_check(( is_real<eT>::value == false ));
+  }
+
+
+
+template<typename eT>
+inline
+void
+chol_factoriser<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  L_mat.reset();
+  
+  valid = false;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+chol_factoriser<eT>::n_rows() const
+  {
+  return L_mat.n_rows;
+  }
+
+
+
+template<typename eT>
+inline
+const Mat<eT>&
+chol_factoriser<eT>::L() const
+  {
+  return L_mat;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+chol_factoriser<eT>::factorise(const Base<eT,T1>& A_expr)
+  {
+  arma_debug_sigprint();
+  
+  reset();
+  
+  L_mat = A_expr.get_ref();
+  
+  if(L_mat.is_square() == false)
+    {
+    arma_warn(1, "chol_factoriser::factorise(): given matrix must be square sized");
+    reset();
+    return false;
+    }
+  
+  if((arma_config::check_conform) && (auxlib::rudimentary_sym_check(L_mat) == false))
+    {
+    arma_warn(1, "chol_factoriser::factorise(): given matrix is not symmetric");
+    }
+  
+  if(L_mat.internal_has_nonfinite() || (auxlib::chol(L_mat, 1) == false))
+    {
+    arma_warn(3, "chol_factoriser::factorise(): factorisation failed");
+    reset();
+    return false;
+    }
+  
+  valid = true;
+  
+  return true;
+  }
+
+
+
+//! rank-1 update or downdate of the trailing part of L, starting at row and column 'start';
+//! the columns of L are modified by plane (or hyperbolic) rotations
+template<typename eT>
+inline
+bool
+chol_factoriser<eT>::update_worker(const uword start, Col<eT>& x, const bool downdate)
+  {
+  arma_debug_sigprint();
+  
+  const uword N = L_mat.n_rows;
+  
+  eT* x_mem = x.memptr();
+  
+  for(uword k=start; k < N; ++k)
+    {
+    eT* L_colmem = L_mat.colptr(k);
+    
+    const eT L_kk = L_colmem[k];
+    const eT x_k  = x_mem[k - start];
+    
+    const eT r2 = (downdate) ? ((L_kk - x_k) * (L_kk + x_k)) : (L_kk*L_kk + x_k*x_k);
+    
+    if( (r2 <= eT(0)) || (arma_isfinite(r2) == false) )  { return false; }
+    
+    const eT r = std::sqrt(r2);
+    const eT c = r   / L_kk;
+    const eT s = x_k / L_kk;
+    
+    L_colmem[k] = r;
+    
+    if(downdate)
+      {
+      for(uword i=k+1; i < N; ++i)
+        {
+        const eT L_ik = (L_colmem[i] - s * x_mem[i - start]) / c;
+        
+        x_mem[i - start] = c * x_mem[i - start] - s * L_ik;
+        L_colmem[i]      = L_ik;
+        }
+      }
+    else
+      {
+      for(uword i=k+1; i < N; ++i)
+        {
+        const eT L_ik = (L_colmem[i] + s * x_mem[i - start]) / c;
+        
+        x_mem[i - start] = c * x_mem[i - start] - s * L_ik;
+        L_colmem[i]      = L_ik;
+        }
+      }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+chol_factoriser<eT>::update(const Base<eT,T1>& x_expr)
+  {
+  arma_debug_sigprint();
+  
+  Col<eT> x(x_expr.get_ref());
+  
+  if(valid == false)  { arma_warn(2, "chol_factoriser::update(): no factorisation available"); return false; }
+  
+  if(x.n_elem != L_mat.n_rows)  { arma_warn(1, "chol_factoriser::update(): size mismatch"); return false; }
+  
+  if(update_worker(0, x, false) == false)
+    {
+    arma_warn(3, "chol_factoriser::update(): update failed");
+    reset();
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+chol_factoriser<eT>::downdate(const Base<eT,T1>& x_expr)
+  {
+  arma_debug_sigprint();
+  
+  Col<eT> x(x_expr.get_ref());
+  
+  if(valid == false)  { arma_warn(2, "chol_factoriser::downdate(): no factorisation available"); return false; }
+  
+  if(x.n_elem != L_mat.n_rows)  { arma_warn(1, "chol_factoriser::downdate(): size mismatch"); return false; }
+  
+  // the downdated matrix may not be positive definite, in which case the factorisation is kept unchanged
+  
+  Mat<eT> L_old = L_mat;
+  
+  if(update_worker(0, x, true) == false)
+    {
+    arma_warn(3, "chol_factoriser::downdate(): downdated matrix is not positive definite");
+    L_mat.steal_mem(L_old);
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+chol_factoriser<eT>::append(const Base<eT,T1>& c_expr)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(c_expr.get_ref());
+  
+  const Mat<eT>& c = U.M;
+  
+  if(valid == false)  { arma_warn(2, "chol_factoriser::append(): no factorisation available"); return false; }
+  
+  const uword N = L_mat.n_rows;
+  
+  if( (c.is_vec() == false) || (c.n_elem != (N+1)) )  { arma_warn(1, "chol_factoriser::append(): size mismatch"); return false; }
+  
+  // the new row of L is the solution of L*l = c(0:N-1)
+  
+  Mat<eT> l(N, 1, arma_nozeros_indicator());
+  
+  arrayops::copy(l.memptr(), c.memptr(), N);
+  
+  if(auxlib::solve_trimat_inplace(l, L_mat, N, 1, false, false) == false)  { arma_warn(3, "chol_factoriser::append(): update failed"); return false; }
+  
+  const eT d = c[N] - dot(l, l);
+  
+  if( (d <= eT(0)) || (arma_isfinite(d) == false) )
+    {
+    arma_warn(3, "chol_factoriser::append(): extended matrix is not positive definite");
+    return false;
+    }
+  
+  L_mat.resize(N+1, N+1);
+  
+  for(uword j=0; j < N; ++j)  { L_mat.at(N,j) = l[j]; }
+  
+  L_mat.at(N,N) = std::sqrt(d);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+chol_factoriser<eT>::remove(const uword k)
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)  { arma_warn(2, "chol_factoriser::remove(): no factorisation available"); return false; }
+  
+  const uword N = L_mat.n_rows;
+  
+  arma_conform_check_bounds( (k >= N), "chol_factoriser::remove(): index out of bounds" );
+  
+  // with L = [L11 0 0; l21 l22 0; L31 l32 L33], the factor of the reduced matrix is [L11 0; L31 L33u],
+  // where L33u*L33u.t() = L33*L33.t() + l32*l32.t()
+  
+  Col<eT> x( (k+1 < N) ? Col<eT>(L_mat.col(k).tail(N-k-1)) : Col<eT>() );
+  
+  L_mat.shed_col(k);
+  L_mat.shed_row(k);
+  
+  if(update_worker(k, x, false) == false)
+    {
+    arma_warn(3, "chol_factoriser::remove(): update failed");
+    reset();
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+chol_factoriser<eT>::solve(Mat<eT>& X, const Base<eT,T1>& B_expr) const
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)
+    {
+    arma_warn(2, "chol_factoriser::solve(): no factorisation available");
+    X.soft_reset();
+    return false;
+    }
+  
+  Mat<eT> tmp(B_expr.get_ref());
+  
+  if(tmp.n_rows != L_mat.n_rows)
+    {
+    arma_warn(1, "chol_factoriser::solve(): matrix size mismatch");
+    X.soft_reset();
+    return false;
+    }
+  
+  const uword N = L_mat.n_rows;
+  
+  bool status =           auxlib::solve_trimat_inplace(tmp, L_mat, N, 1, false, false);
+  status      = status && auxlib::solve_trimat_inplace(tmp, L_mat, N, 1, true,  false);
+  
+  if(status == false)  { X.soft_reset(); return false; }
+  
+  X.steal_mem(tmp);
+  
+  return true;
+  }
+
+
+
+//! estimate of the reciprocal condition number of A, obtained from the triangular factor
+template<typename eT>
+inline
+eT
+chol_factoriser<eT>::rcond() const
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)  { return eT(0); }
+  
+  if(L_mat.is_empty())  { return Datum<eT>::inf; }
+  
+  const eT rcond_L = auxlib::rcond_trimat(L_mat, 1);
+  
+  return rcond_L * rcond_L;
+  }
+
+
+
+//! @}
@@ -420,6 +420,24 @@
 #endif
 
 
+#if defined(ARMA_USE_SIMD)
+  // the run-time selection of the instruction set on x86-64 requires the target attribute and __builtin_cpu_supports()
+  #if (defined(__GNUG__) || defined(__clang__)) && !defined(ARMA_DETECTED_FAKE_GCC) && !defined(ARMA_DETECTED_FAKE_CLANG) && defined(__x86_64__)
+    #undef  ARMA_SIMD_X86
+    #define ARMA_SIMD_X86
+  #elif (defined(__GNUG__) || defined(__clang__)) && !defined(ARMA_DETECTED_FAKE_GCC) && !defined(ARMA_DETECTED_FAKE_CLANG) && defined(__aarch64__) && defined(__ARM_NEON)
+    #undef  ARMA_SIMD_NEON
+    #define ARMA_SIMD_NEON
+  #else
+    #undef ARMA_USE_SIMD
+  #endif
+#endif
+
+#if !defined(ARMA_USE_SIMD)
+  #undef ARMA_USE_SIMD_MATH
+#endif
+
+
 #if (defined(__FAST_MATH__) || (defined(__FINITE_MATH_ONLY__) && (__FINITE_MATH_ONLY__ > 0)) || defined(_M_FP_FAST))
   #undef  ARMA_FAST_MATH
   #define ARMA_FAST_MATH
@@ -124,6 +124,11 @@
 // #define ARMA_USE_MKL_ALLOC
 //// Uncomment the above line to use Intel MKL mkl_malloc() and mkl_free() instead of standard malloc() and free()
 
+// #define ARMA_USE_ARENA_ALLOC
+//// Uncomment the above line to enable a thread-local pool of memory blocks, which is active within the lifetime of arena_scope objects.
+//// Memory released within an arena_scope is reused by subsequent allocations on the same thread,
+//// and is returned to the underlying allocator when the outermost arena_scope is destroyed.
+
 // #define ARMA_USE_MKL_TYPES
 //// Uncomment the above line to use Intel MKL types for complex numbers.
 //// You will need to include appropriate MKL headers before the Armadillo header.
@@ -141,6 +146,28 @@
 //// Comment out the above line to disable use of std::mutex
 #endif
 
+// #define ARMA_USE_MP_EXECUTOR
+//// Uncomment the above line to allow parallelisation via mp_executor, as an alternative or complement to OpenMP.
+//// mp_executor::set_pool() activates a work-stealing thread pool which is shared by all threads;
+//// mp_executor::set() activates a user provided parallel-for function (eg. wrapping an external task scheduler).
+//// Requires ARMA_USE_STD_MUTEX.
+
+#if !defined(ARMA_USE_SIMD)
+// #define ARMA_USE_SIMD
+//// Uncomment the above line to enable the explicit SIMD kernels used for element-wise operations and reductions.
+//// The reductions (eg. accu()) accumulate in a different order than the default implementation,
+//// which can change the results in the last bits.
+//// The kernels use SSE2, AVX2 or AVX-512 on x86-64 (selected at run time based on the CPU), or NEON on AArch64.
+//// The kernels are only available with GCC and Clang; for other compilers ARMA_USE_SIMD is automatically disabled.
+#endif
+
+#if !defined(ARMA_USE_SIMD_MATH)
+// #define ARMA_USE_SIMD_MATH
+//// Uncomment the above line to evaluate exp(), log(), trunc_exp(), normpdf() and log_normpdf() for float and double elements
+//// via the SIMD kernels, which use polynomial approximations with a maximum error of 1 ULP relative to the standard library.
+//// Requires ARMA_USE_SIMD.
+#endif
+
 #if !defined(ARMA_64BIT_WORD)
 // #define ARMA_64BIT_WORD
 //// Uncomment the above line if you require matrices/vectors capable of holding more than 4 billion elements.
@@ -187,11 +214,39 @@
 //// If you mainly use lots of very small vectors (eg. <= 4 elements),
 //// change the number to the size of your vectors.
 
+#if !defined(ARMA_MEM_ALIGNMENT)
+  #define ARMA_MEM_ALIGNMENT 32
+#endif
+//// The alignment (in bytes) of memory blocks with at least 1024 bytes, used by matrices, cubes, etc.
+//// It must be a power of two that is at least 16. The default value is 32.
+//// Use 64 for processors with AVX-512 instructions, so that vectors do not straddle cache lines.
+
+#if !defined(ARMA_MEM_HUGEPAGE_THRESHOLD)
+// #define ARMA_MEM_HUGEPAGE_THRESHOLD 4194304
+#endif
+//// Uncomment the above line to align memory blocks with at least the given number of bytes to 2 MB boundaries;
+//// on Linux the blocks are also marked as eligible for transparent huge pages via madvise().
+
 #if !defined(ARMA_OPENMP_THRESHOLD)
   #define ARMA_OPENMP_THRESHOLD 320
 #endif
 //// The minimum number of elements in a matrix to allow OpenMP based parallelisation;
 //// it must be an integer that is at least 1.
+//// This threshold is used for element-wise expressions with functions of moderate cost (eg. sqrt(), pow()).
+
+#if !defined(ARMA_OPENMP_THRESHOLD_HEAVY)
+  #define ARMA_OPENMP_THRESHOLD_HEAVY 160
+#endif
+//// The minimum number of elements in a matrix to allow OpenMP based parallelisation of element-wise expressions
+//// with costly functions (eg. exp(), log(), sin(), erf()); it must be an integer that is at least 1.
+
+#if !defined(ARMA_OPENMP_THRESHOLD_CHEAP)
+// #define ARMA_OPENMP_THRESHOLD_CHEAP 131072
+#endif
+//// Uncomment the above line to allow OpenMP based parallelisation of element-wise expressions with only inexpensive operations
+//// (eg. addition, multiplication by scalar) for matrices with at least the given number of elements.
+//// Suitable values for ARMA_OPENMP_THRESHOLD, ARMA_OPENMP_THRESHOLD_HEAVY and ARMA_OPENMP_THRESHOLD_CHEAP
+//// can be found by running the benchmark in the "autotune" directory.
 
 #if !defined(ARMA_OPENMP_THREADS)
   #define ARMA_OPENMP_THREADS 8
@@ -299,6 +354,14 @@
   #undef ARMA_USE_OPENMP
 #endif
 
+#if defined(ARMA_DONT_USE_MP_EXECUTOR)
+  #undef ARMA_USE_MP_EXECUTOR
+#endif
+
+#if defined(ARMA_DONT_USE_SIMD)
+  #undef ARMA_USE_SIMD
+#endif
+
 #if defined(ARMA_32BIT_WORD)
   #undef ARMA_64BIT_WORD
 #endif
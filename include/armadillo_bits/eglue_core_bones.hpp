@@ -83,4 +83,13 @@ class eglue_schur : public eglue_core<eglue_schur>
 
 
 
+//! operations which have explicit SIMD kernels
+template<typename eglue_type> struct simd_eglue              { static constexpr uword op = simd_op::none;  };
+template<>                    struct simd_eglue<eglue_plus>  { static constexpr uword op = simd_op::plus;  };
+template<>                    struct simd_eglue<eglue_minus> { static constexpr uword op = simd_op::minus; };
+template<>                    struct simd_eglue<eglue_div>   { static constexpr uword op = simd_op::div;   };
+template<>                    struct simd_eglue<eglue_schur> { static constexpr uword op = simd_op::schur; };
+
+
+
 //! @}
@@ -179,63 +179,100 @@
 
 
 
-#if defined(ARMA_USE_OPENMP)
+#if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
   
   #define arma_applier_1_mp(operatorA, operatorB) \
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword i=0; i<n_elem; ++i)\
+    const int n_threads = mp_thread_limit::get_loop();\
+    \
+    const auto worker = [&](const uword start, const uword endp1)\
       {\
-      out_mem[i] operatorA P1[i] operatorB P2[i];\
-      }\
+      for(uword i=start; i<endp1; ++i)\
+        {\
+        out_mem[i] operatorA P1[i] operatorB P2[i];\
+        }\
+      };\
+    \
+    mp_loop::run_chunked(n_elem, n_threads, worker);\
     }
   
   #define arma_applier_2_mp(operatorA, operatorB) \
     {\
-    const int n_threads = mp_thread_limit::get();\
+    const int n_threads = mp_thread_limit::get_loop();\
     if(n_cols == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_rows; ++count)\
+      const auto worker = [&](const uword start, const uword endp1)\
         {\
-        out_mem[count] operatorA P1.at(count,0) operatorB P2.at(count,0);\
-        }\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA P1.at(count,0) operatorB P2.at(count,0);\
+          }\
+        };\
+      \
+      mp_loop::run_chunked(n_rows, n_threads, worker);\
       }\
     else\
     if(n_rows == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_cols; ++count)\
+      const auto worker = [&](const uword start, const uword endp1)\
         {\
-        out_mem[count] operatorA P1.at(0,count) operatorB P2.at(0,count);\
-        }\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA P1.at(0,count) operatorB P2.at(0,count);\
+          }\
+        };\
+      \
+      mp_loop::run_chunked(n_cols, n_threads, worker);\
       }\
     else\
+    if(n_cols < uword(n_threads))\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword col=0; col<n_cols; ++col)\
+      const auto worker = [&](const uword start, const uword endp1)\
         {\
-        for(uword row=0; row<n_rows; ++row)\
+        for(uword col=0; col < n_cols; ++col)\
+        for(uword row=start; row < endp1; ++row)\
           {\
           out.at(row,col) operatorA P1.at(row,col) operatorB P2.at(row,col);\
           }\
-        }\
+        };\
+      \
+      mp_loop::run_chunked(n_rows, n_threads, worker);\
+      }\
+    else\
+      {\
+      const auto worker = [&](const uword start, const uword endp1)\
+        {\
+        for(uword col=start; col < endp1; ++col)\
+        for(uword row=0; row < n_rows; ++row)\
+          {\
+          out.at(row,col) operatorA P1.at(row,col) operatorB P2.at(row,col);\
+          }\
+        };\
+      \
+      mp_loop::run_chunked(n_cols, n_threads, worker);\
       }\
     }
   
   #define arma_applier_3_mp(operatorA, operatorB) \
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword slice=0; slice<n_slices; ++slice)\
+    const int n_threads = mp_thread_limit::get_loop();\
+    \
+    /* the columns of all slices are distributed among the threads, so that cubes with few slices are also parallelised */\
+    const auto worker = [&](const uword start, const uword endp1)\
       {\
-      for(uword col=0; col<n_cols; ++col)\
-      for(uword row=0; row<n_rows; ++row)\
+      for(uword index=start; index < endp1; ++index)\
         {\
-        out.at(row,col,slice) operatorA P1.at(row,col,slice) operatorB P2.at(row,col,slice);\
+        const uword slice = index / n_cols;\
+        const uword col   = index % n_cols;\
+        \
+        for(uword row=0; row<n_rows; ++row)\
+          {\
+          out.at(row,col,slice) operatorA P1.at(row,col,slice) operatorB P2.at(row,col,slice);\
+          }\
         }\
-      }\
+      };\
+    \
+    mp_loop::run_chunked(n_slices * n_cols, n_threads, worker);\
     }
   
 #else
@@ -264,7 +301,9 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
   typedef typename T1::elem_type eT;
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   // NOTE: we're assuming that the matrix has already been set to the correct size and there is no aliasing;
   // size setting and alias checking is done by either the Mat contructor or operator=()
@@ -276,7 +315,7 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -286,6 +325,11 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
       else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1_mp(=, /); }
       else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1_mp(=, *); }
       }
+    else
+    if(simd::binary_ea< simd_eglue<eglue_type>::op >(out_mem, x.P1.get_ea(), x.P2.get_ea(), 0, n_elem))
+      {
+      arma_debug_print("eglue_core::apply(): simd");
+      }
     else
       {
       if(memory::is_aligned(out_mem))
@@ -297,10 +341,22 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
           typename Proxy<T1>::aligned_ea_type P1 = x.P1.get_aligned_ea();
           typename Proxy<T2>::aligned_ea_type P2 = x.P2.get_aligned_ea();
           
-               if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_1a(=, +); }
-          else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_1a(=, -); }
-          else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1a(=, /); }
-          else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1a(=, *); }
+          if(memory::is_aligned_large(out_mem))
+            {
+            memory::mark_as_aligned_large(out_mem);
+            
+                 if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_1a(=, +); }
+            else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_1a(=, -); }
+            else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1a(=, /); }
+            else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1a(=, *); }
+            }
+          else
+            {
+                 if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_1a(=, +); }
+            else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_1a(=, -); }
+            else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1a(=, /); }
+            else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1a(=, *); }
+            }
           }
         else
           {
@@ -333,7 +389,7 @@ eglue_core<eglue_type>::apply(outT& out, const eGlue<T1, T2, eglue_type>& x)
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(=, -); }
@@ -370,13 +426,15 @@ eglue_core<eglue_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, con
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -430,7 +488,7 @@ eglue_core<eglue_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, con
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(+=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(+=, -); }
@@ -467,13 +525,15 @@ eglue_core<eglue_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, co
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -527,7 +587,7 @@ eglue_core<eglue_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, co
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(-=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(-=, -); }
@@ -564,13 +624,15 @@ eglue_core<eglue_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, co
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -624,7 +686,7 @@ eglue_core<eglue_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, co
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(*=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(*=, -); }
@@ -661,13 +723,15 @@ eglue_core<eglue_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, cons
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (Proxy<T1>::use_at || Proxy<T2>::use_at);
-  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (Proxy<T1>::use_mp || Proxy<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlue<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
       typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
@@ -721,7 +785,7 @@ eglue_core<eglue_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, cons
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (Proxy<T1>::use_mp && Proxy<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_2_mp(/=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_2_mp(/=, -); }
@@ -756,7 +820,9 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
   typedef typename T1::elem_type eT;
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   // NOTE: we're assuming that the cube has already been set to the correct size and there is no aliasing;
   // size setting and alias checking is done by either the Cube contructor or operator=()
@@ -768,7 +834,7 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -778,6 +844,11 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
       else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1_mp(=, /); }
       else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1_mp(=, *); }
       }
+    else
+    if(simd::binary_ea< simd_eglue<eglue_type>::op >(out_mem, x.P1.get_ea(), x.P2.get_ea(), 0, n_elem))
+      {
+      arma_debug_print("eglue_core::apply(): simd");
+      }
     else
       {
       if(memory::is_aligned(out_mem))
@@ -789,10 +860,22 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
           typename ProxyCube<T1>::aligned_ea_type P1 = x.P1.get_aligned_ea();
           typename ProxyCube<T2>::aligned_ea_type P2 = x.P2.get_aligned_ea();
           
-               if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_1a(=, +); }
-          else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_1a(=, -); }
-          else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1a(=, /); }
-          else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1a(=, *); }
+          if(memory::is_aligned_large(out_mem))
+            {
+            memory::mark_as_aligned_large(out_mem);
+            
+                 if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_1a(=, +); }
+            else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_1a(=, -); }
+            else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1a(=, /); }
+            else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1a(=, *); }
+            }
+          else
+            {
+                 if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_1a(=, +); }
+            else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_1a(=, -); }
+            else if(is_same_type<eglue_type, eglue_div  >::yes) { arma_applier_1a(=, /); }
+            else if(is_same_type<eglue_type, eglue_schur>::yes) { arma_applier_1a(=, *); }
+            }
           }
         else
           {
@@ -826,7 +909,7 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(=, -); }
@@ -864,13 +947,15 @@ eglue_core<eglue_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, co
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -924,7 +1009,7 @@ eglue_core<eglue_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, co
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(+=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(+=, -); }
@@ -962,13 +1047,15 @@ eglue_core<eglue_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, c
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1022,7 +1109,7 @@ eglue_core<eglue_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, c
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(-=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(-=, -); }
@@ -1060,13 +1147,15 @@ eglue_core<eglue_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, c
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1120,7 +1209,7 @@ eglue_core<eglue_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, c
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(*=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(*=, -); }
@@ -1158,13 +1247,15 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
   eT* out_mem = out.memptr();
   
   constexpr bool use_at = (ProxyCube<T1>::use_at || ProxyCube<T2>::use_at);
-  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp) && (arma_config::openmp);
+  constexpr bool use_mp = (ProxyCube<T1>::use_mp || ProxyCube<T2>::use_mp || (arma_config::mp_threshold_cheap > 0)) && (arma_config::mp);
+  
+  constexpr uword mp_cost = mp_expr_cost< eGlueCube<T1, T2, eglue_type> >::value;
   
   if(use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(n_elem))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
       typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
@@ -1218,7 +1309,7 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp)>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, (ProxyCube<T1>::use_mp && ProxyCube<T2>::use_mp), mp_cost>::eval_loop(x.get_n_elem()))
       {
            if(is_same_type<eglue_type, eglue_plus >::yes) { arma_applier_3_mp(/=, +); }
       else if(is_same_type<eglue_type, eglue_minus>::yes) { arma_applier_3_mp(/=, -); }
@@ -52,8 +52,10 @@ class eop_core
   };
 
 
-struct eop_use_mp_true  { static constexpr bool use_mp = true;  };
-struct eop_use_mp_false { static constexpr bool use_mp = false; };
+struct eop_use_mp_true  { static constexpr bool use_mp = true;  static constexpr uword mp_cost = mp_op_cost::moderate; };
+struct eop_use_mp_heavy { static constexpr bool use_mp = true;  static constexpr uword mp_cost = mp_op_cost::heavy;    };
+struct eop_use_mp_false { static constexpr bool use_mp = false; static constexpr uword mp_cost = mp_op_cost::cheap;    };
+struct eop_use_mp_pow   { static constexpr bool use_mp = false; static constexpr uword mp_cost = mp_op_cost::moderate; };
 
 
 class eop_neg               : public eop_core<eop_neg>               , public eop_use_mp_false {};
@@ -65,30 +67,30 @@ class eop_scalar_div_pre    : public eop_core<eop_scalar_div_pre>    , public eo
 class eop_scalar_div_post   : public eop_core<eop_scalar_div_post>   , public eop_use_mp_false {};
 class eop_square            : public eop_core<eop_square>            , public eop_use_mp_false {};
 class eop_sqrt              : public eop_core<eop_sqrt>              , public eop_use_mp_true  {};
-class eop_pow               : public eop_core<eop_pow>               , public eop_use_mp_false {};  // for pow(), use_mp is selectively enabled in eop_core_meat.hpp
-class eop_log               : public eop_core<eop_log>               , public eop_use_mp_true  {};
-class eop_log2              : public eop_core<eop_log2>              , public eop_use_mp_true  {};
-class eop_log10             : public eop_core<eop_log10>             , public eop_use_mp_true  {};
-class eop_trunc_log         : public eop_core<eop_trunc_log>         , public eop_use_mp_true  {};
-class eop_log1p             : public eop_core<eop_log1p>             , public eop_use_mp_true  {};
-class eop_exp               : public eop_core<eop_exp>               , public eop_use_mp_true  {};
-class eop_exp2              : public eop_core<eop_exp2>              , public eop_use_mp_true  {};
-class eop_exp10             : public eop_core<eop_exp10>             , public eop_use_mp_true  {};
-class eop_trunc_exp         : public eop_core<eop_trunc_exp>         , public eop_use_mp_true  {};
-class eop_expm1             : public eop_core<eop_expm1>             , public eop_use_mp_true  {};
-class eop_cos               : public eop_core<eop_cos>               , public eop_use_mp_true  {};
-class eop_sin               : public eop_core<eop_sin>               , public eop_use_mp_true  {};
-class eop_tan               : public eop_core<eop_tan>               , public eop_use_mp_true  {};
-class eop_acos              : public eop_core<eop_acos>              , public eop_use_mp_true  {};
-class eop_asin              : public eop_core<eop_asin>              , public eop_use_mp_true  {};
-class eop_atan              : public eop_core<eop_atan>              , public eop_use_mp_true  {};
-class eop_cosh              : public eop_core<eop_cosh>              , public eop_use_mp_true  {};
-class eop_sinh              : public eop_core<eop_sinh>              , public eop_use_mp_true  {};
-class eop_tanh              : public eop_core<eop_tanh>              , public eop_use_mp_true  {};
-class eop_acosh             : public eop_core<eop_acosh>             , public eop_use_mp_true  {};
-class eop_asinh             : public eop_core<eop_asinh>             , public eop_use_mp_true  {};
-class eop_atanh             : public eop_core<eop_atanh>             , public eop_use_mp_true  {};
-class eop_sinc              : public eop_core<eop_sinc>              , public eop_use_mp_true  {};
+class eop_pow               : public eop_core<eop_pow>               , public eop_use_mp_pow   {};  // for pow(), use_mp is selectively enabled in eop_core_meat.hpp
+class eop_log               : public eop_core<eop_log>               , public eop_use_mp_heavy {};
+class eop_log2              : public eop_core<eop_log2>              , public eop_use_mp_heavy {};
+class eop_log10             : public eop_core<eop_log10>             , public eop_use_mp_heavy {};
+class eop_trunc_log         : public eop_core<eop_trunc_log>         , public eop_use_mp_heavy {};
+class eop_log1p             : public eop_core<eop_log1p>             , public eop_use_mp_heavy {};
+class eop_exp               : public eop_core<eop_exp>               , public eop_use_mp_heavy {};
+class eop_exp2              : public eop_core<eop_exp2>              , public eop_use_mp_heavy {};
+class eop_exp10             : public eop_core<eop_exp10>             , public eop_use_mp_heavy {};
+class eop_trunc_exp         : public eop_core<eop_trunc_exp>         , public eop_use_mp_heavy {};
+class eop_expm1             : public eop_core<eop_expm1>             , public eop_use_mp_heavy {};
+class eop_cos               : public eop_core<eop_cos>               , public eop_use_mp_heavy {};
+class eop_sin               : public eop_core<eop_sin>               , public eop_use_mp_heavy {};
+class eop_tan               : public eop_core<eop_tan>               , public eop_use_mp_heavy {};
+class eop_acos              : public eop_core<eop_acos>              , public eop_use_mp_heavy {};
+class eop_asin              : public eop_core<eop_asin>              , public eop_use_mp_heavy {};
+class eop_atan              : public eop_core<eop_atan>              , public eop_use_mp_heavy {};
+class eop_cosh              : public eop_core<eop_cosh>              , public eop_use_mp_heavy {};
+class eop_sinh              : public eop_core<eop_sinh>              , public eop_use_mp_heavy {};
+class eop_tanh              : public eop_core<eop_tanh>              , public eop_use_mp_heavy {};
+class eop_acosh             : public eop_core<eop_acosh>             , public eop_use_mp_heavy {};
+class eop_asinh             : public eop_core<eop_asinh>             , public eop_use_mp_heavy {};
+class eop_atanh             : public eop_core<eop_atanh>             , public eop_use_mp_heavy {};
+class eop_sinc              : public eop_core<eop_sinc>              , public eop_use_mp_heavy {};
 class eop_eps               : public eop_core<eop_eps>               , public eop_use_mp_true  {};
 class eop_abs               : public eop_core<eop_abs>               , public eop_use_mp_false {};
 class eop_arg               : public eop_core<eop_arg>               , public eop_use_mp_false {};
@@ -99,10 +101,31 @@ class eop_round             : public eop_core<eop_round>             , public eo
 class eop_trunc             : public eop_core<eop_trunc>             , public eop_use_mp_false {};
 class eop_sign              : public eop_core<eop_sign>              , public eop_use_mp_false {};
 class eop_cbrt              : public eop_core<eop_cbrt>              , public eop_use_mp_true  {};
-class eop_erf               : public eop_core<eop_erf>               , public eop_use_mp_true  {};
-class eop_erfc              : public eop_core<eop_erfc>              , public eop_use_mp_true  {};
-class eop_lgamma            : public eop_core<eop_lgamma>            , public eop_use_mp_true  {};
-class eop_tgamma            : public eop_core<eop_tgamma>            , public eop_use_mp_true  {};
+class eop_erf               : public eop_core<eop_erf>               , public eop_use_mp_heavy {};
+class eop_erfc              : public eop_core<eop_erfc>              , public eop_use_mp_heavy {};
+class eop_lgamma            : public eop_core<eop_lgamma>            , public eop_use_mp_heavy {};
+class eop_tgamma            : public eop_core<eop_tgamma>            , public eop_use_mp_heavy {};
+
+
+
+//! operations which have explicit SIMD kernels
+template<typename eop_type> struct simd_eop                        { static constexpr uword op = simd_op::none;              };
+template<>                  struct simd_eop<eop_neg>               { static constexpr uword op = simd_op::neg;               };
+template<>                  struct simd_eop<eop_scalar_plus>       { static constexpr uword op = simd_op::scalar_plus;       };
+template<>                  struct simd_eop<eop_scalar_minus_pre>  { static constexpr uword op = simd_op::scalar_minus_pre;  };
+template<>                  struct simd_eop<eop_scalar_minus_post> { static constexpr uword op = simd_op::scalar_minus_post; };
+template<>                  struct simd_eop<eop_scalar_times>      { static constexpr uword op = simd_op::scalar_times;      };
+template<>                  struct simd_eop<eop_scalar_div_pre>    { static constexpr uword op = simd_op::scalar_div_pre;    };
+template<>                  struct simd_eop<eop_scalar_div_post>   { static constexpr uword op = simd_op::scalar_div_post;   };
+template<>                  struct simd_eop<eop_square>            { static constexpr uword op = simd_op::square;            };
+template<>                  struct simd_eop<eop_sqrt>              { static constexpr uword op = simd_op::sqrt;              };
+template<>                  struct simd_eop<eop_abs>               { static constexpr uword op = simd_op::abs;               };
+
+#if defined(ARMA_USE_SIMD_MATH)
+template<>                  struct simd_eop<eop_exp>               { static constexpr uword op = simd_op::exp;               };
+template<>                  struct simd_eop<eop_log>               { static constexpr uword op = simd_op::log;               };
+template<>                  struct simd_eop<eop_trunc_exp>         { static constexpr uword op = simd_op::trunc_exp;         };
+#endif
 
 
 
@@ -165,63 +165,100 @@
 
 
 
-#if defined(ARMA_USE_OPENMP)
+#if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
   
   #define arma_applier_1_mp(operatorA) \
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword i=0; i<n_elem; ++i)\
+    const int n_threads = mp_thread_limit::get_loop();\
+    \
+    const auto worker = [&](const uword start, const uword endp1)\
       {\
-      out_mem[i] operatorA eop_core<eop_type>::process(P[i], k);\
-      }\
+      for(uword i=start; i<endp1; ++i)\
+        {\
+        out_mem[i] operatorA eop_core<eop_type>::process(P[i], k);\
+        }\
+      };\
+    \
+    mp_loop::run_chunked(n_elem, n_threads, worker);\
     }
   
   #define arma_applier_2_mp(operatorA) \
     {\
-    const int n_threads = mp_thread_limit::get();\
+    const int n_threads = mp_thread_limit::get_loop();\
     if(n_cols == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_rows; ++count)\
+      const auto worker = [&](const uword start, const uword endp1)\
         {\
-        out_mem[count] operatorA eop_core<eop_type>::process(P.at(count,0), k);\
-        }\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA eop_core<eop_type>::process(P.at(count,0), k);\
+          }\
+        };\
+      \
+      mp_loop::run_chunked(n_rows, n_threads, worker);\
       }\
     else\
     if(n_rows == 1)\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword count=0; count < n_cols; ++count)\
+      const auto worker = [&](const uword start, const uword endp1)\
         {\
-        out_mem[count] operatorA eop_core<eop_type>::process(P.at(0,count), k);\
-        }\
+        for(uword count=start; count < endp1; ++count)\
+          {\
+          out_mem[count] operatorA eop_core<eop_type>::process(P.at(0,count), k);\
+          }\
+        };\
+      \
+      mp_loop::run_chunked(n_cols, n_threads, worker);\
       }\
     else\
+    if(n_cols < uword(n_threads))\
       {\
-      _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-      for(uword col=0; col < n_cols; ++col)\
+      const auto worker = [&](const uword start, const uword endp1)\
         {\
+        for(uword col=0; col < n_cols; ++col)\
+        for(uword row=start; row < endp1; ++row)\
+          {\
+          out.at(row,col) operatorA eop_core<eop_type>::process(P.at(row,col), k);\
+          }\
+        };\
+      \
+      mp_loop::run_chunked(n_rows, n_threads, worker);\
+      }\
+    else\
+      {\
+      const auto worker = [&](const uword start, const uword endp1)\
+        {\
+        for(uword col=start; col < endp1; ++col)\
         for(uword row=0; row < n_rows; ++row)\
           {\
           out.at(row,col) operatorA eop_core<eop_type>::process(P.at(row,col), k);\
           }\
-        }\
+        };\
+      \
+      mp_loop::run_chunked(n_cols, n_threads, worker);\
       }\
     }
   
   #define arma_applier_3_mp(operatorA) \
     {\
-    const int n_threads = mp_thread_limit::get();\
-    _Pragma("omp parallel for schedule(static) num_threads(n_threads)")\
-    for(uword slice=0; slice<n_slices; ++slice)\
+    const int n_threads = mp_thread_limit::get_loop();\
+    \
+    /* the columns of all slices are distributed among the threads, so that cubes with few slices are also parallelised */\
+    const auto worker = [&](const uword start, const uword endp1)\
       {\
-      for(uword col=0; col<n_cols; ++col)\
-      for(uword row=0; row<n_rows; ++row)\
+      for(uword index=start; index < endp1; ++index)\
         {\
-        out.at(row,col,slice) operatorA eop_core<eop_type>::process(P.at(row,col,slice), k);\
+        const uword slice = index / n_cols;\
+        const uword col   = index % n_cols;\
+        \
+        for(uword row=0; row<n_rows; ++row)\
+          {\
+          out.at(row,col,slice) operatorA eop_core<eop_type>::process(P.at(row,col,slice), k);\
+          }\
         }\
-      }\
+      };\
+    \
+    mp_loop::run_chunked(n_slices * n_cols, n_threads, worker);\
     }
 
 #else
@@ -255,17 +292,31 @@ eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOp<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOp<T1, eop_type> >::value;
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
-      arma_applier_1_mp(=);
+      const auto worker = [&](const uword start, const uword endp1)
+        {
+        if(simd::unary_ea< simd_eop<eop_type>::op >(out_mem, P, start, endp1, k))  { return; }
+        
+        for(uword i=start; i<endp1; ++i)  { out_mem[i] = eop_core<eop_type>::process(P[i], k); }
+        };
+      
+      mp_loop::run_chunked(n_elem, mp_thread_limit::get_loop(), worker);
+      }
+    else
+    if(simd::unary_ea< simd_eop<eop_type>::op >(out_mem, x.P.get_ea(), 0, n_elem, k))
+      {
+      arma_debug_print("eop_core::apply(): simd");
       }
     else
       {
@@ -277,7 +328,16 @@ eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
           {
           typename Proxy<T1>::aligned_ea_type P = x.P.get_aligned_ea();
           
-          arma_applier_1a(=);
+          if(memory::is_aligned_large(out_mem))
+            {
+            memory::mark_as_aligned_large(out_mem);
+            
+            arma_applier_1a(=);
+            }
+          else
+            {
+            arma_applier_1a(=);
+            }
           }
         else
           {
@@ -301,7 +361,7 @@ eop_core<eop_type>::apply(outT& out, const eOp<T1, eop_type>& x)
     
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_2_mp(=);
       }
@@ -332,13 +392,15 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOp<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOp<T1, eop_type> >::value;
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -375,7 +437,7 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_2_mp(+=);
       }
@@ -406,13 +468,15 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOp<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOp<T1, eop_type> >::value;
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -449,7 +513,7 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_2_mp(-=);
       }
@@ -480,13 +544,15 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOp<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOp<T1, eop_type> >::value;
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -523,7 +589,7 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_2_mp(*=);
       }
@@ -554,13 +620,15 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOp<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOp<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOp<T1, eop_type> >::value;
   
   if(Proxy<T1>::use_at == false)
     {
     const uword n_elem = x.get_n_elem();
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename Proxy<T1>::ea_type P = x.P.get_ea();
       
@@ -597,7 +665,7 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
     {
     const Proxy<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_2_mp(/=);
       }
@@ -631,17 +699,31 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOpCube<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOpCube<T1, eop_type> >::value;
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
-      arma_applier_1_mp(=);
+      const auto worker = [&](const uword start, const uword endp1)
+        {
+        if(simd::unary_ea< simd_eop<eop_type>::op >(out_mem, P, start, endp1, k))  { return; }
+        
+        for(uword i=start; i<endp1; ++i)  { out_mem[i] = eop_core<eop_type>::process(P[i], k); }
+        };
+      
+      mp_loop::run_chunked(n_elem, mp_thread_limit::get_loop(), worker);
+      }
+    else
+    if(simd::unary_ea< simd_eop<eop_type>::op >(out_mem, x.P.get_ea(), 0, n_elem, k))
+      {
+      arma_debug_print("eop_core::apply(): simd");
       }
     else
       {
@@ -653,7 +735,16 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
           {
           typename ProxyCube<T1>::aligned_ea_type P = x.P.get_aligned_ea();
           
-          arma_applier_1a(=);
+          if(memory::is_aligned_large(out_mem))
+            {
+            memory::mark_as_aligned_large(out_mem);
+            
+            arma_applier_1a(=);
+            }
+          else
+            {
+            arma_applier_1a(=);
+            }
           }
         else
           {
@@ -678,7 +769,7 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
     
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_3_mp(=);
       }
@@ -710,13 +801,15 @@ eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOpCube<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOpCube<T1, eop_type> >::value;
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -753,7 +846,7 @@ eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_3_mp(+=);
       }
@@ -785,13 +878,15 @@ eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOpCube<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOpCube<T1, eop_type> >::value;
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
       
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -828,7 +923,7 @@ eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_3_mp(-=);
       }
@@ -860,13 +955,15 @@ eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, const
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOpCube<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOpCube<T1, eop_type> >::value;
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -903,7 +1000,7 @@ eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, const
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_3_mp(*=);
       }
@@ -935,13 +1032,15 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
-  const bool use_mp = (arma_config::openmp) && (eOpCube<T1, eop_type>::use_mp || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  const bool use_mp = (arma_config::mp) && (eOpCube<T1, eop_type>::use_mp || (arma_config::mp_threshold_cheap > 0) || (is_same_type<eop_type, eop_pow>::value && (is_cx<eT>::yes || x.aux != eT(2))));
+  
+  constexpr uword mp_cost = mp_expr_cost< eOpCube<T1, eop_type> >::value;
   
   if(ProxyCube<T1>::use_at == false)
     {
     const uword n_elem = out.n_elem;
     
-    if(use_mp && mp_gate<eT>::eval(n_elem))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(n_elem))
       {
       typename ProxyCube<T1>::ea_type P = x.P.get_ea();
       
@@ -978,7 +1077,7 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
     {
     const ProxyCube<T1>& P = x.P;
     
-    if(use_mp && mp_gate<eT>::eval(x.get_n_elem()))
+    if(use_mp && mp_gate<eT, false, mp_cost>::eval_loop(x.get_n_elem()))
       {
       arma_applier_3_mp(/=);
       }
@@ -0,0 +1,453 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fixed_helper
+//! @{
+
+
+// kernels for small fixed size matrices, ie. Mat<eT>::fixed, Col<eT>::fixed and Row<eT>::fixed;
+// the sizes are known at compile time, so all loops have constant bounds and all workspace is on the stack.
+// this avoids memory allocation as well as the call overhead of BLAS and LAPACK.
+// each function returns false if it is not applicable to the given types,
+// or if the result is suspect, in which case the caller falls through to the general code.
+
+namespace fixed_helper
+{
+
+// maximum number of rows or columns of matrices handled by the multiplication kernel
+static constexpr uword mul_max_dim = 16;
+
+// maximum size of square matrices handled by the decomposition based kernels (det, inv, solve)
+static constexpr uword lu_max_dim = 8;
+
+
+
+template<typename T1, bool is_fixed = is_Mat_fixed<T1>::value>
+struct dims
+  {
+  static constexpr uword n_rows = 0;
+  static constexpr uword n_cols = 0;
+  };
+
+
+template<typename T1>
+struct dims<T1, true>
+  {
+  static constexpr uword n_rows = T1::n_rows;
+  static constexpr uword n_cols = T1::n_cols;
+  };
+
+
+
+// the multiplication kernel is used for matrix-vector products, where the call overhead of BLAS dominates;
+// products of square matrices with up to 4 rows are already handled by gemm_emul_tinysq and gemv_emul_tinysq,
+// and products of two matrices are handled faster by BLAS
+template<typename TA, typename TB, const bool do_trans_A, const bool do_trans_B>
+struct use_mul
+  {
+  static constexpr uword M = (do_trans_A) ? dims<TA>::n_cols : dims<TA>::n_rows;
+  static constexpr uword K = (do_trans_A) ? dims<TA>::n_rows : dims<TA>::n_cols;
+  static constexpr uword N = (do_trans_B) ? dims<TB>::n_rows : dims<TB>::n_cols;
+  
+  static constexpr bool is_tiny = (dims<TA>::n_rows == dims<TA>::n_cols) && (dims<TA>::n_rows <= 4);
+  
+  static constexpr bool value =
+       (M >= 1) && (M <= mul_max_dim)
+    && (K >= 1) && (K <= mul_max_dim)
+    && (N >= 1) && (N <= mul_max_dim)
+    && ((M == 1) || (N == 1))
+    && (is_tiny == false);
+  };
+
+
+template<typename T1>
+struct use_lu
+  {
+  static constexpr bool value = (dims<T1>::n_rows >= 1) && (dims<T1>::n_rows <= lu_max_dim) && (dims<T1>::n_rows == dims<T1>::n_cols);
+  };
+
+
+template<typename T1, typename T2>
+struct use_solve
+  {
+  static constexpr bool value = use_lu<T1>::value && (dims<T2>::n_rows == dims<T1>::n_rows) && (dims<T2>::n_cols >= 1) && (dims<T2>::n_cols <= mul_max_dim);
+  };
+
+
+
+//! out = alpha * op(A) * op(B), where op() is either no-op or hermitian transpose;
+//! the product is evaluated in local memory, so aliasing between out and A or B is permitted;
+//! out must be already set to the correct size
+template<const bool do_trans_A, const bool do_trans_B, const bool use_alpha, typename eT, typename TA, typename TB>
+inline
+typename enable_if2< use_mul<TA,TB,do_trans_A,do_trans_B>::value, bool >::result
+mul(Mat<eT>& out, const TA& A, const TB& B, const eT alpha)
+  {
+  arma_debug_sigprint();
+  
+  constexpr uword A_n_rows = dims<TA>::n_rows;
+  constexpr uword B_n_rows = dims<TB>::n_rows;
+  
+  constexpr uword M = use_mul<TA,TB,do_trans_A,do_trans_B>::M;
+  constexpr uword K = use_mul<TA,TB,do_trans_A,do_trans_B>::K;
+  constexpr uword N = use_mul<TA,TB,do_trans_A,do_trans_B>::N;
+  
+  const eT* A_mem = A.memptr();
+  const eT* B_mem = B.memptr();
+  
+  const auto A_at = [&](const uword i, const uword k) -> eT { return (do_trans_A) ? eT(access::alt_conj(A_mem[k + i*A_n_rows])) : A_mem[i + k*A_n_rows]; };
+  const auto B_at = [&](const uword k, const uword j) -> eT { return (do_trans_B) ? eT(access::alt_conj(B_mem[j + k*B_n_rows])) : B_mem[k + j*B_n_rows]; };
+  
+  // the result is either a column vector (N == 1) or a row vector (M == 1);
+  // blocks of 4 elements are evaluated at a time, with the accumulators kept in registers
+  
+  constexpr uword L  = (N == 1) ? M : N;
+  constexpr uword L4 = L - (L % 4);
+  
+  const auto C_at = [&](const uword l, const uword k) -> eT { return (N == 1) ? (A_at(l, k) * B_at(k, 0)) : (A_at(0, k) * B_at(k, l)); };
+  
+  eT C[M*N];
+  
+  for(uword l=0; l < L4; l += 4)
+    {
+    eT acc0 = eT(0);
+    eT acc1 = eT(0);
+    eT acc2 = eT(0);
+    eT acc3 = eT(0);
+    
+    for(uword k=0; k < K; ++k)
+      {
+      acc0 += C_at(l  , k);
+      acc1 += C_at(l+1, k);
+      acc2 += C_at(l+2, k);
+      acc3 += C_at(l+3, k);
+      }
+    
+    C[l  ] = acc0;
+    C[l+1] = acc1;
+    C[l+2] = acc2;
+    C[l+3] = acc3;
+    }
+  
+  for(uword l=L4; l < L; ++l)
+    {
+    eT acc = eT(0);
+    
+    for(uword k=0; k < K; ++k)  { acc += C_at(l, k); }
+    
+    C[l] = acc;
+    }
+  
+  if(use_alpha)  { for(uword i=0; i < M*N; ++i)  { C[i] *= alpha; } }
+  
+  arrayops::copy(out.memptr(), &C[0], M*N);
+  
+  return true;
+  }
+
+
+
+template<const bool do_trans_A, const bool do_trans_B, const bool use_alpha, typename eT, typename TA, typename TB>
+constexpr
+typename enable_if2< (use_mul<TA,TB,do_trans_A,do_trans_B>::value == false), bool >::result
+mul(Mat<eT>&, const TA&, const TB&, const eT)
+  {
+  return false;
+  }
+
+
+
+//! LU decomposition with partial pivoting, in the same form as produced by LAPACK's getrf();
+//! the permutation is stored in perm, and the number of row swaps in n_swaps;
+//! as with getrf(), a zero pivot does not stop the decomposition, and the returned status is false
+template<const uword N, typename eT>
+inline
+bool
+lu(eT* A, uword* perm, uword& n_swaps)
+  {
+  arma_debug_sigprint();
+  
+  bool status = true;
+  
+  n_swaps = 0;
+  
+  for(uword k=0; k < N; ++k)
+    {
+    uword p     = k;
+    auto  p_abs = std::abs(A[k + k*N]);
+    
+    for(uword i=(k+1); i < N; ++i)
+      {
+      const auto val_abs = std::abs(A[i + k*N]);
+      
+      if(val_abs > p_abs)  { p = i; p_abs = val_abs; }
+      }
+    
+    perm[k] = p;
+    
+    if(p != k)
+      {
+      for(uword j=0; j < N; ++j)  { std::swap(A[k + j*N], A[p + j*N]); }
+      
+      ++n_swaps;
+      }
+    
+    const eT pivot = A[k + k*N];
+    
+    if(pivot == eT(0))  { status = false; continue; }
+    
+    const eT pivot_inv = eT(1) / pivot;
+    
+    for(uword i=(k+1); i < N; ++i)  { A[i + k*N] *= pivot_inv; }
+    
+    for(uword j=(k+1); j < N; ++j)
+      {
+      const eT A_kj = A[k + j*N];
+      
+      for(uword i=(k+1); i < N; ++i)  { A[i + j*N] -= A[i + k*N] * A_kj; }
+      }
+    }
+  
+  return status;
+  }
+
+
+
+//! solve LU*X = P*B for X, where LU and perm were obtained by lu(); B is overwritten with X
+template<const uword N, const uword n_rhs, typename eT>
+inline
+void
+lu_solve(const eT* LU, const uword* perm, eT* B)
+  {
+  arma_debug_sigprint();
+  
+  for(uword c=0; c < n_rhs; ++c)
+    {
+    eT* B_col = &B[c*N];
+    
+    for(uword k=0; k < N; ++k)  { if(perm[k] != k)  { std::swap(B_col[k], B_col[perm[k]]); } }
+    
+    for(uword k=0; k < N; ++k)
+      {
+      const eT B_k = B_col[k];
+      
+      for(uword i=(k+1); i < N; ++i)  { B_col[i] -= LU[i + k*N] * B_k; }
+      }
+    
+    for(uword kk=N; kk > 0; --kk)
+      {
+      const uword k = kk-1;
+      
+      B_col[k] /= LU[k + k*N];
+      
+      const eT B_k = B_col[k];
+      
+      for(uword i=0; i < k; ++i)  { B_col[i] -= LU[i + k*N] * B_k; }
+      }
+    }
+  }
+
+
+
+//! reciprocal condition number in the 1-norm, given A and its inverse;
+//! for small matrices the inverse is inexpensive, so the exact value is used rather than an estimate
+template<const uword N, typename eT>
+inline
+typename get_pod_type<eT>::result
+rcond(const eT* A, const eT* A_inv)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  T norm_A     = T(0);
+  T norm_A_inv = T(0);
+  
+  for(uword j=0; j < N; ++j)
+    {
+    T acc_A     = T(0);
+    T acc_A_inv = T(0);
+    
+    for(uword i=0; i < N; ++i)
+      {
+      acc_A     += std::abs(A    [i + j*N]);
+      acc_A_inv += std::abs(A_inv[i + j*N]);
+      }
+    
+    norm_A     = (std::max)(norm_A,     acc_A    );
+    norm_A_inv = (std::max)(norm_A_inv, acc_A_inv);
+    }
+  
+  return (norm_A > T(0)) ? (T(1) / norm_A) / norm_A_inv : T(0);
+  }
+
+
+
+template<typename T1>
+inline
+typename enable_if2< use_lu<T1>::value, bool >::result
+det(typename T1::elem_type& out_val, const T1& X)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  constexpr uword N = dims<T1>::n_rows;
+  
+  eT    LU[N*N];
+  uword perm[N];
+  uword n_swaps = 0;
+  
+  arrayops::copy(&LU[0], X.memptr(), N*N);
+  
+  lu<N>(&LU[0], &perm[0], n_swaps);
+  
+  eT val = LU[0];
+  
+  for(uword i=1; i < N; ++i)  { val *= LU[i + i*N]; }
+  
+  out_val = (n_swaps % 2) ? eT(-val) : eT(val);
+  
+  return true;
+  }
+
+
+
+template<typename T1>
+constexpr
+typename enable_if2< (use_lu<T1>::value == false), bool >::result
+det(typename T1::elem_type&, const T1&)
+  {
+  return false;
+  }
+
+
+
+//! inverse via LU decomposition;
+//! returns false if the matrix is singular or badly conditioned, so that the general code can handle it
+template<typename T1>
+inline
+typename enable_if2< use_lu<T1>::value, bool >::result
+inv(Mat<typename T1::elem_type>& out, const T1& X)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  typedef typename T1::pod_type   T;
+  
+  constexpr uword N = dims<T1>::n_rows;
+  
+  eT    LU[N*N];
+  eT    Y[N*N];
+  uword perm[N];
+  uword n_swaps = 0;
+  
+  arrayops::copy(&LU[0], X.memptr(), N*N);
+  
+  if(lu<N>(&LU[0], &perm[0], n_swaps) == false)  { return false; }
+  
+  for(uword i=0; i < N*N; ++i)  { Y[i] = eT(0); }
+  for(uword i=0; i < N;   ++i)  { Y[i + i*N] = eT(1); }
+  
+  lu_solve<N,N>(&LU[0], &perm[0], &Y[0]);
+  
+  const T rcond_val = rcond<N>(X.memptr(), &Y[0]);
+  
+  if( (rcond_val < std::numeric_limits<T>::epsilon()) || arma_isnan(rcond_val) )  { return false; }
+  
+  out.set_size(N,N);
+  
+  arrayops::copy(out.memptr(), &Y[0], N*N);
+  
+  return true;
+  }
+
+
+
+template<typename T1>
+constexpr
+typename enable_if2< (use_lu<T1>::value == false), bool >::result
+inv(Mat<typename T1::elem_type>&, const T1&)
+  {
+  return false;
+  }
+
+
+
+//! solve A*X = B via LU decomposition;
+//! the system is rejected if its reciprocal condition number is below epsilon,
+//! so that the general code can provide the usual warnings and the approximate solution
+template<typename T1, typename T2>
+inline
+typename enable_if2< use_solve<T1,T2>::value, bool >::result
+solve(Mat<typename T1::elem_type>& out, const T1& A, const T2& B)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  typedef typename T1::pod_type   T;
+  
+  constexpr uword N     = dims<T1>::n_rows;
+  constexpr uword n_rhs = dims<T2>::n_cols;
+  
+  eT    LU[N*N];
+  eT    A_inv[N*N];
+  eT    Y[N*n_rhs];
+  uword perm[N];
+  uword n_swaps = 0;
+  
+  arrayops::copy(&LU[0], A.memptr(), N*N);
+  
+  if(lu<N>(&LU[0], &perm[0], n_swaps) == false)  { return false; }
+  
+  for(uword i=0; i < N*N; ++i)  { A_inv[i] = eT(0); }
+  for(uword i=0; i < N;   ++i)  { A_inv[i + i*N] = eT(1); }
+  
+  lu_solve<N,N>(&LU[0], &perm[0], &A_inv[0]);
+  
+  const T rcond_val = rcond<N>(A.memptr(), &A_inv[0]);
+  
+  if( (rcond_val < std::numeric_limits<T>::epsilon()) || arma_isnan(rcond_val) )  { return false; }
+  
+  arrayops::copy(&Y[0], B.memptr(), N*n_rhs);
+  
+  lu_solve<N,n_rhs>(&LU[0], &perm[0], &Y[0]);
+  
+  out.set_size(N, n_rhs);
+  
+  arrayops::copy(out.memptr(), &Y[0], N*n_rhs);
+  
+  return true;
+  }
+
+
+
+template<typename T1, typename T2>
+constexpr
+typename enable_if2< (use_solve<T1,T2>::value == false), bool >::result
+solve(Mat<typename T1::elem_type>&, const T1&, const T2&)
+  {
+  return false;
+  }
+
+
+
+}  // namespace fixed_helper
+
+
+//! @}
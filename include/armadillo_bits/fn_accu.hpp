@@ -37,21 +37,20 @@ accu_proxy_linear(const Proxy<T1>& P)
   
   const uword n_elem = P.get_n_elem();
   
-  if( arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(n_elem) )
+  if( arma_config::mp && Proxy<T1>::use_mp && mp_gate<eT, false, mp_expr_cost_mp<T1>::value>::eval_loop(n_elem) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
       {
       // NOTE: using parallelisation with manual reduction workaround to take into account complex numbers;
       // NOTE: OpenMP versions lower than 4.0 do not support user-defined reduction
       
-      const int   n_threads_max = mp_thread_limit::get();
+      const int   n_threads_max = mp_thread_limit::get_loop();
       const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
       const uword chunk_size    = n_elem / n_threads_use;
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      const auto worker = [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -60,7 +59,9 @@ accu_proxy_linear(const Proxy<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += Pea[i]; }
         
         partial_accs[thread_id] = acc;
-        }
+        };
+      
+      mp_loop::run(n_threads_use, int(n_threads_use), worker);
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -115,21 +116,20 @@ accu_proxy_at_mp(const Proxy<T1>& P)
   
   eT val = eT(0);
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const uword n_rows = P.get_n_rows();
     const uword n_cols = P.get_n_cols();
     
     if(n_cols == 1)
       {
-      const int   n_threads_max = mp_thread_limit::get();
+      const int   n_threads_max = mp_thread_limit::get_loop();
       const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
       const uword chunk_size    = n_rows / n_threads_use;
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      const auto worker = [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -138,7 +138,9 @@ accu_proxy_at_mp(const Proxy<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += P.at(i,0); }
         
         partial_accs[thread_id] = acc;
-        }
+        };
+      
+      mp_loop::run(n_threads_use, int(n_threads_use), worker);
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -147,14 +149,13 @@ accu_proxy_at_mp(const Proxy<T1>& P)
     else
     if(n_rows == 1)
       {
-      const int   n_threads_max = mp_thread_limit::get();
+      const int   n_threads_max = mp_thread_limit::get_loop();
       const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
       const uword chunk_size    = n_cols / n_threads_use;
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      const auto worker = [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -163,7 +164,9 @@ accu_proxy_at_mp(const Proxy<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += P.at(0,i); }
         
         partial_accs[thread_id] = acc;
-        }
+        };
+      
+      mp_loop::run(n_threads_use, int(n_threads_use), worker);
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -173,21 +176,25 @@ accu_proxy_at_mp(const Proxy<T1>& P)
       {
       podarray<eT> col_accs(n_cols);
       
-      const int n_threads = mp_thread_limit::get();
+      const int n_threads = mp_thread_limit::get_loop();
       
-      #pragma omp parallel for schedule(static) num_threads(n_threads)
-      for(uword col=0; col < n_cols; ++col)
+      const auto worker = [&](const uword start, const uword endp1)
         {
-        eT val1 = eT(0);
-        eT val2 = eT(0);
-        
-        uword i,j;
-        for(i=0, j=1; j < n_rows; i+=2, j+=2)  { val1 += P.at(i,col); val2 += P.at(j,col); }
-        
-        if(i < n_rows)  { val1 += P.at(i,col); }
-        
-        col_accs[col] = val1 + val2;
-        }
+        for(uword col=start; col < endp1; ++col)
+          {
+          eT val1 = eT(0);
+          eT val2 = eT(0);
+          
+          uword i,j;
+          for(i=0, j=1; j < n_rows; i+=2, j+=2)  { val1 += P.at(i,col); val2 += P.at(j,col); }
+          
+          if(i < n_rows)  { val1 += P.at(i,col); }
+          
+          col_accs[col] = val1 + val2;
+          }
+        };
+      
+      mp_loop::run_chunked(n_cols, n_threads, worker);
       
       val = arrayops::accumulate(col_accs.memptr(), n_cols);
       }
@@ -213,7 +220,7 @@ accu_proxy_at(const Proxy<T1>& P)
   
   typedef typename T1::elem_type eT;
   
-  if(arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem()))
+  if(arma_config::mp && Proxy<T1>::use_mp && mp_gate<eT, false, mp_expr_cost_mp<T1>::value>::eval_loop(P.get_n_elem()))
     {
     return accu_proxy_at_mp(P);
     }
@@ -672,21 +679,20 @@ accu_cube_proxy_linear(const ProxyCube<T1>& P)
   
   const uword n_elem = P.get_n_elem();
   
-  if( arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(n_elem) )
+  if( arma_config::mp && ProxyCube<T1>::use_mp && mp_gate<eT, false, mp_expr_cost_mp<T1>::value>::eval_loop(n_elem) )
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
       {
       // NOTE: using parallelisation with manual reduction workaround to take into account complex numbers;
       // NOTE: OpenMP versions lower than 4.0 do not support user-defined reduction
       
-      const int   n_threads_max = mp_thread_limit::get();
+      const int   n_threads_max = mp_thread_limit::get_loop();
       const uword n_threads_use = (std::min)(uword(podarray_prealloc_n_elem::val), uword(n_threads_max));
       const uword chunk_size    = n_elem / n_threads_use;
       
       podarray<eT> partial_accs(n_threads_use);
       
-      #pragma omp parallel for schedule(static) num_threads(int(n_threads_use))
-      for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)
+      const auto worker = [&](const uword thread_id)
         {
         const uword start = (thread_id+0) * chunk_size;
         const uword endp1 = (thread_id+1) * chunk_size;
@@ -695,7 +701,9 @@ accu_cube_proxy_linear(const ProxyCube<T1>& P)
         for(uword i=start; i < endp1; ++i)  { acc += Pea[i]; }
         
         partial_accs[thread_id] = acc;
-        }
+        };
+      
+      mp_loop::run(n_threads_use, int(n_threads_use), worker);
       
       for(uword thread_id=0; thread_id < n_threads_use; ++thread_id)  { val += partial_accs[thread_id]; }
       
@@ -750,7 +758,7 @@ accu_cube_proxy_at_mp(const ProxyCube<T1>& P)
   
   eT val = eT(0);
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const uword n_rows   = P.get_n_rows();
     const uword n_cols   = P.get_n_cols();
@@ -758,24 +766,28 @@ accu_cube_proxy_at_mp(const ProxyCube<T1>& P)
     
     podarray<eT> slice_accs(n_slices);
     
-    const int n_threads = mp_thread_limit::get();
+    const int n_threads = mp_thread_limit::get_loop();
     
-    #pragma omp parallel for schedule(static) num_threads(n_threads)
-    for(uword slice = 0; slice < n_slices; ++slice)
+    const auto worker = [&](const uword start, const uword endp1)
       {
-      eT val1 = eT(0);
-      eT val2 = eT(0);
-      
-      for(uword col = 0; col < n_cols; ++col)
+      for(uword slice = start; slice < endp1; ++slice)
         {
-        uword i,j;
-        for(i=0, j=1; j<n_rows; i+=2, j+=2)  { val1 += P.at(i,col,slice);  val2 += P.at(j,col,slice); }
+        eT val1 = eT(0);
+        eT val2 = eT(0);
+        
+        for(uword col = 0; col < n_cols; ++col)
+          {
+          uword i,j;
+          for(i=0, j=1; j<n_rows; i+=2, j+=2)  { val1 += P.at(i,col,slice);  val2 += P.at(j,col,slice); }
+          
+          if(i < n_rows)  { val1 += P.at(i,col,slice); }
+          }
         
-        if(i < n_rows)  { val1 += P.at(i,col,slice); }
+        slice_accs[slice] = val1 + val2;
         }
-      
-      slice_accs[slice] = val1 + val2;
-      }
+      };
+    
+    mp_loop::run_chunked(n_slices, n_threads, worker);
     
     val = arrayops::accumulate(slice_accs.memptr(), slice_accs.n_elem);
     }
@@ -800,7 +812,7 @@ accu_cube_proxy_at(const ProxyCube<T1>& P)
   
   typedef typename T1::elem_type eT;
   
-  if(arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(P.get_n_elem()))
+  if(arma_config::mp && ProxyCube<T1>::use_mp && mp_gate<eT, false, mp_expr_cost_mp<T1>::value>::eval_loop(P.get_n_elem()))
     {
     return accu_cube_proxy_at_mp(P);
     }
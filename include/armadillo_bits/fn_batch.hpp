@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup fn_batch
+//! @{
+
+
+
+//! C.slice(i) = A.slice(i) * B.slice(i);
+//! if A or B has one slice, the slice is used for all products
+template<typename T1, typename T2>
+arma_warn_unused
+inline
+Cube<typename T1::elem_type>
+batch_mul
+  (
+  const BaseCube<typename T1::elem_type,T1>& A,
+  const BaseCube<typename T1::elem_type,T2>& B
+  )
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_cube<T1> UA(A.get_ref());
+  const unwrap_cube<T2> UB(B.get_ref());
+  
+  Cube<eT> out;
+  
+  op_batch::apply_mul(out, UA.M, UB.M);
+  
+  return out;
+  }
+
+
+
+//! R.slice(i) = chol(X.slice(i), layout)
+template<typename T1>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+batch_chol
+  (
+         Cube<typename T1::elem_type>&       R,
+  const BaseCube<typename T1::elem_type,T1>& X,
+  const char* layout = "upper"
+  )
+  {
+  arma_debug_sigprint();
+  
+  const char sig = (layout != nullptr) ? layout[0] : char(0);
+  
+  arma_conform_check( ((sig != 'u') && (sig != 'l')), "batch_chol(): layout must be \"upper\" or \"lower\"" );
+  
+  const unwrap_cube<T1> U(X.get_ref());
+  
+  const bool status = op_batch::apply_chol(R, U.M, ((sig == 'u') ? 0 : 1));
+  
+  if(status == false)  { arma_warn(3, "batch_chol(): decomposition failed for one or more matrices"); }
+  
+  return status;
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, Cube<typename T1::elem_type> >::result
+batch_chol
+  (
+  const BaseCube<typename T1::elem_type,T1>& X,
+  const char* layout = "upper"
+  )
+  {
+  arma_debug_sigprint();
+  
+  const char sig = (layout != nullptr) ? layout[0] : char(0);
+  
+  arma_conform_check( ((sig != 'u') && (sig != 'l')), "batch_chol(): layout must be \"upper\" or \"lower\"" );
+  
+  const unwrap_cube<T1> U(X.get_ref());
+  
+  Cube<typename T1::elem_type> out;
+  
+  const bool status = op_batch::apply_chol(out, U.M, ((sig == 'u') ? 0 : 1));
+  
+  if(status == false)
+    {
+    out.soft_reset();
+    arma_stop_runtime_error("batch_chol(): decomposition failed");
+    }
+  
+  return out;
+  }
+
+
+
+//! B.slice(i) = inv_sympd(A.slice(i))
+template<typename T1>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+batch_inv_sympd
+  (
+         Cube<typename T1::elem_type>&       B,
+  const BaseCube<typename T1::elem_type,T1>& A
+  )
+  {
+  arma_debug_sigprint();
+  
+  const unwrap_cube<T1> U(A.get_ref());
+  
+  const bool status = op_batch::apply_inv_sympd(B, U.M);
+  
+  if(status == false)  { arma_warn(3, "batch_inv_sympd(): one or more matrices are singular or not positive definite"); }
+  
+  return status;
+  }
+
+
+
+template<typename T1>
+arma_warn_unused
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, Cube<typename T1::elem_type> >::result
+batch_inv_sympd
+  (
+  const BaseCube<typename T1::elem_type,T1>& A
+  )
+  {
+  arma_debug_sigprint();
+  
+  const unwrap_cube<T1> U(A.get_ref());
+  
+  Cube<typename T1::elem_type> out;
+  
+  const bool status = op_batch::apply_inv_sympd(out, U.M);
+  
+  if(status == false)
+    {
+    out.soft_reset();
+    arma_stop_runtime_error("batch_inv_sympd(): matrix is singular or not positive definite");
+    }
+  
+  return out;
+  }
+
+
+
+//! X.slice(i) = solve(A.slice(i), B.slice(i)), for square matrices
+template<typename T1, typename T2>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+batch_solve
+  (
+         Cube<typename T1::elem_type>&       X,
+  const BaseCube<typename T1::elem_type,T1>& A,
+  const BaseCube<typename T1::elem_type,T2>& B
+  )
+  {
+  arma_debug_sigprint();
+  
+  const unwrap_cube<T1> UA(A.get_ref());
+  const unwrap_cube<T2> UB(B.get_ref());
+  
+  const bool status = op_batch::apply_solve(X, UA.M, UB.M);
+  
+  if(status == false)  { arma_warn(3, "batch_solve(): solution not found for one or more systems"); }
+  
+  return status;
+  }
+
+
+
+template<typename T1, typename T2>
+arma_warn_unused
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, Cube<typename T1::elem_type> >::result
+batch_solve
+  (
+  const BaseCube<typename T1::elem_type,T1>& A,
+  const BaseCube<typename T1::elem_type,T2>& B
+  )
+  {
+  arma_debug_sigprint();
+  
+  const unwrap_cube<T1> UA(A.get_ref());
+  const unwrap_cube<T2> UB(B.get_ref());
+  
+  Cube<typename T1::elem_type> out;
+  
+  const bool status = op_batch::apply_solve(out, UA.M, UB.M);
+  
+  if(status == false)
+    {
+    out.soft_reset();
+    arma_stop_runtime_error("batch_solve(): solution not found");
+    }
+  
+  return out;
+  }
+
+
+
+//! @}
@@ -68,6 +68,46 @@ det(typename T1::elem_type& out_val, const Base<typename T1::elem_type,T1>& X)
 
 
 
+//! determinant of a fixed size matrix; small matrices are handled without LAPACK
+template<typename T1>
+arma_warn_unused
+inline
+typename enable_if2< is_Mat_fixed<T1>::value && is_supported_blas_type<typename T1::elem_type>::value, typename T1::elem_type >::result
+det(const T1& X)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  eT out_val = eT(0);
+  
+  if(fixed_helper::det(out_val, X))  { return out_val; }
+  
+  const Mat<eT>& A = X;
+  
+  return det(A);
+  }
+
+
+
+template<typename T1>
+inline
+typename enable_if2< is_Mat_fixed<T1>::value && is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+det(typename T1::elem_type& out_val, const T1& X)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  if(fixed_helper::det(out_val, X))  { return true; }
+  
+  const Mat<eT>& A = X;
+  
+  return det(out_val, A);
+  }
+
+
+
 template<typename T>
 arma_warn_unused
 arma_inline
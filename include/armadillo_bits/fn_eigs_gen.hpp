@@ -422,4 +422,103 @@ eigs_gen
 
 
 
+//! eigenvalues of general real operator A, given by user-supplied functions
+template<typename T, typename fn_type, typename fn_t_type>
+arma_warn_unused
+inline
+typename enable_if2< is_real<T>::value, Col< std::complex<T> > >::result
+eigs_gen
+  (
+  const matfree_op<T, fn_type, fn_t_type>& A,
+  const uword                              n_eigvals,
+  const char*                              form = "lm",
+  const eigs_opts                          opts = eigs_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Mat< std::complex<T> > eigvec;
+  Col< std::complex<T> > eigval;
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_gen(eigval, eigvec, A, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    arma_stop_runtime_error("eigs_gen(): decomposition failed");
+    }
+  
+  return eigval;
+  }
+
+
+
+//! eigenvalues of general real operator A, given by user-supplied functions
+template<typename T, typename fn_type, typename fn_t_type>
+inline
+typename enable_if2< is_real<T>::value, bool >::result
+eigs_gen
+  (
+           Col< std::complex<T> >&         eigval,
+  const matfree_op<T, fn_type, fn_t_type>& A,
+  const uword                              n_eigvals,
+  const char*                              form = "lm",
+  const eigs_opts                          opts = eigs_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Mat< std::complex<T> > eigvec;
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_gen(eigval, eigvec, A, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    arma_warn(3, "eigs_gen(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! eigenvalues and eigenvectors of general real operator A, given by user-supplied functions
+template<typename T, typename fn_type, typename fn_t_type>
+inline
+typename enable_if2< is_real<T>::value, bool >::result
+eigs_gen
+  (
+           Col< std::complex<T> >&         eigval,
+           Mat< std::complex<T> >&         eigvec,
+  const matfree_op<T, fn_type, fn_t_type>& A,
+  const uword                              n_eigvals,
+  const char*                              form = "lm",
+  const eigs_opts                          opts = eigs_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( void_ptr(&eigval) == void_ptr(&eigvec), "eigs_gen(): parameter 'eigval' is an alias of parameter 'eigvec'" );
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_gen(eigval, eigvec, A, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    eigvec.soft_reset();
+    arma_warn(3, "eigs_gen(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
@@ -287,4 +287,103 @@ eigs_sym
 
 
 
+//! eigenvalues of symmetric real operator A, given by user-supplied functions
+template<typename eT, typename fn_type, typename fn_t_type>
+arma_warn_unused
+inline
+typename enable_if2< is_real<eT>::value, Col<eT> >::result
+eigs_sym
+  (
+  const matfree_op<eT, fn_type, fn_t_type>& A,
+  const uword                               n_eigvals,
+  const char*                               form = "lm",
+  const eigs_opts                           opts = eigs_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Mat<eT> eigvec;
+  Col<eT> eigval;
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_sym(eigval, eigvec, A, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    arma_stop_runtime_error("eigs_sym(): decomposition failed");
+    }
+  
+  return eigval;
+  }
+
+
+
+//! eigenvalues of symmetric real operator A, given by user-supplied functions
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+typename enable_if2< is_real<eT>::value, bool >::result
+eigs_sym
+  (
+           Col<eT>&                         eigval,
+  const matfree_op<eT, fn_type, fn_t_type>& A,
+  const uword                               n_eigvals,
+  const char*                               form = "lm",
+  const eigs_opts                           opts = eigs_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Mat<eT> eigvec;
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_sym(eigval, eigvec, A, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    arma_warn(3, "eigs_sym(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! eigenvalues and eigenvectors of symmetric real operator A, given by user-supplied functions
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+typename enable_if2< is_real<eT>::value, bool >::result
+eigs_sym
+  (
+           Col<eT>&                         eigval,
+           Mat<eT>&                         eigvec,
+  const matfree_op<eT, fn_type, fn_t_type>& A,
+  const uword                               n_eigvals,
+  const char*                               form = "lm",
+  const eigs_opts                           opts = eigs_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( void_ptr(&eigval) == void_ptr(&eigvec), "eigs_sym(): parameter 'eigval' is an alias of parameter 'eigvec'" );
+  
+  sp_auxlib::form_type form_val = sp_auxlib::interpret_form_str(form);
+  
+  const bool status = sp_auxlib::eigs_sym(eigval, eigvec, A, n_eigvals, form_val, opts);
+  
+  if(status == false)
+    {
+    eigval.soft_reset();
+    eigvec.soft_reset();
+    arma_warn(3, "eigs_sym(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
 //! @}
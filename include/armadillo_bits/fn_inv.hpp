@@ -61,6 +61,38 @@ inv
 
 
 
+//! inverse of a fixed size matrix; the fixed type is retained so that small matrices can be handled without LAPACK
+template<typename T1>
+arma_warn_unused
+arma_inline
+typename enable_if2< is_Mat_fixed<T1>::value && is_supported_blas_type<typename T1::elem_type>::value, const Op<T1, op_inv_gen_default> >::result
+inv(const T1& X)
+  {
+  arma_debug_sigprint();
+  
+  return Op<T1, op_inv_gen_default>(X);
+  }
+
+
+
+template<typename T1>
+inline
+typename enable_if2< is_Mat_fixed<T1>::value && is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+inv(Mat<typename T1::elem_type>& out, const T1& X)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  if(fixed_helper::inv(out, X))  { return true; }
+  
+  const Mat<eT>& A = X;
+  
+  return inv(out, A);
+  }
+
+
+
 template<typename T1>
 arma_warn_unused
 arma_inline
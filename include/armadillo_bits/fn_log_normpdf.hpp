@@ -57,7 +57,7 @@ log_normpdf_helper(Mat<typename T1::elem_type>& out, const Base<typename T1::ele
   typename Proxy<T2>::ea_type M_ea = PM.get_ea();
   typename Proxy<T3>::ea_type S_ea = PS.get_ea();
   
-  const bool use_mp = arma_config::openmp && mp_gate<eT,true>::eval(N);
+  const bool use_mp = arma_config::openmp && mp_gate<eT, true, mp_op_cost::heavy>::eval(N);
   
   if(use_mp)
     {
@@ -78,14 +78,36 @@ log_normpdf_helper(Mat<typename T1::elem_type>& out, const Base<typename T1::ele
     }
   else
     {
-    for(uword i=0; i<N; ++i)
+    #if defined(ARMA_USE_SIMD_MATH)
       {
-      const eT sigma = S_ea[i];
+      // log(sigma) is evaluated first, so that it can be done by the SIMD kernels
       
-      const eT tmp = (X_ea[i] - M_ea[i]) / sigma;
+      for(uword i=0; i<N; ++i)  { out_mem[i] = S_ea[i]; }
       
-      out_mem[i] = (eT(-0.5) * (tmp*tmp)) - (std::log(sigma) + Datum<eT>::log_sqrt2pi);
+      if(simd::unary<simd_op::log>(out_mem, out_mem, N, eT(0)) == false)
+        {
+        for(uword i=0; i<N; ++i)  { out_mem[i] = std::log(out_mem[i]); }
+        }
+      
+      for(uword i=0; i<N; ++i)
+        {
+        const eT tmp = (X_ea[i] - M_ea[i]) / S_ea[i];
+        
+        out_mem[i] = (eT(-0.5) * (tmp*tmp)) - (out_mem[i] + Datum<eT>::log_sqrt2pi);
+        }
+      }
+    #else
+      {
+      for(uword i=0; i<N; ++i)
+        {
+        const eT sigma = S_ea[i];
+        
+        const eT tmp = (X_ea[i] - M_ea[i]) / sigma;
+        
+        out_mem[i] = (eT(-0.5) * (tmp*tmp)) - (std::log(sigma) + Datum<eT>::log_sqrt2pi);
+        }
       }
+    #endif
     }
   }
 
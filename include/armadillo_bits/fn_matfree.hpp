@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup fn_matfree
+//! @{
+
+
+
+//! linear operator of size n_rows x n_cols, where fn(X,Y) sets Y = A*X
+template<typename eT, typename fn_type>
+arma_warn_unused
+inline
+typename enable_if2< is_supported_elem_type<eT>::value, matfree_op<eT, fn_type, matfree_none> >::result
+matfree(const uword n_rows, const uword n_cols, const fn_type& fn)
+  {
+  arma_debug_sigprint();
+  
+  return matfree_op<eT, fn_type, matfree_none>(n_rows, n_cols, fn, matfree_none());
+  }
+
+
+
+//! linear operator of size n_rows x n_cols, where fn(X,Y) sets Y = A*X and fn_t(X,Y) sets Y = A.t()*X
+template<typename eT, typename fn_type, typename fn_t_type>
+arma_warn_unused
+inline
+typename enable_if2< is_supported_elem_type<eT>::value, matfree_op<eT, fn_type, fn_t_type> >::result
+matfree(const uword n_rows, const uword n_cols, const fn_type& fn, const fn_t_type& fn_t)
+  {
+  arma_debug_sigprint();
+  
+  return matfree_op<eT, fn_type, fn_t_type>(n_rows, n_cols, fn, fn_t);
+  }
+
+
+
+//! @}
@@ -0,0 +1,359 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup fn_rsvd
+//! @{
+
+
+
+//! orthonormal basis for the columns of Y
+template<typename eT>
+inline
+bool
+rsvd_orth(Mat<eT>& Q, const Mat<eT>& Y)
+  {
+  arma_debug_sigprint();
+  
+  Mat<eT> R;
+  
+  return auxlib::qr_econ(Q, R, Y);
+  }
+
+
+
+//! Z = X.t() * Q
+template<typename eT>
+inline
+void
+rsvd_tmul(Mat<eT>& Z, const Mat<eT>& X, const Mat<eT>& Q)
+  {
+  arma_debug_sigprint();
+  
+  Z = X.t() * Q;
+  }
+
+
+
+//! Z = X.t() * Q, without forming the transpose of the sparse matrix
+template<typename eT>
+inline
+void
+rsvd_tmul(Mat<eT>& Z, const SpMat<eT>& X, const Mat<eT>& Q)
+  {
+  arma_debug_sigprint();
+  
+  const Mat<eT> tmp = Q.t() * X;
+  
+  Z = tmp.t();
+  }
+
+
+
+//! randomised range finder with power iterations (Halko, Martinsson, Tropp, 2011), followed by svd of the projected matrix;
+//! mat_type is either Mat<eT> or SpMat<eT>
+template<typename eT, typename mat_type>
+inline
+bool
+rsvd_helper
+  (
+        Mat<eT>&                                 U,
+        Col<typename get_pod_type<eT>::result>&  S,
+        Mat<eT>&                                 V,
+  const mat_type&                                X,
+  const uword                                    k,
+  const rsvd_opts&                               opts,
+  const bool                                     calc_UV
+  )
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check
+    (
+    ( ((void*)(&U) == (void*)(&S)) || (&U == &V) || ((void*)(&S) == (void*)(&V)) ),
+    "rsvd(): two or more output objects are the same object"
+    );
+  
+  if(X.internal_has_nonfinite())  { return false; }
+  
+  const uword m = X.n_rows;
+  const uword n = X.n_cols;
+  
+  const uword min_mn = (std::min)(m, n);
+  
+  const uword kk = (std::min)(k, min_mn);
+  
+  if(kk == 0)
+    {
+    S.reset();
+    
+    if(calc_UV)  { U.set_size(m, 0); V.set_size(n, 0); }
+    
+    return true;
+    }
+  
+  const uword l = (std::min)(kk + uword(opts.oversample), min_mn);
+  
+  Mat<eT> Omega(n, l, arma_nozeros_indicator());
+  
+  Omega.randn();
+  
+  Mat<eT> Y = X * Omega;
+  Mat<eT> Q;
+  Mat<eT> Z;
+  
+  Omega.reset();
+  
+  if(rsvd_orth(Q, Y) == false)  { return false; }
+  
+  // each product is re-orthonormalised, to retain the smaller singular values in finite precision
+  
+  for(uword iter=0; iter < uword(opts.power_iter); ++iter)
+    {
+    rsvd_tmul(Z, X, Q);
+    
+    if(rsvd_orth(Q, Z) == false)  { return false; }
+    
+    Y = X * Q;
+    
+    if(rsvd_orth(Q, Y) == false)  { return false; }
+    }
+  
+  Y.reset();
+  Z.reset();
+  
+  Mat<eT> B = Q.t() * X;
+  
+  if(calc_UV)
+    {
+    Mat<eT> UB;
+    Mat<eT> VB;
+    
+    if(auxlib::svd_dc_econ(UB, S, VB, B) == false)  { return false; }
+    
+    U = Q * UB.head_cols(kk);
+    V = VB.head_cols(kk);
+    }
+  else
+    {
+    if(auxlib::svd_dc(S, B) == false)  { return false; }
+    }
+  
+  S = S.head(kk);
+  
+  return true;
+  }
+
+
+
+//! approximate k largest singular values and corresponding singular vectors of dense matrix X
+template<typename T1>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+rsvd
+  (
+         Mat<typename T1::elem_type>&    U,
+         Col<typename T1::pod_type >&    S,
+         Mat<typename T1::elem_type>&    V,
+  const Base<typename T1::elem_type,T1>& X,
+  const uword                            k,
+  const rsvd_opts&                       opts = rsvd_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> UX(X.get_ref());
+  
+  const bool status = rsvd_helper(U, S, V, UX.M, k, opts, true);
+  
+  if(status == false)
+    {
+    U.soft_reset();
+    S.soft_reset();
+    V.soft_reset();
+    arma_warn(3, "rsvd(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! approximate k largest singular values of dense matrix X
+template<typename T1>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+rsvd
+  (
+         Col<typename T1::pod_type >&    S,
+  const Base<typename T1::elem_type,T1>& X,
+  const uword                            k,
+  const rsvd_opts&                       opts = rsvd_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Mat<typename T1::elem_type> U;
+  Mat<typename T1::elem_type> V;
+  
+  const quasi_unwrap<T1> UX(X.get_ref());
+  
+  const bool status = rsvd_helper(U, S, V, UX.M, k, opts, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_warn(3, "rsvd(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! approximate k largest singular values of dense matrix X
+template<typename T1>
+arma_warn_unused
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, Col<typename T1::pod_type> >::result
+rsvd
+  (
+  const Base<typename T1::elem_type,T1>& X,
+  const uword                            k,
+  const rsvd_opts&                       opts = rsvd_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Col<typename T1::pod_type>  S;
+  Mat<typename T1::elem_type> U;
+  Mat<typename T1::elem_type> V;
+  
+  const quasi_unwrap<T1> UX(X.get_ref());
+  
+  const bool status = rsvd_helper(U, S, V, UX.M, k, opts, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_stop_runtime_error("rsvd(): decomposition failed");
+    }
+  
+  return S;
+  }
+
+
+
+//! approximate k largest singular values and corresponding singular vectors of sparse matrix X
+template<typename T1>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+rsvd
+  (
+           Mat<typename T1::elem_type>&    U,
+           Col<typename T1::pod_type >&    S,
+           Mat<typename T1::elem_type>&    V,
+  const SpBase<typename T1::elem_type,T1>& X,
+  const uword                              k,
+  const rsvd_opts&                         opts = rsvd_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  const unwrap_spmat<T1> UX(X.get_ref());
+  
+  const bool status = rsvd_helper(U, S, V, UX.M, k, opts, true);
+  
+  if(status == false)
+    {
+    U.soft_reset();
+    S.soft_reset();
+    V.soft_reset();
+    arma_warn(3, "rsvd(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! approximate k largest singular values of sparse matrix X
+template<typename T1>
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, bool >::result
+rsvd
+  (
+           Col<typename T1::pod_type >&    S,
+  const SpBase<typename T1::elem_type,T1>& X,
+  const uword                              k,
+  const rsvd_opts&                         opts = rsvd_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Mat<typename T1::elem_type> U;
+  Mat<typename T1::elem_type> V;
+  
+  const unwrap_spmat<T1> UX(X.get_ref());
+  
+  const bool status = rsvd_helper(U, S, V, UX.M, k, opts, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_warn(3, "rsvd(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+//! approximate k largest singular values of sparse matrix X
+template<typename T1>
+arma_warn_unused
+inline
+typename enable_if2< is_supported_blas_type<typename T1::elem_type>::value, Col<typename T1::pod_type> >::result
+rsvd
+  (
+  const SpBase<typename T1::elem_type,T1>& X,
+  const uword                              k,
+  const rsvd_opts&                         opts = rsvd_opts()
+  )
+  {
+  arma_debug_sigprint();
+  
+  Col<typename T1::pod_type>  S;
+  Mat<typename T1::elem_type> U;
+  Mat<typename T1::elem_type> V;
+  
+  const unwrap_spmat<T1> UX(X.get_ref());
+  
+  const bool status = rsvd_helper(U, S, V, UX.M, k, opts, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_stop_runtime_error("rsvd(): decomposition failed");
+    }
+  
+  return S;
+  }
+
+
+
+//! @}
@@ -67,6 +67,39 @@ solve
 
 
 
+//! solve a system with fixed size matrices; the fixed types are retained so that small systems can be handled without LAPACK
+template<typename T1, typename T2>
+arma_warn_unused
+inline
+typename enable_if2< is_Mat_fixed<T1>::value && is_Mat_fixed<T2>::value && is_supported_blas_type<typename T1::elem_type>::value && is_same_type<typename T1::elem_type, typename T2::elem_type>::value, const Glue<T1, T2, glue_solve_gen_default> >::result
+solve(const T1& A, const T2& B)
+  {
+  arma_debug_sigprint();
+  
+  return Glue<T1, T2, glue_solve_gen_default>(A, B);
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+typename enable_if2< is_Mat_fixed<T1>::value && is_Mat_fixed<T2>::value && is_supported_blas_type<typename T1::elem_type>::value && is_same_type<typename T1::elem_type, typename T2::elem_type>::value, bool >::result
+solve(Mat<typename T1::elem_type>& out, const T1& A, const T2& B)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  if(fixed_helper::solve(out, A, B))  { return true; }
+  
+  const Mat<eT>& AA = A;
+  const Mat<eT>& BB = B;
+  
+  return solve(out, AA, BB);
+  }
+
+
+
 template<typename T1, typename T2>
 arma_warn_unused
 inline
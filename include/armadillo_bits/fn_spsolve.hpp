@@ -21,6 +21,83 @@
 
 
 
+//! solve via the built-in sparse Cholesky / LDL factorisation, for symmetric / hermitian matrices
+template<typename T1, typename T2>
+inline
+bool
+spsolve_spchol_helper
+  (
+         Mat<typename T1::elem_type>& out,
+         typename T1::pod_type&       out_rcond,
+  const  T1&                          A_expr,
+  const  T2&                          B_expr,
+  const  spchol_opts&                 opts
+  )
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::pod_type   T;
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_spmat<T1> UA(A_expr);
+  const SpMat<eT>& A =   UA.M;
+  
+  const quasi_unwrap<T2> UB(B_expr);
+  const Mat<eT>& B =     UB.M;
+  
+  if(A.is_square() == false)
+    {
+    out.soft_reset();
+    arma_stop_logic_error("spsolve(): solving under-determined / over-determined systems is currently not supported");
+    return false;
+    }
+  
+  arma_conform_check( (A.n_rows != B.n_rows), "spsolve(): number of rows in the given objects must be the same", [&](){ out.soft_reset(); } );
+  
+  if((arma_config::check_conform) && (sp_auxlib::rudimentary_sym_check(A) == false))
+    {
+    if(is_cx<eT>::no )  { arma_warn(1, "spsolve(): given matrix is not symmetric"); }
+    if(is_cx<eT>::yes)  { arma_warn(1, "spsolve(): given matrix is not hermitian"); }
+    }
+  
+  if(arma_config::check_nonfinite && (A.internal_has_nonfinite() || B.internal_has_nonfinite()))
+    {
+    arma_warn(3, "spsolve(): detected non-finite elements");
+    return false;
+    }
+  
+  spchol_worker<eT> worker;
+  
+  if(worker.factorise(out_rcond, A, opts) == false)
+    {
+    if(opts.factor == spchol_opts::LLT)  { arma_warn(2, "spsolve(): factorisation failed; matrix may not be positive definite"); }
+    if(opts.factor == spchol_opts::LDLT) { arma_warn(2, "spsolve(): factorisation failed; detected zero pivot");                  }
+    
+    return false;
+    }
+  
+  if( (opts.allow_ugly == false) && (out_rcond < std::numeric_limits<T>::epsilon()) )  { return false; }
+  
+  bool status = false;
+  
+  if(UB.is_alias(out))
+    {
+    Mat<eT> tmp;
+    
+    status = worker.solve(tmp, B);
+    
+    out.steal_mem(tmp);
+    }
+  else
+    {
+    status = worker.solve(out, B);
+    }
+  
+  return status;
+  }
+
+
+
 template<typename T1, typename T2>
 inline
 bool
@@ -42,7 +119,7 @@ spsolve_helper
   
   const char sig = (solver != nullptr) ? solver[0] : char(0);
   
-  arma_conform_check( ((sig != 'l') && (sig != 's')), "spsolve(): unknown solver" );
+  arma_conform_check( ((sig != 'l') && (sig != 's') && (sig != 'n')), "spsolve(): unknown solver" );
   
   T rcond = T(0);
   
@@ -106,6 +183,20 @@ spsolve_helper
       status = glue_solve_gen_full::apply(out, AA, B.get_ref(), flags);
       }
     }
+  else
+  if(sig == 'n')  // built-in sparse Cholesky / LDL solver
+    {
+    if( (settings.id != 0) && (settings.id != 2) )
+      {
+      arma_warn(1, "spsolve(): ignoring settings not applicable to built-in solver");
+      }
+    
+    spchol_opts spchol_opts_default;
+    
+    const spchol_opts& native_opts = (settings.id == 2) ? static_cast<const spchol_opts&>(settings) : spchol_opts_default;
+    
+    status = spsolve_spchol_helper(out, rcond, A.get_ref(), B.get_ref(), native_opts);
+    }
   
   
   if( (status == false) && (rcond > T(0)) )
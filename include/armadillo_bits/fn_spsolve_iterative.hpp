@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup fn_spsolve_iterative
+//! @{
+
+
+
+template<typename T1, typename T2>
+inline
+bool
+spsolve_iterative_helper
+  (
+         Mat<typename T1::elem_type>&                    out,
+  const  T1&                                             A_expr,
+  const  T2&                                             B_expr,
+  const  char*                                           method,
+  const  spsolve_iter_opts&                              opts,
+         spsolve_iter_workspace<typename T1::elem_type>& ws
+  )
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_spmat<T1> UA(A_expr);
+  const quasi_unwrap<T2> UB(B_expr);
+  
+  if(UB.is_alias(out))
+    {
+    const Mat<eT> B(UB.M);
+    
+    return spsolve_iter::apply(out, ws, UA.M, B, method, opts);
+    }
+  
+  return spsolve_iter::apply(out, ws, UA.M, UB.M, method, opts);
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+bool
+spsolve_iterative
+  (
+           Mat<typename T1::elem_type>&                    out,
+  const SpBase<typename T1::elem_type, T1>&                A,
+  const   Base<typename T1::elem_type, T2>&                B,
+  const char*                                              method,
+  const spsolve_iter_opts&                                 opts,
+        spsolve_iter_workspace<typename T1::elem_type>&    ws,
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_debug_sigprint();
+  arma_ignore(junk);
+  
+  const bool status = spsolve_iterative_helper(out, A.get_ref(), B.get_ref(), method, opts, ws);
+  
+  if(status == false)  { arma_warn(3, "spsolve_iterative(): solution not found"); }
+  
+  return status;
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+bool
+spsolve_iterative
+  (
+           Mat<typename T1::elem_type>&     out,
+  const SpBase<typename T1::elem_type, T1>& A,
+  const   Base<typename T1::elem_type, T2>& B,
+  const char*                               method = "cg",
+  const spsolve_iter_opts&                  opts   = spsolve_iter_opts(),
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_debug_sigprint();
+  arma_ignore(junk);
+  
+  spsolve_iter_workspace<typename T1::elem_type> ws;
+  
+  const bool status = spsolve_iterative_helper(out, A.get_ref(), B.get_ref(), method, opts, ws);
+  
+  if(status == false)  { arma_warn(3, "spsolve_iterative(): solution not found"); }
+  
+  return status;
+  }
+
+
+
+template<typename T1, typename T2>
+arma_warn_unused
+inline
+Mat<typename T1::elem_type>
+spsolve_iterative
+  (
+  const SpBase<typename T1::elem_type, T1>& A,
+  const   Base<typename T1::elem_type, T2>& B,
+  const char*                               method = "cg",
+  const spsolve_iter_opts&                  opts   = spsolve_iter_opts(),
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr
+  )
+  {
+  arma_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename T1::elem_type eT;
+  
+  Mat<eT> out;
+  
+  spsolve_iter_workspace<eT> ws;
+  
+  const bool status = spsolve_iterative_helper(out, A.get_ref(), B.get_ref(), method, opts, ws);
+  
+  if(status == false)
+    {
+    out.soft_reset();
+    arma_stop_runtime_error("spsolve_iterative(): solution not found");
+    }
+  
+  return out;
+  }
+
+
+
+//! @}
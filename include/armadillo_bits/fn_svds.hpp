@@ -264,6 +264,105 @@ svds_helper
 
 
 
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+bool
+svds_helper
+  (
+           Mat<eT>&                         U,
+           Col<eT>&                         S,
+           Mat<eT>&                         V,
+  const matfree_op<eT, fn_type, fn_t_type>& A,
+  const uword                               k,
+  const typename get_pod_type<eT>::result   tol,
+  const bool                                calc_UV,
+  const typename arma_real_only<eT>::result* junk = nullptr
+  )
+  {
+  arma_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef eT T;
+  
+  if(matfree_op<eT, fn_type, fn_t_type>::has_trans == false)
+    {
+    arma_stop_logic_error("svds(): given operator must provide the product with its transpose");
+    return false;
+    }
+  
+  arma_conform_check
+    (
+    ( ((void*)(&U) == (void*)(&S)) || (&U == &V) || ((void*)(&S) == (void*)(&V)) ),
+    "svds(): two or more output objects are the same object"
+    );
+  
+  arma_conform_check( (tol < T(0)), "svds(): tol must be >= 0" );
+  
+  const uword m = A.n_rows;
+  const uword n = A.n_cols;
+  
+  const uword kk = (std::min)( (std::min)(m, n), k );
+  
+  if(kk == 0)
+    {
+    S.reset();
+    
+    if(calc_UV)  { U.set_size(m, 0); V.set_size(n, 0); }
+    
+    return true;
+    }
+  
+  // the elements of A are not available for scaling, so the augmented operator [0 A; A.t() 0] is used as is
+  
+  const auto C_fn = [&A, m, n](const Mat<eT>& X, Mat<eT>& Y)
+    {
+    Y.set_size(m+n, X.n_cols);
+    
+    Mat<eT> tmp;
+    
+    A.apply(tmp, Mat<eT>(X.rows(m, m+n-1)));  Y.rows(0, m-1  ) = tmp;
+    
+    A.apply_t(tmp, Mat<eT>(X.rows(0, m-1)));  Y.rows(m, m+n-1) = tmp;
+    };
+  
+  const matfree_op<eT, decltype(C_fn), matfree_none> C(m+n, m+n, C_fn, matfree_none());
+  
+  Col<eT> eigval;
+  Mat<eT> eigvec;
+  
+  eigs_opts opts;
+  opts.tol = (tol / Datum<T>::sqrt2);
+  
+  const bool status = eigs_sym(eigval, eigvec, C, kk, "la", opts);
+  
+  if(status == false)
+    {
+    U.soft_reset();
+    S.soft_reset();
+    V.soft_reset();
+    
+    return false;
+    }
+  
+  const uvec sorted_indices = sort_index(eigval, "descend");
+  
+  S = eigval.elem(sorted_indices);
+  
+  if(calc_UV)
+    {
+    eigvec = eigvec.cols(sorted_indices);
+    
+    U = Datum<T>::sqrt2 * eigvec.rows(0, m-1  );
+    V = Datum<T>::sqrt2 * eigvec.rows(m, m+n-1);
+    }
+  
+  if(S.n_elem < k)  { arma_warn(1, "svds(): found fewer singular values than specified"); }
+  
+  return true;
+  }
+
+
+
 //! find the k largest singular values and corresponding singular vectors of sparse matrix X
 template<typename T1>
 inline
@@ -349,4 +448,82 @@ svds
 
 
 
+//! find the k largest singular values and corresponding singular vectors of real operator A, given by user-supplied functions
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+typename enable_if2< is_real<eT>::value, bool >::result
+svds
+  (
+           Mat<eT>&                         U,
+           Col<eT>&                         S,
+           Mat<eT>&                         V,
+  const matfree_op<eT, fn_type, fn_t_type>& A,
+  const uword                               k,
+  const typename get_pod_type<eT>::result   tol = 0.0
+  )
+  {
+  arma_debug_sigprint();
+  
+  const bool status = svds_helper(U, S, V, A, k, tol, true);
+  
+  if(status == false)  { arma_warn(3, "svds(): decomposition failed"); }
+  
+  return status;
+  }
+
+
+
+//! find the k largest singular values of real operator A, given by user-supplied functions
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+typename enable_if2< is_real<eT>::value, bool >::result
+svds
+  (
+           Col<eT>&                         S,
+  const matfree_op<eT, fn_type, fn_t_type>& A,
+  const uword                               k,
+  const typename get_pod_type<eT>::result   tol = 0.0
+  )
+  {
+  arma_debug_sigprint();
+  
+  Mat<eT> U;
+  Mat<eT> V;
+  
+  const bool status = svds_helper(U, S, V, A, k, tol, false);
+  
+  if(status == false)  { arma_warn(3, "svds(): decomposition failed"); }
+  
+  return status;
+  }
+
+
+
+//! find the k largest singular values of real operator A, given by user-supplied functions
+template<typename eT, typename fn_type, typename fn_t_type>
+arma_warn_unused
+inline
+typename enable_if2< is_real<eT>::value, Col<eT> >::result
+svds
+  (
+  const matfree_op<eT, fn_type, fn_t_type>& A,
+  const uword                               k,
+  const typename get_pod_type<eT>::result   tol = 0.0
+  )
+  {
+  arma_debug_sigprint();
+  
+  Col<eT> S;
+  Mat<eT> U;
+  Mat<eT> V;
+  
+  const bool status = svds_helper(U, S, V, A, k, tol, false);
+  
+  if(status == false)  { arma_stop_runtime_error("svds(): decomposition failed"); }
+  
+  return S;
+  }
+
+
+
 //! @}
@@ -72,7 +72,7 @@ glue_powext::apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B)
   const eT*   A_mem =   A.memptr();
   const eT*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(N) )
     {
     #if defined(ARMA_USE_OPENMP)
       {
@@ -126,7 +126,7 @@ glue_powext::apply
   
   if(mode == 0) // each column
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(A.n_elem) )
       {
       #if defined(ARMA_USE_OPENMP)
         {
@@ -163,7 +163,7 @@ glue_powext::apply
   
   if(mode == 1) // each row
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(A.n_elem) )
       {
       #if defined(ARMA_USE_OPENMP)
         {
@@ -255,7 +255,7 @@ glue_powext::apply(Cube<eT>& out, const Cube<eT>& A, const Cube<eT>& B)
   const eT*   A_mem =   A.memptr();
   const eT*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(N) )
     {
     #if defined(ARMA_USE_OPENMP)
       {
@@ -307,7 +307,7 @@ glue_powext::apply
   const eT*   B_mem    = B.memptr();
   const uword B_n_elem = B.n_elem;
   
-  if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+  if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(A.n_elem) )
     {
     #if defined(ARMA_USE_OPENMP)
       {
@@ -401,7 +401,7 @@ glue_powext_cx::apply(Mat< std::complex<T> >& out, const Mat< std::complex<T> >&
   const eT*   A_mem =   A.memptr();
   const  T*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(N) )
     {
     #if defined(ARMA_USE_OPENMP)
       {
@@ -456,7 +456,7 @@ glue_powext_cx::apply
   
   if(mode == 0) // each column
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(A.n_elem) )
       {
       #if defined(ARMA_USE_OPENMP)
         {
@@ -493,7 +493,7 @@ glue_powext_cx::apply
   
   if(mode == 1) // each row
     {
-    if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+    if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(A.n_elem) )
       {
       #if defined(ARMA_USE_OPENMP)
         {
@@ -578,7 +578,7 @@ glue_powext_cx::apply(Cube< std::complex<T> >& out, const Cube< std::complex<T>
   const eT*   A_mem =   A.memptr();
   const  T*   B_mem =   B.memptr();
   
-  if( arma_config::openmp && mp_gate<eT>::eval(N) )
+  if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(N) )
     {
     #if defined(ARMA_USE_OPENMP)
       {
@@ -632,7 +632,7 @@ glue_powext_cx::apply
   const T*    B_mem    = B.memptr();
   const uword B_n_elem = B.n_elem;
   
-  if( arma_config::openmp && mp_gate<eT>::eval(A.n_elem) )
+  if( arma_config::openmp && mp_gate<eT, false, mp_op_cost::heavy>::eval(A.n_elem) )
     {
     #if defined(ARMA_USE_OPENMP)
       {
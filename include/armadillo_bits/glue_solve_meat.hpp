@@ -32,6 +32,8 @@ glue_solve_gen_default::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2
   {
   arma_debug_sigprint();
   
+  if(fixed_helper::solve(out, X.A, X.B))  { arma_debug_print("glue_solve_gen_default: fixed size kernel"); return; }
+  
   const bool status = glue_solve_gen_default::apply(out, X.A, X.B);
   
   if(status == false)
@@ -55,7 +55,11 @@ glue_times_redirect2_helper<do_inv_detect>::apply(Mat<typename T1::elem_type>& o
     return;
     }
   
-  const bool alias = tmp1.is_alias(out) || tmp2.is_alias(out);
+  // the kernel for fixed size matrices evaluates the product in local memory, so aliasing is not a problem
+  
+  constexpr bool use_fixed = fixed_helper::use_mul<typename partial_unwrap<T1>::stored_type, typename partial_unwrap<T2>::stored_type, partial_unwrap<T1>::do_trans, partial_unwrap<T2>::do_trans>::value;
+  
+  const bool alias = (use_fixed) ? false : (tmp1.is_alias(out) || tmp2.is_alias(out));
   
   if(alias == false)
     {
@@ -104,6 +108,8 @@ glue_times_redirect2_helper<true>::apply(Mat<typename T1::elem_type>& out, const
     
     const strip_inv<T1> A_strip(X.A);
     
+    if( (strip_inv<T1>::do_inv_gen) && fixed_helper::solve(out, A_strip.M, X.B) )  { arma_debug_print("glue_times_redirect<2>::apply(): fixed size kernel"); return; }
+    
     Mat<eT> A = A_strip.M;
     
     arma_conform_check( (A.is_square() == false), "inv(): given matrix must be square sized" );
@@ -678,6 +684,8 @@ glue_times::apply
   
   if( (A.n_elem == 0) || (B.n_elem == 0) )  { out.zeros(); return; }
   
+  if(fixed_helper::mul<do_trans_A, do_trans_B, use_alpha>(out, A, B, alpha))  { arma_debug_print("glue_times::apply(): fixed size kernel"); return; }
+  
   if( (do_trans_A == false) && (do_trans_B == false) && (use_alpha == false) )
     {
          if( ((A.n_rows == 1) || (TA::is_row)) && (is_cx<eT>::no) )  { gemv<true,         false, false>::apply(out.memptr(), B, A.memptr()); }
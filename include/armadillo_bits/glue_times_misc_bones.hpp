@@ -25,11 +25,67 @@ class dense_sparse_helper
   {
   public:
   
+  template<typename eT, typename sp_type>
+  arma_inline static typename  arma_not_cx<eT>::result dot(const eT* A_mem, const sp_type& B, const uword col);
+  
+  template<typename eT, typename sp_type>
+  arma_inline static typename arma_cx_only<eT>::result dot(const eT* A_mem, const sp_type& B, const uword col);
+  };
+
+
+
+//! read-only reference to sparse storage in compressed sparse column (CSC) format, which may be owned by another object;
+//! as the CSC format of a matrix is the compressed sparse row (CSR) format of its transpose, this also allows the kernels below to be used for CSR storage;
+//! a block of a CSC matrix is referenced via the bounds of the block within each column and an offset for the row indices
+template<typename eT>
+struct sp_csc_ref
+  {
+  const uword  n_rows;
+  const uword  n_cols;
+  const uword  n_nonzero;
+  const uword* col_ptrs;     // position of the first element of each column; col_ptrs[n_cols] is one past the last element of the last column
+  const uword* col_endp1s;   // position one past the last element of each column; col_ptrs + 1 for contiguous storage
+  const uword* row_indices;
+  const eT*    values;
+  const uword  row_offset;   // subtracted from the row indices
+  
+  inline explicit sp_csc_ref(const SpMat<eT>& X);  // X must be in CSC form, eg. as obtained via unwrap_spmat
+  inline          sp_csc_ref(const uword in_n_rows, const uword in_n_cols, const uword* in_col_ptrs, const uword* in_row_indices, const eT* in_values);
+  inline          sp_csc_ref(const SpSubview<eT>& X, podarray<uword>& bounds);  // bounds is used as storage for the column bounds of the block
+  
+  inline static const uword* get_bounds(const SpSubview<eT>& X, podarray<uword>& bounds);
+  
+  arma_inline bool is_contiguous() const { return ( (row_offset == 0) && (col_endp1s == (col_ptrs + 1)) ); }
+  };
+
+
+
+//! kernels for products of sparse and dense matrices;
+//! blocks of columns of the dense matrix are processed together, in row-interleaved buffers,
+//! so that each element of the sparse matrix is loaded once per block and is multiplied with contiguous values
+class sparse_dense_helper
+  {
+  public:
+  
+  static constexpr uword block_size = 4;
+  
+  template<typename eT>
+  inline static void times(Mat<eT>& out, const sp_csc_ref<eT>& A, const Mat<eT>& B);
+  
   template<typename eT>
-  arma_inline static typename  arma_not_cx<eT>::result dot(const eT* A_mem, const SpMat<eT>& B, const uword col);
+  inline static void trans_times(Mat<eT>& out, const sp_csc_ref<eT>& A, const Mat<eT>& B);
   
   template<typename eT>
-  arma_inline static typename arma_cx_only<eT>::result dot(const eT* A_mem, const SpMat<eT>& B, const uword col);
+  inline static void accumulate(eT* acc, const uword n_acc_cols, const sp_csc_ref<eT>& A, const Mat<eT>& B, const uword B_col_start, const uword A_col_start, const uword A_col_endp1);
+  
+  template<typename eT, const uword nb>
+  inline static void accumulate_kernel(eT* acc, const sp_csc_ref<eT>& A, const Mat<eT>& B, const uword B_col_start, const uword A_col_start, const uword A_col_endp1);
+  
+  template<typename eT, const uword nb>
+  inline static void trans_times_kernel(Mat<eT>& out, const sp_csc_ref<eT>& A, const eT* B_packed, const uword B_col_start, const uword A_col_start, const uword A_col_endp1);
+  
+  template<typename eT>
+  inline static void get_col_ranges(podarray<uword>& bounds, const sp_csc_ref<eT>& A, const uword n_ranges);
   };
 
 
@@ -79,6 +135,12 @@ class glue_times_sparse_dense
   template<typename T1, typename T2>
   inline static void apply_noalias_trans(Mat<typename T1::elem_type>& out, const T1& x, const T2& y);
   
+  template<typename eT, typename T2>
+  inline static void apply_noalias(Mat<eT>& out, const SpSubview<eT>& x, const T2& y);
+  
+  template<typename eT, typename T2>
+  inline static void apply_noalias_trans(Mat<eT>& out, const SpSubview<eT>& x, const T2& y);
+  
   template<typename T1, typename T2>
   inline static void apply_mixed(Mat< typename promote_type<typename T1::elem_type, typename T2::elem_type>::result >& out, const T1& X, const T2& Y);
   };
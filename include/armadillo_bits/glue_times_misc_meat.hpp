@@ -21,41 +21,44 @@
 
 
 
-template<typename eT>
+template<typename eT, typename sp_type>
 arma_inline
 typename arma_not_cx<eT>::result
-dense_sparse_helper::dot(const eT* A_mem, const SpMat<eT>& B, const uword col)
+dense_sparse_helper::dot(const eT* A_mem, const sp_type& B, const uword col)
   {
   arma_debug_sigprint();
   
-        uword      col_offset = B.col_ptrs[col    ];
+  const uword      col_offset = B.col_ptrs[col    ];
   const uword next_col_offset = B.col_ptrs[col + 1];
   
-  const uword* start_ptr = &(B.row_indices[     col_offset]);
-  const uword*   end_ptr = &(B.row_indices[next_col_offset]);
+  const uword* B_row_indices = B.row_indices;
+  const eT*    B_values      = B.values;
   
-  const eT* B_values = B.values;
+  // two accumulators, to break the dependency chain of additions
+  eT acc1 = eT(0);
+  eT acc2 = eT(0);
   
-  eT acc = eT(0);
+  uword i,j;
+  for(i=col_offset, j=col_offset+1; j < next_col_offset; i+=2, j+=2)
+    {
+    acc1 += A_mem[B_row_indices[i]] * B_values[i];
+    acc2 += A_mem[B_row_indices[j]] * B_values[j];
+    }
   
-  for(const uword* ptr = start_ptr; ptr != end_ptr; ++ptr)
+  if(i < next_col_offset)
     {
-    const uword index = (*ptr);
-    
-    acc += A_mem[index] * B_values[col_offset];
-    
-    ++col_offset;
+    acc1 += A_mem[B_row_indices[i]] * B_values[i];
     }
   
-  return acc;
+  return acc1 + acc2;
   }
 
 
 
-template<typename eT>
+template<typename eT, typename sp_type>
 arma_inline
 typename arma_cx_only<eT>::result
-dense_sparse_helper::dot(const eT* A_mem, const SpMat<eT>& B, const uword col)
+dense_sparse_helper::dot(const eT* A_mem, const sp_type& B, const uword col)
   {
   arma_debug_sigprint();
   
@@ -96,6 +99,449 @@ dense_sparse_helper::dot(const eT* A_mem, const SpMat<eT>& B, const uword col)
 
 
 
+template<typename eT>
+inline
+sp_csc_ref<eT>::sp_csc_ref(const SpMat<eT>& X)
+  : n_rows     (X.n_rows      )
+  , n_cols     (X.n_cols      )
+  , n_nonzero  (X.n_nonzero   )
+  , col_ptrs   (X.col_ptrs    )
+  , col_endp1s (X.col_ptrs + 1)
+  , row_indices(X.row_indices )
+  , values     (X.values      )
+  , row_offset (0             )
+  {
+  arma_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+sp_csc_ref<eT>::sp_csc_ref(const uword in_n_rows, const uword in_n_cols, const uword* in_col_ptrs, const uword* in_row_indices, const eT* in_values)
+  : n_rows     (in_n_rows                )
+  , n_cols     (in_n_cols                )
+  , n_nonzero  (in_col_ptrs[in_n_cols]   )
+  , col_ptrs   (in_col_ptrs              )
+  , col_endp1s (in_col_ptrs + 1          )
+  , row_indices(in_row_indices           )
+  , values     (in_values                )
+  , row_offset (0                        )
+  {
+  arma_debug_sigprint();
+  }
+
+
+
+template<typename eT>
+inline
+sp_csc_ref<eT>::sp_csc_ref(const SpSubview<eT>& X, podarray<uword>& bounds)
+  : n_rows     (X.n_rows                                            )
+  , n_cols     (X.n_cols                                            )
+  , n_nonzero  (X.n_nonzero                                         )
+  , col_ptrs   (sp_csc_ref<eT>::get_bounds(X, bounds)               )
+  , col_endp1s ( (X.n_rows == X.m.n_rows) ? (col_ptrs + 1) : (col_ptrs + X.n_cols + 1) )
+  , row_indices(X.m.row_indices                                     )
+  , values     (X.m.values                                          )
+  , row_offset (X.aux_row1                                          )
+  {
+  arma_debug_sigprint();
+  }
+
+
+
+//! if the block spans all rows, the column pointers of the parent matrix are used directly;
+//! otherwise the start positions of the columns are stored in bounds[0, n_cols], followed by the end positions
+template<typename eT>
+inline
+const uword*
+sp_csc_ref<eT>::get_bounds(const SpSubview<eT>& X, podarray<uword>& bounds)
+  {
+  arma_debug_sigprint();
+  
+  X.m.sync();
+  
+  if(X.n_rows == X.m.n_rows)  { return &(X.m.col_ptrs[X.aux_col1]); }
+  
+  const uword X_n_cols = X.n_cols;
+  
+  bounds.set_size(2*X_n_cols + 1);
+  
+  uword* starts = bounds.memptr();
+  uword* endp1s = bounds.memptr() + X_n_cols + 1;
+  
+  const auto worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col=start; col < endp1; ++col)  { X.get_col_bounds(col, starts[col], endp1s[col]); }
+    };
+  
+  const int n_threads = ( (X_n_cols > 1) && mp_gate<eT>::eval_loop(X.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  if(n_threads > 1)  { mp_loop::run_chunked(X_n_cols, n_threads, worker); }
+  else               { worker(uword(0), X_n_cols); }
+  
+  starts[X_n_cols] = (X_n_cols > 0) ? endp1s[X_n_cols - 1] : uword(0);
+  
+  return starts;
+  }
+
+
+
+template<typename eT>
+inline
+void
+sparse_dense_helper::times(Mat<eT>& out, const sp_csc_ref<eT>& A, const Mat<eT>& B)
+  {
+  arma_debug_sigprint();
+  
+  const uword A_n_rows = A.n_rows;
+  const uword A_n_cols = A.n_cols;
+  const uword B_n_cols = B.n_cols;
+  
+  out.zeros(A_n_rows, B_n_cols);
+  
+  if( (A.n_nonzero == 0) || (B.n_elem == 0) )  { return; }
+  
+  const uword n_blocks  = (B_n_cols + block_size - 1) / block_size;
+  const int   n_threads = (mp_gate<eT>::eval_loop(A.n_nonzero)) ? mp_thread_limit::get_loop() : int(1);
+  
+  // splitting the columns of A requires a reduction of the partial results;
+  // limit the number of partial results so that the reduction is small compared to the multiplication
+  const uword n_inner = (std::min)( uword(n_threads), (uword(8) * A.n_nonzero) / A_n_rows );
+  
+  if( (n_blocks >= uword(n_threads)) || (n_inner <= 1) )
+    {
+    arma_debug_print("sparse_dense_helper::times(): blocked over columns of B");
+    
+    const auto worker = [&](const uword start, const uword endp1)
+      {
+      podarray<eT> acc;
+      
+      for(uword block=start; block < endp1; ++block)
+        {
+        const uword B_col_start = block * block_size;
+        const uword n_acc_cols  = (std::min)(uword(block_size), B_n_cols - B_col_start);
+        
+        if(n_acc_cols == 1)
+          {
+          sparse_dense_helper::accumulate(out.colptr(B_col_start), 1, A, B, B_col_start, 0, A_n_cols);
+          
+          continue;
+          }
+        
+        acc.zeros(A_n_rows * n_acc_cols);
+        
+        sparse_dense_helper::accumulate(acc.memptr(), n_acc_cols, A, B, B_col_start, 0, A_n_cols);
+        
+        const eT* acc_mem = acc.memptr();
+        
+        for(uword j=0; j < n_acc_cols; ++j)
+          {
+          eT* out_col = out.colptr(B_col_start + j);
+          
+          for(uword row=0; row < A_n_rows; ++row)  { out_col[row] = acc_mem[row*n_acc_cols + j]; }
+          }
+        }
+      };
+    
+    mp_loop::run_chunked(n_blocks, n_threads, worker);
+    }
+  else
+    {
+    arma_debug_print("sparse_dense_helper::times(): blocked over columns of A");
+    
+    podarray<uword> bounds;
+    
+    sparse_dense_helper::get_col_ranges(bounds, A, n_inner);
+    
+    podarray<eT> acc(n_inner * A_n_rows * block_size);
+    
+    for(uword B_col_start=0; B_col_start < B_n_cols; B_col_start += block_size)
+      {
+      const uword n_acc_cols = (std::min)(uword(block_size), B_n_cols - B_col_start);
+      const uword acc_n_elem = A_n_rows * n_acc_cols;
+      
+      const auto partial_worker = [&](const uword t)
+        {
+        eT* acc_t = acc.memptr() + t*acc_n_elem;
+        
+        arrayops::fill_zeros(acc_t, acc_n_elem);
+        
+        sparse_dense_helper::accumulate(acc_t, n_acc_cols, A, B, B_col_start, bounds[t], bounds[t+1]);
+        };
+      
+      mp_loop::run(n_inner, n_threads, partial_worker);
+      
+      const auto reduce_worker = [&](const uword start, const uword endp1)
+        {
+        const eT* acc_mem = acc.memptr();
+        
+        for(uword j=0; j < n_acc_cols; ++j)
+          {
+          eT* out_col = out.colptr(B_col_start + j);
+          
+          for(uword row=start; row < endp1; ++row)
+            {
+            const uword i = row*n_acc_cols + j;
+            
+            eT val = acc_mem[i];
+            
+            for(uword t=1; t < n_inner; ++t)  { val += acc_mem[t*acc_n_elem + i]; }
+            
+            out_col[row] = val;
+            }
+          }
+        };
+      
+      mp_loop::run_chunked(A_n_rows, n_threads, reduce_worker);
+      }
+    }
+  }
+
+
+
+//! out = A.st() * B, without forming the transpose of A
+template<typename eT>
+inline
+void
+sparse_dense_helper::trans_times(Mat<eT>& out, const sp_csc_ref<eT>& A, const Mat<eT>& B)
+  {
+  arma_debug_sigprint();
+  
+  const uword A_n_cols = A.n_cols;
+  const uword B_n_rows = B.n_rows;
+  const uword B_n_cols = B.n_cols;
+  
+  if( (A.n_nonzero == 0) || (B.n_elem == 0) )  { out.zeros(A_n_cols, B_n_cols); return; }
+  
+  out.set_size(A_n_cols, B_n_cols);
+  
+  const int n_threads = ( (A_n_cols >= 2) && mp_gate<eT>::eval_loop(A.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  const uword n_blocks = (B_n_cols + block_size - 1) / block_size;
+  
+  // blocks of columns of B are stored in row-interleaved form;
+  // a block with one column is used directly
+  podarray<eT> B_packed;
+  
+  if(B_n_cols > 1)
+    {
+    B_packed.set_size(B.n_elem);
+    
+    const auto pack_worker = [&](const uword start, const uword endp1)
+      {
+      for(uword block=start; block < endp1; ++block)
+        {
+        const uword B_col_start = block * block_size;
+        const uword n_acc_cols  = (std::min)(uword(block_size), B_n_cols - B_col_start);
+        
+        if(n_acc_cols == 1)  { continue; }
+        
+        eT* packed_mem = B_packed.memptr() + B_col_start*B_n_rows;
+        
+        for(uword j=0; j < n_acc_cols; ++j)
+          {
+          const eT* B_col = B.colptr(B_col_start + j);
+          
+          for(uword row=0; row < B_n_rows; ++row)  { packed_mem[row*n_acc_cols + j] = B_col[row]; }
+          }
+        }
+      };
+    
+    mp_loop::run_chunked(n_blocks, n_threads, pack_worker);
+    }
+  
+  podarray<uword> bounds;
+  
+  sparse_dense_helper::get_col_ranges(bounds, A, uword(n_threads));
+  
+  arma_static_check( (block_size != 4), "sparse_dense_helper: block_size must match the kernels below" );
+  
+  const auto worker = [&](const uword t)
+    {
+    const uword A_col_start = bounds[t  ];
+    const uword A_col_endp1 = bounds[t+1];
+    
+    for(uword B_col_start=0; B_col_start < B_n_cols; B_col_start += block_size)
+      {
+      const uword n_acc_cols = (std::min)(uword(block_size), B_n_cols - B_col_start);
+      
+      const eT* packed_mem = B_packed.memptr() + B_col_start*B_n_rows;
+      
+      switch(n_acc_cols)
+        {
+        case 1:
+          {
+          const eT*  B_col = B.colptr(B_col_start);
+                eT* out_col = out.colptr(B_col_start);
+          
+          if(A.is_contiguous())
+            {
+            for(uword col=A_col_start; col < A_col_endp1; ++col)  { out_col[col] = dense_sparse_helper::dot(B_col, A, col); }
+            }
+          else
+            {
+            // a column of B is its own row-interleaved form
+            sparse_dense_helper::trans_times_kernel<eT,1>(out, A, B_col, B_col_start, A_col_start, A_col_endp1);
+            }
+          }
+          break;
+        
+        case 2:
+          sparse_dense_helper::trans_times_kernel<eT,2>(out, A, packed_mem, B_col_start, A_col_start, A_col_endp1);
+          break;
+        
+        case 3:
+          sparse_dense_helper::trans_times_kernel<eT,3>(out, A, packed_mem, B_col_start, A_col_start, A_col_endp1);
+          break;
+        
+        default:
+          sparse_dense_helper::trans_times_kernel<eT,block_size>(out, A, packed_mem, B_col_start, A_col_start, A_col_endp1);
+        }
+      }
+    };
+  
+  mp_loop::run(uword(n_threads), n_threads, worker);
+  }
+
+
+
+//! add A.cols(A_col_start, A_col_endp1-1) * B.cols(B_col_start, B_col_start+n_acc_cols-1) to the row-interleaved buffer acc
+template<typename eT>
+inline
+void
+sparse_dense_helper::accumulate(eT* acc, const uword n_acc_cols, const sp_csc_ref<eT>& A, const Mat<eT>& B, const uword B_col_start, const uword A_col_start, const uword A_col_endp1)
+  {
+  arma_static_check( (block_size != 4), "sparse_dense_helper: block_size must match the kernels below" );
+  
+  switch(n_acc_cols)
+    {
+    case 1:
+      sparse_dense_helper::accumulate_kernel<eT,1>(acc, A, B, B_col_start, A_col_start, A_col_endp1);
+      break;
+    
+    case 2:
+      sparse_dense_helper::accumulate_kernel<eT,2>(acc, A, B, B_col_start, A_col_start, A_col_endp1);
+      break;
+    
+    case 3:
+      sparse_dense_helper::accumulate_kernel<eT,3>(acc, A, B, B_col_start, A_col_start, A_col_endp1);
+      break;
+    
+    default:
+      sparse_dense_helper::accumulate_kernel<eT,block_size>(acc, A, B, B_col_start, A_col_start, A_col_endp1);
+    }
+  }
+
+
+
+template<typename eT, const uword nb>
+inline
+void
+sparse_dense_helper::accumulate_kernel(eT* acc, const sp_csc_ref<eT>& A, const Mat<eT>& B, const uword B_col_start, const uword A_col_start, const uword A_col_endp1)
+  {
+  const uword* A_col_ptrs    = A.col_ptrs;
+  const uword* A_col_endp1s  = A.col_endp1s;
+  const uword* A_row_indices = A.row_indices;
+  const eT*    A_values      = A.values;
+  const uword  A_row_offset  = A.row_offset;
+  
+  const uword B_n_rows = B.n_rows;
+  const eT*   B_mem    = B.colptr(B_col_start);
+  
+  eT B_vals[nb];
+  
+  for(uword col=A_col_start; col < A_col_endp1; ++col)
+    {
+    const uword i_start = A_col_ptrs[col];
+    const uword i_endp1 = A_col_endp1s[col];
+    
+    if(i_start == i_endp1)  { continue; }
+    
+    for(uword j=0; j < nb; ++j)  { B_vals[j] = B_mem[j*B_n_rows + col]; }
+    
+    for(uword i=i_start; i < i_endp1; ++i)
+      {
+      const eT  A_val   = A_values[i];
+            eT* acc_row = &(acc[(A_row_indices[i] - A_row_offset) * nb]);
+      
+      for(uword j=0; j < nb; ++j)  { acc_row[j] += A_val * B_vals[j]; }
+      }
+    }
+  }
+
+
+
+template<typename eT, const uword nb>
+inline
+void
+sparse_dense_helper::trans_times_kernel(Mat<eT>& out, const sp_csc_ref<eT>& A, const eT* B_packed, const uword B_col_start, const uword A_col_start, const uword A_col_endp1)
+  {
+  const uword* A_col_ptrs    = A.col_ptrs;
+  const uword* A_col_endp1s  = A.col_endp1s;
+  const uword* A_row_indices = A.row_indices;
+  const eT*    A_values      = A.values;
+  const uword  A_row_offset  = A.row_offset;
+  
+  const uword out_n_rows = out.n_rows;
+        eT*   out_mem    = out.colptr(B_col_start);
+  
+  eT acc[nb];
+  
+  for(uword col=A_col_start; col < A_col_endp1; ++col)
+    {
+    for(uword j=0; j < nb; ++j)  { acc[j] = eT(0); }
+    
+    const uword i_endp1 = A_col_endp1s[col];
+    
+    for(uword i=A_col_ptrs[col]; i < i_endp1; ++i)
+      {
+      const eT  A_val   = A_values[i];
+      const eT* B_row   = &(B_packed[(A_row_indices[i] - A_row_offset) * nb]);
+      
+      for(uword j=0; j < nb; ++j)  { acc[j] += A_val * B_row[j]; }
+      }
+    
+    for(uword j=0; j < nb; ++j)  { out_mem[j*out_n_rows + col] = acc[j]; }
+    }
+  }
+
+
+
+//! split the columns of A into n_ranges contiguous ranges with a similar number of non-zero elements
+template<typename eT>
+inline
+void
+sparse_dense_helper::get_col_ranges(podarray<uword>& bounds, const sp_csc_ref<eT>& A, const uword n_ranges)
+  {
+  const uword  A_n_cols   = A.n_cols;
+  const uword* A_col_ptrs = A.col_ptrs;
+  
+  bounds.set_size(n_ranges + 1);
+  
+  bounds[0]        = 0;
+  bounds[n_ranges] = A_n_cols;
+  
+  // the column pointers of a block may not start at zero
+  const uword base  = A_col_ptrs[0];
+  const uword total = A_col_ptrs[A_n_cols] - base;
+  
+  for(uword t=1; t < n_ranges; ++t)
+    {
+    const uword target = base + uword( (double(total) * double(t)) / double(n_ranges) );
+    
+    const uword col = uword( std::lower_bound(A_col_ptrs, A_col_ptrs + A_n_cols + 1, target) - A_col_ptrs );
+    
+    bounds[t] = (std::min)( (std::max)(col, bounds[t-1]), A_n_cols );
+    }
+  }
+
+
+
+//
+
+
+
 template<typename T1, typename T2>
 inline
 void
@@ -382,81 +828,9 @@ glue_times_sparse_dense::apply_noalias(Mat<typename T1::elem_type>& out, const T
   const quasi_unwrap<T2> UB(y);
   const Mat<eT>&     B = UB.M;
   
-  const uword A_n_rows = A.n_rows;
-  const uword A_n_cols = A.n_cols;
-  
-  const uword B_n_rows = B.n_rows;
-  const uword B_n_cols = B.n_cols;
-  
-  arma_conform_assert_mul_size(A_n_rows, A_n_cols, B_n_rows, B_n_cols, "matrix multiplication");
+  arma_conform_assert_mul_size(A.n_rows, A.n_cols, B.n_rows, B.n_cols, "matrix multiplication");
   
-  if((resolves_to_colvector<T2>::value) || (B_n_cols == 1))
-    {
-    arma_debug_print("using column vector specialisation");
-    
-    out.zeros(A_n_rows, 1);
-    
-          eT* out_mem = out.memptr();
-    const eT*   B_mem =   B.memptr();
-    
-    typename SpMat<eT>::const_iterator A_it = A.begin();
-    
-    const uword nnz = A.n_nonzero;
-    
-    for(uword count = 0; count < nnz; ++count, ++A_it)
-      {
-      const eT    A_it_val = (*A_it);
-      const uword A_it_row = A_it.row();
-      const uword A_it_col = A_it.col();
-      
-      out_mem[A_it_row] += A_it_val * B_mem[A_it_col];
-      }
-    }
-  else
-  if(B_n_cols >= (B_n_rows / uword(100)))
-    {
-    arma_debug_print("using transpose-based multiplication");
-    
-    const SpMat<eT> At = A.st();
-    const   Mat<eT> Bt = B.st();
-    
-    if(A_n_rows == B_n_cols)
-      {
-      glue_times_dense_sparse::apply_noalias(out, Bt, At);
-      
-      op_strans::apply_mat(out, out);  // since 'out' is square-sized, this will do an inplace transpose
-      }
-    else
-      {
-      Mat<eT> tmp;
-      
-      glue_times_dense_sparse::apply_noalias(tmp, Bt, At);
-      
-      op_strans::apply_mat(out, tmp);
-      }
-    }
-  else
-    {
-    arma_debug_print("using standard multiplication");
-    
-    out.zeros(A_n_rows, B_n_cols);
-    
-    typename SpMat<eT>::const_iterator A_it = A.begin();
-    
-    const uword nnz = A.n_nonzero;
-    
-    for(uword count = 0; count < nnz; ++count, ++A_it)
-      {
-      const eT    A_it_val = (*A_it);
-      const uword A_it_row = A_it.row();
-      const uword A_it_col = A_it.col();
-      
-      for(uword col = 0; col < B_n_cols; ++col)
-        {
-        out.at(A_it_row, col) += A_it_val * B.at(A_it_col, col);
-        }
-      }
-    }
+  sparse_dense_helper::times(out, sp_csc_ref<eT>(A), B);
   }
 
 
@@ -476,98 +850,48 @@ glue_times_sparse_dense::apply_noalias_trans(Mat<typename T1::elem_type>& out, c
   const quasi_unwrap<T2> UB(y);
   const Mat<eT>&     B = UB.M;
   
-  const uword A_n_rows = A.n_rows;
-  const uword A_n_cols = A.n_cols;
+  arma_conform_assert_mul_size(A.n_cols, A.n_rows, B.n_rows, B.n_cols, "matrix multiplication");
   
-  const uword B_n_rows = B.n_rows;
-  const uword B_n_cols = B.n_cols;
+  sparse_dense_helper::trans_times(out, sp_csc_ref<eT>(A), B);
+  }
+
+
+
+//! the block is used in place, without extracting it into a separate sparse matrix
+template<typename eT, typename T2>
+inline
+void
+glue_times_sparse_dense::apply_noalias(Mat<eT>& out, const SpSubview<eT>& x, const T2& y)
+  {
+  arma_debug_sigprint();
   
-  arma_conform_assert_mul_size(A_n_cols, A_n_rows, B_n_rows, B_n_cols, "matrix multiplication");
+  const quasi_unwrap<T2> UB(y);
+  const Mat<eT>&     B = UB.M;
   
-  if((resolves_to_colvector<T2>::value) || (B_n_cols == 1))
-    {
-    arma_debug_print("using column vector specialisation (avoiding transpose of A)");
-    
-    if( (arma_config::openmp) && (mp_thread_limit::in_parallel() == false) && (A_n_cols >= 2) && mp_gate<eT>::eval(A.n_nonzero) )
-      {
-      arma_debug_print("opemp implementation");
-      
-      #if defined(ARMA_USE_OPENMP)
-        {
-        out.zeros(A_n_cols, 1);
-        
-              eT* out_mem = out.memptr();
-        const eT*   B_mem =   B.memptr();
-        
-        const int n_threads = mp_thread_limit::get();
-        
-        #pragma omp parallel for schedule(static) num_threads(n_threads)
-        for(uword col=0; col < A_n_cols; ++col)
-          {
-          out_mem[col] = dense_sparse_helper::dot(B_mem, A, col);
-          }
-        }
-      #endif
-      }
-    else
-      {
-      arma_debug_print("serial implementation");
-      
-      out.zeros(A_n_cols, 1);
-      
-            eT* out_mem = out.memptr();
-      const eT*   B_mem =   B.memptr();
-      
-      for(uword col=0; col < A_n_cols; ++col)
-        {
-        out_mem[col] = dense_sparse_helper::dot(B_mem, A, col);
-        }
-      }
-    }
-  else
-  if(B_n_cols >= (B_n_rows / uword(100)))
-    {
-    arma_debug_print("using transpose-based multiplication (avoiding transpose of A)");
-    
-    const Mat<eT> Bt = B.st();
-    
-    if(A_n_cols == B_n_cols)
-      {
-      glue_times_dense_sparse::apply_noalias(out, Bt, A);
-      
-      op_strans::apply_mat(out, out);  // since 'out' is square-sized, this will do an inplace transpose
-      }
-    else
-      {
-      Mat<eT> tmp;
-      
-      glue_times_dense_sparse::apply_noalias(tmp, Bt, A);
-      
-      op_strans::apply_mat(out, tmp);
-      }
-    }
-  else
-    {
-    arma_debug_print("using standard multiplication (avoiding transpose of A)");
-    
-    out.zeros(A_n_cols, B_n_cols);
-    
-    typename SpMat<eT>::const_iterator A_it = A.begin();
-    
-    const uword nnz = A.n_nonzero;
-    
-    for(uword count = 0; count < nnz; ++count, ++A_it)
-      {
-      const eT    A_it_val = (*A_it);
-      const uword A_it_row = A_it.row();
-      const uword A_it_col = A_it.col();
-      
-      for(uword col = 0; col < B_n_cols; ++col)
-        {
-        out.at(A_it_col, col) += A_it_val * B.at(A_it_row, col);
-        }
-      }
-    }
+  arma_conform_assert_mul_size(x.n_rows, x.n_cols, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  podarray<uword> bounds;
+  
+  sparse_dense_helper::times(out, sp_csc_ref<eT>(x, bounds), B);
+  }
+
+
+
+template<typename eT, typename T2>
+inline
+void
+glue_times_sparse_dense::apply_noalias_trans(Mat<eT>& out, const SpSubview<eT>& x, const T2& y)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T2> UB(y);
+  const Mat<eT>&     B = UB.M;
+  
+  arma_conform_assert_mul_size(x.n_cols, x.n_rows, B.n_rows, B.n_cols, "matrix multiplication");
+  
+  podarray<uword> bounds;
+  
+  sparse_dense_helper::trans_times(out, sp_csc_ref<eT>(x, bounds), B);
   }
 
 
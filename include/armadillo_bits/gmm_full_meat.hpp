@@ -1028,8 +1028,14 @@ gmm_full<eT>::internal_gen_boundaries(const uword N) const
   {
   arma_debug_sigprint();
   
-  #if defined(ARMA_USE_OPENMP)
-    const uword n_threads_avail = uword(omp_get_max_threads());
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
+    #if defined(ARMA_USE_OPENMP)
+      const uword n_threads_omp = uword(omp_get_max_threads());
+    #else
+      const uword n_threads_omp = 1;
+    #endif
+    
+    const uword n_threads_avail = (mp_executor::is_active()) ? mp_executor::get_n_threads() : n_threads_omp;
     const uword n_threads       = (n_threads_avail > 0) ? ( (n_threads_avail <= N) ? n_threads_avail : 1 ) : 1;
   #else
     static constexpr uword n_threads = 1;
@@ -1149,14 +1155,13 @@ gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X) const
   
   if(N_samples > 0)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
       {
       const umat boundaries = internal_gen_boundaries(N_samples);
       
       const uword n_threads = boundaries.n_cols;
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      const auto worker = [&](const uword t)
         {
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
@@ -1167,7 +1172,9 @@ gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X) const
           {
           out_mem[i] = internal_scalar_log_p( X.colptr(i) );
           }
-        }
+        };
+      
+      mp_loop::run(n_threads, int(n_threads), worker);
       }
     #else
       {
@@ -1203,14 +1210,13 @@ gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X, const uword gaus_id) const
   
   if(N_samples > 0)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
       {
       const umat boundaries = internal_gen_boundaries(N_samples);
       
       const uword n_threads = boundaries.n_cols;
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      const auto worker = [&](const uword t)
         {
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
@@ -1221,7 +1227,9 @@ gmm_full<eT>::internal_vec_log_p(const Mat<eT>& X, const uword gaus_id) const
           {
           out_mem[i] = internal_scalar_log_p( X.colptr(i), gaus_id );
           }
-        }
+        };
+      
+      mp_loop::run(n_threads, int(n_threads), worker);
       }
     #else
       {
@@ -1254,7 +1262,7 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X) const
   if(N == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const umat boundaries = internal_gen_boundaries(N);
     
@@ -1262,8 +1270,7 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X) const
     
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    const auto worker = [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1276,7 +1283,9 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X) const
         }
       
       t_accs[t] = t_acc;
-      }
+      };
+    
+    mp_loop::run(n_threads, int(n_threads), worker);
     
     return eT(accu(t_accs));
     }
@@ -1311,7 +1320,7 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id) const
   if(N == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const umat boundaries = internal_gen_boundaries(N);
     
@@ -1319,8 +1328,7 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id) const
     
     Col<eT> t_accs(n_threads, arma_zeros_indicator());
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    const auto worker = [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1333,7 +1341,9 @@ gmm_full<eT>::internal_sum_log_p(const Mat<eT>& X, const uword gaus_id) const
         }
       
       t_accs[t] = t_acc;
-      }
+      };
+    
+    mp_loop::run(n_threads, int(n_threads), worker);
     
     return eT(accu(t_accs));
     }
@@ -1368,7 +1378,7 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X) const
   if(N_samples == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const umat boundaries = internal_gen_boundaries(N_samples);
     
@@ -1377,8 +1387,7 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X) const
     field< running_mean_scalar<eT> > t_running_means(n_threads);
     
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    const auto worker = [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1389,7 +1398,9 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X) const
         {
         current_running_mean( internal_scalar_log_p( X.colptr(i) ) );
         }
-      }
+      };
+    
+    mp_loop::run(n_threads, int(n_threads), worker);
     
     
     eT avg = eT(0);
@@ -1437,7 +1448,7 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id) const
   if(N_samples == 0)  { return (-Datum<eT>::inf); }
   
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const umat boundaries = internal_gen_boundaries(N_samples);
     
@@ -1446,8 +1457,7 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id) const
     field< running_mean_scalar<eT> > t_running_means(n_threads);
     
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    const auto worker = [&](const uword t)
       {
       const uword start_index = boundaries.at(0,t);
       const uword   end_index = boundaries.at(1,t);
@@ -1458,7 +1468,9 @@ gmm_full<eT>::internal_avg_log_p(const Mat<eT>& X, const uword gaus_id) const
         {
         current_running_mean( internal_scalar_log_p( X.colptr(i), gaus_id) );
         }
-      }
+      };
+    
+    mp_loop::run(n_threads, int(n_threads), worker);
     
     
     eT avg = eT(0);
@@ -1574,25 +1586,31 @@ gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
   
   if(dist_mode == eucl_dist)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
       {
-      #pragma omp parallel for schedule(static)
-      for(uword i=0; i<X_n_cols; ++i)
+      const uword n_threads = internal_gen_boundaries(X_n_cols).n_cols;
+      
+      const auto worker = [&](const uword start, const uword endp1)
         {
-        const eT* X_colptr = X.colptr(i);
+        for(uword i=start; i < endp1; ++i)
+          {
+          const eT* X_colptr = X.colptr(i);
          
-        eT    best_dist = Datum<eT>::inf;
-        uword best_g    = 0;
+          eT    best_dist = Datum<eT>::inf;
+          uword best_g    = 0;
         
-        for(uword g=0; g<N_gaus; ++g)
-          {
-          const eT tmp_dist = distance<eT,1>::eval(N_dims, X_colptr, means.colptr(g), X_colptr);
+          for(uword g=0; g<N_gaus; ++g)
+            {
+            const eT tmp_dist = distance<eT,1>::eval(N_dims, X_colptr, means.colptr(g), X_colptr);
           
-          if(tmp_dist <= best_dist)  { best_dist = tmp_dist; best_g = g; }
-          }
+            if(tmp_dist <= best_dist)  { best_dist = tmp_dist; best_g = g; }
+            }
         
-        out_mem[i] = best_g;
-        }
+          out_mem[i] = best_g;
+          }
+        };
+      
+      mp_loop::run_chunked(X_n_cols, int(n_threads), worker);
       }
     #else
       {
@@ -1618,7 +1636,7 @@ gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
   else
   if(dist_mode == prob_dist)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
       {
       const umat boundaries = internal_gen_boundaries(X_n_cols);
       
@@ -1626,8 +1644,7 @@ gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
       
       const eT* log_hefts_mem = log_hefts.memptr();
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      const auto worker = [&](const uword t)
         {
         const uword start_index = boundaries.at(0,t);
         const uword   end_index = boundaries.at(1,t);
@@ -1648,7 +1665,9 @@ gmm_full<eT>::internal_vec_assign(urowvec& out, const Mat<eT>& X, const gmm_dist
           
           out_mem[i] = best_g;
           }
-        }
+        };
+      
+      mp_loop::run(n_threads, int(n_threads), worker);
       }
     #else
       {
@@ -1698,7 +1717,7 @@ gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
   
   if(N_gaus == 0)  { return; }
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const umat boundaries = internal_gen_boundaries(X_n_cols);
     
@@ -1711,8 +1730,7 @@ gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
     
     if(dist_mode == eucl_dist)
       {
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      const auto worker = [&](const uword t)
         {
         uword* thread_hist_mem = thread_hist(t).memptr();
         
@@ -1735,15 +1753,16 @@ gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
           
           thread_hist_mem[best_g]++;
           }
-        }
+        };
+      
+      mp_loop::run(n_threads, int(n_threads), worker);
       }
     else
     if(dist_mode == prob_dist)
       {
       const eT* log_hefts_mem = log_hefts.memptr();
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      const auto worker = [&](const uword t)
         {
         uword* thread_hist_mem = thread_hist(t).memptr();
         
@@ -1766,7 +1785,9 @@ gmm_full<eT>::internal_raw_hist(urowvec& hist, const Mat<eT>& X, const gmm_dist_
           
           thread_hist_mem[best_g]++;
           }
-        }
+        };
+      
+      mp_loop::run(n_threads, int(n_threads), worker);
       }
     
     // reduction
@@ -1947,7 +1968,7 @@ gmm_full<eT>::generate_initial_params(const Mat<eT>& X, const eT var_floor)
   
   uword* acc_hefts_mem = acc_hefts.memptr();
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
     const umat boundaries = internal_gen_boundaries(X_n_cols);
     
@@ -1964,8 +1985,7 @@ gmm_full<eT>::generate_initial_params(const Mat<eT>& X, const eT var_floor)
       t_acc_hefts(t).zeros(N_gaus);
       }
     
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t < n_threads; ++t)
+    const auto worker = [&](const uword t)
       {
       uword* t_acc_hefts_mem = t_acc_hefts(t).memptr();
       
@@ -1999,7 +2019,9 @@ gmm_full<eT>::generate_initial_params(const Mat<eT>& X, const eT var_floor)
         
         t_acc_hefts_mem[best_g]++;
         }
-      }
+      };
+    
+    mp_loop::run(n_threads, int(n_threads), worker);
     
     // reduction
     acc_means = t_acc_means(0);
@@ -2112,7 +2134,7 @@ gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
   
   running_mean_scalar<eT> rs_delta;
   
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     const umat boundaries = internal_gen_boundaries(X_n_cols);
     const uword n_threads = boundaries.n_cols;
     
@@ -2127,7 +2149,7 @@ gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
   
   for(uword iter=1; iter <= max_iter; ++iter)
     {
-    #if defined(ARMA_USE_OPENMP)
+    #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
       {
       for(uword t=0; t < n_threads; ++t)
         {
@@ -2136,8 +2158,7 @@ gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
         t_last_indx(t).zeros(N_gaus);
         }
       
-      #pragma omp parallel for schedule(static)
-      for(uword t=0; t < n_threads; ++t)
+      const auto worker = [&](const uword t)
         {
         Mat<eT>& t_acc_means_t   = t_acc_means(t);
         uword*   t_acc_hefts_mem = t_acc_hefts(t).memptr();
@@ -2167,7 +2188,9 @@ gmm_full<eT>::km_iterate(const Mat<eT>& X, const uword max_iter, const bool verb
           t_acc_hefts_mem[best_g]++;
           t_last_indx_mem[best_g] = i;
           }
-        }
+        };
+      
+      mp_loop::run(n_threads, int(n_threads), worker);
       
       // reduction
       
@@ -2440,10 +2463,9 @@ gmm_full<eT>::em_update_params
   
   // em_generate_acc() is the "map" operation, which produces partial accumulators for means, diagonal covariances and hefts
     
-  #if defined(ARMA_USE_OPENMP)
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
     {
-    #pragma omp parallel for schedule(static)
-    for(uword t=0; t<n_threads; t++)
+    const auto worker = [&](const uword t)
       {
        Mat<eT>& acc_means          = t_acc_means[t];
       Cube<eT>& acc_fcovs          = t_acc_fcovs[t];
@@ -2452,7 +2474,9 @@ gmm_full<eT>::em_update_params
        eT&      progress_log_lhood = t_progress_log_lhood[t];
       
       em_generate_acc(X, boundaries.at(0,t), boundaries.at(1,t), acc_means, acc_fcovs, acc_norm_lhoods, gaus_log_lhoods, progress_log_lhood);
-      }
+      };
+    
+    mp_loop::run(n_threads, int(n_threads), worker);
     }
   #else
     {
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup lu_factoriser
+//! @{
+
+
+
+//! LU decomposition P*A = L*U of a square real matrix, which can be modified in O(n^2) operations instead of being recomputed;
+//! a copy of A is kept, so that the decomposition can be recomputed with partial pivoting in the rare case of a modification being unstable
+template<typename eT>
+class lu_factoriser
+  {
+  private:
+  
+  Mat<eT> A_mat;   // copy of the current matrix
+  Mat<eT> L_mat;   // unit lower triangular factor
+  Mat<eT> Ut_mat;  // transpose of the upper triangular factor, so that the rows of U are contiguous in memory
+  uvec    perm;    // row i of P*A is row perm[i] of A
+  bool    valid = false;
+  bool    recomputed = false;  // whether the most recent modification recomputed the decomposition
+  
+  static constexpr eT growth_limit = eT(1000);  // modifications producing elements of L larger than this in magnitude trigger recomputation
+  
+  inline bool factorise_worker();
+  
+  inline bool elim_worker(const uword i, const eT p, const eT q, eT* x);
+  
+  inline bool update_worker(Col<eT>& x, const Col<eT>& y);
+  
+  inline bool remove_worker(const uword k);
+  
+  
+  public:
+  
+  typedef eT elem_type;
+  
+  inline  lu_factoriser();
+  
+  inline void reset();
+  
+  inline uword n_rows() const;
+  
+  template<typename T1> inline bool factorise(const Base<eT,T1>& A_expr);
+  
+  template<typename T1, typename T2> inline bool update(const Base<eT,T1>& u_expr, const Base<eT,T2>& v_expr);  //!< A + u*v.t()
+  
+  template<typename T1, typename T2> inline bool append(const Base<eT,T1>& c_expr, const Base<eT,T2>& r_expr);  //!< add a column c (n+1 elements) and a row r (n elements)
+  
+  inline bool remove(const uword k);  //!< remove row and column k
+  
+  template<typename T1> inline bool solve(Mat<eT>& X, const Base<eT,T1>& B_expr) const;
+  
+  inline eT rcond() const;
+  
+  inline bool was_recomputed() const;  //!< whether the most recent update(), append() or remove() required an O(n^3) recomputation
+  };
+
+
+
+//! @}
@@ -0,0 +1,675 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup lu_factoriser
+//! @{
+
+
+
+template<typename eT>
+inline
+lu_factoriser<eT>::lu_factoriser()
+  {
+  arma_debug_sigprint_this(this);
+  
+  arma_type_check(( is_real<eT>::value == false ));
+  }
+
+
+
+template<typename eT>
+inline
+void
+lu_factoriser<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  A_mat.reset();
+  L_mat.reset();
+  Ut_mat.reset();
+  perm.reset();
+  
+  valid      = false;
+  recomputed = false;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+lu_factoriser<eT>::n_rows() const
+  {
+  return A_mat.n_rows;
+  }
+
+
+
+//! LU decomposition of A_mat with partial pivoting
+template<typename eT>
+inline
+bool
+lu_factoriser<eT>::factorise_worker()
+  {
+  arma_debug_sigprint();
+  
+  const uword N = A_mat.n_rows;
+  
+  Mat<eT> U;
+  podarray<blas_int> ipiv;
+  
+  if(auxlib::lu(L_mat, U, ipiv, A_mat) == false)  { return false; }
+  
+  op_strans::apply_mat_noalias(Ut_mat, U);
+  
+  // convert the sequence of row interchanges into a permutation
+  
+  perm = regspace<uvec>(0, 1, uword(N-1));
+  
+  if(N == 0)  { perm.reset(); }
+  
+  for(uword i=0; i < ipiv.n_elem; ++i)
+    {
+    const uword j = uword(ipiv[i]);
+    
+    if(j != i)  { std::swap(perm[i], perm[j]); }
+    }
+  
+  for(uword i=0; i < N; ++i)
+    {
+    if(Ut_mat.at(i,i) == eT(0))  { return false; }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+lu_factoriser<eT>::factorise(const Base<eT,T1>& A_expr)
+  {
+  arma_debug_sigprint();
+  
+  reset();
+  
+  A_mat = A_expr.get_ref();
+  
+  if(A_mat.is_square() == false)
+    {
+    arma_warn(1, "lu_factoriser::factorise(): given matrix must be square sized");
+    reset();
+    return false;
+    }
+  
+  if(A_mat.internal_has_nonfinite() || (factorise_worker() == false))
+    {
+    arma_warn(3, "lu_factoriser::factorise(): factorisation failed");
+    reset();
+    return false;
+    }
+  
+  valid = true;
+  
+  return true;
+  }
+
+
+
+//! eliminate q against p, which are the elements in rows i and i+1 of either a column of U or the vector x,
+//! by a transformation of rows i and i+1 of U (and x), with the inverse transformation applied to columns i and i+1 of L;
+//! rows i and i+1 of P*A are interchanged when this gives the smaller multiplier (pairwise pivoting);
+//! returns false if the elements of L grow too large
+template<typename eT>
+inline
+bool
+lu_factoriser<eT>::elim_worker(const uword i, const eT p, const eT q, eT* x)
+  {
+  arma_debug_sigprint();
+  
+  if(q == eT(0))  { return true; }
+  
+  const uword N   =  L_mat.n_rows;
+  const uword N_c = Ut_mat.n_rows;  // number of columns of U
+  
+  eT*  L_i_colmem =  L_mat.colptr(i);
+  eT*  L_j_colmem =  L_mat.colptr(i+1);
+  eT* Ut_i_colmem = Ut_mat.colptr(i);    // row i of U
+  eT* Ut_j_colmem = Ut_mat.colptr(i+1);  // row i+1 of U
+  
+  const eT l = L_i_colmem[i+1];
+  
+  eT L_max = eT(0);
+  
+  if( std::abs(l*p + q) <= std::abs(p) )
+    {
+    // without interchange: subtract a multiple of row i from row i+1
+    
+    const eT m = q / p;
+    
+    for(uword c=i; c < N_c; ++c)  { Ut_j_colmem[c] -= m * Ut_i_colmem[c]; }
+    
+    if(x != nullptr)  { x[i+1] -= m * x[i]; }
+    
+    for(uword r=i+1; r < N; ++r)
+      {
+      L_i_colmem[r] += m * L_j_colmem[r];
+      
+      L_max = (std::max)(L_max, std::abs(L_i_colmem[r]));
+      }
+    }
+  else
+    {
+    // with interchange: rows i and i+1 of P*A are swapped,
+    // and the 2x2 transformation is chosen so that L remains unit lower triangular
+    
+    const eT a = p / (l*p + q);
+    const eT b = eT(1) - l*a;
+    
+    for(uword c=i; c < N_c; ++c)
+      {
+      const eT u_i = Ut_i_colmem[c];
+      const eT u_j = Ut_j_colmem[c];
+      
+      Ut_i_colmem[c] = l*u_i + u_j;
+      Ut_j_colmem[c] = b*u_i - a*u_j;
+      }
+    
+    if(x != nullptr)
+      {
+      const eT x_i = x[i];
+      const eT x_j = x[i+1];
+      
+      x[i]   = l*x_i + x_j;
+      x[i+1] = b*x_i - a*x_j;
+      }
+    
+    for(uword r=i+2; r < N; ++r)
+      {
+      const eT L_ri = L_i_colmem[r];
+      const eT L_rj = L_j_colmem[r];
+      
+      L_i_colmem[r] = a*L_ri + b*L_rj;
+      L_j_colmem[r] = L_ri - l*L_rj;
+      
+      L_max = (std::max)(L_max, (std::max)(std::abs(L_i_colmem[r]), std::abs(L_j_colmem[r])));
+      }
+    
+    L_i_colmem[i+1] = a;
+    
+    for(uword c=0; c < i; ++c)  { std::swap(L_mat.at(i,c), L_mat.at(i+1,c)); }
+    
+    std::swap(perm[i], perm[i+1]);
+    }
+  
+  return (L_max <= growth_limit);
+  }
+
+
+
+//! rank-1 modification L*U + x*y.t() of the stored factors, with pairwise pivoting:
+//! with w = inv(L)*x, the vector w is reduced to a multiple of e_0 from the bottom up, which makes U upper Hessenberg;
+//! after adding the rank-1 term to the first row of U, the subdiagonal of U is eliminated from the top down;
+//! returns false if a pivot becomes zero or the elements of L grow too large
+template<typename eT>
+inline
+bool
+lu_factoriser<eT>::update_worker(Col<eT>& x, const Col<eT>& y)
+  {
+  arma_debug_sigprint();
+  
+  const uword N = L_mat.n_rows;
+  
+  if(N == 0)  { return true; }
+  
+  eT* x_mem = x.memptr();
+  
+  for(uword k=0; k < N; ++k)
+    {
+    const eT x_k = x_mem[k];
+    
+    if(x_k == eT(0))  { continue; }
+    
+    const eT* L_colmem = L_mat.colptr(k);
+    
+    for(uword i=k+1; i < N; ++i)  { x_mem[i] -= L_colmem[i] * x_k; }
+    }
+  
+  for(uword ii=N-1; ii > 0; --ii)
+    {
+    const uword i = ii-1;
+    
+    if(elim_worker(i, x_mem[i], x_mem[i+1], x_mem) == false)  { return false; }
+    
+    x_mem[i+1] = eT(0);
+    }
+  
+  const eT x_0 = x_mem[0];
+  
+  eT* Ut_colmem = Ut_mat.colptr(0);
+  
+  for(uword j=0; j < N; ++j)  { Ut_colmem[j] += x_0 * y[j]; }
+  
+  // U(i+1,i) is stored above the diagonal of Ut
+  
+  for(uword i=0; (i+1) < N; ++i)
+    {
+    if(elim_worker(i, Ut_mat.at(i,i), Ut_mat.at(i,i+1), nullptr) == false)  { return false; }
+    
+    Ut_mat.at(i,i+1) = eT(0);
+    }
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT U_ii = Ut_mat.at(i,i);
+    
+    if( (U_ii == eT(0)) || (arma_isfinite(U_ii) == false) )  { return false; }
+    }
+  
+  return true;
+  }
+
+
+
+//! removal of row and column k from the stored factors:
+//! deleting column k of U leaves it upper Hessenberg from column k onwards, which is restored by pairwise-pivoted elimination;
+//! the last row of U is then zero, so row j of P*A (where perm[j] = k) can be deleted along with row j and the last column of L;
+//! the resulting element above the diagonal in rows j to n-2 of L is removed by column operations, compensated for in the rows of U;
+//! returns false if a pivot becomes zero or the elements of L grow too large
+template<typename eT>
+inline
+bool
+lu_factoriser<eT>::remove_worker(const uword k)
+  {
+  arma_debug_sigprint();
+  
+  const uword N = L_mat.n_rows;
+  
+  if(N == 1)
+    {
+     L_mat.reset();
+    Ut_mat.reset();
+    perm.reset();
+    
+    return true;
+    }
+  
+  Ut_mat.shed_row(k);
+  
+  for(uword i=k; (i+1) < N; ++i)
+    {
+    if(elim_worker(i, Ut_mat.at(i,i), Ut_mat.at(i,i+1), nullptr) == false)  { return false; }
+    
+    Ut_mat.at(i,i+1) = eT(0);
+    }
+  
+  uword j = 0;
+  
+  while(perm[j] != k)  { ++j; }
+  
+   L_mat.shed_row(j);
+   L_mat.shed_col(N-1);
+  Ut_mat.shed_col(N-1);
+  
+  perm.shed_row(j);
+  
+  for(uword i=0; i < (N-1); ++i)  { if(perm[i] > k)  { --perm[i]; } }
+  
+  const uword M = N-1;
+  
+  eT L_max = eT(0);
+  
+  for(uword i=j; i < M; ++i)
+    {
+    eT*  L_i_colmem =  L_mat.colptr(i);
+    eT* Ut_i_colmem = Ut_mat.colptr(i);
+    
+    const eT r_0 = L_i_colmem[i];
+    
+    if( (r_0 == eT(0)) || (arma_isfinite(r_0) == false) )  { return false; }
+    
+    if((i+1) < M)
+      {
+            eT*  L_j_colmem =  L_mat.colptr(i+1);
+      const eT* Ut_j_colmem = Ut_mat.colptr(i+1);
+      
+      const eT r_1 = L_j_colmem[i];
+      const eT m   = r_1 / r_0;
+      
+      for(uword r=i+1; r < M; ++r)
+        {
+        L_j_colmem[r] -= m * L_i_colmem[r];
+        
+        L_max = (std::max)(L_max, std::abs(L_j_colmem[r]));
+        }
+      
+      L_j_colmem[i] = eT(0);
+      
+      for(uword c=i; c < M; ++c)  { Ut_i_colmem[c] = r_0 * Ut_i_colmem[c] + r_1 * Ut_j_colmem[c]; }
+      }
+    else
+      {
+      for(uword c=i; c < M; ++c)  { Ut_i_colmem[c] *= r_0; }
+      }
+    
+    for(uword r=i+1; r < M; ++r)
+      {
+      L_i_colmem[r] /= r_0;
+      
+      L_max = (std::max)(L_max, std::abs(L_i_colmem[r]));
+      }
+    
+    L_i_colmem[i] = eT(1);
+    }
+  
+  if(L_max > growth_limit)  { return false; }
+  
+  for(uword i=0; i < M; ++i)
+    {
+    const eT U_ii = Ut_mat.at(i,i);
+    
+    if( (U_ii == eT(0)) || (arma_isfinite(U_ii) == false) )  { return false; }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1, typename T2>
+inline
+bool
+lu_factoriser<eT>::update(const Base<eT,T1>& u_expr, const Base<eT,T2>& v_expr)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> Uu(u_expr.get_ref());
+  const quasi_unwrap<T2> Uv(v_expr.get_ref());
+  
+  const Mat<eT>& u = Uu.M;
+  const Mat<eT>& v = Uv.M;
+  
+  if(valid == false)  { arma_warn(2, "lu_factoriser::update(): no factorisation available"); return false; }
+  
+  const uword N = A_mat.n_rows;
+  
+  if( (u.is_vec() == false) || (v.is_vec() == false) || (u.n_elem != N) || (v.n_elem != N) )  { arma_warn(1, "lu_factoriser::update(): size mismatch"); return false; }
+  
+  for(uword j=0; j < N; ++j)
+    {
+    const eT v_j = v[j];
+    
+    eT* A_colmem = A_mat.colptr(j);
+    
+    for(uword i=0; i < N; ++i)  { A_colmem[i] += u[i] * v_j; }
+    }
+  
+  // P*(A + u*v.t()) = L*U + (P*u)*v.t()
+  
+  Col<eT> x(N, arma_nozeros_indicator());
+  Col<eT> y(N, arma_nozeros_indicator());
+  
+  for(uword i=0; i < N; ++i)  { x[i] = u[ perm[i] ]; y[i] = v[i]; }
+  
+  recomputed = false;
+  
+  if(update_worker(x, y) == false)
+    {
+    recomputed = true;
+    
+    if(factorise_worker() == false)
+      {
+      arma_warn(3, "lu_factoriser::update(): updated matrix is singular");
+      reset();
+      return false;
+      }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1, typename T2>
+inline
+bool
+lu_factoriser<eT>::append(const Base<eT,T1>& c_expr, const Base<eT,T2>& r_expr)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> Uc(c_expr.get_ref());
+  const quasi_unwrap<T2> Ur(r_expr.get_ref());
+  
+  const Mat<eT>& c = Uc.M;
+  const Mat<eT>& r = Ur.M;
+  
+  if(valid == false)  { arma_warn(2, "lu_factoriser::append(): no factorisation available"); return false; }
+  
+  const uword N = A_mat.n_rows;
+  
+  if( (c.is_vec() == false) || (c.n_elem != (N+1)) || ((r.is_vec() == false) && (N > 0)) || (r.n_elem != N) )  { arma_warn(1, "lu_factoriser::append(): size mismatch"); return false; }
+  
+  A_mat.resize(N+1, N+1);
+  
+  for(uword i=0; i <= N; ++i)  { A_mat.at(i,N) = c[i]; }
+  for(uword j=0; j <  N; ++j)  { A_mat.at(N,j) = r[j]; }
+  
+  // with P*A = L*U, the extended factors are [L 0; l.t() 1] and [U u; 0 d],
+  // where L*u = P*c(0:N-1), U.t()*l = r.t() and d = c(N) - dot(l,u)
+  
+  Mat<eT> u(N, 1, arma_nozeros_indicator());
+  Mat<eT> l(N, 1, arma_nozeros_indicator());
+  
+  for(uword i=0; i < N; ++i)  { u[i] = c[ perm[i] ]; l[i] = r[i]; }
+  
+  bool status =           auxlib::solve_trimat_inplace(u,  L_mat, N, 1, false, true );
+  status      = status && auxlib::solve_trimat_inplace(l, Ut_mat, N, 1, false, false);
+  
+  const eT d = c[N] - dot(l, u);
+  
+  status = status && (d != eT(0)) && arma_isfinite(d) && (N == 0 || (max(abs(vectorise(l))) <= growth_limit));
+  
+  if(status)
+    {
+     L_mat.resize(N+1, N+1);
+    Ut_mat.resize(N+1, N+1);
+    
+    for(uword i=0; i < N; ++i)  { L_mat.at(N,i) = l[i]; Ut_mat.at(N,i) = u[i]; }
+    
+     L_mat.at(N,N) = eT(1);
+    Ut_mat.at(N,N) = d;
+    
+    perm.resize(N+1);
+    
+    perm[N] = N;
+    }
+  else
+    {
+    // bordering is unstable without pivoting; instead use
+    // [A c; r d] = [A 0; 0 1] + [c(0:N-1); 0]*e_N.t() + e_N*[r, d-1]
+    // and apply the two rank-1 modifications with pairwise pivoting
+    
+     L_mat.resize(N+1, N+1);
+    Ut_mat.resize(N+1, N+1);
+    
+     L_mat.at(N,N) = eT(1);
+    Ut_mat.at(N,N) = eT(1);
+    
+    perm.resize(N+1);
+    
+    perm[N] = N;
+    
+    Col<eT> x(N+1);
+    Col<eT> y(N+1);
+    
+    for(uword i=0; i < N; ++i)  { x[i] = c[ perm[i] ]; }
+    
+    y[N] = eT(1);
+    
+    status = update_worker(x, y);
+    
+    if(status)
+      {
+      for(uword i=0; i <= N; ++i)  { x[i] = (perm[i] == N) ? eT(1) : eT(0); }
+      for(uword j=0; j <  N; ++j)  { y[j] = r[j]; }
+      
+      y[N] = c[N] - eT(1);
+      
+      status = update_worker(x, y);
+      }
+    
+    if(status == false)
+      {
+      if(factorise_worker() == false)
+        {
+        arma_warn(3, "lu_factoriser::append(): extended matrix is singular");
+        reset();
+        return false;
+        }
+      }
+    }
+  
+  recomputed = (status == false);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+lu_factoriser<eT>::remove(const uword k)
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)  { arma_warn(2, "lu_factoriser::remove(): no factorisation available"); return false; }
+  
+  arma_conform_check_bounds( (k >= A_mat.n_rows), "lu_factoriser::remove(): index out of bounds" );
+  
+  A_mat.shed_col(k);
+  A_mat.shed_row(k);
+  
+  recomputed = (remove_worker(k) == false);
+  
+  if(recomputed)
+    {
+    if(factorise_worker() == false)
+      {
+      arma_warn(3, "lu_factoriser::remove(): reduced matrix is singular");
+      reset();
+      return false;
+      }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+lu_factoriser<eT>::solve(Mat<eT>& X, const Base<eT,T1>& B_expr) const
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)
+    {
+    arma_warn(2, "lu_factoriser::solve(): no factorisation available");
+    X.soft_reset();
+    return false;
+    }
+  
+  const quasi_unwrap<T1> U(B_expr.get_ref());
+  
+  const Mat<eT>& B = U.M;
+  
+  const uword N = A_mat.n_rows;
+  
+  if(B.n_rows != N)
+    {
+    arma_warn(1, "lu_factoriser::solve(): matrix size mismatch");
+    X.soft_reset();
+    return false;
+    }
+  
+  Mat<eT> tmp = B.rows(perm);
+  
+  bool status =           auxlib::solve_trimat_inplace(tmp,  L_mat, N, 1, false, true );
+  status      = status && auxlib::solve_trimat_inplace(tmp, Ut_mat, N, 1, true,  false);
+  
+  if(status == false)  { X.soft_reset(); return false; }
+  
+  X.steal_mem(tmp);
+  
+  return true;
+  }
+
+
+
+//! estimate of the reciprocal condition number of A (1-norm)
+template<typename eT>
+inline
+eT
+lu_factoriser<eT>::rcond() const
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)  { return eT(0); }
+  
+  if(A_mat.is_empty())  { return Datum<eT>::inf; }
+  
+  // gecon() requires L and U in the same matrix
+  
+  Mat<eT> LU = trans(Ut_mat);
+  
+  const uword N = LU.n_rows;
+  
+  for(uword col=0; col < N; ++col)
+    {
+    const eT*  L_colmem = L_mat.colptr(col);
+          eT* LU_colmem =    LU.colptr(col);
+    
+    for(uword row=col+1; row < N; ++row)  { LU_colmem[row] = L_colmem[row]; }
+    }
+  
+  const eT norm_val = norm(A_mat, 1);
+  
+  return auxlib::lu_rcond(LU, norm_val);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+lu_factoriser<eT>::was_recomputed() const
+  {
+  return recomputed;
+  }
+
+
+
+//! @}
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup matfree_op
+//! @{
+
+
+
+//! indicates that the transposed product is not available
+struct matfree_none
+  {
+  template<typename eT>
+  inline void operator()(const Mat<eT>& X, Mat<eT>& Y) const;
+  };
+
+
+
+//! linear operator defined by user-supplied functions, instead of by stored elements;
+//! fn(X,Y) must set Y = A*X, and fn_t(X,Y) must set Y = A.t()*X, where X and Y can have several columns
+template<typename eT, typename fn_type, typename fn_t_type>
+class matfree_op
+  {
+  public:
+  
+  typedef eT                                elem_type;
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  static constexpr bool has_trans = is_same_type<fn_t_type, matfree_none>::no;
+  
+  const uword n_rows;
+  const uword n_cols;
+  
+  inline matfree_op(const uword in_n_rows, const uword in_n_cols, const fn_type& in_fn, const fn_t_type& in_fn_t);
+  
+  inline void apply  (Mat<eT>& Y, const Mat<eT>& X) const;  //!< Y = A * X
+  inline void apply_t(Mat<eT>& Y, const Mat<eT>& X) const;  //!< Y = A.t() * X
+  
+  inline bool is_square() const { return (n_rows == n_cols); }
+  
+  
+  private:
+  
+  const fn_type   fn;
+  const fn_t_type fn_t;
+  };
+
+
+
+//! @}
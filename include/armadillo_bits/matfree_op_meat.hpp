@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup matfree_op
+//! @{
+
+
+
+template<typename eT>
+inline
+void
+matfree_none::operator()(const Mat<eT>& X, Mat<eT>& Y) const
+  {
+  arma_ignore(X);
+  arma_ignore(Y);
+  
+  arma_stop_logic_error("matfree_op: product with the transpose of the operator is not given");
+  }
+
+
+
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+matfree_op<eT, fn_type, fn_t_type>::matfree_op(const uword in_n_rows, const uword in_n_cols, const fn_type& in_fn, const fn_t_type& in_fn_t)
+  : n_rows(in_n_rows)
+  , n_cols(in_n_cols)
+  , fn    (in_fn    )
+  , fn_t  (in_fn_t  )
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+void
+matfree_op<eT, fn_type, fn_t_type>::apply(Mat<eT>& Y, const Mat<eT>& X) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( (X.n_rows != n_cols), "matfree_op: incompatible matrix dimensions" );
+  
+  // Y may be using external memory, in which case it already has the required size
+  
+  Y.set_size(n_rows, X.n_cols);
+  
+  fn(X, Y);
+  
+  arma_conform_check( ((Y.n_rows != n_rows) || (Y.n_cols != X.n_cols)), "matfree_op: given function produced a matrix with incorrect size" );
+  }
+
+
+
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+void
+matfree_op<eT, fn_type, fn_t_type>::apply_t(Mat<eT>& Y, const Mat<eT>& X) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( (X.n_rows != n_rows), "matfree_op: incompatible matrix dimensions" );
+  
+  Y.set_size(n_cols, X.n_cols);
+  
+  fn_t(X, Y);
+  
+  arma_conform_check( ((Y.n_rows != n_cols) || (Y.n_cols != X.n_cols)), "matfree_op: given function produced a matrix with incorrect size" );
+  }
+
+
+
+//! @}
@@ -28,9 +28,17 @@ class memory
   
   template<typename eT> arma_inline static void release(eT* mem);
   
+  arma_malloc inline static void* acquire_raw(const size_t n_bytes);
+              inline static void  release_raw(void* mem);
+  
   template<typename eT> arma_inline static bool      is_aligned(const eT*  mem);
   template<typename eT> arma_inline static void mark_as_aligned(      eT*& mem);
   template<typename eT> arma_inline static void mark_as_aligned(const eT*& mem);
+  
+  template<typename eT> arma_inline static bool      is_aligned_large(const eT*  mem);
+  template<typename eT> arma_inline static void mark_as_aligned_large(      eT*& mem);
+  
+  static constexpr size_t hugepage_size = size_t(2) * size_t(1024) * size_t(1024);
   };
 
 
@@ -49,92 +57,134 @@ memory::acquire(const uword n_elem)
     "arma::memory::acquire(): requested size is too large"
     );
   
-  eT* out_memptr;
+  #if defined(ARMA_USE_ARENA_ALLOC)
+    eT* out_memptr = (eT *) arena_pool::acquire(sizeof(eT)*size_t(n_elem));
+  #else
+    eT* out_memptr = (eT *) memory::acquire_raw(sizeof(eT)*size_t(n_elem));
+  #endif
+  
+  arma_check_bad_alloc( (out_memptr == nullptr), "arma::memory::acquire(): out of memory" );
+  
+  return out_memptr;
+  }
+
+
+
+template<typename eT>
+arma_inline
+void
+memory::release(eT* mem)
+  {
+  if(mem == nullptr)  { return; }
+  
+  #if defined(ARMA_USE_ARENA_ALLOC)
+    arena_pool::release( (void *)(mem) );
+  #else
+    memory::release_raw( (void *)(mem) );
+  #endif
+  }
+
+
+
+arma_malloc
+inline
+void*
+memory::acquire_raw(const size_t n_bytes)
+  {
+  void* out_memptr;
   
   #if   defined(ARMA_ALIEN_MEM_ALLOC_FUNCTION)
     {
-    out_memptr = (eT *) ARMA_ALIEN_MEM_ALLOC_FUNCTION(sizeof(eT)*n_elem);
+    out_memptr = (void *) ARMA_ALIEN_MEM_ALLOC_FUNCTION(n_bytes);
     }
   #elif defined(ARMA_USE_TBB_ALLOC)
     {
-    out_memptr = (eT *) scalable_malloc(sizeof(eT)*n_elem);
+    out_memptr = (void *) scalable_malloc(n_bytes);
     }
   #elif defined(ARMA_USE_MKL_ALLOC)
     {
-    out_memptr = (eT *) mkl_malloc( sizeof(eT)*n_elem, 32 );
+    out_memptr = (void *) mkl_malloc( n_bytes, ( (arma_config::mem_align > 32) ? int(arma_config::mem_align) : int(32) ) );
     }
   #elif defined(ARMA_HAVE_POSIX_MEMALIGN)
     {
-    eT* memptr = nullptr;
+    void* memptr = nullptr;
     
-    const size_t n_bytes   = sizeof(eT)*size_t(n_elem);
-    const size_t alignment = (n_bytes >= size_t(1024)) ? size_t(32) : size_t(16);
+    const bool use_hugepage = (arma_config::mem_hugepage_threshold > 0) && (n_bytes >= size_t(arma_config::mem_hugepage_threshold));
     
-    // TODO: investigate apparent memory leak when using alignment >= 64 (as shown on Fedora 28, glibc 2.27)
+    const size_t alignment = (use_hugepage) ? memory::hugepage_size : ( (n_bytes >= size_t(1024)) ? size_t(arma_config::mem_align) : size_t(16) );
+    
+    // NOTE: an apparent memory leak when using alignment >= 64 was observed on Fedora 28 (glibc 2.27);
+    // NOTE: hence alignment >= 64 is only used when explicitly requested via ARMA_MEM_ALIGNMENT or ARMA_MEM_HUGEPAGE_THRESHOLD
     int status = posix_memalign((void **)&memptr, ( (alignment >= sizeof(void*)) ? alignment : sizeof(void*) ), n_bytes);
     
     out_memptr = (status == 0) ? memptr : nullptr;
+    
+    #if defined(MADV_HUGEPAGE)
+      {
+      if(use_hugepage && (out_memptr != nullptr))
+        {
+        // madvise() requires the length to be a multiple of the page size; failure is not an error, as the advice is only a hint
+        const size_t n_bytes_advise = n_bytes - (n_bytes % memory::hugepage_size);
+        
+        if(n_bytes_advise > 0)  { madvise(out_memptr, n_bytes_advise, MADV_HUGEPAGE); }
+        }
+      }
+    #endif
     }
   #elif defined(_MSC_VER)
     {
     // Windoze is too primitive to handle C++17 std::aligned_alloc()
     
-    //out_memptr = (eT *) malloc(sizeof(eT)*n_elem);
-    //out_memptr = (eT *) _aligned_malloc( sizeof(eT)*n_elem, 16 );  // lives in malloc.h
+    //out_memptr = malloc(n_bytes);
+    //out_memptr = _aligned_malloc( n_bytes, 16 );  // lives in malloc.h
     
-    const size_t n_bytes   = sizeof(eT)*size_t(n_elem);
-    const size_t alignment = (n_bytes >= size_t(1024)) ? size_t(32) : size_t(16);
+    const size_t alignment = (n_bytes >= size_t(1024)) ? size_t(arma_config::mem_align) : size_t(16);
     
-    out_memptr = (eT *) _aligned_malloc( n_bytes, alignment );
+    out_memptr = (void *) _aligned_malloc( n_bytes, alignment );
     }
   #else
     {
     //return ( new(std::nothrow) eT[n_elem] );
-    out_memptr = (eT *) malloc(sizeof(eT)*n_elem);
+    out_memptr = (void *) malloc(n_bytes);
     }
   #endif
   
   // TODO: for mingw, use __mingw_aligned_malloc
   
-  arma_check_bad_alloc( (out_memptr == nullptr), "arma::memory::acquire(): out of memory" );
-  
   return out_memptr;
   }
 
 
 
-template<typename eT>
-arma_inline
+inline
 void
-memory::release(eT* mem)
+memory::release_raw(void* mem)
   {
-  if(mem == nullptr)  { return; }
-  
   #if   defined(ARMA_ALIEN_MEM_FREE_FUNCTION)
     {
-    ARMA_ALIEN_MEM_FREE_FUNCTION( (void *)(mem) );
+    ARMA_ALIEN_MEM_FREE_FUNCTION(mem);
     }
   #elif defined(ARMA_USE_TBB_ALLOC)
     {
-    scalable_free( (void *)(mem) );
+    scalable_free(mem);
     }
   #elif defined(ARMA_USE_MKL_ALLOC)
     {
-    mkl_free( (void *)(mem) );
+    mkl_free(mem);
     }
   #elif defined(ARMA_HAVE_POSIX_MEMALIGN)
     {
-    free( (void *)(mem) );
+    free(mem);
     }
   #elif defined(_MSC_VER)
     {
-    //free( (void *)(mem) );
-    _aligned_free( (void *)(mem) );
+    //free(mem);
+    _aligned_free(mem);
     }
   #else
     {
     //delete [] mem;
-    free( (void *)(mem) );
+    free(mem);
     }
   #endif
   
@@ -207,4 +257,48 @@ memory::mark_as_aligned(const eT*& mem)
 
 
 
+template<typename eT>
+arma_inline
+bool
+memory::is_aligned_large(const eT* mem)
+  {
+  #if (defined(ARMA_HAVE_GCC_ASSUME_ALIGNED) || defined(__cpp_lib_assume_aligned)) && !defined(ARMA_DONT_CHECK_ALIGNMENT)
+    {
+    return (sizeof(std::size_t) >= sizeof(eT*)) ? ((std::size_t(mem) & std::size_t(arma_config::mem_align - 1)) == 0) : false;
+    }
+  #else
+    {
+    arma_ignore(mem);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! mark memory as having the alignment used for large blocks (see ARMA_MEM_ALIGNMENT);
+//! only valid after is_aligned_large() returned true
+template<typename eT>
+arma_inline
+void
+memory::mark_as_aligned_large(eT*& mem)
+  {
+  #if defined(ARMA_HAVE_GCC_ASSUME_ALIGNED)
+    {
+    mem = (eT*)__builtin_assume_aligned(mem, arma_config::mem_align);
+    }
+  #elif defined(__cpp_lib_assume_aligned)
+    {
+    mem = (eT*)std::assume_aligned<arma_config::mem_align>(mem);
+    }
+  #else
+    {
+    arma_ignore(mem);
+    }
+  #endif
+  }
+
+
+
 //! @}
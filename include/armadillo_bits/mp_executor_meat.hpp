@@ -0,0 +1,451 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup mp_misc
+//! @{
+
+
+
+#if defined(ARMA_USE_MP_EXECUTOR)
+
+inline
+mp_pool::job_type::job_type(const task_type& in_task, const uword in_n_tasks)
+  : task     (&in_task  )
+  , n_tasks  (in_n_tasks)
+  , next_task(0         )
+  , n_tickets(0         )
+  , failed   (false     )
+  {
+  }
+
+
+
+inline
+void
+mp_pool::job_type::work()
+  {
+  while(true)
+    {
+    const uword task_id = next_task.fetch_add(1);
+    
+    if(task_id >= n_tasks)  { return; }
+    
+    if(failed.load())  { continue; }
+    
+    try
+      {
+      (*task)(task_id);
+      }
+    catch(...)
+      {
+      const std::lock_guard<std::mutex> lock(error_mutex);
+      
+      if(failed.load() == false)  { error = std::current_exception(); failed.store(true); }
+      }
+    }
+  }
+
+
+
+inline
+mp_pool::~mp_pool()
+  {
+  arma_debug_sigprint_this(this);
+  
+    {
+    const std::lock_guard<std::mutex> lock(sleep_mutex);
+    
+    stop = true;
+    }
+  
+  sleep_cv.notify_all();
+  
+  for(uword i=0; i < workers.size(); ++i)  { workers[i].join(); }
+  }
+
+
+
+inline
+mp_pool::mp_pool(const uword in_n_workers)
+  : n_workers (in_n_workers                        )
+  , queues    (new queue_type[in_n_workers + 1]    )
+  , n_queued  (0                                   )
+  , next_queue(0                                   )
+  {
+  arma_debug_sigprint_this(this);
+  
+  // queue n_workers is used by threads which are not part of the pool
+  
+  workers.reserve(n_workers);
+  
+  for(uword i=0; i < n_workers; ++i)
+    {
+    workers.push_back( std::thread( [this,i]() { (*this).worker_loop(i); } ) );
+    }
+  }
+
+
+
+inline
+uword
+mp_pool::get_n_workers() const
+  {
+  return n_workers;
+  }
+
+
+
+inline
+bool
+mp_pool::try_execute(const uword first_queue)
+  {
+  if(n_queued.load() == 0)  { return false; }
+  
+  const uword n_queues = n_workers + 1;
+  
+  for(uword count=0; count < n_queues; ++count)
+    {
+    const uword queue_id = (first_queue + count) % n_queues;
+    
+    queue_type& queue = queues[queue_id];
+    
+    job_type* job = nullptr;
+    
+      {
+      const std::lock_guard<std::mutex> lock(queue.queue_mutex);
+      
+      if(queue.tickets.empty() == false)
+        {
+        // take from the front of our own queue, and steal from the back of other queues
+        
+        if(count == 0)  { job = queue.tickets.front(); queue.tickets.pop_front(); }
+        else            { job = queue.tickets.back();  queue.tickets.pop_back();  }
+        
+        n_queued.fetch_sub(1);
+        }
+      }
+    
+    if(job != nullptr)
+      {
+      (*job).work();
+      
+      (*job).n_tickets.fetch_sub(1);
+      
+      return true;
+      }
+    }
+  
+  return false;
+  }
+
+
+
+inline
+void
+mp_pool::remove_tickets(job_type* job)
+  {
+  const uword n_queues = n_workers + 1;
+  
+  for(uword queue_id=0; queue_id < n_queues; ++queue_id)
+    {
+    queue_type& queue = queues[queue_id];
+    
+    const std::lock_guard<std::mutex> lock(queue.queue_mutex);
+    
+    const uword n_before = uword(queue.tickets.size());
+    
+    queue.tickets.erase( std::remove(queue.tickets.begin(), queue.tickets.end(), job), queue.tickets.end() );
+    
+    const uword n_removed = n_before - uword(queue.tickets.size());
+    
+    if(n_removed > 0)
+      {
+      n_queued.fetch_sub(n_removed);
+      
+      (*job).n_tickets.fetch_sub(n_removed);
+      }
+    }
+  }
+
+
+
+inline
+void
+mp_pool::worker_loop(const uword worker_id)
+  {
+  while(true)
+    {
+    if( (*this).try_execute(worker_id) )  { continue; }
+    
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    
+    sleep_cv.wait(lock, [this]() { return (stop || (n_queued.load() > 0)); });
+    
+    if(stop && (n_queued.load() == 0))  { return; }
+    }
+  }
+
+
+
+inline
+void
+mp_pool::run(const uword n_tasks, const task_type& task)
+  {
+  arma_debug_sigprint();
+  
+  if(n_tasks == 0)  { return; }
+  
+  if( (n_tasks == 1) || (n_workers == 0) )
+    {
+    for(uword task_id=0; task_id < n_tasks; ++task_id)  { task(task_id); }
+    
+    return;
+    }
+  
+  job_type job(task, n_tasks);
+  
+  // the calling thread also works on the job, hence one ticket less than the number of tasks is sufficient
+  
+  const uword n_tickets = (std::min)(n_tasks - 1, n_workers);
+  
+  job.n_tickets.store(n_tickets);
+  
+  for(uword i=0; i < n_tickets; ++i)
+    {
+    queue_type& queue = queues[ next_queue.fetch_add(1) % n_workers ];
+    
+    const std::lock_guard<std::mutex> lock(queue.queue_mutex);
+    
+    queue.tickets.push_back(&job);
+    
+    n_queued.fetch_add(1);
+    }
+  
+    {
+    const std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+  
+  sleep_cv.notify_all();
+  
+  job.work();
+  
+  // all tasks have been claimed; tickets which have not been picked up are no longer needed
+  
+  (*this).remove_tickets(&job);
+  
+  // wait for tasks still being executed by other threads, while helping with other jobs
+  
+  while(job.n_tickets.load() > 0)
+    {
+    if( (*this).try_execute(n_workers) == false )  { std::this_thread::yield(); }
+    }
+  
+  if(job.failed.load())  { std::rethrow_exception(job.error); }
+  }
+
+#endif
+
+
+
+//
+
+
+
+inline
+mp_executor::state_type&
+mp_executor::get_state()
+  {
+  static state_type state;
+  
+  return state;
+  }
+
+
+
+#if defined(ARMA_USE_MP_EXECUTOR)
+
+//! replace the active worker; calls to run() which are in flight keep using the previous worker until they finish;
+//! state_mutex serialises concurrent calls to set_worker(), while run() only loads the worker atomically
+inline
+void
+mp_executor::set_worker(const std::shared_ptr<const worker_type>& new_worker, const uword n_threads)
+  {
+  arma_debug_sigprint();
+  
+  state_type& state = mp_executor::get_state();
+  
+  std::shared_ptr<const worker_type> old_worker;
+  
+    {
+    const std::lock_guard<std::mutex> lock(state.state_mutex);
+    
+    old_worker = std::atomic_load(&(state.worker));
+    
+    std::atomic_store(&(state.worker), new_worker);
+    
+    state.n_threads.store( (new_worker) ? (std::max)(uword(1), n_threads) : uword(1) );
+    
+    state.active.store(bool(new_worker));
+    }
+  
+  // if not in use by run(), the previous worker (and its thread pool) is destroyed here, outside of the lock
+  }
+
+#endif
+
+
+
+//! use the given function to run tasks;
+//! fn(n_tasks, task) must call task(i) for each i in [0, n_tasks) and return once all calls have finished;
+//! n_threads is the number of threads the function is expected to use
+inline
+void
+mp_executor::set(const function_type& fn, const uword n_threads)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    {
+    std::shared_ptr<worker_type> new_worker;
+    
+    if(fn)
+      {
+      new_worker = std::make_shared<worker_type>();
+      
+      new_worker->fn = fn;
+      }
+    
+    mp_executor::set_worker(new_worker, n_threads);
+    }
+  #else
+    {
+    arma_ignore(fn);
+    arma_ignore(n_threads);
+    
+    arma_stop_logic_error("mp_executor::set(): use of ARMA_USE_MP_EXECUTOR must be enabled");
+    }
+  #endif
+  }
+
+
+
+//! use the built-in work-stealing thread pool to run tasks;
+//! n_threads includes the calling thread; n_threads = 0 indicates std::thread::hardware_concurrency()
+inline
+void
+mp_executor::set_pool(const uword n_threads)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    {
+    const uword n_threads_hw  = uword(std::thread::hardware_concurrency());
+    const uword n_threads_use = (n_threads > 0) ? n_threads : ( (n_threads_hw > 0) ? n_threads_hw : uword(1) );
+    
+    std::shared_ptr<worker_type> new_worker = std::make_shared<worker_type>();
+    
+    new_worker->pool.reset( new mp_pool(n_threads_use - 1) );
+    
+    mp_pool* pool_ptr = new_worker->pool.get();
+    
+    new_worker->fn = [pool_ptr](const uword n_tasks, const std::function<void(const uword)>& task) { (*pool_ptr).run(n_tasks, task); };
+    
+    mp_executor::set_worker(new_worker, n_threads_use);
+    }
+  #else
+    {
+    arma_ignore(n_threads);
+    
+    arma_stop_logic_error("mp_executor::set_pool(): use of ARMA_USE_MP_EXECUTOR must be enabled");
+    }
+  #endif
+  }
+
+
+
+//! revert to parallelisation via OpenMP (if enabled)
+inline
+void
+mp_executor::reset()
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    {
+    mp_executor::set_worker(std::shared_ptr<const worker_type>(), uword(1));
+    }
+  #endif
+  }
+
+
+
+inline
+bool
+mp_executor::is_active()
+  {
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    {
+    return mp_executor::get_state().active.load(std::memory_order_relaxed);
+    }
+  #else
+    {
+    return false;
+    }
+  #endif
+  }
+
+
+
+inline
+uword
+mp_executor::get_n_threads()
+  {
+  return mp_executor::get_state().n_threads.load(std::memory_order_relaxed);
+  }
+
+
+
+inline
+void
+mp_executor::run(const uword n_tasks, const std::function<void(const uword)>& task)
+  {
+  arma_debug_sigprint();
+  
+  if(n_tasks == 0)  { return; }
+  
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    {
+    if( (n_tasks > 1) && mp_executor::is_active() )
+      {
+      state_type& state = mp_executor::get_state();
+      
+      // the worker is published atomically, so concurrent calls to run() don't contend for state_mutex
+      const std::shared_ptr<const worker_type> local_worker = std::atomic_load(&(state.worker));
+      
+      if(local_worker)  { (*local_worker).fn(n_tasks, task); return; }
+      }
+    }
+  #endif
+  
+  for(uword task_id=0; task_id < n_tasks; ++task_id)  { task(task_id); }
+  }
+
+
+
+//! @}
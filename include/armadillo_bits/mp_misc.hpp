@@ -22,24 +22,234 @@
 
 
 
-template<typename eT, const bool use_smaller_thresh = false>
+#if defined(ARMA_USE_MP_EXECUTOR)
+
+//! work-stealing thread pool;
+//! each call to run() splits the work into tickets which are distributed over per-worker queues;
+//! idle workers steal tickets from the queues of other workers,
+//! and threads waiting for a job to finish execute tickets of other jobs,
+//! so that nested calls to run() can be parallelised without creating additional threads
+class mp_pool
+  {
+  public:
+  
+  typedef std::function<void(const uword)> task_type;
+  
+  struct job_type
+    {
+    const task_type*   task;
+    uword              n_tasks;
+    std::atomic<uword> next_task;
+    std::atomic<uword> n_tickets;      // number of tickets that are queued or being executed
+    std::atomic<bool>  failed;
+    std::exception_ptr error;
+    std::mutex         error_mutex;
+    
+    inline job_type(const task_type& in_task, const uword in_n_tasks);
+    
+    inline void work();
+    };
+  
+  inline ~mp_pool();
+  inline explicit mp_pool(const uword in_n_workers);
+  
+  inline uword get_n_workers() const;
+  
+  inline void run(const uword n_tasks, const task_type& task);
+  
+  inline      mp_pool(const mp_pool&) = delete;
+  inline void operator=(const mp_pool&) = delete;
+  
+  
+  private:
+  
+  struct queue_type
+    {
+    std::mutex            queue_mutex;
+    std::deque<job_type*> tickets;
+    };
+  
+  uword n_workers = 0;
+  
+  std::vector<std::thread>      workers;
+  std::unique_ptr<queue_type[]> queues;
+  
+  std::atomic<uword> n_queued;
+  std::atomic<uword> next_queue;
+  
+  std::mutex              sleep_mutex;
+  std::condition_variable sleep_cv;
+  bool                    stop = false;
+  
+  inline bool try_execute(const uword first_queue);
+  inline void remove_tickets(job_type* job);
+  inline void worker_loop(const uword worker_id);
+  };
+
+#endif
+
+
+
+//! user-selectable alternative to OpenMP for parallelising element-wise operations, accu(), Cube::each_slice(), gmm_diag and gmm_full;
+//! work is submitted as a set of independent tasks, either to a built-in work-stealing thread pool or to a user-supplied function
+class mp_executor
+  {
+  public:
+  
+  typedef std::function< void(const uword n_tasks, const std::function<void(const uword)>& task) > function_type;
+  
+  inline static void set(const function_type& fn, const uword n_threads);
+  inline static void set_pool(const uword n_threads = 0);
+  inline static void reset();
+  
+  inline static bool  is_active();
+  inline static uword get_n_threads();
+  
+  inline static void run(const uword n_tasks, const std::function<void(const uword)>& task);
+  
+  
+  private:
+  
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    struct worker_type
+      {
+      function_type            fn;
+      std::unique_ptr<mp_pool> pool;
+      };
+  #endif
+  
+  struct state_type
+    {
+    std::atomic<bool>  active;
+    std::atomic<uword> n_threads;
+    
+    #if defined(ARMA_USE_MP_EXECUTOR)
+      std::mutex                         state_mutex;  // serialises replacement of the worker
+      std::shared_ptr<const worker_type> worker;       // accessed via std::atomic_load() and std::atomic_store(); each call to run() holds its own reference, so a worker replaced by set() or reset() outlives the calls using it
+    #endif
+    
+    inline state_type() : active(false), n_threads(1) {}
+    };
+  
+  inline static state_type& get_state();
+  
+  #if defined(ARMA_USE_MP_EXECUTOR)
+    inline static void set_worker(const std::shared_ptr<const worker_type>& new_worker, const uword n_threads);
+  #endif
+  };
+
+
+
+//! classes of per-element cost of element-wise operations;
+//! each class has its own minimum number of elements for parallelisation
+struct mp_op_cost
+  {
+  static constexpr uword cheap    = 0;  //!< eg. addition, multiplication by scalar, abs()
+  static constexpr uword moderate = 1;  //!< eg. sqrt(), pow()
+  static constexpr uword heavy    = 2;  //!< eg. exp(), log(), sin(), erf()
+  
+  template<const uword cost>
+  struct threshold
+    {
+    static constexpr uword value = (cost == heavy) ? arma_config::mp_threshold_heavy : ( (cost == cheap) ? arma_config::mp_threshold_cheap : arma_config::mp_threshold );
+    };
+  };
+
+
+
+//! cost class of an element-wise expression, determined by its most expensive operation;
+//! expressions which are not handled by eop_core or eglue_core are regarded as cheap;
+//! within eOp and eGlue expressions, parallelisable sub-expressions are regarded as at least moderate
+template<typename T>
+struct mp_expr_cost
+  {
+  static constexpr uword value = mp_op_cost::cheap;
+  };
+
+
+template<typename T1, typename eop_type>
+struct mp_expr_cost< eOp<T1, eop_type> >
+  {
+  static constexpr uword cost_a = (eop_type::mp_cost > mp_expr_cost<T1>::value) ? eop_type::mp_cost : mp_expr_cost<T1>::value;
+  static constexpr uword cost_b = (eOp<T1, eop_type>::use_mp) ? mp_op_cost::moderate : mp_op_cost::cheap;
+  
+  static constexpr uword value  = (cost_a > cost_b) ? cost_a : cost_b;
+  };
+
+
+template<typename T1, typename T2, typename eglue_type>
+struct mp_expr_cost< eGlue<T1, T2, eglue_type> >
+  {
+  static constexpr uword cost_a = (mp_expr_cost<T1>::value > mp_expr_cost<T2>::value) ? mp_expr_cost<T1>::value : mp_expr_cost<T2>::value;
+  static constexpr uword cost_b = (eGlue<T1, T2, eglue_type>::use_mp) ? mp_op_cost::moderate : mp_op_cost::cheap;
+  
+  static constexpr uword value  = (cost_a > cost_b) ? cost_a : cost_b;
+  };
+
+
+template<typename T1, typename eop_type>
+struct mp_expr_cost< eOpCube<T1, eop_type> >
+  {
+  static constexpr uword cost_a = (eop_type::mp_cost > mp_expr_cost<T1>::value) ? eop_type::mp_cost : mp_expr_cost<T1>::value;
+  static constexpr uword cost_b = (eOpCube<T1, eop_type>::use_mp) ? mp_op_cost::moderate : mp_op_cost::cheap;
+  
+  static constexpr uword value  = (cost_a > cost_b) ? cost_a : cost_b;
+  };
+
+
+template<typename T1, typename T2, typename eglue_type>
+struct mp_expr_cost< eGlueCube<T1, T2, eglue_type> >
+  {
+  static constexpr uword cost_a = (mp_expr_cost<T1>::value > mp_expr_cost<T2>::value) ? mp_expr_cost<T1>::value : mp_expr_cost<T2>::value;
+  static constexpr uword cost_b = (eGlueCube<T1, T2, eglue_type>::use_mp) ? mp_op_cost::moderate : mp_op_cost::cheap;
+  
+  static constexpr uword value  = (cost_a > cost_b) ? cost_a : cost_b;
+  };
+
+
+
+//! cost class of an expression which is known to be marked as parallelisable
+template<typename T>
+struct mp_expr_cost_mp
+  {
+  static constexpr uword value = (mp_expr_cost<T>::value > mp_op_cost::moderate) ? mp_expr_cost<T>::value : mp_op_cost::moderate;
+  };
+
+
+
+template<typename eT, const bool use_smaller_thresh = false, const uword cost = mp_op_cost::moderate>
 struct mp_gate
   {
   arma_inline
   static
   bool
+  length_ok(const uword n_elem)
+    {
+    constexpr uword threshold = mp_op_cost::threshold<cost>::value;
+    
+    // a zero threshold indicates that parallelisation is disabled for the given cost class
+    if(threshold == 0)  { return false; }
+    
+    return (is_cx<eT>::yes || use_smaller_thresh) ? (n_elem >= (threshold/uword(2))) : (n_elem >= threshold);
+    }
+  
+  
+  //! for code which is parallelised directly via OpenMP
+  arma_inline
+  static
+  bool
   eval(const uword n_elem)
     {
     #if defined(ARMA_USE_OPENMP)
       {
-      const bool length_ok = (is_cx<eT>::yes || use_smaller_thresh) ? (n_elem >= (arma_config::mp_threshold/uword(2))) : (n_elem >= arma_config::mp_threshold);
+      const bool status = length_ok(n_elem);
       
-      if(length_ok)
+      if(status)
         {
         if(omp_in_parallel())  { return false; }
         }
       
-      return length_ok;
+      return status;
       }
     #else
       {
@@ -49,12 +259,26 @@ struct mp_gate
       }
     #endif
     }
+  
+  
+  //! for code which is parallelised via mp_loop or mp_executor::run();
+  //! the executor handles nested parallelism, so the omp_in_parallel() check is only needed when the executor is not active
+  arma_inline
+  static
+  bool
+  eval_loop(const uword n_elem)
+    {
+    if(mp_executor::is_active())  { return length_ok(n_elem); }
+    
+    return eval(n_elem);
+    }
   };
 
 
 
 struct mp_thread_limit
   {
+  //! number of threads for code which is parallelised directly via OpenMP
   arma_inline
   static
   int
@@ -69,6 +293,17 @@ struct mp_thread_limit
     return n_threads;
     }
   
+  //! number of threads for code which is parallelised via mp_loop or mp_executor::run()
+  arma_inline
+  static
+  int
+  get_loop()
+    {
+    if(mp_executor::is_active())  { return int( (std::max)(uword(1), mp_executor::get_n_threads()) ); }
+    
+    return mp_thread_limit::get();
+    }
+  
   arma_inline
   static
   bool
@@ -88,4 +323,117 @@ struct mp_thread_limit
 
 
 
+//! run independent tasks in parallel, via mp_executor if active, or via OpenMP otherwise
+struct mp_loop
+  {
+  //! call F(task_id) for each task_id in [0, n_tasks)
+  template<typename functor>
+  inline
+  static
+  void
+  run(const uword n_tasks, const int n_threads, const functor& F)
+    {
+    if(mp_executor::is_active())
+      {
+      const std::function<void(const uword)> task = [&F](const uword task_id) { F(task_id); };
+      
+      mp_executor::run(n_tasks, task);
+      
+      return;
+      }
+    
+    #if defined(ARMA_USE_OPENMP)
+      {
+      #pragma omp parallel for schedule(static) num_threads(n_threads)
+      for(uword task_id=0; task_id < n_tasks; ++task_id)  { F(task_id); }
+      }
+    #else
+      {
+      arma_ignore(n_threads);
+      
+      for(uword task_id=0; task_id < n_tasks; ++task_id)  { F(task_id); }
+      }
+    #endif
+    }
+  
+  
+  //! split [0, n) into contiguous ranges and call F(start, endp1) for each range
+  template<typename functor>
+  inline
+  static
+  void
+  run_chunked(const uword n, const int n_threads, const functor& F)
+    {
+    if(n == 0)  { return; }
+    
+    // the executor balances the load dynamically, so it benefits from more chunks than threads
+    const uword n_chunks_max = uword((std::max)(int(1), n_threads)) * ( mp_executor::is_active() ? uword(4) : uword(1) );
+    const uword n_chunks     = (std::min)(n_chunks_max, n);
+    const uword chunk_size   = n / n_chunks;
+    const uword n_extra      = n % n_chunks;
+    
+    const auto chunk_worker = [&](const uword chunk_id)
+      {
+      const uword start = chunk_id * chunk_size + (std::min)(chunk_id, n_extra);
+      const uword endp1 = start + chunk_size + ( (chunk_id < n_extra) ? uword(1) : uword(0) );
+      
+      F(start, endp1);
+      };
+    
+    mp_loop::run(n_chunks, n_threads, chunk_worker);
+    }
+  
+  
+  //! split [0, n) into contiguous ranges with a similar amount of work and call F(start, endp1) for each range;
+  //! the work for [0, i) is given by cumulative[i], plus one unit of overhead for each element (eg. the col_ptrs array of a sparse matrix)
+  template<typename functor>
+  inline
+  static
+  void
+  run_weighted(const uword n, const uword* cumulative, const int n_threads, const functor& F)
+    {
+    if(n == 0)  { return; }
+    
+    const uword n_tasks_max = uword((std::max)(int(1), n_threads)) * ( mp_executor::is_active() ? uword(4) : uword(1) );
+    const uword n_tasks     = (std::min)(n_tasks_max, n);
+    
+    if(n_tasks <= 1)  { F(uword(0), n); return; }
+    
+    const double total = double(cumulative[n] - cumulative[0]) + double(n);
+    
+    // smallest i such that the work for [0, i) is at least the target for the start of task t
+    const auto find_start = [&](const uword t) -> uword
+      {
+      if(t == 0)        { return uword(0); }
+      if(t >= n_tasks)  { return n;        }
+      
+      const double target = (total * double(t)) / double(n_tasks);
+      
+      uword lo = 0;
+      uword hi = n;
+      
+      while(lo < hi)
+        {
+        const uword mid = lo + (hi - lo) / 2;
+        
+        if( (double(cumulative[mid] - cumulative[0]) + double(mid)) < target )  { lo = mid + 1; } else { hi = mid; }
+        }
+      
+      return lo;
+      };
+    
+    const auto task_worker = [&](const uword t)
+      {
+      const uword start = find_start(t  );
+      const uword endp1 = find_start(t+1);
+      
+      if(start < endp1)  { F(start, endp1); }
+      };
+    
+    mp_loop::run(n_tasks, n_threads, task_worker);
+    }
+  };
+
+
+
 //! @}
@@ -90,6 +90,15 @@ class gemm_emul_large
     const uword B_n_rows = B.n_rows;
     const uword B_n_cols = B.n_cols;
     
+    if(gemm_emul_blocked<do_trans_A, do_trans_B, use_alpha, use_beta>::template is_worthwhile<eT>(C.n_rows, C.n_cols, (do_trans_A) ? A_n_rows : A_n_cols))
+      {
+      arma_debug_print("gemm_emul_large::apply(): blocked");
+      
+      gemm_emul_blocked<do_trans_A, do_trans_B, use_alpha, use_beta>::apply(C, A, B, alpha, beta);
+      
+      return;
+      }
+    
     if( (do_trans_A == false) && (do_trans_B == false) )
       {
       arma_aligned podarray<eT> tmp(A_n_cols);
@@ -0,0 +1,446 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup gemm
+//! @{
+
+
+
+//! block sizes for gemm_emul_blocked, and parallelisation of the emulated BLAS functions
+template<typename eT>
+struct gemm_emul_blocking
+  {
+  static constexpr uword MR = (sizeof(eT) <= 4) ? 16 : ( (sizeof(eT) <= 8) ? 8 : 4 );  //!< rows of the micro-kernel; 64 bytes per column
+  static constexpr uword NR = 4;                                                        //!< columns of the micro-kernel
+  static constexpr uword KC = 256;                                                      //!< depth of the packed panels; a panel of B is kept in L1 cache
+  static constexpr uword MC = (MR * 16);                                                //!< rows of a packed block of A; the block is kept in L2 cache
+  static constexpr uword NC = 2048;                                                     //!< columns of a packed block of B
+  
+  //! smaller products are evaluated via dot products, as the packing has an overhead of O(M*K + K*N)
+  static constexpr uword min_n_rows = MR;
+  static constexpr uword min_n_cols = NR;
+  static constexpr uword min_depth  = 16;
+  
+  //! number of threads for a product with the given number of multiply-adds;
+  //! the number of multiply-adds in units of 1024 is compared against the threshold for expensive element-wise operations
+  inline
+  static
+  int
+  get_n_threads(const double n_madd)
+    {
+    const double work = (std::min)( n_madd / double(1024), double(ARMA_MAX_UWORD) );
+    
+    return ( (arma_config::mp) && mp_gate<eT, false, mp_op_cost::heavy>::eval_loop(uword(work)) ) ? mp_thread_limit::get_loop() : int(1);
+    }
+  };
+
+
+
+//! cache-blocked emulation of gemm(), in the style of GotoBLAS:
+//! blocks of op(A) and op(B) are packed into contiguous panels, which are then multiplied by a register-blocked micro-kernel;
+//! for large matrices, C is split into tiles which are evaluated in parallel;
+//! the transposes of A and B are handled during packing;
+//! for non-complex matrices only, as it assumes only simple transposes (ie. doesn't do hermitian transposes)
+template<const bool do_trans_A=false, const bool do_trans_B=false, const bool use_alpha=false, const bool use_beta=false>
+class gemm_emul_blocked
+  {
+  public:
+  
+  template<typename eT>
+  inline
+  static
+  bool
+  is_worthwhile(const uword M, const uword N, const uword K)
+    {
+    typedef gemm_emul_blocking<eT> blk;
+    
+    return ( (M >= blk::min_n_rows) && (N >= blk::min_n_cols) && (K >= blk::min_depth) );
+    }
+  
+  
+  
+  //! C = alpha*op(A)*op(B) + beta*C, where op(A) is M x K and op(B) is K x N;
+  //! if upper_only is true, elements below the diagonal of C may not be evaluated (for use by syrk_emul)
+  template<typename eT, typename TA, typename TB>
+  arma_hot
+  inline
+  static
+  void
+  apply
+    (
+          Mat<eT>& C,
+    const TA&      A,
+    const TB&      B,
+    const eT       alpha      = eT(1),
+    const eT       beta       = eT(0),
+    const bool     upper_only = false
+    )
+    {
+    arma_debug_sigprint();
+    
+    typedef gemm_emul_blocking<eT> blk;
+    
+    const uword M = C.n_rows;
+    const uword N = C.n_cols;
+    const uword K = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    if( (M == 0) || (N == 0) )  { return; }
+    
+    if(K == 0)
+      {
+      if(use_beta)  { arrayops::inplace_mul(C.memptr(), beta, C.n_elem); }  else  { C.zeros(); }
+      
+      return;
+      }
+    
+    const uword m_panels = (M + blk::MR - 1) / blk::MR;
+    const uword n_panels = (N + blk::NR - 1) / blk::NR;
+    
+    const int n_threads = blk::get_n_threads( double(M) * double(N) * double(K) * ( (upper_only) ? double(0.5) : double(1) ) );
+    
+    if(n_threads <= 1)
+      {
+      gemm_emul_blocked::apply_tile(C, A, B, alpha, beta, upper_only, 0, M, 0, N);
+      
+      return;
+      }
+    
+    // C is split into a grid of n_row_parts x n_col_parts tiles;
+    // the tile boundaries are aligned with the micro-kernel, and each tile packs its own blocks of A and B
+    
+    uword n_row_parts = 1;
+    uword n_col_parts = uword(n_threads);
+    
+    if(upper_only == false)
+      {
+      // choose the grid with the smallest amount of packing per tile, ie. minimise M/n_row_parts + N/n_col_parts
+      
+      double best_cost = Datum<double>::inf;
+      
+      for(uword r=1; r <= uword(n_threads); ++r)
+        {
+        if( (uword(n_threads) % r) != 0 )  { continue; }
+        
+        const uword c = uword(n_threads) / r;
+        
+        if( (r > m_panels) || (c > n_panels) )  { continue; }
+        
+        const double cost = double(M)/double(r) + double(N)/double(c);
+        
+        if(cost < best_cost)  { best_cost = cost; n_row_parts = r; n_col_parts = c; }
+        }
+      }
+    
+    n_row_parts = (std::min)(n_row_parts, m_panels);
+    n_col_parts = (std::min)(n_col_parts, n_panels);
+    
+    const auto tile_worker = [&](const uword tile_id)
+      {
+      const uword rp = tile_id % n_row_parts;
+      const uword cp = tile_id / n_row_parts;
+      
+      uword col_start_panel = 0;
+      uword col_endp1_panel = 0;
+      
+      if(upper_only)
+        {
+        // the amount of work for columns [0,j) of an upper triangle is proportional to j^2,
+        // so the column boundaries are placed at n_panels*sqrt(cp/n_col_parts) to balance the load
+        
+        col_start_panel = uword( double(n_panels) * std::sqrt(double(cp  ) / double(n_col_parts)) );
+        col_endp1_panel = uword( double(n_panels) * std::sqrt(double(cp+1) / double(n_col_parts)) );
+        
+        if((cp+1) == n_col_parts)  { col_endp1_panel = n_panels; }
+        }
+      else
+        {
+        col_start_panel = (n_panels * (cp  )) / n_col_parts;
+        col_endp1_panel = (n_panels * (cp+1)) / n_col_parts;
+        }
+      
+      const uword row_start_panel = (m_panels * (rp  )) / n_row_parts;
+      const uword row_endp1_panel = (m_panels * (rp+1)) / n_row_parts;
+      
+      const uword row_start = row_start_panel * blk::MR;
+      const uword row_endp1 = (std::min)(M, row_endp1_panel * blk::MR);
+      const uword col_start = col_start_panel * blk::NR;
+      const uword col_endp1 = (std::min)(N, col_endp1_panel * blk::NR);
+      
+      if( (row_start >= row_endp1) || (col_start >= col_endp1) )  { return; }
+      
+      gemm_emul_blocked::apply_tile(C, A, B, alpha, beta, upper_only, row_start, row_endp1, col_start, col_endp1);
+      };
+    
+    arma_debug_print( arma_str::format("gemm_emul_blocked::apply(): tiles: %u x %u") % n_row_parts % n_col_parts );
+    
+    mp_loop::run(n_row_parts * n_col_parts, n_threads, tile_worker);
+    }
+  
+  
+  
+  private:
+  
+  //! pack rows [row_start, row_start+mc) and columns [p_start, p_start+kc) of op(A) into panels of MR rows;
+  //! within each panel, the elements are stored column by column; the last panel is padded with zeros
+  template<typename eT, typename TA>
+  inline
+  static
+  void
+  pack_A(eT* out, const TA& A, const uword row_start, const uword mc, const uword p_start, const uword kc)
+    {
+    constexpr uword MR = gemm_emul_blocking<eT>::MR;
+    
+    for(uword ir=0; ir < mc; ir += MR)
+      {
+      const uword mr = (std::min)(uword(MR), mc - ir);
+      
+      if(do_trans_A == false)
+        {
+        for(uword p=0; p < kc; ++p)
+          {
+          const eT* A_col = &(A.at(row_start + ir, p_start + p));
+          
+          for(uword i=0;  i < mr; ++i)  { out[i] = A_col[i]; }
+          for(uword i=mr; i < MR; ++i)  { out[i] = eT(0);    }
+          
+          out += MR;
+          }
+        }
+      else
+        {
+        // rows of op(A) are columns of A
+        
+        for(uword i=0; i < MR; ++i)
+          {
+          if(i < mr)
+            {
+            const eT* A_col = &(A.at(p_start, row_start + ir + i));
+            
+            for(uword p=0; p < kc; ++p)  { out[p*MR + i] = A_col[p]; }
+            }
+          else
+            {
+            for(uword p=0; p < kc; ++p)  { out[p*MR + i] = eT(0); }
+            }
+          }
+        
+        out += kc*MR;
+        }
+      }
+    }
+  
+  
+  
+  //! pack rows [p_start, p_start+kc) and columns [col_start, col_start+nc) of op(B) into panels of NR columns;
+  //! within each panel, the elements are stored row by row; the last panel is padded with zeros
+  template<typename eT, typename TB>
+  inline
+  static
+  void
+  pack_B(eT* out, const TB& B, const uword p_start, const uword kc, const uword col_start, const uword nc)
+    {
+    constexpr uword NR = gemm_emul_blocking<eT>::NR;
+    
+    for(uword jr=0; jr < nc; jr += NR)
+      {
+      const uword nr = (std::min)(uword(NR), nc - jr);
+      
+      if(do_trans_B == false)
+        {
+        for(uword j=0; j < NR; ++j)
+          {
+          if(j < nr)
+            {
+            const eT* B_col = &(B.at(p_start, col_start + jr + j));
+            
+            for(uword p=0; p < kc; ++p)  { out[p*NR + j] = B_col[p]; }
+            }
+          else
+            {
+            for(uword p=0; p < kc; ++p)  { out[p*NR + j] = eT(0); }
+            }
+          }
+        
+        out += kc*NR;
+        }
+      else
+        {
+        // columns of op(B) are rows of B
+        
+        for(uword p=0; p < kc; ++p)
+          {
+          const eT* B_col = &(B.at(col_start + jr, p_start + p));
+          
+          for(uword j=0;  j < nr; ++j)  { out[j] = B_col[j]; }
+          for(uword j=nr; j < NR; ++j)  { out[j] = eT(0);    }
+          
+          out += NR;
+          }
+        }
+      }
+    }
+  
+  
+  
+  //! ab = a*b, where a is a packed MR x kc panel and b is a packed kc x NR panel;
+  //! the fixed-size loops are intended to be vectorised by the compiler, with the accumulators held in registers
+  template<typename eT>
+  arma_hot
+  inline
+  static
+  void
+  micro_kernel(eT* ab, const uword kc, const eT* a, const eT* b)
+    {
+    constexpr uword MR = gemm_emul_blocking<eT>::MR;
+    constexpr uword NR = gemm_emul_blocking<eT>::NR;
+    
+    if(simd::gemm_micro<MR,NR>(ab, kc, a, b))  { return; }
+    
+    eT acc[MR*NR];
+    
+    for(uword i=0; i < MR*NR; ++i)  { acc[i] = eT(0); }
+    
+    for(uword p=0; p < kc; ++p)
+      {
+      for(uword j=0; j < NR; ++j)
+        {
+        const eT b_j = b[j];
+        
+        for(uword i=0; i < MR; ++i)  { acc[j*MR + i] += a[i] * b_j; }
+        }
+      
+      a += MR;
+      b += NR;
+      }
+    
+    for(uword i=0; i < MR*NR; ++i)  { ab[i] = acc[i]; }
+    }
+  
+  
+  
+  //! evaluate rows [row_start, row_endp1) and columns [col_start, col_endp1) of C
+  template<typename eT, typename TA, typename TB>
+  inline
+  static
+  void
+  apply_tile
+    (
+          Mat<eT>& C,
+    const TA&      A,
+    const TB&      B,
+    const eT       alpha,
+    const eT       beta,
+    const bool     upper_only,
+    const uword    row_start,
+    const uword    row_endp1,
+    const uword    col_start,
+    const uword    col_endp1
+    )
+    {
+    typedef gemm_emul_blocking<eT> blk;
+    
+    constexpr uword MR = blk::MR;
+    constexpr uword NR = blk::NR;
+    
+    const uword K = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    const uword tile_n_rows = row_endp1 - row_start;
+    const uword tile_n_cols = col_endp1 - col_start;
+    
+    const uword max_mc = (std::min)(uword(blk::MC), MR * ((tile_n_rows + MR - 1) / MR));
+    const uword max_nc = (std::min)(uword(blk::NC), NR * ((tile_n_cols + NR - 1) / NR));
+    const uword max_kc = (std::min)(uword(blk::KC), K);
+    
+    podarray<eT> A_packed(max_mc * max_kc);
+    podarray<eT> B_packed(max_kc * max_nc);
+    
+    eT ab[MR*NR];
+    
+    const uword C_n_rows = C.n_rows;
+    
+    for(uword jc = col_start; jc < col_endp1; jc += blk::NC)
+      {
+      const uword nc = (std::min)(uword(blk::NC), col_endp1 - jc);
+      
+      // with upper_only, rows at or below the last column of the block are not needed
+      const uword row_endp1_jc = (upper_only) ? (std::min)(row_endp1, jc + nc) : row_endp1;
+      
+      if(row_start >= row_endp1_jc)  { continue; }
+      
+      for(uword pc = 0; pc < K; pc += blk::KC)
+        {
+        const uword kc = (std::min)(uword(blk::KC), K - pc);
+        
+        const bool first_block = (pc == 0);
+        
+        gemm_emul_blocked::pack_B(B_packed.memptr(), B, pc, kc, jc, nc);
+        
+        for(uword ic = row_start; ic < row_endp1_jc; ic += blk::MC)
+          {
+          const uword mc = (std::min)(uword(blk::MC), row_endp1_jc - ic);
+          
+          gemm_emul_blocked::pack_A(A_packed.memptr(), A, ic, mc, pc, kc);
+          
+          for(uword jr = 0; jr < nc; jr += NR)
+            {
+            const uword nr = (std::min)(uword(NR), nc - jr);
+            
+            const eT* b = B_packed.memptr() + jr*kc;
+            
+            for(uword ir = 0; ir < mc; ir += MR)
+              {
+              const uword mr = (std::min)(uword(MR), mc - ir);
+              
+              const uword row = ic + ir;
+              const uword col = jc + jr;
+              
+              // skip micro-tiles which are entirely below the diagonal
+              if( upper_only && (row >= (col + nr)) )  { continue; }
+              
+              gemm_emul_blocked::micro_kernel(&ab[0], kc, A_packed.memptr() + ir*kc, b);
+              
+              for(uword j=0; j < nr; ++j)
+                {
+                      eT* C_col  = C.memptr() + (col + j)*C_n_rows + row;
+                const eT* ab_col = &ab[j*MR];
+                
+                if(first_block)
+                  {
+                       if( (use_alpha == false) && (use_beta == false) )  { for(uword i=0; i < mr; ++i)  { C_col[i] =       ab_col[i];                } }
+                  else if( (use_alpha == true ) && (use_beta == false) )  { for(uword i=0; i < mr; ++i)  { C_col[i] = alpha*ab_col[i];                } }
+                  else if( (use_alpha == false) && (use_beta == true ) )  { for(uword i=0; i < mr; ++i)  { C_col[i] =       ab_col[i] + beta*C_col[i]; } }
+                  else if( (use_alpha == true ) && (use_beta == true ) )  { for(uword i=0; i < mr; ++i)  { C_col[i] = alpha*ab_col[i] + beta*C_col[i]; } }
+                  }
+                else
+                  {
+                  if(use_alpha == false)  { for(uword i=0; i < mr; ++i)  { C_col[i] +=       ab_col[i]; } }
+                  else                    { for(uword i=0; i < mr; ++i)  { C_col[i] += alpha*ab_col[i]; } }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  
+  };
+
+
+
+//! @}
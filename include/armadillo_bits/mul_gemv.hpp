@@ -144,6 +144,71 @@ class gemv_emul_helper
   {
   public:
   
+  //! number of rows of y processed at a time by apply_cols()
+  static constexpr uword block_size = 256;
+  
+  
+  
+  //! y = alpha*A*x + beta*y for rows [row_start, row_endp1), for non-complex matrices;
+  //! A is accessed column by column, with four columns processed at a time;
+  //! the rows are processed in blocks, so that the partial sums stay in L1 cache
+  template<const bool use_alpha, const bool use_beta, typename eT, typename TA>
+  arma_hot
+  inline
+  static
+  void
+  apply_cols( eT* y, const TA& A, const eT* x, const uword row_start, const uword row_endp1, const eT alpha, const eT beta )
+    {
+    const uword A_n_rows = A.n_rows;
+    const uword A_n_cols = A.n_cols;
+    
+    const eT* A_mem = A.memptr();
+    
+    eT acc[block_size];
+    
+    for(uword r0 = row_start; r0 < row_endp1; r0 += block_size)
+      {
+      const uword n = (std::min)(uword(block_size), row_endp1 - r0);
+      
+      for(uword i=0; i < n; ++i)  { acc[i] = eT(0); }
+      
+      uword col = 0;
+      
+      for(; (col+4) <= A_n_cols; col += 4)
+        {
+        const eT* A0 = &A_mem[(col  )*A_n_rows + r0];
+        const eT* A1 = &A_mem[(col+1)*A_n_rows + r0];
+        const eT* A2 = &A_mem[(col+2)*A_n_rows + r0];
+        const eT* A3 = &A_mem[(col+3)*A_n_rows + r0];
+        
+        const eT x0 = x[col  ];
+        const eT x1 = x[col+1];
+        const eT x2 = x[col+2];
+        const eT x3 = x[col+3];
+        
+        for(uword i=0; i < n; ++i)  { acc[i] += (A0[i]*x0 + A1[i]*x1) + (A2[i]*x2 + A3[i]*x3); }
+        }
+      
+      for(; col < A_n_cols; ++col)
+        {
+        const eT* A0 = &A_mem[col*A_n_rows + r0];
+        
+        const eT x0 = x[col];
+        
+        for(uword i=0; i < n; ++i)  { acc[i] += A0[i]*x0; }
+        }
+      
+      eT* y_r0 = &y[r0];
+      
+           if( (use_alpha == false) && (use_beta == false) )  { for(uword i=0; i < n; ++i)  { y_r0[i] =       acc[i];                } }
+      else if( (use_alpha == true ) && (use_beta == false) )  { for(uword i=0; i < n; ++i)  { y_r0[i] = alpha*acc[i];                } }
+      else if( (use_alpha == false) && (use_beta == true ) )  { for(uword i=0; i < n; ++i)  { y_r0[i] =       acc[i] + beta*y_r0[i]; } }
+      else if( (use_alpha == true ) && (use_beta == true ) )  { for(uword i=0; i < n; ++i)  { y_r0[i] = alpha*acc[i] + beta*y_r0[i]; } }
+      }
+    }
+  
+  
+  
   template<typename eT, typename TA>
   arma_hot
   inline
@@ -241,6 +306,30 @@ class gemv_emul
         else if( (use_alpha == true ) && (use_beta == true ) )  { y[0] = alpha*acc + beta*y[0]; }
         }
       else
+      if(is_cx<eT>::no)
+        {
+        // A is accessed column by column; the blocks of rows are distributed among threads
+        
+        const int n_threads = gemm_emul_blocking<eT>::get_n_threads( double(A_n_rows) * double(A_n_cols) );
+        
+        if(n_threads > 1)
+          {
+          const uword block_size = gemv_emul_helper::block_size;
+          const uword n_blocks   = (A_n_rows + block_size - 1) / block_size;
+          
+          const auto worker = [&](const uword start, const uword endp1)
+            {
+            gemv_emul_helper::apply_cols<use_alpha, use_beta>(y, A, x, start*block_size, (std::min)(A_n_rows, endp1*block_size), alpha, beta);
+            };
+          
+          mp_loop::run_chunked(n_blocks, n_threads, worker);
+          }
+        else
+          {
+          gemv_emul_helper::apply_cols<use_alpha, use_beta>(y, A, x, 0, A_n_rows, alpha, beta);
+          }
+        }
+      else
       for(uword row=0; row < A_n_rows; ++row)
         {
         const eT acc = gemv_emul_helper::dot_row_col(A, x, row, A_n_cols);
@@ -256,26 +345,24 @@ class gemv_emul
       {
       if(is_cx<eT>::no)
         {
-        for(uword col=0; col < A_n_cols; ++col)
+        const auto worker = [&](const uword start, const uword endp1)
           {
-          // col is interpreted as row when storing the results in 'y'
-          
-          
-          // const eT* A_coldata = A.colptr(col);
-          // 
-          // eT acc = eT(0);
-          // for(uword row=0; row < A_n_rows; ++row)
-          //   {
-          //   acc += A_coldata[row] * x[row];
-          //   }
-          
-          const eT acc = op_dot::direct_dot_arma(A_n_rows, A.colptr(col), x);
-          
-               if( (use_alpha == false) && (use_beta == false) )  { y[col] =       acc;               }
-          else if( (use_alpha == true ) && (use_beta == false) )  { y[col] = alpha*acc;               }
-          else if( (use_alpha == false) && (use_beta == true ) )  { y[col] =       acc + beta*y[col]; }
-          else if( (use_alpha == true ) && (use_beta == true ) )  { y[col] = alpha*acc + beta*y[col]; }
-          }
+          for(uword col=start; col < endp1; ++col)
+            {
+            // col is interpreted as row when storing the results in 'y'
+            
+            const eT acc = op_dot::direct_dot_arma(A_n_rows, A.colptr(col), x);
+            
+                 if( (use_alpha == false) && (use_beta == false) )  { y[col] =       acc;               }
+            else if( (use_alpha == true ) && (use_beta == false) )  { y[col] = alpha*acc;               }
+            else if( (use_alpha == false) && (use_beta == true ) )  { y[col] =       acc + beta*y[col]; }
+            else if( (use_alpha == true ) && (use_beta == true ) )  { y[col] = alpha*acc + beta*y[col]; }
+            }
+          };
+        
+        const int n_threads = gemm_emul_blocking<eT>::get_n_threads( double(A_n_rows) * double(A_n_cols) );
+        
+        if(n_threads > 1)  { mp_loop::run_chunked(A_n_cols, n_threads, worker); }  else  { worker(0, A_n_cols); }
         }
       else
         {
@@ -211,6 +211,24 @@ class syrk_emul
     // do_trans_A == false  ->   C = alpha * A   * A^T + beta*C
     // do_trans_A == true   ->   C = alpha * A^T * A   + beta*C
     
+    const uword N = (do_trans_A) ? A.n_cols : A.n_rows;
+    const uword K = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    if(gemm_emul_blocked<do_trans_A, (do_trans_A == false), use_alpha, use_beta>::template is_worthwhile<eT>(N, N, K))
+      {
+      arma_debug_print("syrk_emul::apply(): blocked");
+      
+      // when beta is used, the lower triangle is evaluated as well, as C is not assumed to be symmetric
+      
+      const bool upper_only = (use_beta == false);
+      
+      gemm_emul_blocked<do_trans_A, (do_trans_A == false), use_alpha, use_beta>::apply(C, A, A, alpha, beta, upper_only);
+      
+      if(upper_only)  { syrk_helper::inplace_copy_upper_tri_to_lower_tri(C); }
+      
+      return;
+      }
+    
     if(do_trans_A == false)
       {
       Mat<eT> AA;
@@ -37,6 +37,9 @@ class DenseGenMatProd
   inline DenseGenMatProd(const Mat<eT>& mat_obj);
 
   inline void perform_op(eT* x_in, eT* y_out) const;
+  
+  // block version, Y_out = A * X_in; used by the block solvers
+  inline void perform_op(const Mat<eT>& X_in, Mat<eT>& Y_out) const;
   };
 
 
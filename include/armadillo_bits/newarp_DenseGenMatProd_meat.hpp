@@ -48,4 +48,17 @@ DenseGenMatProd<eT>::perform_op(eT* x_in, eT* y_out) const
   }
 
 
+
+// Perform the matrix-matrix multiplication operation \f$Y=AX\f$.
+template<typename eT>
+inline
+void
+DenseGenMatProd<eT>::perform_op(const Mat<eT>& X_in, Mat<eT>& Y_out) const
+  {
+  arma_debug_sigprint();
+  
+  Y_out = op_mat * X_in;
+  }
+
+
 }  // namespace newarp
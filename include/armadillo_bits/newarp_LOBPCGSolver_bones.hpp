@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+namespace newarp
+{
+
+
+//! This class implements the LOBPCG (locally optimal block preconditioned conjugate gradient) eigen solver for real symmetric matrices.
+//! The matrix is applied to blocks of vectors, so that OpType::perform_op() can use sparse-dense matrix products.
+template<typename eT, int SelectionRule, typename OpType>
+class LOBPCGSolver
+  {
+  private:
+  
+  const OpType&     op;        // object to conduct matrix operation; must provide the block version of perform_op()
+  const uword       nev;       // number of eigenvalues requested
+  const uword       dim_n;     // dimension of matrix A
+  const uword       bs;        // block size; the extra bs - nev vectors accelerate convergence
+  uword             nmatop;    // number of matrix operations called
+  uword             niter;     // number of iterations
+  Mat<eT>           X;         // current approximations of the eigenvectors
+  Mat<eT>           AX;        // sign * A * X
+  Col<eT>           theta;     // Ritz values of sign * A
+  Col<eT>           pc_diag;   // inverse of the diagonal preconditioner; empty if not used
+  std::vector<bool> conv;      // indicator of the convergence of Ritz pairs
+  
+  std::mt19937_64   local_rng; // local random number generator
+  
+  // The solver always seeks the smallest eigenvalues of sign * A;
+  // sign is -1 for LARGEST_ALGE and +1 for SMALLEST_ALGE
+  inline static eT sign() { return (SelectionRule == EigsSelect::LARGEST_ALGE) ? eT(-1) : eT(+1); }
+  
+  inline void fill_rand(eT* dest, const uword N, const uword seed_val);
+  
+  // Orthonormalise the columns of V via Cholesky QR, and apply the same transformation to AV (if given)
+  inline static bool orthonormalise(Mat<eT>& V, Mat<eT>* AV);
+  
+  
+  public:
+  
+  //! Constructor to create a solver object.
+  inline LOBPCGSolver(const OpType& op_, uword nev_, uword bs_);
+  
+  //! Using the diagonal of the matrix for preconditioning.
+  inline void set_precond(const Col<eT>& diag_A);
+  
+  //! Providing the initial block; columns not given are filled randomly.
+  inline void init(const Mat<eT>& X_init);
+  
+  //! Providing a random initial block.
+  inline void init();
+  
+  //! Conducting the major computation procedure.
+  inline uword compute(uword maxit = 1000, eT tol = 1e-10);
+  
+  //! Returning the number of iterations used in the computation.
+  inline uword num_iterations() { return niter; }
+  
+  //! Returning the number of matrix operations used in the computation.
+  inline uword num_operations() { return nmatop; }
+  
+  //! Returning the converged eigenvalues, in ascending order.
+  inline Col<eT> eigenvalues();
+  
+  //! Returning the eigenvectors associated with the converged eigenvalues.
+  inline Mat<eT> eigenvectors();
+  };
+
+
+}  // namespace newarp
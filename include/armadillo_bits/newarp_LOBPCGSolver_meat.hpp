@@ -0,0 +1,423 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+namespace newarp
+{
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+void
+LOBPCGSolver<eT, SelectionRule, OpType>::fill_rand(eT* dest, const uword N, const uword seed_val)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename std::mt19937_64::result_type seed_type;
+  
+  local_rng.seed( seed_type(seed_val) );
+  
+  std::uniform_real_distribution<double> dist(-1.0, +1.0);
+  
+  for(uword i=0; i < N; ++i)  { dest[i] = eT(dist(local_rng)); }
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+bool
+LOBPCGSolver<eT, SelectionRule, OpType>::orthonormalise(Mat<eT>& V, Mat<eT>* AV)
+  {
+  arma_debug_sigprint();
+  
+  Mat<eT> R = V.t() * V;
+  
+  R = eT(0.5) * (R + R.t());
+  
+  if(auxlib::chol(R, 0) == false)  { return false; }
+  
+  if(auxlib::inv_tr(R, 0) == false)  { return false; }
+  
+  V = V * R;
+  
+  if(AV != nullptr)  { (*AV) = (*AV) * R; }
+  
+  return true;
+  }
+
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+LOBPCGSolver<eT, SelectionRule, OpType>::LOBPCGSolver(const OpType& op_, uword nev_, uword bs_)
+  : op(op_)
+  , nev(nev_)
+  , dim_n(op.n_rows)
+  , bs(bs_)
+  , nmatop(0)
+  , niter(0)
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( ((SelectionRule != EigsSelect::LARGEST_ALGE) && (SelectionRule != EigsSelect::SMALLEST_ALGE)), "newarp::LOBPCGSolver: only LARGEST_ALGE and SMALLEST_ALGE are supported" );
+  
+  arma_conform_check( (nev_ < 1 || nev_ > bs_), "newarp::LOBPCGSolver: nev must satisfy 1 <= nev <= bs" );
+  arma_conform_check( (3*bs_ > dim_n),          "newarp::LOBPCGSolver: bs must satisfy 3*bs <= n, n is the size of matrix" );
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+void
+LOBPCGSolver<eT, SelectionRule, OpType>::set_precond(const Col<eT>& diag_A)
+  {
+  arma_debug_sigprint();
+  
+  // the preconditioner must be positive definite, while the diagonal of sign * A may have elements of either sign;
+  // the diagonal is hence shifted so that its smallest element is a tenth of the range of its elements;
+  // zero elements (ie. when all diagonal elements are equal) are replaced with 1
+  
+  const uword N = diag_A.n_elem;
+  
+  pc_diag.set_size(N);
+  
+  if(N == 0)  { return; }
+  
+  eT d_min = sign() * diag_A[0];
+  eT d_max = d_min;
+  
+  for(uword i=1; i < N; ++i)
+    {
+    const eT val = sign() * diag_A[i];
+    
+    d_min = (std::min)(d_min, val);
+    d_max = (std::max)(d_max, val);
+    }
+  
+  const eT shift = d_min - eT(0.1) * (d_max - d_min);
+  
+  for(uword i=0; i < N; ++i)
+    {
+    const eT val = sign() * diag_A[i] - shift;
+    
+    pc_diag[i] = (val > eT(0)) ? (eT(1) / val) : eT(1);
+    }
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+void
+LOBPCGSolver<eT, SelectionRule, OpType>::init(const Mat<eT>& X_init)
+  {
+  arma_debug_sigprint();
+  
+  X.set_size(dim_n, bs);
+  
+  const uword n_given = (X_init.n_rows == dim_n) ? (std::min)(X_init.n_cols, bs) : uword(0);
+  
+  if(n_given > 0)  { X.head_cols(n_given) = X_init.head_cols(n_given); }
+  
+  for(uword i=n_given; i < bs; ++i)  { fill_rand(X.colptr(i), dim_n, i+1); }
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+void
+LOBPCGSolver<eT, SelectionRule, OpType>::init()
+  {
+  arma_debug_sigprint();
+  
+  init(Mat<eT>());
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+uword
+LOBPCGSolver<eT, SelectionRule, OpType>::compute(uword maxit, eT tol)
+  {
+  arma_debug_sigprint();
+  
+  const eT s = sign();
+  
+  // Initial block: orthonormal basis, followed by the Rayleigh-Ritz procedure
+  
+  Mat<eT> Q;
+  Mat<eT> R;
+  
+  if(auxlib::qr_econ(Q, R, X) == false)  { arma_stop_runtime_error("newarp::LOBPCGSolver::compute(): orthonormalisation of initial block failed"); return 0; }
+  
+  X.steal_mem(Q);
+  
+  op.perform_op(X, AX);  AX *= s;
+  
+  nmatop += bs;
+  
+  Mat<eT> G = X.t() * AX;
+  
+  G = eT(0.5) * (G + G.t());
+  
+  Mat<eT> C;
+  
+  if(eig_sym(theta, C, G) == false)  { arma_stop_runtime_error("newarp::LOBPCGSolver::compute(): Rayleigh-Ritz procedure failed"); return 0; }
+  
+  X  = X  * C;
+  AX = AX * C;
+  
+  // The norm of A is estimated by the largest Ritz value in magnitude seen so far
+  
+  eT a_norm = (std::max)( std::abs(theta[0]), std::abs(theta[bs-1]) );
+  
+  conv.assign(bs, false);
+  
+  Mat<eT> Rs;  // residuals
+  Mat<eT> W;
+  Mat<eT> AW;
+  Mat<eT> P;
+  Mat<eT> AP;
+  Mat<eT> Pa;
+  Mat<eT> APa;
+  
+  bool has_P = false;
+  
+  uword i, nconv = 0;
+  
+  for(i = 0; ; i++)
+    {
+    // Residuals of the Ritz pairs; converged pairs are not extended by W and P (soft locking),
+    // while the extra vectors beyond nev are kept active until the wanted pairs converge
+    
+    Rs = AX;
+    
+    for(uword j = 0; j < bs; j++)  { Rs.col(j) -= theta[j] * X.col(j); }
+    
+    const eT thresh = tol * (std::max)(a_norm, std::numeric_limits<eT>::min());
+    
+    std::vector<uword> active_list;
+    
+    nconv = 0;
+    
+    for(uword j = 0; j < bs; j++)
+      {
+      const eT res = norm(Rs.col(j));
+      
+      if( (j < nev) && (conv[j] == false) && (res <= thresh) )  { conv[j] = true; }
+      
+      if( (j < nev) && conv[j] )  { nconv++; }  else  { active_list.push_back(j); }
+      
+      }
+    
+    if( (nconv >= nev) || (i >= maxit) )  { break; }
+    
+    const uvec active = conv_to<uvec>::from(active_list);
+    
+    const uword na = active.n_elem;
+    
+    // Preconditioned residuals, orthogonal to X
+    
+    W = Rs.cols(active);
+    
+    if(pc_diag.n_elem == dim_n)  { W.each_col() %= pc_diag; }
+    
+    W -= X * (X.t() * W);
+    
+    if(orthonormalise(W, nullptr) == false)
+      {
+      if(auxlib::qr_econ(Q, R, W) == false)  { break; }
+      
+      W.steal_mem(Q);
+      }
+    
+    op.perform_op(W, AW);  AW *= s;
+    
+    nmatop += na;
+    
+    // Search directions from the previous iteration
+    
+    bool use_P = has_P;
+    
+    if(use_P)
+      {
+      Pa  = P.cols(active);
+      APa = AP.cols(active);
+      
+      use_P = orthonormalise(Pa, &APa);
+      }
+    
+    // Rayleigh-Ritz procedure on the subspace spanned by [X W P];
+    // the Gram matrices are formed blockwise from the upper triangle, to avoid concatenating the blocks
+    
+    const uword m = use_P ? (bs + 2*na) : (bs + na);
+    
+    Mat<eT> gram_A(m, m, arma_nozeros_indicator());
+    Mat<eT> gram_B(m, m, arma_nozeros_indicator());
+    
+    const span sX(0,  bs-1   );
+    const span sW(bs, bs+na-1);
+    
+    gram_A(sX,sX) = X.t() * AX;
+    gram_A(sX,sW) = X.t() * AW;
+    gram_A(sW,sW) = W.t() * AW;
+    
+    gram_B(sX,sX) = X.t() * X;
+    gram_B(sX,sW) = X.t() * W;
+    gram_B(sW,sW) = W.t() * W;
+    
+    if(use_P)
+      {
+      const span sP(bs+na, m-1);
+      
+      gram_A(sX,sP) = X.t()  * APa;
+      gram_A(sW,sP) = W.t()  * APa;
+      gram_A(sP,sP) = Pa.t() * APa;
+      
+      gram_B(sX,sP) = X.t()  * Pa;
+      gram_B(sW,sP) = W.t()  * Pa;
+      gram_B(sP,sP) = Pa.t() * Pa;
+      }
+    
+    // the diagonal blocks are symmetrised by using only their upper triangles
+    
+    gram_A = symmatu(gram_A);
+    gram_B = symmatu(gram_B);
+    
+    Mat<eT> L = gram_B;
+    
+    bool status = auxlib::chol(L, 1);
+    
+    if( (status == false) && use_P )
+      {
+      // the basis is ill-conditioned; restart without P
+      
+      use_P = false;
+      
+      gram_A = gram_A.submat(0, 0, bs+na-1, bs+na-1);
+      gram_B = gram_B.submat(0, 0, bs+na-1, bs+na-1);
+      
+      L = gram_B;
+      
+      status = auxlib::chol(L, 1);
+      }
+    
+    if(status == false)  { break; }
+    
+    if(auxlib::inv_tr(L, 1) == false)  { break; }
+    
+    const Mat<eT>& L_inv = L;
+    
+    Mat<eT> M = L_inv * gram_A * L_inv.t();
+    
+    M = eT(0.5) * (M + M.t());
+    
+    Col<eT> eigval;
+    Mat<eT> eigvec;
+    
+    if(eig_sym(eigval, eigvec, M) == false)  { break; }
+    
+    a_norm = (std::max)( a_norm, (std::max)(std::abs(eigval[0]), std::abs(eigval[eigval.n_elem-1])) );
+    
+    C = L_inv.t() * eigvec.head_cols(bs);
+    
+    theta = eigval.head(bs);
+    
+    // Update X and the search directions P
+    
+    const Mat<eT> C_X = C.head_rows(bs);
+    const Mat<eT> C_W = C.rows(bs, bs+na-1);
+    
+    P  = W  * C_W;
+    AP = AW * C_W;
+    
+    if(use_P)
+      {
+      const Mat<eT> C_P = C.tail_rows(na);
+      
+      P  += Pa  * C_P;
+      AP += APa * C_P;
+      }
+    
+    X  = X  * C_X + P;
+    AX = AX * C_X + AP;
+    
+    has_P = true;
+    }
+  
+  niter = i;
+  
+  return (std::min)(nev, nconv);
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+Col<eT>
+LOBPCGSolver<eT, SelectionRule, OpType>::eigenvalues()
+  {
+  arma_debug_sigprint();
+  
+  std::vector<eT> vals;
+  
+  for(uword i=0; i < nev; i++)
+    {
+    if(conv[i])  { vals.push_back( sign() * theta[i] ); }
+    }
+  
+  Col<eT> res(vals.size(), arma_nozeros_indicator());
+  
+  for(uword i=0; i < res.n_elem; i++)  { res[i] = vals[i]; }
+  
+  return (sign() < eT(0)) ? Col<eT>(flipud(res)) : res;
+  }
+
+
+
+template<typename eT, int SelectionRule, typename OpType>
+inline
+Mat<eT>
+LOBPCGSolver<eT, SelectionRule, OpType>::eigenvectors()
+  {
+  arma_debug_sigprint();
+  
+  std::vector<uword> ind;
+  
+  for(uword i=0; i < nev; i++)
+    {
+    if(conv[i])  { ind.push_back(i); }
+    }
+  
+  // the Ritz values of sign * A are in ascending order
+  if(sign() < eT(0))  { std::reverse(ind.begin(), ind.end()); }
+  
+  Mat<eT> res(dim_n, ind.size(), arma_nozeros_indicator());
+  
+  for(uword i=0; i < res.n_cols; i++)  { res.col(i) = X.col(ind[i]); }
+  
+  return res;
+  }
+
+
+}  // namespace newarp
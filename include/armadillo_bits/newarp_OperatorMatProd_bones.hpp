@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+namespace newarp
+{
+
+
+//! Define matrix operations on user-supplied operators, such as matfree_op
+template<typename eT, typename op_type>
+class OperatorMatProd
+  {
+  private:
+  
+  const op_type& op_obj;
+  
+  
+  public:
+  
+  const uword n_rows;  // number of rows of the underlying operator
+  const uword n_cols;  // number of columns of the underlying operator
+  
+  inline OperatorMatProd(const op_type& in_op_obj);
+  
+  inline void perform_op(eT* x_in, eT* y_out) const;
+  
+  // block version, Y_out = A * X_in; used by the block solvers
+  inline void perform_op(const Mat<eT>& X_in, Mat<eT>& Y_out) const;
+  };
+
+
+}  // namespace newarp
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+namespace newarp
+{
+
+
+template<typename eT, typename op_type>
+inline
+OperatorMatProd<eT, op_type>::OperatorMatProd(const op_type& in_op_obj)
+  : op_obj(in_op_obj)
+  , n_rows(in_op_obj.n_rows)
+  , n_cols(in_op_obj.n_cols)
+  {
+  arma_debug_sigprint();
+  }
+
+
+
+// Perform the matrix-vector multiplication operation \f$y=Ax\f$.
+// y_out = A * x_in
+template<typename eT, typename op_type>
+inline
+void
+OperatorMatProd<eT, op_type>::perform_op(eT* x_in, eT* y_out) const
+  {
+  arma_debug_sigprint();
+  
+  const Mat<eT> x(x_in , n_cols, 1, false, true);
+        Mat<eT> y(y_out, n_rows, 1, false, true);
+  
+  op_obj.apply(y, x);
+  }
+
+
+
+// Perform the matrix-matrix multiplication operation \f$Y=AX\f$.
+template<typename eT, typename op_type>
+inline
+void
+OperatorMatProd<eT, op_type>::perform_op(const Mat<eT>& X_in, Mat<eT>& Y_out) const
+  {
+  arma_debug_sigprint();
+  
+  op_obj.apply(Y_out, X_in);
+  }
+
+
+}  // namespace newarp
@@ -38,6 +38,9 @@ class SparseGenMatProd
   inline SparseGenMatProd(const SpMat<eT>& mat_obj);
   
   inline void perform_op(eT* x_in, eT* y_out) const;
+  
+  // block version, Y_out = A * X_in; used by the block solvers
+  inline void perform_op(const Mat<eT>& X_in, Mat<eT>& Y_out) const;
   };
 
 
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup op_batch
+//! @{
+
+
+
+//! operations on batches of small matrices, stored as the slices of cubes;
+//! for float and double matrices, groups of matrices are interleaved element by element and processed by the explicit SIMD kernels,
+//! with each lane of a vector holding a separate matrix; the groups are evaluated in parallel
+class op_batch
+  {
+  public:
+  
+  //! larger matrices are processed one at a time, via the functions used for single matrices
+  static constexpr uword simd_max_size = 16;
+  
+  template<typename eT> inline static void apply_mul      (Cube<eT>& C, const Cube<eT>& A, const Cube<eT>& B);
+  template<typename eT> inline static bool apply_chol     (Cube<eT>& R, const Cube<eT>& X, const uword layout);
+  template<typename eT> inline static bool apply_inv_sympd(Cube<eT>& B, const Cube<eT>& A);
+  template<typename eT> inline static bool apply_solve    (Cube<eT>& X, const Cube<eT>& A, const Cube<eT>& B);
+  
+  
+  private:
+  
+  //! number of matrices in each group; one cache line of each element is processed at a time
+  template<typename eT> arma_inline static constexpr uword n_lanes()  { return uword(64) / uword(sizeof(eT)); }
+  
+  template<typename eT> inline static bool use_simd(const uword N);
+  
+  template<typename eT> inline static void pack  (eT* buf, const Cube<eT>& X, const uword start, const bool do_trans);
+  template<typename eT> inline static void unpack(Cube<eT>& X, const eT* buf, const uword start, const uword mode);
+  
+  template<typename eT> inline static bool check_lanes(Cube<eT>& X, const uword start, const eT* buf, const uword N, const bool positive_diag);
+  
+  template<typename eT, typename functor> inline static bool run(const uword n_slices, const uword buf_n_elem, const double n_madd, const functor& F);
+  };
+
+
+
+//! @}
@@ -0,0 +1,548 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup op_batch
+//! @{
+
+
+
+template<typename eT>
+inline
+void
+op_batch::apply_mul(Cube<eT>& C, const Cube<eT>& A, const Cube<eT>& B)
+  {
+  arma_debug_sigprint();
+  
+  if( (&C == &A) || (&C == &B) )
+    {
+    Cube<eT> tmp;
+    
+    op_batch::apply_mul(tmp, A, B);
+    
+    C.steal_mem(tmp);
+    
+    return;
+    }
+  
+  arma_conform_check( (A.n_cols != B.n_rows), "batch_mul(): incompatible matrix dimensions" );
+  
+  arma_conform_check
+    (
+    ( (A.n_slices != B.n_slices) && (A.n_slices != 1) && (B.n_slices != 1) ),
+    "batch_mul(): number of slices must be the same, or one of the cubes must have one slice"
+    );
+  
+  const uword M = A.n_rows;
+  const uword K = A.n_cols;
+  const uword N = B.n_cols;
+  
+  const uword n_slices = ( (A.n_slices == 1) || (B.n_slices == 1) ) ? (std::max)(A.n_slices, B.n_slices) : A.n_slices;
+  
+  C.set_size(M, N, n_slices);
+  
+  if(C.is_empty())  { return; }
+  
+  if(K == 0)  { C.zeros(); return; }
+  
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const double n_madd = double(M) * double(K) * double(N) * double(n_slices);
+  
+  const auto slice_worker = [&](const uword start, eT*) -> bool
+    {
+    const uword endp1 = (std::min)(start + L, n_slices);
+    
+    for(uword s=start; s < endp1; ++s)
+      {
+      const Mat<eT> A_s(const_cast<eT*>(A.slice_memptr( (A.n_slices == 1) ? 0 : s )), M, K, false);
+      const Mat<eT> B_s(const_cast<eT*>(B.slice_memptr( (B.n_slices == 1) ? 0 : s )), K, N, false);
+      
+            Mat<eT> C_s(C.slice_memptr(s), M, N, false, true);
+      
+      glue_times::apply<eT, false, false, false>(C_s, A_s, B_s, eT(0));
+      }
+    
+    return true;
+    };
+  
+  // BLAS is faster than the batched kernel for products of matrices larger than 4x4, as the packing is limited by memory bandwidth
+  const uword max_size = (arma_config::blas) ? uword(4) : op_batch::simd_max_size;
+  
+  if( op_batch::use_simd<eT>( (std::max)((std::max)(M, K), N) ) && ( (std::max)((std::max)(M, K), N) <= max_size ) )
+    {
+    arma_debug_print("op_batch::apply_mul(): simd");
+    
+    const auto group_worker = [&](const uword start, eT* buf) -> bool
+      {
+      eT* buf_A = buf;
+      eT* buf_B = buf_A + M*K*L;
+      eT* buf_C = buf_B + K*N*L;
+      
+      op_batch::pack(buf_A, A, start, false);
+      op_batch::pack(buf_B, B, start, false);
+      
+      if(simd::batch_mul(buf_C, buf_A, buf_B, M, K, N, L) == false)  { return slice_worker(start, nullptr); }
+      
+      op_batch::unpack(C, buf_C, start, 0);
+      
+      return true;
+      };
+    
+    op_batch::run<eT>(n_slices, (M*K + K*N + M*N)*L, n_madd, group_worker);
+    }
+  else
+    {
+    op_batch::run<eT>(n_slices, 0, n_madd, slice_worker);
+    }
+  }
+
+
+
+//! layout = 0: R is upper triangular, with R^T R = X;  layout = 1: R is lower triangular, with R R^T = X;
+//! as with chol(), only the triangle of X specified by the layout is used
+template<typename eT>
+inline
+bool
+op_batch::apply_chol(Cube<eT>& R, const Cube<eT>& X, const uword layout)
+  {
+  arma_debug_sigprint();
+  
+  if(&R == &X)
+    {
+    Cube<eT> tmp;
+    
+    const bool status = op_batch::apply_chol(tmp, X, layout);
+    
+    R.steal_mem(tmp);
+    
+    return status;
+    }
+  
+  arma_conform_check( (X.n_rows != X.n_cols), "batch_chol(): given matrices must be square sized" );
+  
+  const uword N        = X.n_rows;
+  const uword n_slices = X.n_slices;
+  
+  R.set_size(N, N, n_slices);
+  
+  if(R.is_empty())  { return true; }
+  
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const double n_madd = double(N) * double(N) * double(N) * double(n_slices) / double(6);
+  
+  const auto slice_worker = [&](const uword start, eT*) -> bool
+    {
+    const uword endp1 = (std::min)(start + L, n_slices);
+    
+    bool status = true;
+    
+    for(uword s=start; s < endp1; ++s)
+      {
+      Mat<eT> R_s(R.slice_memptr(s), N, N, false, true);
+      
+      arrayops::copy(R_s.memptr(), X.slice_memptr(s), N*N);
+      
+      if(auxlib::chol(R_s, layout) == false)  { R_s.fill(Datum<eT>::nan); status = false; }
+      }
+    
+    return status;
+    };
+  
+  if(op_batch::use_simd<eT>(N))
+    {
+    arma_debug_print("op_batch::apply_chol(): simd");
+    
+    const auto group_worker = [&](const uword start, eT* buf) -> bool
+      {
+      // the kernel uses the lower triangle, which holds the upper triangle after transposing
+      op_batch::pack(buf, X, start, (layout == 0));
+      
+      if(simd::batch_chol(buf, buf, N, 0, L) == false)  { return slice_worker(start, nullptr); }
+      
+      op_batch::unpack(R, buf, start, ((layout == 0) ? 2 : 1));
+      
+      return op_batch::check_lanes(R, start, buf, N, true);
+      };
+    
+    return op_batch::run<eT>(n_slices, N*N*L, n_madd, group_worker);
+    }
+  
+  return op_batch::run<eT>(n_slices, 0, n_madd, slice_worker);
+  }
+
+
+
+//! B = inv(A), for symmetric positive definite matrices; as with inv_sympd(), only the lower triangle of A is used
+template<typename eT>
+inline
+bool
+op_batch::apply_inv_sympd(Cube<eT>& B, const Cube<eT>& A)
+  {
+  arma_debug_sigprint();
+  
+  if(&B == &A)
+    {
+    Cube<eT> tmp;
+    
+    const bool status = op_batch::apply_inv_sympd(tmp, A);
+    
+    B.steal_mem(tmp);
+    
+    return status;
+    }
+  
+  arma_conform_check( (A.n_rows != A.n_cols), "batch_inv_sympd(): given matrices must be square sized" );
+  
+  const uword N        = A.n_rows;
+  const uword n_slices = A.n_slices;
+  
+  B.set_size(N, N, n_slices);
+  
+  if(B.is_empty())  { return true; }
+  
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const double n_madd = double(N) * double(N) * double(N) * double(n_slices);
+  
+  const auto slice_worker = [&](const uword start, eT*) -> bool
+    {
+    const uword endp1 = (std::min)(start + L, n_slices);
+    
+    bool status = true;
+    
+    for(uword s=start; s < endp1; ++s)
+      {
+      Mat<eT> B_s(B.slice_memptr(s), N, N, false, true);
+      
+      arrayops::copy(B_s.memptr(), A.slice_memptr(s), N*N);
+      
+      bool sympd_state_junk = false;
+      
+      if(auxlib::inv_sympd(B_s, sympd_state_junk) == false)  { B_s.fill(Datum<eT>::nan); status = false; }
+      }
+    
+    return status;
+    };
+  
+  if(op_batch::use_simd<eT>(N))
+    {
+    arma_debug_print("op_batch::apply_inv_sympd(): simd");
+    
+    const auto group_worker = [&](const uword start, eT* buf) -> bool
+      {
+      eT* buf_A = buf;
+      eT* buf_I = buf_A + N*N*L;
+      
+      op_batch::pack(buf_A, A, start, false);
+      
+      arrayops::fill_zeros(buf_I, N*N*L);
+      
+      for(uword i=0; i < N; ++i)  { arrayops::inplace_set(&buf_I[(i + i*N)*L], eT(1), L); }
+      
+      if(simd::batch_chol(buf_A, buf_I, N, N, L) == false)  { return slice_worker(start, nullptr); }
+      
+      // the result is symmetric only up to rounding errors
+      op_batch::unpack(B, buf_I, start, 3);
+      
+      return op_batch::check_lanes(B, start, buf_A, N, true);
+      };
+    
+    return op_batch::run<eT>(n_slices, 2*N*N*L, n_madd, group_worker);
+    }
+  
+  return op_batch::run<eT>(n_slices, 0, n_madd, slice_worker);
+  }
+
+
+
+//! X = solve(A,B), for square A; the reciprocal condition number is not estimated, and approximate solutions are not attempted
+template<typename eT>
+inline
+bool
+op_batch::apply_solve(Cube<eT>& X, const Cube<eT>& A, const Cube<eT>& B)
+  {
+  arma_debug_sigprint();
+  
+  if( (&X == &A) || (&X == &B) )
+    {
+    Cube<eT> tmp;
+    
+    const bool status = op_batch::apply_solve(tmp, A, B);
+    
+    X.steal_mem(tmp);
+    
+    return status;
+    }
+  
+  arma_conform_check( (A.n_rows != A.n_cols),     "batch_solve(): given matrices must be square sized"            );
+  arma_conform_check( (A.n_rows != B.n_rows),     "batch_solve(): number of rows in given matrices must be the same" );
+  arma_conform_check( (A.n_slices != B.n_slices), "batch_solve(): number of slices in given cubes must be the same" );
+  
+  const uword N        = A.n_rows;
+  const uword n_rhs    = B.n_cols;
+  const uword n_slices = A.n_slices;
+  
+  X.set_size(N, n_rhs, n_slices);
+  
+  if(X.is_empty())  { return true; }
+  
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const double n_madd = double(N) * double(N) * (double(N)/double(3) + double(n_rhs)) * double(n_slices);
+  
+  const auto slice_worker = [&](const uword start, eT*) -> bool
+    {
+    const uword endp1 = (std::min)(start + L, n_slices);
+    
+    bool status = true;
+    
+    Mat<eT> A_s(N, N, arma_nozeros_indicator());
+    
+    for(uword s=start; s < endp1; ++s)
+      {
+      arrayops::copy(A_s.memptr(), A.slice_memptr(s), N*N);
+      
+      const Mat<eT> B_s(const_cast<eT*>(B.slice_memptr(s)), N, n_rhs, false);
+      
+            Mat<eT> X_s(X.slice_memptr(s), N, n_rhs, false, true);
+      
+      if(auxlib::solve_square_fast(X_s, A_s, B_s) == false)  { X_s.fill(Datum<eT>::nan); status = false; }
+      }
+    
+    return status;
+    };
+  
+  if(op_batch::use_simd<eT>( (std::max)(N, n_rhs) ))
+    {
+    arma_debug_print("op_batch::apply_solve(): simd");
+    
+    const auto group_worker = [&](const uword start, eT* buf) -> bool
+      {
+      eT* buf_A = buf;
+      eT* buf_B = buf_A + N*N*L;
+      
+      op_batch::pack(buf_A, A, start, false);
+      op_batch::pack(buf_B, B, start, false);
+      
+      if(simd::batch_lu_solve(buf_A, buf_B, N, n_rhs, L) == false)  { return slice_worker(start, nullptr); }
+      
+      op_batch::unpack(X, buf_B, start, 0);
+      
+      return op_batch::check_lanes(X, start, buf_A, N, false);
+      };
+    
+    return op_batch::run<eT>(n_slices, (N*N + N*n_rhs)*L, n_madd, group_worker);
+    }
+  
+  return op_batch::run<eT>(n_slices, 0, n_madd, slice_worker);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+op_batch::use_simd(const uword N)
+  {
+  return ( (is_same_type<eT,float>::yes || is_same_type<eT,double>::yes) && (N <= op_batch::simd_max_size) && (simd::get_isa() != simd::isa_none) );
+  }
+
+
+
+//! interleave the matrices in slices [start, start+L) of X, or of their transposes;
+//! a cube with one slice is replicated across all lanes, and lanes beyond the last slice are filled with the identity matrix
+template<typename eT>
+inline
+void
+op_batch::pack(eT* buf, const Cube<eT>& X, const uword start, const bool do_trans)
+  {
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const uword X_n_rows = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  const uword n_rows = (do_trans) ? X_n_cols : X_n_rows;
+  
+  for(uword l=0; l < L; ++l)
+    {
+    const uword s = (X.n_slices == 1) ? uword(0) : (start + l);
+    
+    if(s >= X.n_slices)
+      {
+      for(uword j=0; j < X_n_cols; ++j)
+      for(uword i=0; i < X_n_rows; ++i)
+        {
+        buf[(i + j*X_n_rows)*L + l] = (i == j) ? eT(1) : eT(0);
+        }
+      
+      continue;
+      }
+    
+    const eT* X_mem = X.slice_memptr(s);
+    
+    if(do_trans)
+      {
+      for(uword j=0; j < X_n_cols; ++j)
+      for(uword i=0; i < X_n_rows; ++i)
+        {
+        buf[(j + i*n_rows)*L + l] = X_mem[i + j*X_n_rows];
+        }
+      }
+    else
+      {
+      const uword X_n_elem_slice = X.n_elem_slice;
+      
+      for(uword i=0; i < X_n_elem_slice; ++i)  { buf[i*L + l] = X_mem[i]; }
+      }
+    }
+  }
+
+
+
+//! store the lanes of buf in slices [start, start+L) of X;
+//! mode = 0: full matrices;  mode = 1: lower triangles;  mode = 2: transposes of the lower triangles;  mode = 3: symmetric matrices from the lower triangles
+template<typename eT>
+inline
+void
+op_batch::unpack(Cube<eT>& X, const eT* buf, const uword start, const uword mode)
+  {
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const uword n_rows = X.n_rows;
+  const uword n_cols = X.n_cols;
+  
+  const uword endp1 = (std::min)(start + L, X.n_slices);
+  
+  for(uword s=start; s < endp1; ++s)
+    {
+    const uword l = s - start;
+    
+    eT* X_mem = X.slice_memptr(s);
+    
+    if(mode == 0)
+      {
+      const uword X_n_elem_slice = X.n_elem_slice;
+      
+      for(uword i=0; i < X_n_elem_slice; ++i)  { X_mem[i] = buf[i*L + l]; }
+      
+      continue;
+      }
+    
+    for(uword j=0; j < n_cols; ++j)
+    for(uword i=0; i < n_rows; ++i)
+      {
+      eT val = buf[(i + j*n_rows)*L + l];
+      
+      if( (mode == 1) && (i < j) )  { val = eT(0); }
+      if( (mode == 2)            )  { val = (i <= j) ? buf[(j + i*n_rows)*L + l] : eT(0); }
+      if( (mode == 3) && (i < j) )  { val = buf[(j + i*n_rows)*L + l]; }
+      
+      X_mem[i + j*n_rows] = val;
+      }
+    }
+  }
+
+
+
+//! check the decompositions held in the lanes of buf, via the diagonals of the N x N factors, as well as the results in slices [start, start+L) of X;
+//! the slices with failed decompositions or non-finite results are filled with NaN
+template<typename eT>
+inline
+bool
+op_batch::check_lanes(Cube<eT>& X, const uword start, const eT* buf, const uword N, const bool positive_diag)
+  {
+  typedef typename get_pod_type<eT>::result T;
+  
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const uword endp1 = (std::min)(start + L, X.n_slices);
+  
+  bool status = true;
+  
+  for(uword s=start; s < endp1; ++s)
+    {
+    const uword l = s - start;
+    
+    bool lane_status = arrayops::is_finite(X.slice_memptr(s), X.n_elem_slice);
+    
+    for(uword i=0; (i < N) && lane_status; ++i)
+      {
+      const eT d = buf[(i + i*N)*L + l];
+      
+      lane_status = (positive_diag) ? (access::tmp_real(d) > T(0)) : (d != eT(0));
+      }
+    
+    if(lane_status == false)
+      {
+      arrayops::inplace_set(X.slice_memptr(s), Datum<eT>::nan, X.n_elem_slice);
+      
+      status = false;
+      }
+    }
+  
+  return status;
+  }
+
+
+
+//! call F(start, buf) for the groups of L slices starting at start = 0, L, 2L, ...;
+//! the groups are evaluated in parallel for large batches, with a buffer of buf_n_elem elements for each thread;
+//! returns false if F returned false for any group
+template<typename eT, typename functor>
+inline
+bool
+op_batch::run(const uword n_slices, const uword buf_n_elem, const double n_madd, const functor& F)
+  {
+  arma_debug_sigprint();
+  
+  constexpr uword L = op_batch::n_lanes<eT>();
+  
+  const uword n_groups = (n_slices + L - 1) / L;
+  
+  podarray<uword> group_status(n_groups);
+  
+  const auto chunk_worker = [&](const uword group_start, const uword group_endp1)
+    {
+    podarray<eT> buf(buf_n_elem);
+    
+    for(uword g=group_start; g < group_endp1; ++g)  { group_status[g] = (F(g*L, buf.memptr())) ? uword(1) : uword(0); }
+    };
+  
+  const int n_threads = gemm_emul_blocking<eT>::get_n_threads(n_madd);
+  
+  if( (n_threads > 1) && (n_groups > 1) )
+    {
+    arma_debug_print("op_batch::run(): parallel");
+    
+    mp_loop::run_chunked(n_groups, n_threads, chunk_worker);
+    }
+  else
+    {
+    chunk_worker(0, n_groups);
+    }
+  
+  for(uword g=0; g < n_groups; ++g)  { if(group_status[g] == uword(0))  { return false; } }
+  
+  return true;
+  }
+
+
+
+//! @}
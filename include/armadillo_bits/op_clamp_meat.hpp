@@ -79,6 +79,8 @@ op_clamp::apply_direct(Mat<eT>& out, const Mat<eT>& X, const eT min_val, const e
     const eT*   X_mem =   X.memptr();
           eT* out_mem = out.memptr();
     
+    if(simd::clamp(out_mem, X_mem, N, min_val, max_val))  { return; }
+    
     for(uword i=0; i<N; ++i)
       {
       const eT val = X_mem[i];
@@ -202,6 +204,8 @@ op_clamp::apply_direct(Cube<eT>& out, const Cube<eT>& X, const eT min_val, const
     const eT*   X_mem =   X.memptr();
           eT* out_mem = out.memptr();
     
+    if(simd::clamp(out_mem, X_mem, N, min_val, max_val))  { return; }
+    
     for(uword i=0; i<N; ++i)
       {
       const eT val = X_mem[i];
@@ -28,6 +28,8 @@ op_inv_gen_default::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_inv_g
   {
   arma_debug_sigprint();
   
+  if(fixed_helper::inv(out, X.m))  { arma_debug_print("op_inv_gen_default: fixed size kernel"); return; }
+  
   const bool status = op_inv_gen_default::apply_direct(out, X.m, "inv()");
   
   if(status == false)
@@ -87,14 +87,9 @@ op_sp_mean::apply_fast
       }
     else
       {
-      for(uword col = 0; col < p_n_cols; ++col)
-        {
-        out_mem[col] = arrayops::accumulate
-          (
-          &p.get_values()[p.get_col_ptrs()[col]],
-          p.get_col_ptrs()[col + 1] - p.get_col_ptrs()[col]
-          ) / T(p_n_rows);
-        }
+      op_sp_sum::col_sums(out_mem, p.get_values(), p.get_col_ptrs(), p_n_cols, p.get_n_nonzero());
+      
+      out /= T(p_n_rows);
       }
     }
   else
@@ -106,11 +101,18 @@ op_sp_mean::apply_fast
     
     eT* out_mem = out.memptr();
     
-    typename SpProxy<T1>::const_iterator_type it = p.begin();
-    
-    const uword N = p.get_n_nonzero();
-    
-    for(uword i=0; i < N; ++i)  { out_mem[it.row()] += (*it); ++it; }
+    if(SpProxy<T1>::use_iterator)
+      {
+      typename SpProxy<T1>::const_iterator_type it = p.begin();
+      
+      const uword N = p.get_n_nonzero();
+      
+      for(uword i=0; i < N; ++i)  { out_mem[it.row()] += (*it); ++it; }
+      }
+    else
+      {
+      op_sp_sum::row_sums(out_mem, p.get_values(), p.get_row_indices(), p_n_rows, p.get_n_nonzero());
+      }
     
     out /= T(p_n_cols);
     }
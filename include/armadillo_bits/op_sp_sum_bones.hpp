@@ -27,6 +27,12 @@ class op_sp_sum
   
   template<typename T1>
   inline static void apply(Mat<typename T1::elem_type>& out, const mtSpReduceOp<typename T1::elem_type, T1, op_sp_sum>& in);
+  
+  template<typename eT>
+  inline static void col_sums(eT* out_mem, const eT* values, const uword* col_ptrs, const uword n_cols, const uword n_nonzero);
+  
+  template<typename eT>
+  inline static void row_sums(eT* out_mem, const eT* values, const uword* row_indices, const uword n_rows, const uword n_nonzero);
   };
 
 
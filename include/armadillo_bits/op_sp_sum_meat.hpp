@@ -62,29 +62,110 @@ op_sp_sum::apply(Mat<typename T1::elem_type>& out, const mtSpReduceOp<typename T
       }
     else
       {
-      for(uword col = 0; col < p_n_cols; ++col)
-        {
-        out_mem[col] = arrayops::accumulate
-          (
-          &p.get_values()[p.get_col_ptrs()[col]],
-          p.get_col_ptrs()[col + 1] - p.get_col_ptrs()[col]
-          );
-        }
+      op_sp_sum::col_sums(out_mem, p.get_values(), p.get_col_ptrs(), p_n_cols, p.get_n_nonzero());
       }
     }
   else
   if(dim == 1)  // find the sum in each row
     {
-    typename SpProxy<T1>::const_iterator_type it = p.begin();
+    if(SpProxy<T1>::use_iterator)
+      {
+      typename SpProxy<T1>::const_iterator_type it = p.begin();
+      
+      const uword N = p.get_n_nonzero();
+      
+      for(uword i=0; i < N; ++i)
+        {
+        out_mem[it.row()] += (*it);
+        ++it;
+        }
+      }
+    else
+      {
+      op_sp_sum::row_sums(out_mem, p.get_values(), p.get_row_indices(), p_n_rows, p.get_n_nonzero());
+      }
+    }
+  }
+
+
+
+//! sum of each column of a CSC matrix; the columns are processed in parallel for large matrices
+template<typename eT>
+inline
+void
+op_sp_sum::col_sums(eT* out_mem, const eT* values, const uword* col_ptrs, const uword n_cols, const uword n_nonzero)
+  {
+  arma_debug_sigprint();
+  
+  const auto worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col=start; col < endp1; ++col)
+      {
+      out_mem[col] = arrayops::accumulate( &(values[col_ptrs[col]]), col_ptrs[col + 1] - col_ptrs[col] );
+      }
+    };
+  
+  const int n_threads = ( (n_cols > 1) && mp_gate<eT>::eval_loop(n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  if(n_threads > 1)  { mp_loop::run_weighted(n_cols, col_ptrs, n_threads, worker); return; }
+  
+  worker(uword(0), n_cols);
+  }
+
+
+
+//! sum of each row of a CSC matrix, accumulated into out_mem, which must be set to zero beforehand;
+//! for large matrices, contiguous parts of the non-zero elements are accumulated into separate buffers, which are then added together
+template<typename eT>
+inline
+void
+op_sp_sum::row_sums(eT* out_mem, const eT* values, const uword* row_indices, const uword n_rows, const uword n_nonzero)
+  {
+  arma_debug_sigprint();
+  
+  const int n_threads = ( (n_rows > 0) && mp_gate<eT>::eval_loop(n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  // each part must be large enough to justify the extra buffer of length n_rows
+  const uword n_parts = (n_threads > 1) ? (std::min)(uword(n_threads), n_nonzero / (std::max)(n_rows, uword(1))) : uword(1);
+  
+  if(n_parts <= 1)
+    {
+    for(uword i=0; i < n_nonzero; ++i)  { out_mem[row_indices[i]] += values[i]; }
     
-    const uword N = p.get_n_nonzero();
+    return;
+    }
+  
+  arma_debug_print("op_sp_sum::row_sums(): parallel");
+  
+  podarray<eT> partial( (n_parts - 1) * n_rows );
+  
+  eT* partial_mem = partial.memptr();
+  
+  partial.zeros();
+  
+  const auto part_worker = [&](const uword part)
+    {
+    const uword start = (n_nonzero * part      ) / n_parts;
+    const uword endp1 = (n_nonzero * (part + 1)) / n_parts;
     
-    for(uword i=0; i < N; ++i)
+    eT* acc = (part == 0) ? out_mem : &(partial_mem[(part - 1) * n_rows]);
+    
+    for(uword i=start; i < endp1; ++i)  { acc[row_indices[i]] += values[i]; }
+    };
+  
+  mp_loop::run(n_parts, n_threads, part_worker);
+  
+  const auto combine_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword part=1; part < n_parts; ++part)
       {
-      out_mem[it.row()] += (*it);
-      ++it;
+      const eT* acc = &(partial_mem[(part - 1) * n_rows]);
+      
+      for(uword row=start; row < endp1; ++row)  { out_mem[row] += acc[row]; }
       }
-    }
+    };
+  
+  mp_loop::run_chunked(n_rows, n_threads, combine_worker);
   }
 
 
@@ -75,30 +75,39 @@ op_sp_vecnorm::apply_direct(Mat< typename get_pod_type<eT>::result >& out, const
   
   T* out_mem = out.memptr();
   
-  for(uword col=0; col < X.n_cols; ++col)
+  const auto worker = [&](const uword start, const uword endp1)
     {
-    const uword      col_offset = X.col_ptrs[col    ];
-    const uword next_col_offset = X.col_ptrs[col + 1];
-    
-    const eT* start_ptr = &X.values[     col_offset];
-    const eT*   end_ptr = &X.values[next_col_offset];
-    
-    const uword n_elem = end_ptr - start_ptr;
-    
-    T out_val = T(0);
-    
-    if(n_elem > 0)
+    for(uword col=start; col < endp1; ++col)
       {
-      const Col<eT> tmp(const_cast<eT*>(start_ptr), n_elem, false, false);
+      const uword      col_offset = X.col_ptrs[col    ];
+      const uword next_col_offset = X.col_ptrs[col + 1];
       
-      const Proxy< Col<eT> > P(tmp);
+      const eT* start_ptr = &X.values[     col_offset];
+      const eT*   end_ptr = &X.values[next_col_offset];
+      
+      const uword n_elem = end_ptr - start_ptr;
+      
+      T out_val = T(0);
+      
+      if(n_elem > 0)
+        {
+        const Col<eT> tmp(const_cast<eT*>(start_ptr), n_elem, false, false);
+        
+        const Proxy< Col<eT> > P(tmp);
+        
+        if(k == uword(1))  { out_val = op_norm::vec_norm_1(P); }
+        if(k == uword(2))  { out_val = op_norm::vec_norm_2(P); }
+        }
       
-      if(k == uword(1))  { out_val = op_norm::vec_norm_1(P); }
-      if(k == uword(2))  { out_val = op_norm::vec_norm_2(P); }
+      out_mem[col] = out_val;
       }
-    
-    out_mem[col] = out_val;
-    }
+    };
+  
+  const int n_threads = ( (X.n_cols > 1) && mp_gate<eT>::eval_loop(X.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  if(n_threads > 1)  { mp_loop::run_weighted(X.n_cols, X.col_ptrs, n_threads, worker); return; }
+  
+  worker(uword(0), X.n_cols);
   }
 
 
@@ -161,39 +170,48 @@ op_sp_vecnorm_ext::apply_direct(Mat< typename get_pod_type<eT>::result >& out, c
   
   T* out_mem = out.memptr();
   
-  for(uword col=0; col < X.n_cols; ++col)
+  const auto worker = [&](const uword start, const uword endp1)
     {
-    const uword      col_offset = X.col_ptrs[col    ];
-    const uword next_col_offset = X.col_ptrs[col + 1];
-    
-    const eT* start_ptr = &X.values[     col_offset];
-    const eT*   end_ptr = &X.values[next_col_offset];
-    
-    const uword n_elem = end_ptr - start_ptr;
-    
-    T out_val = T(0);
-    
-    if(n_elem > 0)
+    for(uword col=start; col < endp1; ++col)
       {
-      const Col<eT> tmp(const_cast<eT*>(start_ptr), n_elem, false, false);
+      const uword      col_offset = X.col_ptrs[col    ];
+      const uword next_col_offset = X.col_ptrs[col + 1];
       
-      const Proxy< Col<eT> > P(tmp);
+      const eT* start_ptr = &X.values[     col_offset];
+      const eT*   end_ptr = &X.values[next_col_offset];
       
-      if(method_id == uword(1))
-        {
-        out_val = op_norm::vec_norm_max(P);
-        }
-      else
-      if(method_id == uword(2))
+      const uword n_elem = end_ptr - start_ptr;
+      
+      T out_val = T(0);
+      
+      if(n_elem > 0)
         {
-        const T tmp_val = op_norm::vec_norm_min(P);
+        const Col<eT> tmp(const_cast<eT*>(start_ptr), n_elem, false, false);
         
-        out_val = (n_elem < X.n_rows) ? T((std::min)(T(0), tmp_val)) : T(tmp_val);
+        const Proxy< Col<eT> > P(tmp);
+        
+        if(method_id == uword(1))
+          {
+          out_val = op_norm::vec_norm_max(P);
+          }
+        else
+        if(method_id == uword(2))
+          {
+          const T tmp_val = op_norm::vec_norm_min(P);
+          
+          out_val = (n_elem < X.n_rows) ? T((std::min)(T(0), tmp_val)) : T(tmp_val);
+          }
         }
+      
+      out_mem[col] = out_val;
       }
-    
-    out_mem[col] = out_val;
-    }
+    };
+  
+  const int n_threads = ( (X.n_cols > 1) && mp_gate<eT>::eval_loop(X.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  
+  if(n_threads > 1)  { mp_loop::run_weighted(X.n_cols, X.col_ptrs, n_threads, worker); return; }
+  
+  worker(uword(0), X.n_cols);
   }
 
 
@@ -479,4 +479,70 @@ operator*
 
 
 
+//! multiplication of a sparse matrix stored in CSR, BSR or SELL-C-sigma format and a dense object
+template<typename T1, typename T2>
+inline
+typename
+enable_if2
+  <
+  (is_SpMat_alt<T1>::value && is_arma_type<T2>::value && is_same_type<typename T1::elem_type, typename T2::elem_type>::value),
+  Mat<typename T1::elem_type>
+  >::result
+operator*
+  (
+  const T1& X,
+  const T2& Y
+  )
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const quasi_unwrap<T2> UY(Y);
+  
+  Mat<eT> out;
+  
+  X.times(out, UY.M);
+  
+  return out;
+  }
+
+
+
+//! multiplication of a dense object and a sparse matrix stored in CSR, BSR or SELL-C-sigma format
+template<typename T1, typename T2>
+inline
+typename
+enable_if2
+  <
+  (is_arma_type<T1>::value && is_SpMat_alt<T2>::value && is_same_type<typename T1::elem_type, typename T2::elem_type>::value),
+  Mat<typename T1::elem_type>
+  >::result
+operator*
+  (
+  const T1& X,
+  const T2& Y
+  )
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  // X * Y = (Y.st() * X.st()).st()
+  
+  const Mat<eT> Xt = strans(X);
+  
+  Mat<eT> tmp;
+  
+  Y.trans_times(tmp, Xt);
+  
+  Mat<eT> out;
+  
+  op_strans::apply_mat_noalias(out, tmp);
+  
+  return out;
+  }
+
+
+
 //! @}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup qr_factoriser
+//! @{
+
+
+
+//! QR decomposition A = Q*R of a real matrix, with Q square and orthogonal;
+//! rows and columns can be added or removed, and rank-1 updates applied, in O(m^2 + m*n) operations instead of recomputing
+template<typename eT>
+class qr_factoriser
+  {
+  private:
+  
+  Mat<eT> Q_mat;
+  Mat<eT> R_mat;
+  bool    valid = false;
+  
+  inline static void givens(eT& c, eT& s, eT& r, const eT a, const eT b);
+  
+  inline static void rotate_rows(Mat<eT>& X, const uword i, const uword j, const eT c, const eT s, const uword col_start);
+  inline static void rotate_cols(Mat<eT>& X, const uword i, const uword j, const eT c, const eT s);
+  
+  inline void reduce_hessenberg(const uword start);
+  
+  
+  public:
+  
+  typedef eT elem_type;
+  
+  inline  qr_factoriser();
+  
+  inline void reset();
+  
+  inline uword n_rows() const;
+  inline uword n_cols() const;
+  
+  inline const Mat<eT>& Q() const;
+  inline const Mat<eT>& R() const;
+  
+  template<typename T1> inline bool factorise(const Base<eT,T1>& A_expr);
+  
+  template<typename T1, typename T2> inline bool update(const Base<eT,T1>& u_expr, const Base<eT,T2>& v_expr);  //!< A + u*v.t()
+  
+  template<typename T1> inline bool append_row(const Base<eT,T1>& r_expr);
+  template<typename T1> inline bool append_col(const Base<eT,T1>& c_expr);
+  
+  inline bool remove_row(const uword k);
+  inline bool remove_col(const uword k);
+  
+  template<typename T1> inline bool solve(Mat<eT>& X, const Base<eT,T1>& B_expr) const;  //!< least-squares solution; requires n_rows >= n_cols
+  
+  inline eT rcond() const;
+  };
+
+
+
+//! @}
@@ -0,0 +1,472 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup qr_factoriser
+//! @{
+
+
+
+template<typename eT>
+inline
+qr_factoriser<eT>::qr_factoriser()
+  {
+  arma_debug_sigprint_this(this);
+  
+  arma_type_check(( is_real<eT>::value == false ));
+  }
+
+
+
+template<typename eT>
+inline
+void
+qr_factoriser<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  Q_mat.reset();
+  R_mat.reset();
+  
+  valid = false;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+qr_factoriser<eT>::n_rows() const
+  {
+  return R_mat.n_rows;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+qr_factoriser<eT>::n_cols() const
+  {
+  return R_mat.n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+const Mat<eT>&
+qr_factoriser<eT>::Q() const
+  {
+  return Q_mat;
+  }
+
+
+
+template<typename eT>
+inline
+const Mat<eT>&
+qr_factoriser<eT>::R() const
+  {
+  return R_mat;
+  }
+
+
+
+//! plane rotation such that [c s; -s c] * [a; b] = [r; 0]
+template<typename eT>
+inline
+void
+qr_factoriser<eT>::givens(eT& c, eT& s, eT& r, const eT a, const eT b)
+  {
+  if(b == eT(0))  { c = eT(1); s = eT(0); r = a; return; }
+  
+  r = std::hypot(a, b);
+  c = a / r;
+  s = b / r;
+  }
+
+
+
+//! apply the rotation to rows i and j of X, starting at column col_start
+template<typename eT>
+inline
+void
+qr_factoriser<eT>::rotate_rows(Mat<eT>& X, const uword i, const uword j, const eT c, const eT s, const uword col_start)
+  {
+  const uword X_n_cols = X.n_cols;
+  
+  for(uword col=col_start; col < X_n_cols; ++col)
+    {
+    eT& X_i = X.at(i,col);
+    eT& X_j = X.at(j,col);
+    
+    const eT t_i = X_i;
+    const eT t_j = X_j;
+    
+    X_i =  c*t_i + s*t_j;
+    X_j = -s*t_i + c*t_j;
+    }
+  }
+
+
+
+//! apply the transposed rotation to columns i and j of X, so that X*R is unchanged when the rotation is applied to rows i and j of R
+template<typename eT>
+inline
+void
+qr_factoriser<eT>::rotate_cols(Mat<eT>& X, const uword i, const uword j, const eT c, const eT s)
+  {
+  const uword X_n_rows = X.n_rows;
+  
+  eT* X_i = X.colptr(i);
+  eT* X_j = X.colptr(j);
+  
+  for(uword row=0; row < X_n_rows; ++row)
+    {
+    const eT t_i = X_i[row];
+    const eT t_j = X_j[row];
+    
+    X_i[row] =  c*t_i + s*t_j;
+    X_j[row] = -s*t_i + c*t_j;
+    }
+  }
+
+
+
+//! restore the upper triangular form of R, which has non-zero elements on the first subdiagonal from column 'start' onwards
+template<typename eT>
+inline
+void
+qr_factoriser<eT>::reduce_hessenberg(const uword start)
+  {
+  arma_debug_sigprint();
+  
+  const uword N = (std::min)( (R_mat.n_rows > 0) ? (R_mat.n_rows - 1) : uword(0), R_mat.n_cols );
+  
+  eT c, s, r;
+  
+  for(uword k=start; k < N; ++k)
+    {
+    givens(c, s, r, R_mat.at(k,k), R_mat.at(k+1,k));
+    
+    rotate_rows(R_mat, k, k+1, c, s, k+1);
+    rotate_cols(Q_mat, k, k+1, c, s);
+    
+    R_mat.at(k,  k) = r;
+    R_mat.at(k+1,k) = eT(0);
+    }
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+qr_factoriser<eT>::factorise(const Base<eT,T1>& A_expr)
+  {
+  arma_debug_sigprint();
+  
+  reset();
+  
+  const quasi_unwrap<T1> U(A_expr.get_ref());
+  
+  if(U.M.internal_has_nonfinite() || (auxlib::qr(Q_mat, R_mat, U.M) == false))
+    {
+    arma_warn(3, "qr_factoriser::factorise(): factorisation failed");
+    reset();
+    return false;
+    }
+  
+  valid = true;
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1, typename T2>
+inline
+bool
+qr_factoriser<eT>::update(const Base<eT,T1>& u_expr, const Base<eT,T2>& v_expr)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> Uu(u_expr.get_ref());
+  const quasi_unwrap<T2> Uv(v_expr.get_ref());
+  
+  const Mat<eT>& u = Uu.M;
+  const Mat<eT>& v = Uv.M;
+  
+  if(valid == false)  { arma_warn(2, "qr_factoriser::update(): no factorisation available"); return false; }
+  
+  const uword m = R_mat.n_rows;
+  const uword n = R_mat.n_cols;
+  
+  if( (u.is_vec() == false) || (v.is_vec() == false) || (u.n_elem != m) || (v.n_elem != n) )  { arma_warn(1, "qr_factoriser::update(): size mismatch"); return false; }
+  
+  if(m == 0)  { return true; }
+  
+  Col<eT> w = Q_mat.t() * vectorise(u);
+  
+  // reduce w to a multiple of e1; R becomes upper Hessenberg
+  
+  eT c, s, r;
+  
+  for(uword k=m-1; k >= 1; --k)
+    {
+    givens(c, s, r, w[k-1], w[k]);
+    
+    w[k-1] = r;
+    w[k  ] = eT(0);
+    
+    if((k-1) < n)  { rotate_rows(R_mat, k-1, k, c, s, k-1); }
+    
+    rotate_cols(Q_mat, k-1, k, c, s);
+    }
+  
+  for(uword j=0; j < n; ++j)  { R_mat.at(0,j) += w[0] * v[j]; }
+  
+  reduce_hessenberg(0);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+qr_factoriser<eT>::append_row(const Base<eT,T1>& r_expr)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(r_expr.get_ref());
+  
+  const Mat<eT>& row_vals = U.M;
+  
+  if(valid == false)  { arma_warn(2, "qr_factoriser::append_row(): no factorisation available"); return false; }
+  
+  const uword m = R_mat.n_rows;
+  const uword n = R_mat.n_cols;
+  
+  if( (row_vals.is_vec() == false) || (row_vals.n_elem != n) )  { arma_warn(1, "qr_factoriser::append_row(): size mismatch"); return false; }
+  
+  R_mat.resize(m+1, n);
+  Q_mat.resize(m+1, m+1);
+  
+  for(uword j=0; j < n; ++j)  { R_mat.at(m,j) = row_vals[j]; }
+  
+  Q_mat.at(m,m) = eT(1);
+  
+  // annihilate the new row of R using the rows above it
+  
+  const uword N = (std::min)(m, n);
+  
+  eT c, s, r;
+  
+  for(uword j=0; j < N; ++j)
+    {
+    givens(c, s, r, R_mat.at(j,j), R_mat.at(m,j));
+    
+    rotate_rows(R_mat, j, m, c, s, j+1);
+    rotate_cols(Q_mat, j, m, c, s);
+    
+    R_mat.at(j,j) = r;
+    R_mat.at(m,j) = eT(0);
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+qr_factoriser<eT>::append_col(const Base<eT,T1>& c_expr)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(c_expr.get_ref());
+  
+  const Mat<eT>& col_vals = U.M;
+  
+  if(valid == false)  { arma_warn(2, "qr_factoriser::append_col(): no factorisation available"); return false; }
+  
+  const uword m = R_mat.n_rows;
+  const uword n = R_mat.n_cols;
+  
+  if( (col_vals.is_vec() == false) || (col_vals.n_elem != m) )  { arma_warn(1, "qr_factoriser::append_col(): size mismatch"); return false; }
+  
+  Col<eT> w = Q_mat.t() * vectorise(col_vals);
+  
+  // rows n+1 onwards of R are zero, so only Q is affected by the rotations
+  
+  eT c, s, r;
+  
+  for(uword k=((m > 0) ? (m-1) : 0); k > n; --k)
+    {
+    givens(c, s, r, w[k-1], w[k]);
+    
+    w[k-1] = r;
+    w[k  ] = eT(0);
+    
+    rotate_cols(Q_mat, k-1, k, c, s);
+    }
+  
+  R_mat.resize(m, n+1);
+  
+  R_mat.col(n) = w;
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+qr_factoriser<eT>::remove_row(const uword k)
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)  { arma_warn(2, "qr_factoriser::remove_row(): no factorisation available"); return false; }
+  
+  const uword m = R_mat.n_rows;
+  
+  arma_conform_check_bounds( (k >= m), "qr_factoriser::remove_row(): index out of bounds" );
+  
+  // reduce row k of Q to a multiple of e1; R becomes upper Hessenberg,
+  // and the remaining rows of R form the upper triangular factor of the reduced matrix
+  
+  const uword n = R_mat.n_cols;
+  
+  eT c, s, r;
+  
+  for(uword j=m-1; j >= 1; --j)
+    {
+    givens(c, s, r, Q_mat.at(k,j-1), Q_mat.at(k,j));
+    
+    if((j-1) < n)  { rotate_rows(R_mat, j-1, j, c, s, j-1); }
+    
+    rotate_cols(Q_mat, j-1, j, c, s);
+    }
+  
+  Q_mat.shed_row(k);
+  Q_mat.shed_col(0);
+  R_mat.shed_row(0);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+qr_factoriser<eT>::remove_col(const uword k)
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)  { arma_warn(2, "qr_factoriser::remove_col(): no factorisation available"); return false; }
+  
+  arma_conform_check_bounds( (k >= R_mat.n_cols), "qr_factoriser::remove_col(): index out of bounds" );
+  
+  R_mat.shed_col(k);
+  
+  reduce_hessenberg(k);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+bool
+qr_factoriser<eT>::solve(Mat<eT>& X, const Base<eT,T1>& B_expr) const
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)
+    {
+    arma_warn(2, "qr_factoriser::solve(): no factorisation available");
+    X.soft_reset();
+    return false;
+    }
+  
+  const quasi_unwrap<T1> U(B_expr.get_ref());
+  
+  const Mat<eT>& B = U.M;
+  
+  const uword m = R_mat.n_rows;
+  const uword n = R_mat.n_cols;
+  
+  if(B.n_rows != m)
+    {
+    arma_warn(1, "qr_factoriser::solve(): matrix size mismatch");
+    X.soft_reset();
+    return false;
+    }
+  
+  if(m < n)
+    {
+    arma_warn(1, "qr_factoriser::solve(): solving under-determined systems is currently not supported");
+    X.soft_reset();
+    return false;
+    }
+  
+  Mat<eT> tmp = Q_mat.head_cols(n).t() * B;
+  
+  if(auxlib::solve_trimat_inplace(tmp, R_mat, n, 0, false, false) == false)  { X.soft_reset(); return false; }
+  
+  X.steal_mem(tmp);
+  
+  return true;
+  }
+
+
+
+//! reciprocal condition number of the square part of R
+template<typename eT>
+inline
+eT
+qr_factoriser<eT>::rcond() const
+  {
+  arma_debug_sigprint();
+  
+  if(valid == false)  { return eT(0); }
+  
+  const uword N = (std::min)(R_mat.n_rows, R_mat.n_cols);
+  
+  if(N == 0)  { return Datum<eT>::inf; }
+  
+  const Mat<eT> R_sq = R_mat.submat(0, 0, N-1, N-1);
+  
+  return auxlib::rcond_trimat(R_sq, 0);
+  }
+
+
+
+//! @}
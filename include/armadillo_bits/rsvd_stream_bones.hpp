@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup rsvd_stream
+//! @{
+
+
+
+//! single-pass randomised svd of a matrix given as consecutive chunks of columns;
+//! only the sketches Y = X*Omega and W = Psi*X are kept (Tropp, Yurtsever, Udell, Cevher, 2017)
+template<typename eT>
+class rsvd_stream
+  {
+  public:
+  
+  typedef eT                                elem_type;
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  inline rsvd_stream(const uword in_n_rows, const uword in_n_cols, const uword in_k, const rsvd_opts& opts = rsvd_opts());
+  
+  template<typename T1> inline void add(const   Base<eT,T1>& chunk);
+  template<typename T1> inline void add(const SpBase<eT,T1>& chunk);
+  
+  inline uword n_cols_added() const;
+  
+  inline bool finish(Mat<eT>& U, Col<pod_type>& S, Mat<eT>& V) const;
+  inline bool finish(Col<pod_type>& S) const;
+  
+  
+  private:
+  
+  const uword n_rows;
+  const uword n_cols;
+  const uword k;
+  
+  uword n_added = 0;
+  
+  Mat<eT> Psi;  // co-range test matrix
+  Mat<eT> Y;    // range sketch
+  Mat<eT> W;    // co-range sketch
+  
+  template<typename mat_type> inline void add_worker(const mat_type& chunk);
+  
+  inline bool finish_worker(Mat<eT>& U, Col<pod_type>& S, Mat<eT>& V, const bool calc_UV) const;
+  };
+
+
+
+//! @}
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup rsvd_stream
+//! @{
+
+
+
+template<typename eT>
+inline
+rsvd_stream<eT>::rsvd_stream(const uword in_n_rows, const uword in_n_cols, const uword in_k, const rsvd_opts& opts)
+  : n_rows(in_n_rows)
+  , n_cols(in_n_cols)
+  , k     ((std::min)( (std::min)(in_n_rows, in_n_cols), in_k ))
+  {
+  arma_debug_sigprint_this(this);
+  
+  const uword l  = (std::min)( k + uword(opts.oversample), (std::min)(n_rows, n_cols) );
+  const uword l2 = (std::min)( 2*l + 1, n_rows );
+  
+  Psi.randn(l2, n_rows);
+  
+  Y.zeros(n_rows, l);
+  W.zeros(l2, n_cols);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+void
+rsvd_stream<eT>::add(const Base<eT,T1>& chunk)
+  {
+  arma_debug_sigprint();
+  
+  const quasi_unwrap<T1> U(chunk.get_ref());
+  
+  add_worker(U.M);
+  }
+
+
+
+template<typename eT>
+template<typename T1>
+inline
+void
+rsvd_stream<eT>::add(const SpBase<eT,T1>& chunk)
+  {
+  arma_debug_sigprint();
+  
+  const unwrap_spmat<T1> U(chunk.get_ref());
+  
+  add_worker(U.M);
+  }
+
+
+
+template<typename eT>
+template<typename mat_type>
+inline
+void
+rsvd_stream<eT>::add_worker(const mat_type& chunk)
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( (chunk.n_rows != n_rows), "rsvd_stream::add(): incorrect number of rows in given chunk" );
+  
+  arma_conform_check( ((n_added + chunk.n_cols) > n_cols), "rsvd_stream::add(): number of given columns exceeds the number of columns in the matrix" );
+  
+  if(chunk.n_cols == 0)  { return; }
+  
+  // the rows of the range test matrix are used only once, so they are generated as needed
+  
+  Mat<eT> Omega(chunk.n_cols, Y.n_cols, arma_nozeros_indicator());
+  
+  Omega.randn();
+  
+  Y += chunk * Omega;
+  
+  W.cols(n_added, n_added + chunk.n_cols - 1) = Psi * chunk;
+  
+  n_added += chunk.n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+rsvd_stream<eT>::n_cols_added() const
+  {
+  return n_added;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+rsvd_stream<eT>::finish(Mat<eT>& U, Col<pod_type>& S, Mat<eT>& V) const
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check
+    (
+    ( ((void*)(&U) == (void*)(&S)) || (&U == &V) || ((void*)(&S) == (void*)(&V)) ),
+    "rsvd_stream::finish(): two or more output objects are the same object"
+    );
+  
+  const bool status = finish_worker(U, S, V, true);
+  
+  if(status == false)
+    {
+    U.soft_reset();
+    S.soft_reset();
+    V.soft_reset();
+    arma_warn(3, "rsvd_stream::finish(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+rsvd_stream<eT>::finish(Col<pod_type>& S) const
+  {
+  arma_debug_sigprint();
+  
+  Mat<eT> U;
+  Mat<eT> V;
+  
+  const bool status = finish_worker(U, S, V, false);
+  
+  if(status == false)
+    {
+    S.soft_reset();
+    arma_warn(3, "rsvd_stream::finish(): decomposition failed");
+    }
+  
+  return status;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+rsvd_stream<eT>::finish_worker(Mat<eT>& U, Col<pod_type>& S, Mat<eT>& V, const bool calc_UV) const
+  {
+  arma_debug_sigprint();
+  
+  if(n_added != n_cols)
+    {
+    arma_stop_logic_error("rsvd_stream::finish(): not all columns of the matrix have been given");
+    return false;
+    }
+  
+  if(k == 0)
+    {
+    S.reset();
+    
+    if(calc_UV)  { U.set_size(n_rows, 0); V.set_size(n_cols, 0); }
+    
+    return true;
+    }
+  
+  if(Y.internal_has_nonfinite() || W.internal_has_nonfinite())  { return false; }
+  
+  Mat<eT> Q;
+  
+  if(rsvd_orth(Q, Y) == false)  { return false; }
+  
+  // X ~= Q*B, where B is the least-squares solution of (Psi*Q)*B = W
+  
+  Mat<eT> PQ = Psi * Q;
+  Mat<eT> B;
+  
+  if(auxlib::solve_rect_fast(B, PQ, W) == false)  { return false; }
+  
+  if(calc_UV)
+    {
+    Mat<eT> UB;
+    Mat<eT> VB;
+    
+    if(auxlib::svd_dc_econ(UB, S, VB, B) == false)  { return false; }
+    
+    U = Q * UB.head_cols(k);
+    V = VB.head_cols(k);
+    }
+  else
+    {
+    if(auxlib::svd_dc(S, B) == false)  { return false; }
+    }
+  
+  S = S.head(k);
+  
+  return true;
+  }
+
+
+
+//! @}
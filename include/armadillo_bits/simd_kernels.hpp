@@ -0,0 +1,607 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+// kernels shared by all instruction sets;
+// this file is included in the body of each simd_* struct, which provides wrappers for the intrinsics;
+// arma_simd_target specifies the instruction set for which the kernels are compiled
+
+
+
+template<const uword op, typename vec_type>
+arma_simd_target
+arma_inline
+static
+vec_type
+vec_binary(const vec_type a, const vec_type b)
+  {
+  if(op == simd_op::plus )  { return add(a,b); }
+  if(op == simd_op::minus)  { return sub(a,b); }
+  if(op == simd_op::schur)  { return mul(a,b); }
+  
+  return div(a,b);
+  }
+
+
+
+template<const uword op, typename vec_type>
+arma_simd_target
+arma_inline
+static
+vec_type
+vec_unary(const vec_type a, const vec_type k)
+  {
+  if(op == simd_op::scalar_plus      )  { return add(a,k);  }
+  if(op == simd_op::scalar_minus_pre )  { return sub(k,a);  }
+  if(op == simd_op::scalar_minus_post)  { return sub(a,k);  }
+  if(op == simd_op::scalar_times     )  { return mul(a,k);  }
+  if(op == simd_op::scalar_div_pre   )  { return div(k,a);  }
+  if(op == simd_op::scalar_div_post  )  { return div(a,k);  }
+  if(op == simd_op::square           )  { return mul(a,a);  }
+  if(op == simd_op::neg              )  { return neg(a);    }
+  if(op == simd_op::abs              )  { return abs(a);    }
+  
+  return sqrt(a);
+  }
+
+
+
+template<const uword op, typename T>
+arma_simd_target
+inline
+static
+void
+binary(T* out, const T* A, const T* B, const uword n_elem)
+  {
+  typedef decltype(load(A)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  uword i = 0;
+  
+  for(; (i+W) <= n_elem; i += W)
+    {
+    store( &out[i], vec_binary<op>(load(&A[i]), load(&B[i])) );
+    }
+  
+  for(; i < n_elem; ++i)
+    {
+    out[i] = simd_op::binary<op>(A[i], B[i]);
+    }
+  }
+
+
+
+//! exp(x) for x in [-708,708] (double) or [-87,87] (float), which keeps the result a normal number;
+//! x = n*log(2) + r, with |r| <= log(2)/2, so that exp(x) = 2^n * exp(r);
+//! exp(r) is evaluated via a Taylor polynomial of degree 13 (double) or 7 (float);
+//! the maximum observed error is 1 ULP
+template<typename T, typename vec_type>
+arma_simd_target
+arma_inline
+static
+vec_type
+vec_exp(const vec_type x)
+  {
+  const bool is_dbl = (sizeof(T) == sizeof(double));
+  
+  // adding 1.5*2^52 (double) or 1.5*2^23 (float) rounds to the nearest integer, which is held in the low bits of the mantissa;
+  // the exponent bias is included so that the low bits directly form the exponent field of 2^n
+  const vec_type magic  = set1( is_dbl ? T(6755399441055744.0 + 1023.0) : T(12582912.0f + 127.0f) );
+  const vec_type ln2_hi = set1( is_dbl ? T(6.93147180369123816490e-01)  : T( 6.93359375e-01f) );
+  const vec_type ln2_lo = set1( is_dbl ? T(1.90821492927058770002e-10)  : T(-2.12194440e-04f) );
+  
+  const vec_type t = add(mul(x, set1(T(1.44269504088896340736))), magic);
+  const vec_type n = sub(t, magic);
+  const vec_type r = sub(sub(x, mul(n, ln2_hi)), mul(n, ln2_lo));
+  
+  // coefficients 1/j!
+  const double c[] =
+    {
+    1.0,
+    1.0,
+    5.00000000000000000000e-01,
+    1.66666666666666666667e-01,
+    4.16666666666666666667e-02,
+    8.33333333333333333333e-03,
+    1.38888888888888888889e-03,
+    1.98412698412698412698e-04,
+    2.48015873015873015873e-05,
+    2.75573192239858906526e-06,
+    2.75573192239858906526e-07,
+    2.50521083854417187751e-08,
+    2.08767569878680989792e-09,
+    1.60590438368216145994e-10
+    };
+  
+  // the polynomial is evaluated in powers of r^2, with pairs of coefficients combined first (Estrin's scheme),
+  // which halves the length of the dependency chain in comparison to Horner's scheme
+  const uword n_pairs = is_dbl ? 7 : 4;
+  
+  const vec_type r2 = mul(r, r);
+  
+  vec_type p = add(set1( T(c[2*n_pairs-2]) ), mul(r, set1( T(c[2*n_pairs-1]) )));
+  
+  for(uword j=n_pairs-1; j > 0; --j)  { p = add(mul(p, r2), add(set1( T(c[2*j-2]) ), mul(r, set1( T(c[2*j-1]) )))); }
+  
+  return mul(p, exp2_bits(t));
+  }
+
+
+
+//! log(x) for positive normal x, following the method used by FDLIBM;
+//! x = 2^e * m, with m in [sqrt(2)/2, sqrt(2)), so that log(x) = e*log(2) + log(1+f), with f = m-1;
+//! log(1+f) = 2s + s*R(s^2), with s = f/(2+f), where R is a minimax polynomial of degree 14 (double) or 8 (float);
+//! the maximum observed error is 1 ULP
+template<typename T, typename vec_type>
+arma_simd_target
+arma_inline
+static
+vec_type
+vec_log(const vec_type x)
+  {
+  const bool is_dbl = (sizeof(T) == sizeof(double));
+  
+  const vec_type ln2_hi = set1( is_dbl ? T(6.93147180369123816490e-01) : T(6.9313812256e-01f) );
+  const vec_type ln2_lo = set1( is_dbl ? T(1.90821492927058770002e-10) : T(9.0580006145e-06f) );
+  
+  const vec_type one  = set1(T(1));
+  const vec_type half = set1(T(0.5));
+  
+  const vec_type m0 = mantissa(x);
+  const vec_type e0 = exponent(x);
+  
+  const vec_type sqrt2 = set1( T(1.41421356237309504880) );
+  
+  const vec_type m = select_gt(m0, sqrt2, mul(m0, half), m0 );
+  const vec_type e = select_gt(m0, sqrt2, add(e0, one),  e0 );
+  
+  const vec_type f    = sub(m, one);
+  const vec_type hfsq = mul(half, mul(f, f));
+  const vec_type s    = div(f, add(set1(T(2)), f));
+  const vec_type z    = mul(s, s);
+  const vec_type w    = mul(z, z);
+  
+  vec_type R;
+  
+  if(is_dbl)
+    {
+    const vec_type t1 = mul(w, add(set1(T(3.999999999940941908e-01)), mul(w, add(set1(T(2.222219843214978396e-01)), mul(w, set1(T(1.531383769920937332e-01)))))));
+    const vec_type t2 = mul(z, add(set1(T(6.666666666666735130e-01)), mul(w, add(set1(T(2.857142874366239149e-01)), mul(w, add(set1(T(1.818357216161805012e-01)), mul(w, set1(T(1.479819860511658591e-01)))))))));
+    
+    R = add(t1, t2);
+    }
+  else
+    {
+    const vec_type t1 = mul(w, add(set1(T(0.40000972152f)), mul(w, set1(T(0.24279078841f)))));
+    const vec_type t2 = mul(z, add(set1(T(0.66666662693f)), mul(w, set1(T(0.28498786688f)))));
+    
+    R = add(t1, t2);
+    }
+  
+  // e*ln2_hi - ((hfsq - (s*(hfsq+R) + e*ln2_lo)) - f)
+  return sub(mul(e, ln2_hi), sub(sub(hfsq, add(mul(s, add(hfsq, R)), mul(e, ln2_lo))), f));
+  }
+
+
+
+//! approximated operations;
+//! blocks containing an element outside of the range handled by the vector code are evaluated via the scalar functions,
+//! which preserves the handling of special values (eg. NaN, infinity, zero, negative and subnormal numbers)
+template<const uword op, typename T>
+arma_simd_target
+inline
+static
+void
+unary_approx(T* out, const T* A, const uword n_elem)
+  {
+  typedef decltype(load(A)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  const bool is_dbl = (sizeof(T) == sizeof(double));
+  const bool is_log = (op == simd_op::log);
+  
+  const vec_type lo = set1( is_log ? std::numeric_limits<T>::min() : (is_dbl ? T(-708) : T(-87)) );
+  const vec_type hi = set1( is_log ? std::numeric_limits<T>::max() : (is_dbl ? T( 708) : T( 87)) );
+  
+  uword i = 0;
+  
+  for(; (i+W) <= n_elem; i += W)
+    {
+    const vec_type a = load(&A[i]);
+    
+    if(all_within(a, lo, hi))
+      {
+      store( &out[i], (is_log) ? vec_log<T>(a) : vec_exp<T>(a) );
+      }
+    else
+      {
+      for(uword j=i; j < (i+W); ++j)  { out[j] = simd_op::unary<op>(A[j], T(0)); }
+      }
+    }
+  
+  for(; i < n_elem; ++i)
+    {
+    out[i] = simd_op::unary<op>(A[i], T(0));
+    }
+  }
+
+
+
+template<const uword op, typename T>
+arma_simd_target
+inline
+static
+void
+unary(T* out, const T* A, const uword n_elem, const T k)
+  {
+  if(simd_op::is_approx(op))  { unary_approx<op>(out, A, n_elem); return; }
+  
+  typedef decltype(load(A)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  const vec_type vk = set1(k);
+  
+  uword i = 0;
+  
+  for(; (i+W) <= n_elem; i += W)
+    {
+    store( &out[i], vec_unary<op>(load(&A[i]), vk) );
+    }
+  
+  for(; i < n_elem; ++i)
+    {
+    out[i] = simd_op::unary<op>(A[i], k);
+    }
+  }
+
+
+
+//! sum of all elements;
+//! for n_elem_per_group = 2 the elements at even and odd positions are summed separately,
+//! which provides the real and imaginary parts of the sum of complex numbers
+template<typename T>
+arma_simd_target
+inline
+static
+void
+accumulate(T* out, const uword n_elem_per_group, const T* A, const uword n_elem)
+  {
+  typedef decltype(load(A)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  vec_type acc1 = set1(T(0));
+  vec_type acc2 = set1(T(0));
+  
+  uword i = 0;
+  
+  for(; (i+2*W) <= n_elem; i += 2*W)
+    {
+    acc1 = add(acc1, load(&A[i  ]));
+    acc2 = add(acc2, load(&A[i+W]));
+    }
+  
+  if((i+W) <= n_elem)
+    {
+    acc1 = add(acc1, load(&A[i]));
+    
+    i += W;
+    }
+  
+  T tmp[W];
+  
+  store(&tmp[0], add(acc1, acc2));
+  
+  for(uword g=0; g < n_elem_per_group; ++g)  { out[g] = T(0); }
+  
+  // W is a multiple of n_elem_per_group, and so is the number of elements processed above
+  for(uword j=0; j < W;      ++j)  { out[j % n_elem_per_group] += tmp[j]; }
+  for(;          i < n_elem; ++i)  { out[i % n_elem_per_group] += A[i];   }
+  }
+
+
+
+template<typename T>
+arma_simd_target
+inline
+static
+void
+clamp(T* out, const T* A, const uword n_elem, const T min_val, const T max_val)
+  {
+  typedef decltype(load(A)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  const vec_type vmin = set1(min_val);
+  const vec_type vmax = set1(max_val);
+  
+  uword i = 0;
+  
+  // the element is given as the second operand, so that NaN is propagated
+  for(; (i+W) <= n_elem; i += W)
+    {
+    store( &out[i], min(vmax, max(vmin, load(&A[i]))) );
+    }
+  
+  for(; i < n_elem; ++i)
+    {
+    const T val = A[i];
+    
+    out[i] = (val < min_val) ? min_val : ((val > max_val) ? max_val : val);
+    }
+  }
+
+
+
+//! micro-kernel of gemm_emul_blocked: ab = a*b, where a is a packed MR x kc panel (stored column by column),
+//! b is a packed kc x NR panel (stored row by row), and ab is an MR x NR block stored column by column;
+//! MR must be a multiple of the vector width
+template<const uword MR, const uword NR, typename T>
+arma_simd_target
+inline
+static
+void
+gemm_micro(T* ab, const uword kc, const T* a, const T* b)
+  {
+  typedef decltype(load(a)) vec_type;
+  
+  constexpr uword W  = sizeof(vec_type) / sizeof(T);
+  constexpr uword MV = MR / W;
+  
+  vec_type acc[MV*NR];
+  
+  for(uword i=0; i < MV*NR; ++i)  { acc[i] = set1(T(0)); }
+  
+  for(uword p=0; p < kc; ++p)
+    {
+    vec_type a_p[MV];
+    
+    for(uword v=0; v < MV; ++v)  { a_p[v] = load(&a[v*W]); }
+    
+    for(uword j=0; j < NR; ++j)
+      {
+      const vec_type b_j = set1(b[j]);
+      
+      for(uword v=0; v < MV; ++v)  { acc[j*MV + v] = add(acc[j*MV + v], mul(a_p[v], b_j)); }
+      }
+    
+    a += MR;
+    b += NR;
+    }
+  
+  for(uword j=0; j < NR; ++j)
+  for(uword v=0; v < MV; ++v)
+    {
+    store( &ab[j*MR + v*W], acc[j*MV + v] );
+    }
+  }
+
+
+
+// kernels of op_batch, which operate on groups of L small matrices stored interleaved element by element:
+// element (i,j) of the l-th matrix in a group of n_rows x n_cols matrices is at [(i + j*n_rows)*L + l];
+// each lane of a vector processes a separate matrix; L must be a multiple of the vector width
+
+//! c = a*b, where a is M x K, b is K x N, and c is M x N
+template<typename T>
+arma_simd_target
+inline
+static
+void
+batch_mul(T* c, const T* a, const T* b, const uword M, const uword K, const uword N, const uword L)
+  {
+  typedef decltype(load(a)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  for(uword l=0; l < L; l += W)
+  for(uword j=0; j < N; ++j)
+    {
+    const T* b_j = &b[j*K*L + l];
+    
+    const uword M4 = M - (M % 4);
+    
+    // blocks of 4 rows share the loads of b, and provide independent chains of additions
+    
+    for(uword i=0; i < M4; i += 4)
+      {
+      vec_type acc[4] = { set1(T(0)), set1(T(0)), set1(T(0)), set1(T(0)) };
+      
+      for(uword k=0; k < K; ++k)
+        {
+        const vec_type b_kj = load(&b_j[k*L]);
+        const T*       a_ik = &a[(i + k*M)*L + l];
+        
+        acc[0] = add(acc[0], mul(load(&a_ik[0*L]), b_kj));
+        acc[1] = add(acc[1], mul(load(&a_ik[1*L]), b_kj));
+        acc[2] = add(acc[2], mul(load(&a_ik[2*L]), b_kj));
+        acc[3] = add(acc[3], mul(load(&a_ik[3*L]), b_kj));
+        }
+      
+      for(uword r=0; r < 4; ++r)  { store(&c[(i + r + j*M)*L + l], acc[r]); }
+      }
+    
+    for(uword i=M4; i < M; ++i)
+      {
+      vec_type acc = set1(T(0));
+      
+      for(uword k=0; k < K; ++k)  { acc = add(acc, mul(load(&a[(i + k*M)*L + l]), load(&b_j[k*L]))); }
+      
+      store(&c[(i + j*M)*L + l], acc);
+      }
+    }
+  }
+
+
+
+//! Cholesky decomposition of the N x N matrices in a, using only their lower triangles; a is overwritten with the lower triangular factors;
+//! if n_rhs > 0, the N x n_rhs matrices in b are overwritten with the solutions of (L*L^T) x = b;
+//! lanes with matrices that are not positive definite have non-positive or NaN values on the diagonal of the factor
+template<typename T>
+arma_simd_target
+inline
+static
+void
+batch_chol(T* a, T* b, const uword N, const uword n_rhs, const uword L)
+  {
+  typedef decltype(load(a)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  for(uword l=0; l < L; l += W)
+    {
+    for(uword j=0; j < N; ++j)
+      {
+      vec_type d = load(&a[(j + j*N)*L + l]);
+      
+      for(uword k=0; k < j; ++k)  { const vec_type x = load(&a[(j + k*N)*L + l]);  d = sub(d, mul(x, x)); }
+      
+      d = sqrt(d);
+      
+      store(&a[(j + j*N)*L + l], d);
+      
+      for(uword i=j+1; i < N; ++i)
+        {
+        vec_type x = load(&a[(i + j*N)*L + l]);
+        
+        for(uword k=0; k < j; ++k)  { x = sub(x, mul(load(&a[(i + k*N)*L + l]), load(&a[(j + k*N)*L + l]))); }
+        
+        store(&a[(i + j*N)*L + l], div(x, d));
+        }
+      }
+    
+    for(uword c=0; c < n_rhs; ++c)
+      {
+      T* b_c = &b[c*N*L];
+      
+      // forward substitution with L, followed by back substitution with L^T
+      
+      for(uword i=0; i < N; ++i)
+        {
+        vec_type x = load(&b_c[i*L + l]);
+        
+        for(uword k=0; k < i; ++k)  { x = sub(x, mul(load(&a[(i + k*N)*L + l]), load(&b_c[k*L + l]))); }
+        
+        store(&b_c[i*L + l], div(x, load(&a[(i + i*N)*L + l])));
+        }
+      
+      for(uword i=N; i-- > 0;)
+        {
+        vec_type x = load(&b_c[i*L + l]);
+        
+        for(uword k=i+1; k < N; ++k)  { x = sub(x, mul(load(&a[(k + i*N)*L + l]), load(&b_c[k*L + l]))); }
+        
+        store(&b_c[i*L + l], div(x, load(&a[(i + i*N)*L + l])));
+        }
+      }
+    }
+  }
+
+
+
+//! solution of a x = b via LU decomposition with partial pivoting, where a is N x N and b is N x n_rhs;
+//! a is overwritten with the factors (with the rows permuted), and b with the solutions;
+//! the pivot row is chosen separately for each lane, and the rows are swapped via selections;
+//! lanes with singular matrices have zero or NaN values on the diagonal of the upper triangular factor
+template<typename T>
+arma_simd_target
+inline
+static
+void
+batch_lu_solve(T* a, T* b, const uword N, const uword n_rhs, const uword L)
+  {
+  typedef decltype(load(a)) vec_type;
+  
+  constexpr uword W = sizeof(vec_type) / sizeof(T);
+  
+  const vec_type half = set1(T(0.5));
+  const vec_type one  = set1(T(1  ));
+  
+  for(uword l=0; l < L; l += W)
+    {
+    for(uword k=0; k < N; ++k)
+      {
+      // the pivot indices are held as floating point numbers, so that they can be compared and selected with the other values
+      
+      vec_type best = abs(load(&a[(k + k*N)*L + l]));
+      vec_type piv  = set1(T(k));
+      
+      for(uword i=k+1; i < N; ++i)
+        {
+        const vec_type x = abs(load(&a[(i + k*N)*L + l]));
+        
+        piv  = select_gt(x, best, set1(T(i)), piv );
+        best = select_gt(x, best, x,          best);
+        }
+      
+      for(uword i=k+1; i < N; ++i)
+        {
+        // swap rows k and i in the lanes where the pivot is in row i
+        
+        const vec_type dist = abs(sub(piv, set1(T(i))));
+        
+        for(uword j=k; j < N; ++j)
+          {
+          const vec_type x = load(&a[(k + j*N)*L + l]);
+          const vec_type y = load(&a[(i + j*N)*L + l]);
+          
+          store(&a[(k + j*N)*L + l], select_gt(half, dist, y, x));
+          store(&a[(i + j*N)*L + l], select_gt(half, dist, x, y));
+          }
+        
+        for(uword j=0; j < n_rhs; ++j)
+          {
+          const vec_type x = load(&b[(k + j*N)*L + l]);
+          const vec_type y = load(&b[(i + j*N)*L + l]);
+          
+          store(&b[(k + j*N)*L + l], select_gt(half, dist, y, x));
+          store(&b[(i + j*N)*L + l], select_gt(half, dist, x, y));
+          }
+        }
+      
+      const vec_type r = div(one, load(&a[(k + k*N)*L + l]));
+      
+      for(uword i=k+1; i < N; ++i)
+        {
+        const vec_type m = mul(load(&a[(i + k*N)*L + l]), r);
+        
+        store(&a[(i + k*N)*L + l], m);
+        
+        for(uword j=k+1; j < N;     ++j)  { store(&a[(i + j*N)*L + l], sub(load(&a[(i + j*N)*L + l]), mul(m, load(&a[(k + j*N)*L + l])))); }
+        for(uword j=0;   j < n_rhs; ++j)  { store(&b[(i + j*N)*L + l], sub(load(&b[(i + j*N)*L + l]), mul(m, load(&b[(k + j*N)*L + l])))); }
+        }
+      }
+    
+    for(uword j=0; j < n_rhs; ++j)
+      {
+      T* b_j = &b[j*N*L];
+      
+      for(uword i=N; i-- > 0;)
+        {
+        vec_type x = load(&b_j[i*L + l]);
+        
+        for(uword k=i+1; k < N; ++k)  { x = sub(x, mul(load(&a[(i + k*N)*L + l]), load(&b_j[k*L + l]))); }
+        
+        store(&b_j[i*L + l], div(x, load(&a[(i + i*N)*L + l])));
+        }
+      }
+    }
+  }
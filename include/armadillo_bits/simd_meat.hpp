@@ -0,0 +1,868 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup simd_misc
+//! @{
+
+
+
+template<const uword op, typename T>
+arma_inline
+T
+simd_op::binary(const T a, const T b)
+  {
+  if(op == simd_op::plus )  { return a + b; }
+  if(op == simd_op::minus)  { return a - b; }
+  if(op == simd_op::schur)  { return a * b; }
+  
+  return a / b;
+  }
+
+
+
+template<const uword op, typename T>
+arma_inline
+T
+simd_op::unary(const T a, const T k)
+  {
+  if(op == simd_op::scalar_plus      )  { return a + k;        }
+  if(op == simd_op::scalar_minus_pre )  { return k - a;        }
+  if(op == simd_op::scalar_minus_post)  { return a - k;        }
+  if(op == simd_op::scalar_times     )  { return a * k;        }
+  if(op == simd_op::scalar_div_pre   )  { return k / a;        }
+  if(op == simd_op::scalar_div_post  )  { return a / k;        }
+  if(op == simd_op::square           )  { return a * a;        }
+  if(op == simd_op::neg              )  { return -a;           }
+  if(op == simd_op::abs              )  { return std::abs(a);  }
+  if(op == simd_op::exp              )  { return std::exp(a);  }
+  if(op == simd_op::log              )  { return std::log(a);  }
+  if(op == simd_op::trunc_exp        )  { return (a >= Datum<T>::log_max) ? std::numeric_limits<T>::max() : std::exp(a); }
+  
+  return std::sqrt(a);
+  }
+
+
+
+inline
+std::atomic<uword>&
+simd::get_state()
+  {
+  static std::atomic<uword> state( simd::detect_isa() );
+  
+  return state;
+  }
+
+
+
+inline
+uword
+simd::detect_isa()
+  {
+  #if defined(ARMA_USE_SIMD) && defined(ARMA_SIMD_X86)
+    {
+    if(simd::has_isa(isa_avx512))  { return isa_avx512; }
+    if(simd::has_isa(isa_avx2  ))  { return isa_avx2;   }
+    
+    return isa_sse2;
+    }
+  #elif defined(ARMA_USE_SIMD) && defined(ARMA_SIMD_NEON)
+    {
+    return isa_neon;
+    }
+  #else
+    {
+    return isa_none;
+    }
+  #endif
+  }
+
+
+
+//! instruction set currently used by the kernels
+inline
+uword
+simd::get_isa()
+  {
+  return simd::get_state().load(std::memory_order_relaxed);
+  }
+
+
+
+//! select the instruction set used by the kernels (eg. for benchmarking);
+//! returns false if the instruction set is not supported by the CPU or was not enabled at compile time;
+//! isa_none disables the kernels
+inline
+bool
+simd::set_isa(const uword in_isa)
+  {
+  arma_debug_sigprint();
+  
+  if(simd::has_isa(in_isa) == false)  { return false; }
+  
+  simd::get_state().store(in_isa, std::memory_order_relaxed);
+  
+  return true;
+  }
+
+
+
+inline
+bool
+simd::has_isa(const uword in_isa)
+  {
+  if(in_isa == isa_none)  { return true; }
+  
+  #if defined(ARMA_USE_SIMD) && defined(ARMA_SIMD_X86)
+    {
+    __builtin_cpu_init();
+    
+    if(in_isa == isa_sse2  )  { return true; }
+    if(in_isa == isa_avx2  )  { return (__builtin_cpu_supports("avx2"   ) != 0); }
+    if(in_isa == isa_avx512)  { return (__builtin_cpu_supports("avx512f") != 0); }
+    }
+  #elif defined(ARMA_USE_SIMD) && defined(ARMA_SIMD_NEON)
+    {
+    if(in_isa == isa_neon)  { return true; }
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+inline
+const char*
+simd::isa_name(const uword in_isa)
+  {
+  if(in_isa == isa_none  )  { return "none";    }
+  if(in_isa == isa_sse2  )  { return "SSE2";    }
+  if(in_isa == isa_avx2  )  { return "AVX2";    }
+  if(in_isa == isa_avx512)  { return "AVX-512"; }
+  if(in_isa == isa_neon  )  { return "NEON";    }
+  
+  return "unknown";
+  }
+
+
+
+template<const uword op, typename T>
+inline
+bool
+simd::binary_dispatch(T* out, const T* A, const T* B, const uword n_elem)
+  {
+  if( (op == simd_op::none) || (n_elem < simd::min_n_elem) )  { return false; }
+  
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::binary<op>(out, A, B, n_elem); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::binary<op>  (out, A, B, n_elem); return true; }
+      if(isa == isa_sse2  )  { simd_sse2::binary<op>  (out, A, B, n_elem); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::binary<op>(out, A, B, n_elem); return true; }
+      }
+    #endif
+    }
+  #else
+    {
+    arma_ignore(out);
+    arma_ignore(A);
+    arma_ignore(B);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<const uword op, typename T>
+inline
+bool
+simd::unary_dispatch(T* out, const T* A, const uword n_elem, const T k)
+  {
+  if( (op == simd_op::none) || (n_elem < simd::min_n_elem) )  { return false; }
+  
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::unary<op>(out, A, n_elem, k); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::unary<op>  (out, A, n_elem, k); return true; }
+      if(isa == isa_sse2  )  { simd_sse2::unary<op>  (out, A, n_elem, k); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::unary<op>(out, A, n_elem, k); return true; }
+      }
+    #endif
+    }
+  #else
+    {
+    arma_ignore(out);
+    arma_ignore(A);
+    arma_ignore(k);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<typename T>
+inline
+bool
+simd::accumulate_dispatch(T* out, const uword n_elem_per_group, const T* A, const uword n_elem)
+  {
+  if(n_elem < simd::min_n_elem)  { return false; }
+  
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::accumulate(out, n_elem_per_group, A, n_elem); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::accumulate  (out, n_elem_per_group, A, n_elem); return true; }
+      if(isa == isa_sse2  )  { simd_sse2::accumulate  (out, n_elem_per_group, A, n_elem); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::accumulate(out, n_elem_per_group, A, n_elem); return true; }
+      }
+    #endif
+    }
+  #else
+    {
+    arma_ignore(out);
+    arma_ignore(n_elem_per_group);
+    arma_ignore(A);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<typename T>
+inline
+bool
+simd::clamp_dispatch(T* out, const T* A, const uword n_elem, const T min_val, const T max_val)
+  {
+  if(n_elem < simd::min_n_elem)  { return false; }
+  
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::clamp(out, A, n_elem, min_val, max_val); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::clamp  (out, A, n_elem, min_val, max_val); return true; }
+      if(isa == isa_sse2  )  { simd_sse2::clamp  (out, A, n_elem, min_val, max_val); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::clamp(out, A, n_elem, min_val, max_val); return true; }
+      }
+    #endif
+    }
+  #else
+    {
+    arma_ignore(out);
+    arma_ignore(A);
+    arma_ignore(min_val);
+    arma_ignore(max_val);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<const uword MR, const uword NR, typename T>
+inline
+bool
+simd::gemm_micro_dispatch(T* ab, const uword kc, const T* a, const T* b)
+  {
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    // SSE2 is not used, as its 16 registers cannot hold the accumulators;
+    // the compiler generates comparable code for the generic micro-kernel
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::gemm_micro<MR,NR>(ab, kc, a, b); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::gemm_micro<MR,NR>  (ab, kc, a, b); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::gemm_micro<MR,NR>(ab, kc, a, b); return true; }
+      }
+    #endif
+    
+    arma_ignore(isa);
+    }
+  #else
+    {
+    arma_ignore(ab);
+    arma_ignore(kc);
+    arma_ignore(a);
+    arma_ignore(b);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<typename T>
+inline
+bool
+simd::batch_mul_dispatch(T* c, const T* a, const T* b, const uword M, const uword K, const uword N, const uword n_lanes)
+  {
+  // the lanes are processed in vectors of up to 64 bytes
+  if( (n_lanes == 0) || ((n_lanes % (uword(64) / uword(sizeof(T)))) != 0) )  { return false; }
+  
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::batch_mul(c, a, b, M, K, N, n_lanes); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::batch_mul  (c, a, b, M, K, N, n_lanes); return true; }
+      if(isa == isa_sse2  )  { simd_sse2::batch_mul  (c, a, b, M, K, N, n_lanes); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::batch_mul(c, a, b, M, K, N, n_lanes); return true; }
+      }
+    #endif
+    }
+  #else
+    {
+    arma_ignore(c);
+    arma_ignore(a);
+    arma_ignore(b);
+    arma_ignore(M);
+    arma_ignore(K);
+    arma_ignore(N);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<typename T>
+inline
+bool
+simd::batch_chol_dispatch(T* a, T* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  // the lanes are processed in vectors of up to 64 bytes
+  if( (n_lanes == 0) || ((n_lanes % (uword(64) / uword(sizeof(T)))) != 0) )  { return false; }
+  
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::batch_chol(a, b, N, n_rhs, n_lanes); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::batch_chol  (a, b, N, n_rhs, n_lanes); return true; }
+      if(isa == isa_sse2  )  { simd_sse2::batch_chol  (a, b, N, n_rhs, n_lanes); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::batch_chol(a, b, N, n_rhs, n_lanes); return true; }
+      }
+    #endif
+    }
+  #else
+    {
+    arma_ignore(a);
+    arma_ignore(b);
+    arma_ignore(N);
+    arma_ignore(n_rhs);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+template<typename T>
+inline
+bool
+simd::batch_lu_solve_dispatch(T* a, T* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  // the lanes are processed in vectors of up to 64 bytes
+  if( (n_lanes == 0) || ((n_lanes % (uword(64) / uword(sizeof(T)))) != 0) )  { return false; }
+  
+  #if defined(ARMA_USE_SIMD)
+    {
+    const uword isa = simd::get_isa();
+    
+    #if defined(ARMA_SIMD_X86)
+      {
+      if(isa == isa_avx512)  { simd_avx512::batch_lu_solve(a, b, N, n_rhs, n_lanes); return true; }
+      if(isa == isa_avx2  )  { simd_avx2::batch_lu_solve  (a, b, N, n_rhs, n_lanes); return true; }
+      if(isa == isa_sse2  )  { simd_sse2::batch_lu_solve  (a, b, N, n_rhs, n_lanes); return true; }
+      }
+    #elif defined(ARMA_SIMD_NEON)
+      {
+      if(isa == isa_neon)  { simd_neon::batch_lu_solve(a, b, N, n_rhs, n_lanes); return true; }
+      }
+    #endif
+    }
+  #else
+    {
+    arma_ignore(a);
+    arma_ignore(b);
+    arma_ignore(N);
+    arma_ignore(n_rhs);
+    }
+  #endif
+  
+  return false;
+  }
+
+
+
+// 
+// binary
+
+
+
+template<const uword op, typename eT>
+inline
+bool
+simd::binary(eT* out, const eT* A, const eT* B, const uword n_elem)
+  {
+  arma_ignore(out);
+  arma_ignore(A);
+  arma_ignore(B);
+  arma_ignore(n_elem);
+  
+  return false;
+  }
+
+
+
+template<const uword op>
+inline
+bool
+simd::binary(float* out, const float* A, const float* B, const uword n_elem)
+  {
+  return simd::binary_dispatch<op>(out, A, B, n_elem);
+  }
+
+
+
+template<const uword op>
+inline
+bool
+simd::binary(double* out, const double* A, const double* B, const uword n_elem)
+  {
+  return simd::binary_dispatch<op>(out, A, B, n_elem);
+  }
+
+
+
+template<const uword op, typename T>
+inline
+bool
+simd::binary(std::complex<T>* out, const std::complex<T>* A, const std::complex<T>* B, const uword n_elem)
+  {
+  // only addition and subtraction act independently on the real and imaginary parts
+  
+  if( (op != simd_op::plus) && (op != simd_op::minus) )  { return false; }
+  
+  return simd::binary<op>( reinterpret_cast<T*>(out), reinterpret_cast<const T*>(A), reinterpret_cast<const T*>(B), 2*n_elem );
+  }
+
+
+
+template<const uword op, typename eT, typename ea1_type, typename ea2_type>
+inline
+bool
+simd::binary_ea(eT* out, const ea1_type& A, const ea2_type& B, const uword start, const uword endp1)
+  {
+  arma_ignore(out);
+  arma_ignore(A);
+  arma_ignore(B);
+  arma_ignore(start);
+  arma_ignore(endp1);
+  
+  return false;
+  }
+
+
+
+template<const uword op, typename eT>
+inline
+bool
+simd::binary_ea(eT* out, const eT* const& A, const eT* const& B, const uword start, const uword endp1)
+  {
+  return simd::binary<op>(out + start, A + start, B + start, endp1 - start);
+  }
+
+
+
+// 
+// unary
+
+
+
+template<const uword op, typename eT>
+inline
+bool
+simd::unary(eT* out, const eT* A, const uword n_elem, const eT k)
+  {
+  arma_ignore(out);
+  arma_ignore(A);
+  arma_ignore(n_elem);
+  arma_ignore(k);
+  
+  return false;
+  }
+
+
+
+template<const uword op>
+inline
+bool
+simd::unary(float* out, const float* A, const uword n_elem, const float k)
+  {
+  return simd::unary_dispatch<op>(out, A, n_elem, k);
+  }
+
+
+
+template<const uword op>
+inline
+bool
+simd::unary(double* out, const double* A, const uword n_elem, const double k)
+  {
+  return simd::unary_dispatch<op>(out, A, n_elem, k);
+  }
+
+
+
+template<const uword op, typename T>
+inline
+bool
+simd::unary(std::complex<T>* out, const std::complex<T>* A, const uword n_elem, const std::complex<T> k)
+  {
+  // only negation acts independently on the real and imaginary parts
+  
+  if(op != simd_op::neg)  { return false; }
+  
+  return simd::unary<op>( reinterpret_cast<T*>(out), reinterpret_cast<const T*>(A), 2*n_elem, std::real(k) );
+  }
+
+
+
+template<const uword op, typename eT, typename ea_type>
+inline
+bool
+simd::unary_ea(eT* out, const ea_type& A, const uword start, const uword endp1, const eT k)
+  {
+  arma_ignore(out);
+  arma_ignore(A);
+  arma_ignore(start);
+  arma_ignore(endp1);
+  arma_ignore(k);
+  
+  return false;
+  }
+
+
+
+template<const uword op, typename eT>
+inline
+bool
+simd::unary_ea(eT* out, const eT* const& A, const uword start, const uword endp1, const eT k)
+  {
+  return simd::unary<op>(out + start, A + start, endp1 - start, k);
+  }
+
+
+
+// 
+// accumulate
+
+
+
+template<typename eT>
+inline
+bool
+simd::accumulate(eT& out, const eT* A, const uword n_elem)
+  {
+  arma_ignore(out);
+  arma_ignore(A);
+  arma_ignore(n_elem);
+  
+  return false;
+  }
+
+
+
+inline
+bool
+simd::accumulate(float& out, const float* A, const uword n_elem)
+  {
+  return simd::accumulate_dispatch(&out, 1, A, n_elem);
+  }
+
+
+
+inline
+bool
+simd::accumulate(double& out, const double* A, const uword n_elem)
+  {
+  return simd::accumulate_dispatch(&out, 1, A, n_elem);
+  }
+
+
+
+template<typename T>
+inline
+bool
+simd::accumulate(std::complex<T>& out, const std::complex<T>* A, const uword n_elem)
+  {
+  T tmp[2];
+  
+  if(simd::accumulate_dispatch(&tmp[0], 2, reinterpret_cast<const T*>(A), 2*n_elem) == false)  { return false; }
+  
+  out = std::complex<T>(tmp[0], tmp[1]);
+  
+  return true;
+  }
+
+
+
+// 
+// clamp
+
+
+
+template<typename eT>
+inline
+bool
+simd::clamp(eT* out, const eT* A, const uword n_elem, const eT min_val, const eT max_val)
+  {
+  arma_ignore(out);
+  arma_ignore(A);
+  arma_ignore(n_elem);
+  arma_ignore(min_val);
+  arma_ignore(max_val);
+  
+  return false;
+  }
+
+
+
+inline
+bool
+simd::clamp(float* out, const float* A, const uword n_elem, const float min_val, const float max_val)
+  {
+  return simd::clamp_dispatch(out, A, n_elem, min_val, max_val);
+  }
+
+
+
+inline
+bool
+simd::clamp(double* out, const double* A, const uword n_elem, const double min_val, const double max_val)
+  {
+  return simd::clamp_dispatch(out, A, n_elem, min_val, max_val);
+  }
+
+
+
+// 
+// gemm_micro
+
+
+
+template<const uword MR, const uword NR, typename eT>
+inline
+bool
+simd::gemm_micro(eT* ab, const uword kc, const eT* a, const eT* b)
+  {
+  arma_ignore(ab);
+  arma_ignore(kc);
+  arma_ignore(a);
+  arma_ignore(b);
+  
+  return false;
+  }
+
+
+
+template<const uword MR, const uword NR>
+inline
+bool
+simd::gemm_micro(float* ab, const uword kc, const float* a, const float* b)
+  {
+  return simd::gemm_micro_dispatch<MR,NR>(ab, kc, a, b);
+  }
+
+
+
+template<const uword MR, const uword NR>
+inline
+bool
+simd::gemm_micro(double* ab, const uword kc, const double* a, const double* b)
+  {
+  return simd::gemm_micro_dispatch<MR,NR>(ab, kc, a, b);
+  }
+
+
+
+// 
+// batch
+
+
+
+template<typename eT>
+inline
+bool
+simd::batch_mul(eT* c, const eT* a, const eT* b, const uword M, const uword K, const uword N, const uword n_lanes)
+  {
+  arma_ignore(c);
+  arma_ignore(a);
+  arma_ignore(b);
+  arma_ignore(M);
+  arma_ignore(K);
+  arma_ignore(N);
+  arma_ignore(n_lanes);
+  
+  return false;
+  }
+
+
+
+inline
+bool
+simd::batch_mul(float* c, const float* a, const float* b, const uword M, const uword K, const uword N, const uword n_lanes)
+  {
+  return simd::batch_mul_dispatch(c, a, b, M, K, N, n_lanes);
+  }
+
+
+
+inline
+bool
+simd::batch_mul(double* c, const double* a, const double* b, const uword M, const uword K, const uword N, const uword n_lanes)
+  {
+  return simd::batch_mul_dispatch(c, a, b, M, K, N, n_lanes);
+  }
+
+
+
+
+template<typename eT>
+inline
+bool
+simd::batch_chol(eT* a, eT* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  arma_ignore(a);
+  arma_ignore(b);
+  arma_ignore(N);
+  arma_ignore(n_rhs);
+  arma_ignore(n_lanes);
+  
+  return false;
+  }
+
+
+
+inline
+bool
+simd::batch_chol(float* a, float* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  return simd::batch_chol_dispatch(a, b, N, n_rhs, n_lanes);
+  }
+
+
+
+inline
+bool
+simd::batch_chol(double* a, double* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  return simd::batch_chol_dispatch(a, b, N, n_rhs, n_lanes);
+  }
+
+
+
+
+template<typename eT>
+inline
+bool
+simd::batch_lu_solve(eT* a, eT* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  arma_ignore(a);
+  arma_ignore(b);
+  arma_ignore(N);
+  arma_ignore(n_rhs);
+  arma_ignore(n_lanes);
+  
+  return false;
+  }
+
+
+
+inline
+bool
+simd::batch_lu_solve(float* a, float* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  return simd::batch_lu_solve_dispatch(a, b, N, n_rhs, n_lanes);
+  }
+
+
+
+inline
+bool
+simd::batch_lu_solve(double* a, double* b, const uword N, const uword n_rhs, const uword n_lanes)
+  {
+  return simd::batch_lu_solve_dispatch(a, b, N, n_rhs, n_lanes);
+  }
+
+
+
+//! @}
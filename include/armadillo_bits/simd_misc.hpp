@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup simd_misc
+//! @{
+
+
+
+//! element-wise operations provided by the explicit SIMD kernels
+struct simd_op
+  {
+  static constexpr uword none              =  0;
+  
+  static constexpr uword plus              =  1;  //!< A + B
+  static constexpr uword minus             =  2;  //!< A - B
+  static constexpr uword schur             =  3;  //!< A % B
+  static constexpr uword div               =  4;  //!< A / B
+  
+  static constexpr uword scalar_plus       =  5;  //!< A + k
+  static constexpr uword scalar_minus_pre  =  6;  //!< k - A
+  static constexpr uword scalar_minus_post =  7;  //!< A - k
+  static constexpr uword scalar_times      =  8;  //!< A * k
+  static constexpr uword scalar_div_pre    =  9;  //!< k / A
+  static constexpr uword scalar_div_post   = 10;  //!< A / k
+  static constexpr uword square            = 11;
+  static constexpr uword neg               = 12;
+  static constexpr uword abs               = 13;
+  static constexpr uword sqrt              = 14;
+  static constexpr uword exp               = 15;
+  static constexpr uword log               = 16;
+  static constexpr uword trunc_exp         = 17;
+  
+  //! operations evaluated via polynomial approximations instead of the instructions of the CPU
+  static constexpr bool is_approx(const uword op)  { return (op >= simd_op::exp); }
+  
+  template<const uword op, typename T> arma_inline static T binary(const T a, const T b);
+  template<const uword op, typename T> arma_inline static T unary (const T a, const T k);
+  };
+
+
+
+#if defined(ARMA_USE_SIMD)
+
+#undef arma_simd_target
+
+
+#if defined(ARMA_SIMD_X86)
+
+#define arma_simd_target
+
+//! SSE2 kernels; SSE2 is part of the x86-64 baseline
+struct simd_sse2
+  {
+  arma_inline static __m128d load(const double* A)   { return _mm_loadu_pd(A); }
+  arma_inline static __m128  load(const float*  A)   { return _mm_loadu_ps(A); }
+  
+  arma_inline static void store(double* A, const __m128d x)  { _mm_storeu_pd(A, x); }
+  arma_inline static void store(float*  A, const __m128  x)  { _mm_storeu_ps(A, x); }
+  
+  arma_inline static __m128d set1(const double k)  { return _mm_set1_pd(k); }
+  arma_inline static __m128  set1(const float  k)  { return _mm_set1_ps(k); }
+  
+  arma_inline static __m128d add (const __m128d a, const __m128d b)  { return _mm_add_pd(a,b); }
+  arma_inline static __m128  add (const __m128  a, const __m128  b)  { return _mm_add_ps(a,b); }
+  arma_inline static __m128d sub (const __m128d a, const __m128d b)  { return _mm_sub_pd(a,b); }
+  arma_inline static __m128  sub (const __m128  a, const __m128  b)  { return _mm_sub_ps(a,b); }
+  arma_inline static __m128d mul (const __m128d a, const __m128d b)  { return _mm_mul_pd(a,b); }
+  arma_inline static __m128  mul (const __m128  a, const __m128  b)  { return _mm_mul_ps(a,b); }
+  arma_inline static __m128d div (const __m128d a, const __m128d b)  { return _mm_div_pd(a,b); }
+  arma_inline static __m128  div (const __m128  a, const __m128  b)  { return _mm_div_ps(a,b); }
+  arma_inline static __m128d min (const __m128d a, const __m128d b)  { return _mm_min_pd(a,b); }
+  arma_inline static __m128  min (const __m128  a, const __m128  b)  { return _mm_min_ps(a,b); }
+  arma_inline static __m128d max (const __m128d a, const __m128d b)  { return _mm_max_pd(a,b); }
+  arma_inline static __m128  max (const __m128  a, const __m128  b)  { return _mm_max_ps(a,b); }
+  
+  arma_inline static __m128d sqrt(const __m128d a)  { return _mm_sqrt_pd(a); }
+  arma_inline static __m128  sqrt(const __m128  a)  { return _mm_sqrt_ps(a); }
+  arma_inline static __m128d abs (const __m128d a)  { return _mm_andnot_pd(_mm_set1_pd(-0.0 ), a); }
+  arma_inline static __m128  abs (const __m128  a)  { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+  arma_inline static __m128d neg (const __m128d a)  { return _mm_xor_pd   (_mm_set1_pd(-0.0 ), a); }
+  arma_inline static __m128  neg (const __m128  a)  { return _mm_xor_ps   (_mm_set1_ps(-0.0f), a); }
+  
+  // helpers for the exp() and log() kernels:
+  // exponent() and mantissa() split a positive normal number into its unbiased exponent and a mantissa in [1,2);
+  // exp2_bits() moves the low bits of the mantissa into the exponent field;
+  // select_gt() provides x where a > b, and y otherwise;
+  // all_within() checks whether all elements are in the range [lo,hi], which is false for NaN
+  arma_inline static __m128d exponent (const __m128d a)  { return _mm_sub_pd(_mm_or_pd(_mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(a), 52)), _mm_set1_pd(4503599627370496.0)), _mm_set1_pd(4503599627370496.0 + 1023.0)); }
+  arma_inline static __m128  exponent (const __m128  a)  { return _mm_sub_ps(_mm_or_ps(_mm_castsi128_ps(_mm_srli_epi32(_mm_castps_si128(a), 23)), _mm_set1_ps(8388608.0f        )), _mm_set1_ps(8388608.0f         + 127.0f)); }
+  arma_inline static __m128d mantissa (const __m128d a)  { return _mm_or_pd(_mm_and_pd(a, _mm_castsi128_pd(_mm_set1_epi64x(0x000FFFFFFFFFFFFFLL))), _mm_set1_pd(1.0 )); }
+  arma_inline static __m128  mantissa (const __m128  a)  { return _mm_or_ps(_mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32 (0x007FFFFF          ))), _mm_set1_ps(1.0f)); }
+  arma_inline static __m128d exp2_bits(const __m128d a)  { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(a), 52)); }
+  arma_inline static __m128  exp2_bits(const __m128  a)  { return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(a), 23)); }
+  
+  arma_inline static __m128d select_gt(const __m128d a, const __m128d b, const __m128d x, const __m128d y)  { const __m128d c = _mm_cmpgt_pd(a,b); return _mm_or_pd(_mm_and_pd(c,x), _mm_andnot_pd(c,y)); }
+  arma_inline static __m128  select_gt(const __m128  a, const __m128  b, const __m128  x, const __m128  y)  { const __m128  c = _mm_cmpgt_ps(a,b); return _mm_or_ps(_mm_and_ps(c,x), _mm_andnot_ps(c,y)); }
+  
+  arma_inline static bool all_within(const __m128d a, const __m128d lo, const __m128d hi)  { return (_mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(a,lo), _mm_cmple_pd(a,hi))) == 0x3); }
+  arma_inline static bool all_within(const __m128  a, const __m128  lo, const __m128  hi)  { return (_mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(a,lo), _mm_cmple_ps(a,hi))) == 0xF); }
+  
+  #include "simd_kernels.hpp"
+  };
+
+#undef  arma_simd_target
+#define arma_simd_target __attribute__((__target__("avx2")))
+
+//! AVX2 kernels; only used when the CPU supports AVX2
+struct simd_avx2
+  {
+  arma_simd_target arma_inline static __m256d load(const double* A)   { return _mm256_loadu_pd(A); }
+  arma_simd_target arma_inline static __m256  load(const float*  A)   { return _mm256_loadu_ps(A); }
+  
+  arma_simd_target arma_inline static void store(double* A, const __m256d x)  { _mm256_storeu_pd(A, x); }
+  arma_simd_target arma_inline static void store(float*  A, const __m256  x)  { _mm256_storeu_ps(A, x); }
+  
+  arma_simd_target arma_inline static __m256d set1(const double k)  { return _mm256_set1_pd(k); }
+  arma_simd_target arma_inline static __m256  set1(const float  k)  { return _mm256_set1_ps(k); }
+  
+  arma_simd_target arma_inline static __m256d add (const __m256d a, const __m256d b)  { return _mm256_add_pd(a,b); }
+  arma_simd_target arma_inline static __m256  add (const __m256  a, const __m256  b)  { return _mm256_add_ps(a,b); }
+  arma_simd_target arma_inline static __m256d sub (const __m256d a, const __m256d b)  { return _mm256_sub_pd(a,b); }
+  arma_simd_target arma_inline static __m256  sub (const __m256  a, const __m256  b)  { return _mm256_sub_ps(a,b); }
+  arma_simd_target arma_inline static __m256d mul (const __m256d a, const __m256d b)  { return _mm256_mul_pd(a,b); }
+  arma_simd_target arma_inline static __m256  mul (const __m256  a, const __m256  b)  { return _mm256_mul_ps(a,b); }
+  arma_simd_target arma_inline static __m256d div (const __m256d a, const __m256d b)  { return _mm256_div_pd(a,b); }
+  arma_simd_target arma_inline static __m256  div (const __m256  a, const __m256  b)  { return _mm256_div_ps(a,b); }
+  arma_simd_target arma_inline static __m256d min (const __m256d a, const __m256d b)  { return _mm256_min_pd(a,b); }
+  arma_simd_target arma_inline static __m256  min (const __m256  a, const __m256  b)  { return _mm256_min_ps(a,b); }
+  arma_simd_target arma_inline static __m256d max (const __m256d a, const __m256d b)  { return _mm256_max_pd(a,b); }
+  arma_simd_target arma_inline static __m256  max (const __m256  a, const __m256  b)  { return _mm256_max_ps(a,b); }
+  
+  arma_simd_target arma_inline static __m256d sqrt(const __m256d a)  { return _mm256_sqrt_pd(a); }
+  arma_simd_target arma_inline static __m256  sqrt(const __m256  a)  { return _mm256_sqrt_ps(a); }
+  arma_simd_target arma_inline static __m256d abs (const __m256d a)  { return _mm256_andnot_pd(_mm256_set1_pd(-0.0 ), a); }
+  arma_simd_target arma_inline static __m256  abs (const __m256  a)  { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+  arma_simd_target arma_inline static __m256d neg (const __m256d a)  { return _mm256_xor_pd   (_mm256_set1_pd(-0.0 ), a); }
+  arma_simd_target arma_inline static __m256  neg (const __m256  a)  { return _mm256_xor_ps   (_mm256_set1_ps(-0.0f), a); }
+  
+  arma_simd_target arma_inline static __m256d exponent (const __m256d a)  { return _mm256_sub_pd(_mm256_or_pd(_mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(a), 52)), _mm256_set1_pd(4503599627370496.0)), _mm256_set1_pd(4503599627370496.0 + 1023.0)); }
+  arma_simd_target arma_inline static __m256  exponent (const __m256  a)  { return _mm256_sub_ps(_mm256_or_ps(_mm256_castsi256_ps(_mm256_srli_epi32(_mm256_castps_si256(a), 23)), _mm256_set1_ps(8388608.0f        )), _mm256_set1_ps(8388608.0f         + 127.0f)); }
+  arma_simd_target arma_inline static __m256d mantissa (const __m256d a)  { return _mm256_or_pd(_mm256_and_pd(a, _mm256_castsi256_pd(_mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL))), _mm256_set1_pd(1.0 )); }
+  arma_simd_target arma_inline static __m256  mantissa (const __m256  a)  { return _mm256_or_ps(_mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32 (0x007FFFFF          ))), _mm256_set1_ps(1.0f)); }
+  arma_simd_target arma_inline static __m256d exp2_bits(const __m256d a)  { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a), 52)); }
+  arma_simd_target arma_inline static __m256  exp2_bits(const __m256  a)  { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(a), 23)); }
+  
+  arma_simd_target arma_inline static __m256d select_gt(const __m256d a, const __m256d b, const __m256d x, const __m256d y)  { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+  arma_simd_target arma_inline static __m256  select_gt(const __m256  a, const __m256  b, const __m256  x, const __m256  y)  { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+  
+  arma_simd_target arma_inline static bool all_within(const __m256d a, const __m256d lo, const __m256d hi)  { return (_mm256_movemask_pd(_mm256_and_pd(_mm256_cmp_pd(a, lo, _CMP_GE_OQ), _mm256_cmp_pd(a, hi, _CMP_LE_OQ))) == 0xF ); }
+  arma_simd_target arma_inline static bool all_within(const __m256  a, const __m256  lo, const __m256  hi)  { return (_mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(a, lo, _CMP_GE_OQ), _mm256_cmp_ps(a, hi, _CMP_LE_OQ))) == 0xFF); }
+  
+  #include "simd_kernels.hpp"
+  };
+
+#undef  arma_simd_target
+#define arma_simd_target __attribute__((__target__("avx512f")))
+
+//! AVX-512 kernels; only used when the CPU supports AVX-512F;
+//! bitwise operations on floating point vectors are done in the integer domain, as they would otherwise require AVX-512DQ
+struct simd_avx512
+  {
+  arma_simd_target arma_inline static __m512d load(const double* A)   { return _mm512_loadu_pd(A); }
+  arma_simd_target arma_inline static __m512  load(const float*  A)   { return _mm512_loadu_ps(A); }
+  
+  arma_simd_target arma_inline static void store(double* A, const __m512d x)  { _mm512_storeu_pd(A, x); }
+  arma_simd_target arma_inline static void store(float*  A, const __m512  x)  { _mm512_storeu_ps(A, x); }
+  
+  arma_simd_target arma_inline static __m512d set1(const double k)  { return _mm512_set1_pd(k); }
+  arma_simd_target arma_inline static __m512  set1(const float  k)  { return _mm512_set1_ps(k); }
+  
+  arma_simd_target arma_inline static __m512d add (const __m512d a, const __m512d b)  { return _mm512_add_pd(a,b); }
+  arma_simd_target arma_inline static __m512  add (const __m512  a, const __m512  b)  { return _mm512_add_ps(a,b); }
+  arma_simd_target arma_inline static __m512d sub (const __m512d a, const __m512d b)  { return _mm512_sub_pd(a,b); }
+  arma_simd_target arma_inline static __m512  sub (const __m512  a, const __m512  b)  { return _mm512_sub_ps(a,b); }
+  arma_simd_target arma_inline static __m512d mul (const __m512d a, const __m512d b)  { return _mm512_mul_pd(a,b); }
+  arma_simd_target arma_inline static __m512  mul (const __m512  a, const __m512  b)  { return _mm512_mul_ps(a,b); }
+  arma_simd_target arma_inline static __m512d div (const __m512d a, const __m512d b)  { return _mm512_div_pd(a,b); }
+  arma_simd_target arma_inline static __m512  div (const __m512  a, const __m512  b)  { return _mm512_div_ps(a,b); }
+  // the zero-masking variants with all mask bits set are used, as the unmasked variants trigger spurious -Wmaybe-uninitialized warnings in some versions of GCC
+  arma_simd_target arma_inline static __m512d min (const __m512d a, const __m512d b)  { return _mm512_maskz_min_pd(__mmask8 (0xFF  ), a, b); }
+  arma_simd_target arma_inline static __m512  min (const __m512  a, const __m512  b)  { return _mm512_maskz_min_ps(__mmask16(0xFFFF), a, b); }
+  arma_simd_target arma_inline static __m512d max (const __m512d a, const __m512d b)  { return _mm512_maskz_max_pd(__mmask8 (0xFF  ), a, b); }
+  arma_simd_target arma_inline static __m512  max (const __m512  a, const __m512  b)  { return _mm512_maskz_max_ps(__mmask16(0xFFFF), a, b); }
+  
+  arma_simd_target arma_inline static __m512d sqrt(const __m512d a)  { return _mm512_maskz_sqrt_pd(__mmask8 (0xFF  ), a); }
+  arma_simd_target arma_inline static __m512  sqrt(const __m512  a)  { return _mm512_maskz_sqrt_ps(__mmask16(0xFFFF), a); }
+  
+  arma_simd_target arma_inline static __m512d abs (const __m512d a)  { return _mm512_castsi512_pd( _mm512_and_si512(_mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL), _mm512_castpd_si512(a)) ); }
+  arma_simd_target arma_inline static __m512  abs (const __m512  a)  { return _mm512_castsi512_ps( _mm512_and_si512(_mm512_set1_epi32(0x7FFFFFFF          ), _mm512_castps_si512(a)) ); }
+  arma_simd_target arma_inline static __m512d neg (const __m512d a)  { return _mm512_castsi512_pd( _mm512_xor_si512(_mm512_castpd_si512(_mm512_set1_pd(-0.0 )), _mm512_castpd_si512(a)) ); }
+  arma_simd_target arma_inline static __m512  neg (const __m512  a)  { return _mm512_castsi512_ps( _mm512_xor_si512(_mm512_castps_si512(_mm512_set1_ps(-0.0f)), _mm512_castps_si512(a)) ); }
+  
+  arma_simd_target arma_inline static __m512d exponent (const __m512d a)  { return _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_maskz_srli_epi64(__mmask8 (0xFF  ), _mm512_castpd_si512(a), 52), _mm512_castpd_si512(_mm512_set1_pd(4503599627370496.0)))), _mm512_set1_pd(4503599627370496.0 + 1023.0)); }
+  arma_simd_target arma_inline static __m512  exponent (const __m512  a)  { return _mm512_sub_ps(_mm512_castsi512_ps(_mm512_or_si512(_mm512_maskz_srli_epi32(__mmask16(0xFFFF), _mm512_castps_si512(a), 23), _mm512_castps_si512(_mm512_set1_ps(8388608.0f        )))), _mm512_set1_ps(8388608.0f         + 127.0f)); }
+  arma_simd_target arma_inline static __m512d mantissa (const __m512d a)  { return _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL)), _mm512_castpd_si512(_mm512_set1_pd(1.0 )))); }
+  arma_simd_target arma_inline static __m512  mantissa (const __m512  a)  { return _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x007FFFFF          )), _mm512_castps_si512(_mm512_set1_ps(1.0f)))); }
+  arma_simd_target arma_inline static __m512d exp2_bits(const __m512d a)  { return _mm512_castsi512_pd(_mm512_maskz_slli_epi64(__mmask8 (0xFF  ), _mm512_castpd_si512(a), 52)); }
+  arma_simd_target arma_inline static __m512  exp2_bits(const __m512  a)  { return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(__mmask16(0xFFFF), _mm512_castps_si512(a), 23)); }
+  
+  arma_simd_target arma_inline static __m512d select_gt(const __m512d a, const __m512d b, const __m512d x, const __m512d y)  { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_GT_OQ), y, x); }
+  arma_simd_target arma_inline static __m512  select_gt(const __m512  a, const __m512  b, const __m512  x, const __m512  y)  { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ), y, x); }
+  
+  arma_simd_target arma_inline static bool all_within(const __m512d a, const __m512d lo, const __m512d hi)  { return (_mm512_mask_cmp_pd_mask(_mm512_cmp_pd_mask(a, lo, _CMP_GE_OQ), a, hi, _CMP_LE_OQ) == __mmask8 (0xFF  )); }
+  arma_simd_target arma_inline static bool all_within(const __m512  a, const __m512  lo, const __m512  hi)  { return (_mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(a, lo, _CMP_GE_OQ), a, hi, _CMP_LE_OQ) == __mmask16(0xFFFF)); }
+  
+  #include "simd_kernels.hpp"
+  };
+
+#undef arma_simd_target
+
+#endif
+
+
+
+#if defined(ARMA_SIMD_NEON)
+
+#define arma_simd_target
+
+//! NEON kernels; NEON (including double precision) is part of the AArch64 baseline
+struct simd_neon
+  {
+  arma_inline static float64x2_t load(const double* A)   { return vld1q_f64(A); }
+  arma_inline static float32x4_t load(const float*  A)   { return vld1q_f32(A); }
+  
+  arma_inline static void store(double* A, const float64x2_t x)  { vst1q_f64(A, x); }
+  arma_inline static void store(float*  A, const float32x4_t x)  { vst1q_f32(A, x); }
+  
+  arma_inline static float64x2_t set1(const double k)  { return vdupq_n_f64(k); }
+  arma_inline static float32x4_t set1(const float  k)  { return vdupq_n_f32(k); }
+  
+  arma_inline static float64x2_t add (const float64x2_t a, const float64x2_t b)  { return vaddq_f64(a,b); }
+  arma_inline static float32x4_t add (const float32x4_t a, const float32x4_t b)  { return vaddq_f32(a,b); }
+  arma_inline static float64x2_t sub (const float64x2_t a, const float64x2_t b)  { return vsubq_f64(a,b); }
+  arma_inline static float32x4_t sub (const float32x4_t a, const float32x4_t b)  { return vsubq_f32(a,b); }
+  arma_inline static float64x2_t mul (const float64x2_t a, const float64x2_t b)  { return vmulq_f64(a,b); }
+  arma_inline static float32x4_t mul (const float32x4_t a, const float32x4_t b)  { return vmulq_f32(a,b); }
+  arma_inline static float64x2_t div (const float64x2_t a, const float64x2_t b)  { return vdivq_f64(a,b); }
+  arma_inline static float32x4_t div (const float32x4_t a, const float32x4_t b)  { return vdivq_f32(a,b); }
+  arma_inline static float64x2_t min (const float64x2_t a, const float64x2_t b)  { return vminq_f64(a,b); }
+  arma_inline static float32x4_t min (const float32x4_t a, const float32x4_t b)  { return vminq_f32(a,b); }
+  arma_inline static float64x2_t max (const float64x2_t a, const float64x2_t b)  { return vmaxq_f64(a,b); }
+  arma_inline static float32x4_t max (const float32x4_t a, const float32x4_t b)  { return vmaxq_f32(a,b); }
+  
+  arma_inline static float64x2_t sqrt(const float64x2_t a)  { return vsqrtq_f64(a); }
+  arma_inline static float32x4_t sqrt(const float32x4_t a)  { return vsqrtq_f32(a); }
+  arma_inline static float64x2_t abs (const float64x2_t a)  { return vabsq_f64(a);   }
+  arma_inline static float32x4_t abs (const float32x4_t a)  { return vabsq_f32(a);   }
+  arma_inline static float64x2_t neg (const float64x2_t a)  { return vnegq_f64(a);   }
+  arma_inline static float32x4_t neg (const float32x4_t a)  { return vnegq_f32(a);   }
+  
+  arma_inline static float64x2_t exponent (const float64x2_t a)  { return vsubq_f64(vreinterpretq_f64_u64(vorrq_u64(vshrq_n_u64(vreinterpretq_u64_f64(a), 52), vreinterpretq_u64_f64(vdupq_n_f64(4503599627370496.0)))), vdupq_n_f64(4503599627370496.0 + 1023.0)); }
+  arma_inline static float32x4_t exponent (const float32x4_t a)  { return vsubq_f32(vreinterpretq_f32_u32(vorrq_u32(vshrq_n_u32(vreinterpretq_u32_f32(a), 23), vreinterpretq_u32_f32(vdupq_n_f32(8388608.0f        )))), vdupq_n_f32(8388608.0f         + 127.0f)); }
+  arma_inline static float64x2_t mantissa (const float64x2_t a)  { return vreinterpretq_f64_u64(vorrq_u64(vandq_u64(vreinterpretq_u64_f64(a), vdupq_n_u64(0x000FFFFFFFFFFFFFULL)), vreinterpretq_u64_f64(vdupq_n_f64(1.0 )))); }
+  arma_inline static float32x4_t mantissa (const float32x4_t a)  { return vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(a), vdupq_n_u32(0x007FFFFFU          )), vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))); }
+  arma_inline static float64x2_t exp2_bits(const float64x2_t a)  { return vreinterpretq_f64_u64(vshlq_n_u64(vreinterpretq_u64_f64(a), 52)); }
+  arma_inline static float32x4_t exp2_bits(const float32x4_t a)  { return vreinterpretq_f32_u32(vshlq_n_u32(vreinterpretq_u32_f32(a), 23)); }
+  
+  arma_inline static float64x2_t select_gt(const float64x2_t a, const float64x2_t b, const float64x2_t x, const float64x2_t y)  { return vbslq_f64(vcgtq_f64(a,b), x, y); }
+  arma_inline static float32x4_t select_gt(const float32x4_t a, const float32x4_t b, const float32x4_t x, const float32x4_t y)  { return vbslq_f32(vcgtq_f32(a,b), x, y); }
+  
+  arma_inline static bool all_within(const float64x2_t a, const float64x2_t lo, const float64x2_t hi)  { return (vminvq_u32(vreinterpretq_u32_u64(vandq_u64(vcgeq_f64(a,lo), vcleq_f64(a,hi)))) == 0xFFFFFFFFU); }
+  arma_inline static bool all_within(const float32x4_t a, const float32x4_t lo, const float32x4_t hi)  { return (vminvq_u32(                      vandq_u32(vcgeq_f32(a,lo), vcleq_f32(a,hi)))  == 0xFFFFFFFFU); }
+  
+  #include "simd_kernels.hpp"
+  };
+
+#undef arma_simd_target
+
+#endif
+
+#endif
+
+
+
+//! explicit SIMD kernels for element-wise operations and reductions on float and double arrays
+//! (and on arrays of complex numbers, where the operation acts on the real and imaginary parts independently);
+//! the instruction set is selected at run time, based on the capabilities of the CPU;
+//! each function returns false if the operation was not handled, in which case the caller uses its own scalar code
+class simd
+  {
+  public:
+  
+  enum isa_id : uword
+    {
+    isa_none   = 0,
+    isa_sse2   = 1,
+    isa_avx2   = 2,
+    isa_avx512 = 3,
+    isa_neon   = 4
+    };
+  
+  //! arrays with fewer elements are processed by the scalar code
+  static constexpr uword min_n_elem = 16;
+  
+  inline static uword       get_isa();
+  inline static bool        set_isa(const uword in_isa);
+  inline static bool        has_isa(const uword in_isa);
+  inline static const char* isa_name(const uword in_isa);
+  
+  // out = A op B
+  template<const uword op, typename eT> inline static bool binary(      eT*                out, const eT*                A, const eT*                B, const uword n_elem);
+  template<const uword op>              inline static bool binary(      float*             out, const float*             A, const float*             B, const uword n_elem);
+  template<const uword op>              inline static bool binary(      double*            out, const double*            A, const double*            B, const uword n_elem);
+  template<const uword op, typename T>  inline static bool binary(      std::complex<T>*   out, const std::complex<T>*   A, const std::complex<T>*   B, const uword n_elem);
+  
+  // out = op(A, k)
+  template<const uword op, typename eT> inline static bool unary(      eT*              out, const eT*              A, const uword n_elem, const eT              k);
+  template<const uword op>              inline static bool unary(      float*           out, const float*           A, const uword n_elem, const float           k);
+  template<const uword op>              inline static bool unary(      double*          out, const double*          A, const uword n_elem, const double          k);
+  template<const uword op, typename T>  inline static bool unary(      std::complex<T>* out, const std::complex<T>* A, const uword n_elem, const std::complex<T> k);
+  
+  // variants for the element accessors of Proxy and ProxyCube, which are pointers only for objects stored in contiguous memory;
+  // the elements in the range [start, endp1) are processed
+  template<const uword op, typename eT, typename ea1_type, typename ea2_type> inline static bool binary_ea(eT* out, const ea1_type&  A, const ea2_type&  B, const uword start, const uword endp1);
+  template<const uword op, typename eT>                                      inline static bool binary_ea(eT* out, const eT* const& A, const eT* const& B, const uword start, const uword endp1);
+  
+  template<const uword op, typename eT, typename ea_type> inline static bool unary_ea(eT* out, const ea_type&  A, const uword start, const uword endp1, const eT k);
+  template<const uword op, typename eT>                   inline static bool unary_ea(eT* out, const eT* const& A, const uword start, const uword endp1, const eT k);
+  
+  // out = sum(A)
+  template<typename eT> inline static bool accumulate(eT&               out, const eT*               A, const uword n_elem);
+                        inline static bool accumulate(float&            out, const float*            A, const uword n_elem);
+                        inline static bool accumulate(double&           out, const double*           A, const uword n_elem);
+  template<typename T>  inline static bool accumulate(std::complex<T>&  out, const std::complex<T>*  A, const uword n_elem);
+  
+  // out = clamp(A, min_val, max_val)
+  template<typename eT> inline static bool clamp(eT*     out, const eT*     A, const uword n_elem, const eT     min_val, const eT     max_val);
+                        inline static bool clamp(float*  out, const float*  A, const uword n_elem, const float  min_val, const float  max_val);
+                        inline static bool clamp(double* out, const double* A, const uword n_elem, const double min_val, const double max_val);
+  
+  // ab = a*b, for the packed panels used by gemm_emul_blocked
+  template<const uword MR, const uword NR, typename eT> inline static bool gemm_micro(eT*     ab, const uword kc, const eT*     a, const eT*     b);
+  template<const uword MR, const uword NR>              inline static bool gemm_micro(float*  ab, const uword kc, const float*  a, const float*  b);
+  template<const uword MR, const uword NR>              inline static bool gemm_micro(double* ab, const uword kc, const double* a, const double* b);
+  
+  // operations on groups of n_lanes small matrices stored interleaved element by element, for op_batch
+  template<typename eT> inline static bool batch_mul     (eT*     c, const eT*     a, const eT*     b, const uword M, const uword K, const uword N, const uword n_lanes);
+                        inline static bool batch_mul     (float*  c, const float*  a, const float*  b, const uword M, const uword K, const uword N, const uword n_lanes);
+                        inline static bool batch_mul     (double* c, const double* a, const double* b, const uword M, const uword K, const uword N, const uword n_lanes);
+  template<typename eT> inline static bool batch_chol    (eT*     a, eT*     b, const uword N, const uword n_rhs, const uword n_lanes);
+                        inline static bool batch_chol    (float*  a, float*  b, const uword N, const uword n_rhs, const uword n_lanes);
+                        inline static bool batch_chol    (double* a, double* b, const uword N, const uword n_rhs, const uword n_lanes);
+  template<typename eT> inline static bool batch_lu_solve(eT*     a, eT*     b, const uword N, const uword n_rhs, const uword n_lanes);
+                        inline static bool batch_lu_solve(float*  a, float*  b, const uword N, const uword n_rhs, const uword n_lanes);
+                        inline static bool batch_lu_solve(double* a, double* b, const uword N, const uword n_rhs, const uword n_lanes);
+  
+  
+  private:
+  
+  inline static uword               detect_isa();
+  inline static std::atomic<uword>& get_state();
+  
+  template<const uword op, typename T> inline static bool binary_dispatch    (T* out, const T* A, const T* B, const uword n_elem);
+  template<const uword op, typename T> inline static bool unary_dispatch     (T* out, const T* A, const uword n_elem, const T k);
+  template<typename T>                 inline static bool accumulate_dispatch(T* out, const uword n_elem_per_group, const T* A, const uword n_elem);
+  template<typename T>                 inline static bool clamp_dispatch     (T* out, const T* A, const uword n_elem, const T min_val, const T max_val);
+  
+  template<const uword MR, const uword NR, typename T> inline static bool gemm_micro_dispatch(T* ab, const uword kc, const T* a, const T* b);
+  
+  template<typename T> inline static bool batch_mul_dispatch     (T* c, const T* a, const T* b, const uword M, const uword K, const uword N, const uword n_lanes);
+  template<typename T> inline static bool batch_chol_dispatch    (T* a, T* b, const uword N, const uword n_rhs, const uword n_lanes);
+  template<typename T> inline static bool batch_lu_solve_dispatch(T* a, T* b, const uword N, const uword n_rhs, const uword n_lanes);
+  };
+
+
+
+//! @}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup solve_factoriser
+//! @{
+
+
+
+//! stored factorisation of a dense square matrix; the structure of the matrix is detected once, during factorise()
+template<typename eT>
+class solve_factoriser_worker
+  {
+  public:
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  inline bool factorise(T& out_rcond, Mat<eT>& A, const uword flags);  // A is overwritten
+  
+  inline bool solve(Mat<eT>& X, const Mat<eT>& B) const;
+  
+  inline uword get_method() const;
+  
+  
+  private:
+  
+  uword method = 0;  // 1: LU, 2: Cholesky, 3: band LU, 4: upper triangular, 5: lower triangular
+  uword n      = 0;
+  uword KL     = 0;
+  uword KU     = 0;
+  
+  Mat<eT>            F;     // factorisation; band factorisation is in the storage format used by gbtrf
+  podarray<blas_int> ipiv;
+  
+  inline bool factorise_lu   (T& out_rcond, Mat<eT>& A);
+  inline bool factorise_chol (T& out_rcond, Mat<eT>& A);
+  inline bool factorise_band (T& out_rcond, Mat<eT>& A);
+  inline bool factorise_trimat(T& out_rcond, Mat<eT>& A, const uword layout);
+  };
+
+
+
+class solve_factoriser
+  {
+  private:
+  
+  void_ptr worker_ptr          = nullptr;
+  uword    elem_type_indicator = 0;
+  uword    n_rows              = 0;
+  double   rcond_value         = double(0);
+  
+  template<typename eT> inline void delete_worker();
+  
+  inline void cleanup();
+  
+  template<typename eT> inline bool factorise_worker(Mat<eT>& A, const uword flags);
+  
+  
+  public:
+  
+  inline ~solve_factoriser();
+  inline  solve_factoriser();
+  
+  inline void reset();
+  
+  inline double rcond() const;
+  
+  inline const char* method() const;
+  
+  template<typename T1> inline bool factorise(const Base<typename T1::elem_type,T1>& A_expr, const solve_opts::opts& opts = solve_opts::none, const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr);
+  
+  template<typename T1> inline bool solve(Mat<typename T1::elem_type>& X, const Base<typename T1::elem_type,T1>& B_expr, const typename arma_blas_type_only<typename T1::elem_type>::result* junk = nullptr) const;
+  
+  inline      solve_factoriser(const solve_factoriser&) = delete;
+  inline void operator=       (const solve_factoriser&) = delete;
+  };
+
+
+
+//! @}
@@ -0,0 +1,600 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+//! \addtogroup solve_factoriser
+//! @{
+
+
+
+template<typename eT>
+inline
+bool
+solve_factoriser_worker<eT>::factorise(T& out_rcond, Mat<eT>& A, const uword flags)
+  {
+  arma_debug_sigprint();
+  
+  out_rcond = T(0);
+  
+  method = 0;
+  n      = A.n_rows;
+  KL     = 0;
+  KU     = 0;
+  
+  F.reset();
+  ipiv.reset();
+  
+  if(A.is_empty())  { method = 1; out_rcond = Datum<T>::inf; return true; }
+  
+  const bool user_triu    = bool(flags & solve_opts::flag_triu        );
+  const bool user_tril    = bool(flags & solve_opts::flag_tril        );
+  const bool no_band      = bool(flags & solve_opts::flag_no_band     );
+  const bool no_sympd     = bool(flags & solve_opts::flag_no_sympd    );
+  const bool no_trimat    = bool(flags & solve_opts::flag_no_trimat   );
+  const bool likely_sympd = bool(flags & solve_opts::flag_likely_sympd);
+  
+  if(user_triu)  { return factorise_trimat(out_rcond, A, uword(0)); }
+  if(user_tril)  { return factorise_trimat(out_rcond, A, uword(1)); }
+  
+  const bool crippled = auxlib::crippled_lapack(A);
+  
+  const bool is_band = arma_config::optimise_band && ( (no_band || crippled) ? false : band_helper::is_band(KL, KU, A, uword(32)) );
+  
+  const bool is_triu = (no_trimat || likely_sympd || is_band           ) ? false : trimat_helper::is_triu(A);
+  const bool is_tril = (no_trimat || likely_sympd || is_band || is_triu) ? false : trimat_helper::is_tril(A);
+  
+  const bool try_sympd = arma_config::optimise_sym && ( (no_sympd || is_band || is_triu || is_tril || crippled) ? false : (likely_sympd ? true : sym_helper::guess_sympd(A, uword(16))) );
+  
+  if(is_band)  { return factorise_band(out_rcond, A); }
+  
+  if(is_triu)  { return factorise_trimat(out_rcond, A, uword(0)); }
+  if(is_tril)  { return factorise_trimat(out_rcond, A, uword(1)); }
+  
+  if(try_sympd)
+    {
+    if(factorise_chol(out_rcond, A))  { return true; }
+    
+    // A isn't really sympd
+    
+    arma_debug_print("solve_factoriser: Cholesky decomposition failed; retrying with LU decomposition");
+    }
+  
+  return factorise_lu(out_rcond, A);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+solve_factoriser_worker<eT>::factorise_lu(T& out_rcond, Mat<eT>& A)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_LAPACK)
+    {
+    arma_conform_assert_blas_size(A);
+    
+    char     norm_id  = '1';
+    blas_int n_blas   = blas_int(n);
+    blas_int info     = blas_int(0);
+    T        norm_val = T(0);
+    
+    podarray<T> junk(1);
+    
+    F.steal_mem(A);
+    
+    ipiv.set_size(n + 2);  // +2 for paranoia
+    
+    arma_debug_print("lapack::lange()");
+    norm_val = (has_blas_float_bug<eT>::value) ? auxlib::norm1_gen(F) : lapack::lange<eT>(&norm_id, &n_blas, &n_blas, F.memptr(), &n_blas, junk.memptr());
+    
+    arma_debug_print("lapack::getrf()");
+    lapack::getrf<eT>(&n_blas, &n_blas, F.memptr(), &n_blas, ipiv.memptr(), &info);
+    
+    if(info != blas_int(0))  { return false; }
+    
+    method    = 1;
+    out_rcond = auxlib::lu_rcond<T>(F, norm_val);
+    
+    return true;
+    }
+  #else
+    {
+    arma_ignore(out_rcond);
+    arma_ignore(A);
+    arma_stop_logic_error("solve_factoriser::factorise(): use of LAPACK must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+bool
+solve_factoriser_worker<eT>::factorise_chol(T& out_rcond, Mat<eT>& A)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_LAPACK)
+    {
+    arma_conform_assert_blas_size(A);
+    
+    char     norm_id  = '1';
+    char     uplo     = 'L';
+    blas_int n_blas   = blas_int(n);
+    blas_int info     = blas_int(0);
+    T        norm_val = T(0);
+    
+    podarray<T> work(n);
+    
+    F = A;
+    
+    arma_debug_print("lapack::lansy()");
+    norm_val = (has_blas_float_bug<eT>::value) ? auxlib::norm1_sym(F) : lapack::lansy(&norm_id, &uplo, &n_blas, F.memptr(), &n_blas, work.memptr());
+    
+    arma_debug_print("lapack::potrf()");
+    lapack::potrf<eT>(&uplo, &n_blas, F.memptr(), &n_blas, &info);
+    
+    if(info != blas_int(0))  { F.reset(); return false; }
+    
+    method    = 2;
+    out_rcond = auxlib::lu_rcond_sympd<T>(F, norm_val);
+    
+    return true;
+    }
+  #else
+    {
+    arma_ignore(out_rcond);
+    arma_ignore(A);
+    arma_stop_logic_error("solve_factoriser::factorise(): use of LAPACK must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+bool
+solve_factoriser_worker<eT>::factorise_band(T& out_rcond, Mat<eT>& A)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_LAPACK)
+    {
+    // for gbtrf, matrix F size: 2*KL+KU+1 x N; band representation of A stored in rows KL+1 to 2*KL+KU+1  (note: fortran counts from 1)
+    
+    band_helper::compress(F, A, KL, KU, true);
+    
+    arma_conform_assert_blas_size(F);
+    
+    blas_int n_blas = blas_int(n);
+    blas_int kl     = blas_int(KL);
+    blas_int ku     = blas_int(KU);
+    blas_int ldab   = blas_int(F.n_rows);
+    blas_int info   = blas_int(0);
+    
+    ipiv.set_size(n + 2);  // +2 for paranoia
+    
+    const T norm_val = auxlib::norm1_band(A, KL, KU);
+    
+    arma_debug_print("lapack::gbtrf()");
+    lapack::gbtrf<eT>(&n_blas, &n_blas, &kl, &ku, F.memptr(), &ldab, ipiv.memptr(), &info);
+    
+    if(info != blas_int(0))  { return false; }
+    
+    method    = 3;
+    out_rcond = auxlib::lu_rcond_band<T>(F, KL, KU, ipiv, norm_val);
+    
+    return true;
+    }
+  #else
+    {
+    arma_ignore(out_rcond);
+    arma_ignore(A);
+    arma_stop_logic_error("solve_factoriser::factorise(): use of LAPACK must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+bool
+solve_factoriser_worker<eT>::factorise_trimat(T& out_rcond, Mat<eT>& A, const uword layout)
+  {
+  arma_debug_sigprint();
+  
+  // the triangular matrix is its own factorisation
+  
+  F.steal_mem(A);
+  
+  method    = (layout == 0) ? uword(4) : uword(5);
+  out_rcond = auxlib::rcond_trimat(F, layout);
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+solve_factoriser_worker<eT>::solve(Mat<eT>& X, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  // NOTE: the stored factorisation is not modified by the LAPACK functions below;
+  // NOTE: const_cast is only used to match the signatures of the LAPACK wrappers
+  
+  X = B;
+  
+  if(X.is_empty())  { return true; }
+  
+  #if defined(ARMA_USE_LAPACK)
+    {
+    arma_conform_assert_blas_size(F, X);
+    
+    char     trans  = 'N';
+    blas_int n_blas = blas_int(n);
+    blas_int nrhs   = blas_int(X.n_cols);
+    blas_int ldx    = blas_int(X.n_rows);
+    blas_int info   = blas_int(0);
+    
+    eT*       F_mem    = const_cast<eT*>(F.memptr());
+    blas_int* ipiv_mem = const_cast<blas_int*>(ipiv.memptr());
+    
+    if(method == 1)
+      {
+      arma_debug_print("lapack::getrs()");
+      lapack::getrs<eT>(&trans, &n_blas, &nrhs, F_mem, &n_blas, ipiv_mem, X.memptr(), &ldx, &info);
+      }
+    else
+    if(method == 2)
+      {
+      char uplo = 'L';
+      
+      arma_debug_print("lapack::potrs()");
+      lapack::potrs<eT>(&uplo, &n_blas, &nrhs, F_mem, &n_blas, X.memptr(), &ldx, &info);
+      }
+    else
+    if(method == 3)
+      {
+      blas_int kl   = blas_int(KL);
+      blas_int ku   = blas_int(KU);
+      blas_int ldab = blas_int(F.n_rows);
+      
+      arma_debug_print("lapack::gbtrs()");
+      lapack::gbtrs<eT>(&trans, &n_blas, &kl, &ku, &nrhs, F_mem, &ldab, ipiv_mem, X.memptr(), &ldx, &info);
+      }
+    else
+    if( (method == 4) || (method == 5) )
+      {
+      char uplo = (method == 4) ? 'U' : 'L';
+      char diag = 'N';
+      
+      arma_debug_print("lapack::trtrs()");
+      lapack::trtrs<eT>(&uplo, &trans, &diag, &n_blas, &nrhs, F.memptr(), &n_blas, X.memptr(), &ldx, &info);
+      }
+    else
+      {
+      return false;
+      }
+    
+    return (info == blas_int(0));
+    }
+  #else
+    {
+    arma_stop_logic_error("solve_factoriser::solve(): use of LAPACK must be enabled");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+inline
+uword
+solve_factoriser_worker<eT>::get_method() const
+  {
+  return method;
+  }
+
+
+
+// 
+
+
+
+template<typename eT>
+inline
+void
+solve_factoriser::delete_worker()
+  {
+  arma_debug_sigprint();
+  
+  if(worker_ptr != nullptr)
+    {
+    solve_factoriser_worker<eT>* ptr = reinterpret_cast< solve_factoriser_worker<eT>* >(worker_ptr);
+    
+    delete ptr;
+    
+    worker_ptr = nullptr;
+    }
+  }
+
+
+
+inline
+void
+solve_factoriser::cleanup()
+  {
+  arma_debug_sigprint();
+  
+       if(elem_type_indicator == 1)  { delete_worker<    float>(); }
+  else if(elem_type_indicator == 2)  { delete_worker<   double>(); }
+  else if(elem_type_indicator == 3)  { delete_worker< cx_float>(); }
+  else if(elem_type_indicator == 4)  { delete_worker<cx_double>(); }
+  
+  worker_ptr          = nullptr;
+  elem_type_indicator = 0;
+  n_rows              = 0;
+  rcond_value         = double(0);
+  }
+
+
+
+inline
+solve_factoriser::~solve_factoriser()
+  {
+  arma_debug_sigprint_this(this);
+  
+  cleanup();
+  }
+
+
+
+inline
+solve_factoriser::solve_factoriser()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+inline
+void
+solve_factoriser::reset()
+  {
+  arma_debug_sigprint();
+  
+  cleanup();
+  }
+
+
+
+inline
+double
+solve_factoriser::rcond() const
+  {
+  arma_debug_sigprint();
+  
+  return rcond_value;
+  }
+
+
+
+inline
+const char*
+solve_factoriser::method() const
+  {
+  arma_debug_sigprint();
+  
+  uword method_id = 0;
+  
+  if(worker_ptr != nullptr)
+    {
+         if(elem_type_indicator == 1)  { method_id = reinterpret_cast< const solve_factoriser_worker<    float>* >(worker_ptr)->get_method(); }
+    else if(elem_type_indicator == 2)  { method_id = reinterpret_cast< const solve_factoriser_worker<   double>* >(worker_ptr)->get_method(); }
+    else if(elem_type_indicator == 3)  { method_id = reinterpret_cast< const solve_factoriser_worker< cx_float>* >(worker_ptr)->get_method(); }
+    else if(elem_type_indicator == 4)  { method_id = reinterpret_cast< const solve_factoriser_worker<cx_double>* >(worker_ptr)->get_method(); }
+    }
+  
+  switch(method_id)
+    {
+    case 1:  return "lu";
+    case 2:  return "chol";
+    case 3:  return "band";
+    case 4:  return "trimatu";
+    case 5:  return "trimatl";
+    default: return "";
+    }
+  }
+
+
+
+template<typename eT>
+inline
+bool
+solve_factoriser::factorise_worker(Mat<eT>& A, const uword flags)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  n_rows = A.n_rows;
+  
+  worker_ptr = new(std::nothrow) solve_factoriser_worker<eT>;
+  
+  if(worker_ptr == nullptr)
+    {
+    arma_warn(3, "solve_factoriser::factorise(): could not construct worker object");
+    return false;
+    }
+  
+       if(    is_float<eT>::value)  { elem_type_indicator = 1; }
+  else if(   is_double<eT>::value)  { elem_type_indicator = 2; }
+  else if( is_cx_float<eT>::value)  { elem_type_indicator = 3; }
+  else if(is_cx_double<eT>::value)  { elem_type_indicator = 4; }
+  
+  solve_factoriser_worker<eT>* local_worker_ptr = reinterpret_cast< solve_factoriser_worker<eT>* >(worker_ptr);
+  solve_factoriser_worker<eT>& local_worker_ref = (*local_worker_ptr);
+  
+  T local_rcond_value = T(0);
+  
+  const bool status = local_worker_ref.factorise(local_rcond_value, A, flags);
+  
+  rcond_value = double(local_rcond_value);
+  
+  const bool allow_ugly = bool(flags & solve_opts::flag_allow_ugly);
+  
+  if( (status == false) || arma_isnan(local_rcond_value) || ((allow_ugly == false) && (local_rcond_value < std::numeric_limits<T>::epsilon())) )
+    {
+    arma_warn(3, "solve_factoriser::factorise(): factorisation failed; rcond: ", local_rcond_value);
+    cleanup();
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+template<typename T1>
+inline
+bool
+solve_factoriser::factorise
+  (
+  const Base<typename T1::elem_type,T1>& A_expr,
+  const solve_opts::opts&                opts,
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk
+  )
+  {
+  arma_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename T1::elem_type eT;
+  
+  cleanup();
+  
+  const uword flags = opts.flags;
+  
+  if(flags & solve_opts::flag_fast        )  { arma_warn(2, "solve_factoriser::factorise(): option 'fast' ignored"        ); }
+  if(flags & solve_opts::flag_equilibrate )  { arma_warn(2, "solve_factoriser::factorise(): option 'equilibrate' ignored" ); }
+  if(flags & solve_opts::flag_no_approx   )  { arma_warn(2, "solve_factoriser::factorise(): option 'no_approx' ignored"   ); }
+  if(flags & solve_opts::flag_refine      )  { arma_warn(2, "solve_factoriser::factorise(): option 'refine' ignored"      ); }
+  if(flags & solve_opts::flag_force_approx)  { arma_warn(2, "solve_factoriser::factorise(): option 'force_approx' ignored"); }
+  if(flags & solve_opts::flag_force_sym   )  { arma_warn(2, "solve_factoriser::factorise(): option 'force_sym' ignored"   ); }
+  
+  arma_conform_check( ((flags & solve_opts::flag_no_sympd) && (flags & solve_opts::flag_likely_sympd)), "solve_factoriser::factorise(): options 'no_sympd' and 'likely_sympd' are mutually exclusive" );
+  
+  Mat<eT> A = A_expr.get_ref();
+  
+  if(A.is_square() == false)
+    {
+    arma_warn(1, "solve_factoriser::factorise(): given matrix must be square sized");
+    return false;
+    }
+  
+  if(arma_config::check_nonfinite && A.internal_has_nonfinite())
+    {
+    arma_warn(3, "solve_factoriser::factorise(): detected non-finite elements");
+    return false;
+    }
+  
+  return factorise_worker<eT>(A, flags);
+  }
+
+
+
+template<typename T1>
+inline
+bool
+solve_factoriser::solve
+  (
+         Mat<typename T1::elem_type>&    X,
+  const Base<typename T1::elem_type,T1>& B_expr,
+  const typename arma_blas_type_only<typename T1::elem_type>::result* junk
+  ) const
+  {
+  arma_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename T1::elem_type eT;
+  
+  if(worker_ptr == nullptr)
+    {
+    arma_warn(2, "solve_factoriser::solve(): no factorisation available");
+    X.soft_reset();
+    return false;
+    }
+  
+  bool type_mismatch = false;
+  
+       if(    (is_float<eT>::value) && (elem_type_indicator != 1) )  { type_mismatch = true; }
+  else if(   (is_double<eT>::value) && (elem_type_indicator != 2) )  { type_mismatch = true; }
+  else if( (is_cx_float<eT>::value) && (elem_type_indicator != 3) )  { type_mismatch = true; }
+  else if((is_cx_double<eT>::value) && (elem_type_indicator != 4) )  { type_mismatch = true; }
+  
+  if(type_mismatch)
+    {
+    arma_warn(1, "solve_factoriser::solve(): matrix type mismatch");
+    X.soft_reset();
+    return false;
+    }
+  
+  const quasi_unwrap<T1> U(B_expr.get_ref());
+  const Mat<eT>& B     = U.M;
+  
+  if(n_rows != B.n_rows)
+    {
+    arma_warn(1, "solve_factoriser::solve(): matrix size mismatch");
+    X.soft_reset();
+    return false;
+    }
+  
+  const bool is_alias = U.is_alias(X);
+  
+  Mat<eT>  tmp;
+  Mat<eT>& out = is_alias ? tmp : X;
+  
+  const solve_factoriser_worker<eT>* local_worker_ptr = reinterpret_cast< const solve_factoriser_worker<eT>* >(worker_ptr);
+  
+  const bool status = local_worker_ptr->solve(out,B);
+  
+  if(is_alias)  { X.steal_mem(tmp); }
+  
+  if(status == false)
+    {
+    arma_warn(3, "solve_factoriser::solve(): solution not found");
+    X.soft_reset();
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+//! @}
@@ -32,6 +32,12 @@ class sp_auxlib
   
   inline static form_type interpret_form_str(const char* form_str);
   
+  template<typename eT>
+  inline static bool rudimentary_sym_check(const SpMat<eT>& X);
+  
+  template<typename T>
+  inline static bool rudimentary_sym_check(const SpMat< std::complex<T> >& X);
+  
   //
   // eigs_sym() for real matrices
   
@@ -47,6 +53,15 @@ class sp_auxlib
   template<typename eT>
   inline static bool eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X, const uword n_eigvals, const eT sigma, const eigs_opts& opts);
 
+  template<typename eT, typename fn_type, typename fn_t_type>
+  inline static bool eigs_sym(Col<eT>& eigval, Mat<eT>& eigvec, const matfree_op<eT, fn_type, fn_t_type>& A, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  template<typename eT, typename OpType>
+  inline static bool eigs_sym_newarp_op(Col<eT>& eigval, Mat<eT>& eigvec, const OpType& op, const SpMat<eT>* X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  template<typename eT, typename OpType>
+  inline static bool eigs_sym_lobpcg(Col<eT>& eigval, Mat<eT>& eigvec, const OpType& op, const SpMat<eT>* X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
   template<typename eT, bool use_sigma>
   inline static bool eigs_sym_arpack(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X, const uword n_eigvals, const form_type form_val, const eT sigma, const eigs_opts& opts);
   
@@ -62,6 +77,12 @@ class sp_auxlib
   template<typename T>
   inline static bool eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpMat<T>& X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
   
+  template<typename T, typename fn_type, typename fn_t_type>
+  inline static bool eigs_gen(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const matfree_op<T, fn_type, fn_t_type>& A, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
+  template<typename T, typename OpType>
+  inline static bool eigs_gen_newarp_op(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const OpType& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts);
+  
   template<typename T, bool use_sigma>
   inline static bool eigs_gen_arpack(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const SpMat<T>& X, const uword n_eigvals, const form_type form_val, const std::complex<T> sigma, const eigs_opts& opts);
   
@@ -147,13 +168,6 @@ class sp_auxlib
     podarray<T>& workd, podarray<T>& workl, blas_int& lworkl, podarray<eT>& rwork,
     blas_int& info
     );
-  
-  
-  template<typename eT>
-  inline static bool rudimentary_sym_check(const SpMat<eT>& X);
-  
-  template<typename T>
-  inline static bool rudimentary_sym_check(const SpMat< std::complex<T> >& X);
   };
 
 
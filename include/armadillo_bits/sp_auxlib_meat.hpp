@@ -167,12 +167,71 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
   
   #if defined(ARMA_USE_NEWARP)
     {
-    arma_conform_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_la) && (form_val != form_sa), "eigs_sym(): unknown form specified" );
-    
     if(X.is_square() == false)  { return false; }
     
     const newarp::SparseGenMatProd<eT> op(X);
     
+    return sp_auxlib::eigs_sym_newarp_op(eigval, eigvec, op, &X, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! eigendecomposition of symmetric real operator given by user-supplied functions
+template<typename eT, typename fn_type, typename fn_t_type>
+inline
+bool
+sp_auxlib::eigs_sym(Col<eT>& eigval, Mat<eT>& eigvec, const matfree_op<eT, fn_type, fn_t_type>& A, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( (A.is_square() == false), "eigs_sym(): given operator must be square sized" );
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    const newarp::OperatorMatProd< eT, matfree_op<eT, fn_type, fn_t_type> > op(A);
+    
+    return sp_auxlib::eigs_sym_newarp_op(eigval, eigvec, op, static_cast<const SpMat<eT>*>(nullptr), n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    arma_stop_logic_error("eigs_sym(): use of NEWARP must be enabled for operators");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename eT, typename OpType>
+inline
+bool
+sp_auxlib::eigs_sym_newarp_op(Col<eT>& eigval, Mat<eT>& eigvec, const OpType& op, const SpMat<eT>* X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    arma_conform_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_la) && (form_val != form_sa), "eigs_sym(): unknown form specified" );
+    
     arma_conform_check( (n_eigvals >= op.n_rows), "eigs_sym(): n_eigvals must be less than the number of rows in the matrix" );
     
     // If the matrix is empty, the case is trivial.
@@ -183,6 +242,18 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       return true;
       }
     
+    if(opts.method == eigs_opts::LOBPCG)
+      {
+      if( (form_val == form_la) || (form_val == form_sa) )
+        {
+        if(3*n_eigvals <= op.n_rows)  { return sp_auxlib::eigs_sym_lobpcg(eigval, eigvec, op, X, n_eigvals, form_val, opts); }
+        }
+      else
+        {
+        arma_warn(1, "eigs_sym(): LOBPCG supports only the \"la\" and \"sa\" forms; using Lanczos instead");
+        }
+      }
+    
     uword n   = op.n_rows;
     
     // Use max(2*k+1, 20) as default subspace dimension for the sym case; MATLAB uses max(2*k, 20), but we need to be backward-compatible.
@@ -229,7 +300,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       {
       if(form_val == form_lm)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_MAGN, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -238,7 +309,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_sm)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_MAGN, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -247,7 +318,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_la)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_ALGE, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::LARGEST_ALGE, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -256,7 +327,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
       else
       if(form_val == form_sa)
         {
-        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, newarp::SparseGenMatProd<eT> > eigs(op, n_eigvals, ncv);
+        newarp::SymEigsSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -279,6 +350,7 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
     {
     arma_ignore(eigval);
     arma_ignore(eigvec);
+    arma_ignore(op);
     arma_ignore(X);
     arma_ignore(n_eigvals);
     arma_ignore(form_val);
@@ -394,6 +466,95 @@ sp_auxlib::eigs_sym_newarp(Col<eT>& eigval, Mat<eT>& eigvec, const SpMat<eT>& X,
 
 
 
+template<typename eT, typename OpType>
+inline
+bool
+sp_auxlib::eigs_sym_lobpcg(Col<eT>& eigval, Mat<eT>& eigvec, const OpType& op, const SpMat<eT>* X, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    const uword n = op.n_rows;
+    
+    // the diagonal preconditioner needs the elements of X, which are not available for operators
+    
+    const bool use_precond = (opts.precond) && (X != nullptr);
+    
+    if( (opts.precond) && (X == nullptr) )  { arma_warn(1, "eigs_sym(): opts.precond is not supported for operators; ignoring"); }
+    
+    // by default, use a few extra vectors to accelerate convergence of the wanted eigenpairs
+    
+    uword bs = (opts.blocksize != 0) ? uword(opts.blocksize) : uword( n_eigvals + (std::max)(uword(2), uword(n_eigvals/10)) );
+    
+    if(bs < n_eigvals)  { arma_warn(1, "eigs_sym(): opts.blocksize must be at least k; using k instead of ", opts.blocksize); bs = n_eigvals; }
+    
+    if(3*bs > n)  { bs = (std::max)(n_eigvals, n/3); }
+    
+    // LOBPCG cannot attain the accuracy of Lanczos at machine precision; eps^(2/3) relative to the norm of X is used by default
+    
+    const eT tol = (opts.tol > double(0)) ? (std::max)(eT(opts.tol), std::numeric_limits<eT>::epsilon()) : std::pow(std::numeric_limits<eT>::epsilon(), eT(2)/eT(3));
+    
+    const uword maxiter = uword(opts.maxiter);
+    
+    const bool warm = (opts.warm_start) && (eigvec.n_rows == n) && (eigvec.n_cols > 0);
+    
+    bool status = true;
+    
+    uword nconv = 0;
+    
+    try
+      {
+      if(form_val == form_la)
+        {
+        // the given eigenvectors are in ascending order of eigenvalues, while the solver uses descending order for "la"
+        
+        newarp::LOBPCGSolver< eT, newarp::EigsSelect::LARGEST_ALGE, OpType > eigs(op, n_eigvals, bs);
+        if(use_precond)  { eigs.set_precond(Col<eT>(X->diag())); }
+        if(warm)  { eigs.init(Mat<eT>(fliplr(eigvec))); }  else  { eigs.init(); }
+        nconv  = eigs.compute(maxiter, tol);
+        eigval = eigs.eigenvalues();
+        eigvec = eigs.eigenvectors();
+        }
+      else
+        {
+        newarp::LOBPCGSolver< eT, newarp::EigsSelect::SMALLEST_ALGE, OpType > eigs(op, n_eigvals, bs);
+        if(use_precond)  { eigs.set_precond(Col<eT>(X->diag())); }
+        if(warm)  { eigs.init(eigvec); }  else  { eigs.init(); }
+        nconv  = eigs.compute(maxiter, tol);
+        eigval = eigs.eigenvalues();
+        eigvec = eigs.eigenvectors();
+        }
+      }
+    catch(const std::runtime_error&)
+      {
+      status = false;
+      }
+    
+    if(status == true)
+      {
+      if(nconv == 0)  { status = false; }
+      }
+    
+    return status;
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(op);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
 template<typename eT, bool use_sigma>
 inline
 bool
@@ -620,12 +781,71 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
   
   #if defined(ARMA_USE_NEWARP)
     {
-    arma_conform_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_lr) && (form_val != form_sr) && (form_val != form_li) && (form_val != form_si), "eigs_gen(): unknown form specified" );
-    
     if(X.is_square() == false)  { return false; }
     
     const newarp::SparseGenMatProd<T> op(X);
     
+    return sp_auxlib::eigs_gen_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(X);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+//! eigendecomposition of general real operator given by user-supplied functions
+template<typename T, typename fn_type, typename fn_t_type>
+inline
+bool
+sp_auxlib::eigs_gen(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const matfree_op<T, fn_type, fn_t_type>& A, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_check( (A.is_square() == false), "eigs_gen(): given operator must be square sized" );
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    const newarp::OperatorMatProd< T, matfree_op<T, fn_type, fn_t_type> > op(A);
+    
+    return sp_auxlib::eigs_gen_newarp_op(eigval, eigvec, op, n_eigvals, form_val, opts);
+    }
+  #else
+    {
+    arma_ignore(eigval);
+    arma_ignore(eigvec);
+    arma_ignore(n_eigvals);
+    arma_ignore(form_val);
+    arma_ignore(opts);
+    
+    arma_stop_logic_error("eigs_gen(): use of NEWARP must be enabled for operators");
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename T, typename OpType>
+inline
+bool
+sp_auxlib::eigs_gen_newarp_op(Col< std::complex<T> >& eigval, Mat< std::complex<T> >& eigvec, const OpType& op, const uword n_eigvals, const form_type form_val, const eigs_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  #if defined(ARMA_USE_NEWARP)
+    {
+    arma_conform_check( (form_val != form_lm) && (form_val != form_sm) && (form_val != form_lr) && (form_val != form_sr) && (form_val != form_li) && (form_val != form_si), "eigs_gen(): unknown form specified" );
+    
     arma_conform_check( (n_eigvals + 1 >= op.n_rows), "eigs_gen(): n_eigvals + 1 must be less than the number of rows in the matrix" );
     
     // If the matrix is empty, the case is trivial.
@@ -682,7 +902,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       {
       if(form_val == form_lm)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_MAGN, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -691,7 +911,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_sm)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_MAGN, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_MAGN, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -700,7 +920,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_lr)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_REAL, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_REAL, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -709,7 +929,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_sr)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_REAL, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_REAL, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -718,7 +938,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_li)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_IMAG, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::LARGEST_IMAG, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -727,7 +947,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
       else
       if(form_val == form_si)
         {
-        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_IMAG, newarp::SparseGenMatProd<T> > eigs(op, n_eigvals, ncv);
+        newarp::GenEigsSolver< T, newarp::EigsSelect::SMALLEST_IMAG, OpType > eigs(op, n_eigvals, ncv);
         eigs.init();
         nconv  = eigs.compute(maxiter, tol);
         eigval = eigs.eigenvalues();
@@ -750,7 +970,7 @@ sp_auxlib::eigs_gen_newarp(Col< std::complex<T> >& eigval, Mat< std::complex<T>
     {
     arma_ignore(eigval);
     arma_ignore(eigvec);
-    arma_ignore(X);
+    arma_ignore(op);
     arma_ignore(n_eigvals);
     arma_ignore(form_val);
     arma_ignore(opts);
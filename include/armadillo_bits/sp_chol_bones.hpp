@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup sp_chol
+//! @{
+
+
+
+//! fill-reducing ordering of a symmetric sparsity pattern via approximate minimum degree on the quotient graph
+class sp_amd
+  {
+  public:
+  
+  //! the pattern is given in CSC form, where both triangles are stored; diagonal elements are ignored;
+  //! perm[k] is the index of the variable eliminated at step k
+  inline static void apply(podarray<uword>& perm, const uword n, const uword* col_ptrs, const uword* row_indices);
+  };
+
+
+
+//! built-in supernodal sparse Cholesky (LL^H) and LDL^H factorisation of symmetric / hermitian matrices
+template<typename eT>
+class spchol_worker
+  {
+  public:
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  inline ~spchol_worker();
+  inline  spchol_worker();
+  
+  inline bool factorise(T& out_rcond, const SpMat<eT>& A, const spchol_opts& opts);
+  
+  inline bool solve(Mat<eT>& X, const Mat<eT>& B) const;
+  
+  inline      spchol_worker(const spchol_worker&) = delete;
+  inline void operator=    (const spchol_worker&) = delete;
+  
+  
+  private:
+  
+  uword n       = 0;
+  uword n_super = 0;
+  bool  is_ldl  = false;
+  
+  podarray<uword> perm;         // perm[k]: column of A that is column k of the permuted matrix
+  podarray<uword> super_ptrs;   // columns of supernode s: [super_ptrs[s], super_ptrs[s+1])
+  podarray<uword> col_super;    // supernode of each column
+  podarray<uword> rows_ptrs;    // rows of supernode s: super_rows[ rows_ptrs[s] ... rows_ptrs[s+1]-1 ], in ascending order
+  podarray<uword> super_rows;
+  podarray<uword> vals_ptrs;    // dense column-major panel of supernode s starts at panels[ vals_ptrs[s] ]
+  podarray<eT>    panels;       // for LDL^H, the diagonal of each panel holds D instead of the unit diagonal of L
+  
+  inline void symbolic(const SpMat<eT>& A, const spchol_opts& opts);
+  
+  inline bool numeric(const SpMat<eT>& A);
+  
+  inline void solve_col(eT* y) const;
+  
+  inline T rcond_est(const T A_norm1) const;
+  
+  inline static void permuted_pattern(podarray<uword>& C_col_ptrs, podarray<uword>& C_row_indices, const uword N, const uword* S_col_ptrs, const uword* S_row_indices, const uword* in_perm, const uword* in_perm_inv);
+  
+  inline static void etree(podarray<uword>& parent, const uword N, const uword* C_col_ptrs, const uword* C_row_indices);
+  };
+
+
+
+//! @}
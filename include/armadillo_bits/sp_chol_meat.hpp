@@ -0,0 +1,1145 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup sp_chol
+//! @{
+
+
+
+inline
+void
+sp_amd::apply(podarray<uword>& perm, const uword n, const uword* col_ptrs, const uword* row_indices)
+  {
+  arma_debug_sigprint();
+  
+  perm.set_size(n);
+  
+  if(n == 0)  { return; }
+  
+  const uword none = n;
+  
+  // variables with many neighbours would dominate the cost of the degree updates;
+  // they are excluded from the elimination and placed last
+  const uword dense_thresh = (std::max)( uword(16), uword(10.0 * std::sqrt(double(n))) );
+  
+  podarray<uword> state (n);  // 0: variable, 1: element, 2: absorbed element, 3: variable merged into a supervariable, 4: dense variable
+  podarray<uword> nv    (n);  // number of variables represented by each supervariable
+  podarray<uword> degree(n);  // approximate external degree of each supervariable
+  
+  std::vector< std::vector<uword> > adj_var (n);  // supervariables adjacent to each supervariable
+  std::vector< std::vector<uword> > adj_elem(n);  // elements adjacent to each supervariable
+  std::vector< std::vector<uword> > elem_var(n);  // supervariables adjacent to each element
+  
+  for(uword i=0; i < n; ++i)
+    {
+    uword count = 0;
+    
+    for(uword k=col_ptrs[i]; k < col_ptrs[i+1]; ++k)  { count += (row_indices[k] != i) ? uword(1) : uword(0); }
+    
+    state[i] = (count > dense_thresh) ? uword(4) : uword(0);
+    nv[i]    = 1;
+    }
+  
+  uword n_sparse = 0;
+  
+  for(uword i=0; i < n; ++i)
+    {
+    if(state[i] != 0)  { continue; }
+    
+    ++n_sparse;
+    
+    std::vector<uword>& adj = adj_var[i];
+    
+    adj.reserve(col_ptrs[i+1] - col_ptrs[i]);
+    
+    for(uword k=col_ptrs[i]; k < col_ptrs[i+1]; ++k)
+      {
+      const uword j = row_indices[k];
+      
+      if( (j != i) && (state[j] == 0) )  { adj.push_back(j); }
+      }
+    
+    degree[i] = uword(adj.size());
+    }
+  
+  // doubly linked lists of supervariables with the same degree
+  
+  podarray<uword> head(n+1);
+  podarray<uword> next(n);
+  podarray<uword> prev(n);
+  
+  head.fill(none);
+  
+  const auto list_insert = [&](const uword i)
+    {
+    const uword d = degree[i];
+    
+    next[i] = head[d];
+    prev[i] = none;
+    
+    if(head[d] != none)  { prev[head[d]] = i; }
+    
+    head[d] = i;
+    };
+  
+  const auto list_remove = [&](const uword i)
+    {
+    if(prev[i] != none)  { next[prev[i]] = next[i]; } else { head[degree[i]] = next[i]; }
+    if(next[i] != none)  { prev[next[i]] = prev[i]; }
+    };
+  
+  uword min_deg = n;
+  
+  for(uword i=0; i < n; ++i)
+    {
+    if(state[i] == 0)  { list_insert(i); min_deg = (std::min)(min_deg, degree[i]); }
+    }
+  
+  // variables merged into a supervariable are kept in a chain, so that they can be placed next to each other in the ordering
+  
+  podarray<uword> chain_next(n);
+  podarray<uword> chain_tail(n);
+  
+  chain_next.fill(none);
+  
+  for(uword i=0; i < n; ++i)  { chain_tail[i] = i; }
+  
+  podarray<uword> mark  (n);  // mark[i] == tag: supervariable i is in the new element
+  podarray<uword> w     (n);  // w[e]: weight of element e outside the new element; valid if w_mark[e] == tag
+  podarray<uword> w_mark(n);
+  
+  mark.zeros();
+  w_mark.zeros();
+  
+  podarray<uword> pivots(n);
+  
+  uword n_pivots = 0;
+  uword n_elim   = 0;  // number of eliminated variables
+  uword tag      = 0;
+  
+  std::vector<uword> Lp;
+  
+  std::vector< std::pair<uword,uword> > hashes;
+  
+  while(n_elim < n_sparse)
+    {
+    while(head[min_deg] == none)  { ++min_deg; }
+    
+    const uword p = head[min_deg];
+    
+    list_remove(p);
+    
+    ++tag;
+    
+    // form the new element from p, its adjacent supervariables, and the supervariables of its adjacent elements (which are absorbed)
+    
+    mark[p] = tag;
+    
+    Lp.clear();
+    
+    uword Lp_weight = 0;
+    
+    for(const uword e : adj_elem[p])
+      {
+      if(state[e] != 1)  { continue; }
+      
+      for(const uword i : elem_var[e])
+        {
+        if( (state[i] == 0) && (mark[i] != tag) )  { mark[i] = tag; Lp.push_back(i); Lp_weight += nv[i]; list_remove(i); }
+        }
+      
+      state[e] = 2;
+      
+      std::vector<uword>().swap(elem_var[e]);
+      }
+    
+    for(const uword i : adj_var[p])
+      {
+      if( (state[i] == 0) && (mark[i] != tag) )  { mark[i] = tag; Lp.push_back(i); Lp_weight += nv[i]; list_remove(i); }
+      }
+    
+    std::vector<uword>().swap(adj_var [p]);
+    std::vector<uword>().swap(adj_elem[p]);
+    
+    state[p] = 1;
+    
+    pivots[n_pivots] = p;  ++n_pivots;
+    
+    n_elim += nv[p];
+    
+    // weights of the other elements adjacent to the new element, excluding the supervariables in the new element
+    
+    for(const uword i : Lp)
+      {
+      for(const uword e : adj_elem[i])
+        {
+        if(state[e] != 1)  { continue; }
+        
+        if(w_mark[e] != tag)
+          {
+          std::vector<uword>& Le = elem_var[e];
+          
+          uword count  = 0;
+          uword weight = 0;
+          
+          for(const uword j : Le)  { if(state[j] == 0)  { Le[count] = j; ++count; weight += nv[j]; } }
+          
+          Le.resize(count);
+          
+          w_mark[e] = tag;
+          w[e]      = weight;
+          }
+        
+        w[e] -= nv[i];
+        }
+      }
+    
+    // update the adjacency and the approximate degree of each supervariable in the new element
+    
+    for(const uword i : Lp)
+      {
+      uword deg = 0;
+      
+      std::vector<uword>& Ei = adj_elem[i];
+      
+      uword count = 0;
+      
+      for(const uword e : Ei)
+        {
+        if(state[e] != 1)  { continue; }
+        
+        // element e is a subset of the new element
+        if(w[e] == 0)  { state[e] = 2; std::vector<uword>().swap(elem_var[e]); continue; }
+        
+        Ei[count] = e;  ++count;
+        
+        deg += w[e];
+        }
+      
+      Ei.resize(count);
+      Ei.push_back(p);
+      
+      // edges to supervariables in the new element are now represented by the new element
+      
+      std::vector<uword>& Ai = adj_var[i];
+      
+      count = 0;
+      
+      for(const uword j : Ai)
+        {
+        if( (state[j] != 0) || (mark[j] == tag) )  { continue; }
+        
+        Ai[count] = j;  ++count;
+        
+        deg += nv[j];
+        }
+      
+      Ai.resize(count);
+      
+      deg += Lp_weight - nv[i];
+      
+      deg = (std::min)( deg, degree[i] + Lp_weight - nv[i] );
+      deg = (std::min)( deg, n_sparse  - n_elim    - nv[i] );
+      
+      degree[i] = deg;
+      }
+    
+    // detect indistinguishable supervariables, which have the same adjacency
+    
+    hashes.clear();
+    
+    for(const uword i : Lp)
+      {
+      std::vector<uword>& Ei = adj_elem[i];
+      std::vector<uword>& Ai = adj_var [i];
+      
+      std::sort(Ei.begin(), Ei.end());
+      std::sort(Ai.begin(), Ai.end());
+      
+      uword h = uword(Ei.size()) + (uword(Ai.size()) << 16);
+      
+      for(const uword e : Ei)  { h += e; }
+      for(const uword j : Ai)  { h += j; }
+      
+      hashes.push_back( std::make_pair(h, i) );
+      }
+    
+    std::sort(hashes.begin(), hashes.end());
+    
+    const uword n_hashes = uword(hashes.size());
+    
+    for(uword a=0; a < n_hashes; ++a)
+      {
+      const uword i = hashes[a].second;
+      
+      if(state[i] != 0)  { continue; }
+      
+      for(uword b=a+1; (b < n_hashes) && (hashes[b].first == hashes[a].first); ++b)
+        {
+        const uword j = hashes[b].second;
+        
+        if(state[j] != 0)  { continue; }
+        
+        if( (adj_elem[i] != adj_elem[j]) || (adj_var[i] != adj_var[j]) )  { continue; }
+        
+        nv[i]     += nv[j];
+        degree[i]  = (degree[i] > nv[j]) ? (degree[i] - nv[j]) : uword(0);
+        
+        nv[j]    = 0;
+        state[j] = 3;
+        
+        chain_next[chain_tail[i]] = j;
+        chain_tail[i]             = chain_tail[j];
+        
+        std::vector<uword>().swap(adj_var [j]);
+        std::vector<uword>().swap(adj_elem[j]);
+        }
+      }
+    
+    // the new element keeps only the principal supervariables
+    
+    std::vector<uword>& Le = elem_var[p];
+    
+    Le.reserve(Lp.size());
+    
+    for(const uword i : Lp)
+      {
+      if(state[i] != 0)  { continue; }
+      
+      Le.push_back(i);
+      
+      list_insert(i);
+      
+      min_deg = (std::min)(min_deg, degree[i]);
+      }
+    }
+  
+  uword k = 0;
+  
+  for(uword a=0; a < n_pivots; ++a)
+    {
+    for(uword i=pivots[a]; i != none; i = chain_next[i])  { perm[k] = i; ++k; }
+    }
+  
+  for(uword i=0; i < n; ++i)
+    {
+    if(state[i] == 4)  { perm[k] = i; ++k; }
+    }
+  
+  arma_check( (k != n), "sp_amd::apply(): internal error" );
+  }
+
+
+
+// 
+
+
+
+template<typename eT>
+inline
+spchol_worker<eT>::~spchol_worker()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+spchol_worker<eT>::spchol_worker()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+//! C(:,j) holds the rows of S(:,perm[j]) after symmetric permutation; the rows are not sorted
+template<typename eT>
+inline
+void
+spchol_worker<eT>::permuted_pattern(podarray<uword>& C_col_ptrs, podarray<uword>& C_row_indices, const uword N, const uword* S_col_ptrs, const uword* S_row_indices, const uword* in_perm, const uword* in_perm_inv)
+  {
+  arma_debug_sigprint();
+  
+  C_col_ptrs.set_size(N+1);
+  C_row_indices.set_size(S_col_ptrs[N]);
+  
+  uword count = 0;
+  
+  for(uword j=0; j < N; ++j)
+    {
+    C_col_ptrs[j] = count;
+    
+    const uword c = in_perm[j];
+    
+    for(uword k=S_col_ptrs[c]; k < S_col_ptrs[c+1]; ++k)  { C_row_indices[count] = in_perm_inv[ S_row_indices[k] ]; ++count; }
+    }
+  
+  C_col_ptrs[N] = count;
+  }
+
+
+
+//! elimination tree of a symmetric pattern; parent[j] == N for roots
+template<typename eT>
+inline
+void
+spchol_worker<eT>::etree(podarray<uword>& parent, const uword N, const uword* C_col_ptrs, const uword* C_row_indices)
+  {
+  arma_debug_sigprint();
+  
+  parent.set_size(N);
+  
+  podarray<uword> ancestor(N);
+  
+  for(uword j=0; j < N; ++j)
+    {
+    parent[j]   = N;
+    ancestor[j] = N;
+    
+    for(uword k=C_col_ptrs[j]; k < C_col_ptrs[j+1]; ++k)
+      {
+      uword i = C_row_indices[k];
+      
+      // walk up from i to the root of its current subtree, compressing the path
+      while( (i != N) && (i < j) )
+        {
+        const uword i_next = ancestor[i];
+        
+        ancestor[i] = j;
+        
+        if(i_next == N)  { parent[i] = j; }
+        
+        i = i_next;
+        }
+      }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+spchol_worker<eT>::symbolic(const SpMat<eT>& A, const spchol_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  const uword N = A.n_rows;
+  
+  n = N;
+  
+  // pattern of A + A^T without the diagonal
+  
+  podarray<uword> S_col_ptrs(N+1);
+  podarray<uword> S_row_indices;
+  
+  {
+  podarray<uword> counts(N+1);
+  
+  counts.zeros();
+  
+  for(uword c=0; c < N; ++c)
+  for(uword k=A.col_ptrs[c]; k < A.col_ptrs[c+1]; ++k)
+    {
+    const uword r = A.row_indices[k];
+    
+    if(r != c)  { ++counts[c+1]; ++counts[r+1]; }
+    }
+  
+  for(uword c=0; c < N; ++c)  { counts[c+1] += counts[c]; }
+  
+  podarray<uword> tmp(counts[N]);
+  podarray<uword> pos(N);
+  
+  arrayops::copy(pos.memptr(), counts.memptr(), N);
+  
+  for(uword c=0; c < N; ++c)
+  for(uword k=A.col_ptrs[c]; k < A.col_ptrs[c+1]; ++k)
+    {
+    const uword r = A.row_indices[k];
+    
+    if(r != c)  { tmp[pos[c]] = r; ++pos[c]; tmp[pos[r]] = c; ++pos[r]; }
+    }
+  
+  // remove duplicates, as A may have a symmetric pattern
+  
+  S_row_indices.set_size(counts[N]);
+  
+  podarray<uword> seen(N);
+  
+  seen.fill(N);
+  
+  uword count = 0;
+  
+  for(uword c=0; c < N; ++c)
+    {
+    S_col_ptrs[c] = count;
+    
+    for(uword k=counts[c]; k < counts[c+1]; ++k)
+      {
+      const uword r = tmp[k];
+      
+      if(seen[r] != c)  { seen[r] = c; S_row_indices[count] = r; ++count; }
+      }
+    }
+  
+  S_col_ptrs[N] = count;
+  }
+  
+  // fill-reducing ordering
+  
+  podarray<uword> perm0(N);
+  
+  if(opts.permutation == spchol_opts::AMD)
+    {
+    sp_amd::apply(perm0, N, S_col_ptrs.memptr(), S_row_indices.memptr());
+    }
+  else
+    {
+    for(uword i=0; i < N; ++i)  { perm0[i] = i; }
+    }
+  
+  podarray<uword> perm_inv(N);
+  
+  podarray<uword> C_col_ptrs;
+  podarray<uword> C_row_indices;
+  
+  podarray<uword> parent;
+  
+  for(uword i=0; i < N; ++i)  { perm_inv[perm0[i]] = i; }
+  
+  permuted_pattern(C_col_ptrs, C_row_indices, N, S_col_ptrs.memptr(), S_row_indices.memptr(), perm0.memptr(), perm_inv.memptr());
+  
+  etree(parent, N, C_col_ptrs.memptr(), C_row_indices.memptr());
+  
+  // postorder the elimination tree, so that the columns of each supernode are contiguous
+  
+  podarray<uword> post(N);
+  
+  {
+  podarray<uword> child_head(N);
+  podarray<uword> child_next(N);
+  podarray<uword> stack(N);
+  
+  child_head.fill(N);
+  
+  for(uword jj=N; jj > 0; --jj)
+    {
+    const uword j = jj-1;
+    
+    if(parent[j] != N)  { child_next[j] = child_head[parent[j]]; child_head[parent[j]] = j; }
+    }
+  
+  uword k = 0;
+  
+  for(uword root=0; root < N; ++root)
+    {
+    if(parent[root] != N)  { continue; }
+    
+    uword top = 0;
+    
+    stack[0] = root;
+    
+    while(true)
+      {
+      const uword j     = stack[top];
+      const uword child = child_head[j];
+      
+      if(child == N)
+        {
+        post[k] = j;  ++k;
+        
+        if(top == 0)  { break; }
+        
+        --top;
+        }
+      else
+        {
+        child_head[j] = child_next[child];
+        
+        ++top;
+        
+        stack[top] = child;
+        }
+      }
+    }
+  }
+  
+  perm.set_size(N);
+  
+  for(uword i=0; i < N; ++i)  { perm[i] = perm0[post[i]]; }
+  for(uword i=0; i < N; ++i)  { perm_inv[perm[i]] = i;    }
+  
+  permuted_pattern(C_col_ptrs, C_row_indices, N, S_col_ptrs.memptr(), S_row_indices.memptr(), perm.memptr(), perm_inv.memptr());
+  
+  etree(parent, N, C_col_ptrs.memptr(), C_row_indices.memptr());
+  
+  // column counts of L, via the row subtrees of the elimination tree
+  
+  podarray<uword> col_counts(N);
+  podarray<uword> n_children(N);
+  
+  {
+  podarray<uword> visited(N);
+  
+  col_counts.zeros();
+  n_children.zeros();
+  
+  for(uword i=0; i < N; ++i)
+    {
+    visited[i] = i;
+    
+    ++col_counts[i];
+    
+    if(parent[i] != N)  { ++n_children[parent[i]]; }
+    
+    for(uword k=C_col_ptrs[i]; k < C_col_ptrs[i+1]; ++k)
+      {
+      uword j = C_row_indices[k];
+      
+      if(j > i)  { continue; }
+      
+      while(visited[j] != i)  { visited[j] = i; ++col_counts[j]; j = parent[j]; }
+      }
+    }
+  }
+  
+  // fundamental supernodes: chains of columns where each column is the only child of the next and has the same structure below the diagonal
+  
+  col_super.set_size(N);
+  super_ptrs.set_size(N+1);
+  
+  n_super = 0;
+  
+  for(uword j=0; j < N; ++j)
+    {
+    const bool merge = (j > 0) && (parent[j-1] == j) && (n_children[j] == 1) && (col_counts[j-1] == col_counts[j] + 1);
+    
+    if(merge == false)  { super_ptrs[n_super] = j; ++n_super; }
+    
+    col_super[j] = n_super - 1;
+    }
+  
+  super_ptrs[n_super] = N;
+  
+  // row structure of each supernode: the structure of its first column, assembled from the original pattern and the structures of the child supernodes
+  
+  rows_ptrs.set_size(n_super+1);
+  vals_ptrs.set_size(n_super+1);
+  
+  rows_ptrs[0] = 0;
+  vals_ptrs[0] = 0;
+  
+  for(uword s=0; s < n_super; ++s)
+    {
+    const uword n_rows_s = col_counts[ super_ptrs[s] ];
+    const uword n_cols_s = super_ptrs[s+1] - super_ptrs[s];
+    
+    rows_ptrs[s+1] = rows_ptrs[s] + n_rows_s;
+    vals_ptrs[s+1] = vals_ptrs[s] + n_rows_s * n_cols_s;
+    }
+  
+  super_rows.set_size(rows_ptrs[n_super]);
+  
+  {
+  podarray<uword> child_head(n_super);
+  podarray<uword> child_next(n_super);
+  podarray<uword> seen(N);
+  
+  child_head.fill(n_super);
+  seen.fill(n_super);
+  
+  for(uword s=0; s < n_super; ++s)
+    {
+    const uword f = super_ptrs[s  ];
+    const uword l = super_ptrs[s+1];
+    
+    uword* R     = super_rows.memptr() + rows_ptrs[s];
+    uword  count = 0;
+    
+    for(uword j=f; j < l; ++j)  { R[count] = j; ++count; seen[j] = s; }
+    
+    for(uword j=f; j < l; ++j)
+    for(uword k=C_col_ptrs[j]; k < C_col_ptrs[j+1]; ++k)
+      {
+      const uword r = C_row_indices[k];
+      
+      if( (r >= l) && (seen[r] != s) )  { seen[r] = s; R[count] = r; ++count; }
+      }
+    
+    for(uword c=child_head[s]; c != n_super; c = child_next[c])
+      {
+      for(uword k=rows_ptrs[c]; k < rows_ptrs[c+1]; ++k)
+        {
+        const uword r = super_rows[k];
+        
+        if( (r >= l) && (seen[r] != s) )  { seen[r] = s; R[count] = r; ++count; }
+        }
+      }
+    
+    arma_check( (count != (rows_ptrs[s+1] - rows_ptrs[s])), "spchol_worker::symbolic(): internal error" );
+    
+    std::sort(R + (l-f), R + count);
+    
+    const uword p = parent[l-1];
+    
+    if(p != N)
+      {
+      const uword t = col_super[p];
+      
+      child_next[s] = child_head[t];
+      child_head[t] = s;
+      }
+    }
+  }
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spchol_worker<eT>::numeric(const SpMat<eT>& A)
+  {
+  arma_debug_sigprint();
+  
+  const uword N = n;
+  
+  panels.set_size(vals_ptrs[n_super]);
+  
+  podarray<uword> perm_inv(N);
+  
+  for(uword i=0; i < N; ++i)  { perm_inv[perm[i]] = i; }
+  
+  podarray<uword> rel(N);  // position of each row within the current supernode
+  
+  // descendants of each supernode which are yet to be applied, as linked lists;
+  // next_pos[d] is the position of the first row of supernode d that has not been used for updates
+  
+  podarray<uword> link_head(n_super);
+  podarray<uword> link_next(n_super);
+  podarray<uword> next_pos (n_super);
+  
+  link_head.fill(n_super);
+  
+  Mat<eT> W;
+  
+  for(uword s=0; s < n_super; ++s)
+    {
+    const uword f    = super_ptrs[s];
+    const uword l    = super_ptrs[s+1];
+    const uword nc   = l - f;
+    const uword m    = rows_ptrs[s+1] - rows_ptrs[s];
+    
+    const uword* R = super_rows.memptr() + rows_ptrs[s];
+          eT*    P = panels.memptr() + vals_ptrs[s];
+    
+    arrayops::fill_zeros(P, m*nc);
+    
+    for(uword i=0; i < m; ++i)  { rel[R[i]] = i; }
+    
+    // lower triangle of the permuted matrix
+    
+    for(uword j=f; j < l; ++j)
+      {
+      const uword c = perm[j];
+      
+      eT* Pj = P + (j-f)*m;
+      
+      for(uword k=A.col_ptrs[c]; k < A.col_ptrs[c+1]; ++k)
+        {
+        const uword i = perm_inv[ A.row_indices[k] ];
+        
+        if(i >= j)  { Pj[ rel[i] ] += A.values[k]; }
+        }
+      }
+    
+    // updates from descendant supernodes
+    
+    uword d = link_head[s];
+    
+    while(d != n_super)
+      {
+      const uword d_next = link_next[d];
+      
+      const uword  nd = super_ptrs[d+1] - super_ptrs[d];
+      const uword  md = rows_ptrs[d+1]  - rows_ptrs[d];
+      const uword* Rd = super_rows.memptr() + rows_ptrs[d];
+      const eT*    Pd = panels.memptr() + vals_ptrs[d];
+      
+      const uword p1 = next_pos[d];
+            uword p2 = p1;
+      
+      while( (p2 < md) && (Rd[p2] < l) )  { ++p2; }
+      
+      const uword q  = p2 - p1;  // number of columns of s which are updated
+      const uword mr = md - p1;  // number of rows which are updated
+      
+      // W = L_d(p1:end, :) * D_d * L_d(p1:p2-1, :)^H; only the lower trapezoid is used
+      
+      if( (mr*q*nd) >= uword(32768) )
+        {
+        const Mat<eT> Ld(const_cast<eT*>(Pd), md, nd, false, true);
+        
+        Mat<eT> Lq = Ld.rows(p1, p2-1);
+        
+        if(is_ldl)  { for(uword k=0; k < nd; ++k)  { Lq.col(k) *= access::alt_conj(Pd[k*md + k]); } }
+        
+        W = Ld.rows(p1, md-1) * Lq.t();
+        }
+      else
+        {
+        W.zeros(mr, q);
+        
+        for(uword k=0; k < nd; ++k)
+          {
+          const eT* Lk = Pd + k*md + p1;
+          const eT  dk = (is_ldl) ? Pd[k*md + k] : eT(1);
+          
+          for(uword jq=0; jq < q; ++jq)
+            {
+            const eT coef = access::alt_conj(Lk[jq]) * dk;
+            
+            if(coef == eT(0))  { continue; }
+            
+            eT* Wj = W.colptr(jq);
+            
+            for(uword i=jq; i < mr; ++i)  { Wj[i] += Lk[i] * coef; }
+            }
+          }
+        }
+      
+      for(uword jq=0; jq < q; ++jq)
+        {
+        const eT* Wj = W.colptr(jq);
+              eT* Pj = P + (Rd[p1+jq] - f)*m;
+        
+        for(uword i=jq; i < mr; ++i)  { Pj[ rel[Rd[p1+i]] ] -= Wj[i]; }
+        }
+      
+      next_pos[d] = p2;
+      
+      if(p2 < md)
+        {
+        const uword t = col_super[Rd[p2]];
+        
+        link_next[d] = link_head[t];
+        link_head[t] = d;
+        }
+      
+      d = d_next;
+      }
+    
+    // factorise the panel
+    
+    for(uword j=0; j < nc; ++j)
+      {
+      eT* Pj = P + j*m;
+      
+      for(uword k=0; k < j; ++k)
+        {
+        const eT* Pk = P + k*m;
+        
+        const eT coef = access::alt_conj(Pk[j]) * ( (is_ldl) ? Pk[k] : eT(1) );
+        
+        if(coef == eT(0))  { continue; }
+        
+        for(uword i=j; i < m; ++i)  { Pj[i] -= Pk[i] * coef; }
+        }
+      
+      if(is_ldl)
+        {
+        const eT dj = Pj[j];
+        
+        if( (std::abs(dj) == T(0)) || arma_isnan(dj) )  { return false; }
+        
+        const eT inv_dj = eT(1) / dj;
+        
+        for(uword i=j+1; i < m; ++i)  { Pj[i] *= inv_dj; }
+        }
+      else
+        {
+        const T djj = access::tmp_real(Pj[j]);
+        
+        if( (djj <= T(0)) || arma_isnan(djj) )  { return false; }
+        
+        const T dj = std::sqrt(djj);
+        
+        Pj[j] = eT(dj);
+        
+        const T inv_dj = T(1) / dj;
+        
+        for(uword i=j+1; i < m; ++i)  { Pj[i] *= inv_dj; }
+        }
+      }
+    
+    next_pos[s] = nc;
+    
+    if(nc < m)
+      {
+      const uword t = col_super[R[nc]];
+      
+      link_next[s] = link_head[t];
+      link_head[t] = s;
+      }
+    }
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spchol_worker<eT>::factorise(T& out_rcond, const SpMat<eT>& A, const spchol_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  out_rcond = T(0);
+  
+  is_ldl = (opts.factor == spchol_opts::LDLT);
+  
+  A.sync();
+  
+  symbolic(A, opts);
+  
+  const bool status = numeric(A);
+  
+  if(status == false)  { return false; }
+  
+  if(n == 0)  { out_rcond = T(1); return true; }
+  
+  out_rcond = rcond_est( spop_norm::mat_norm_1(A) );
+  
+  return true;
+  }
+
+
+
+//! reciprocal condition number in the 1-norm, via the Hager/Higham estimate of norm(inv(A),1) (as used by LAPACK pocon/sycon);
+//! as inv(A) is hermitian, only solves with the stored factorisation are required
+template<typename eT>
+inline
+typename get_pod_type<eT>::result
+spchol_worker<eT>::rcond_est(const T A_norm1) const
+  {
+  arma_debug_sigprint();
+  
+  if( (A_norm1 == T(0)) || (arma_isfinite(A_norm1) == false) )  { return T(0); }
+  
+  podarray<eT> x(n);
+  podarray<eT> xi(n);
+  
+  x.fill( eT(T(1) / T(n)) );
+  
+  solve_col(x.memptr());
+  
+  T est = T(0);
+  
+  for(uword i=0; i < n; ++i)  { est += std::abs(x[i]); }
+  
+  if(n > 1)
+    {
+    uword j     = 0;
+    uword j_old = 0;
+    
+    for(uword iter=1; iter <= 5; ++iter)
+      {
+      if(iter > 1)
+        {
+        x.zeros();
+        
+        x[j] = eT(1);
+        
+        solve_col(x.memptr());
+        
+        const T est_old = est;
+        
+        est = T(0);
+        
+        for(uword i=0; i < n; ++i)  { est += std::abs(x[i]); }
+        
+        if(est <= est_old)  { est = est_old; break; }
+        }
+      
+      // xi = sign(x), with sign(0) = 1
+      
+      for(uword i=0; i < n; ++i)
+        {
+        const T abs_val = std::abs(x[i]);
+        
+        xi[i] = (abs_val == T(0)) ? eT(1) : (x[i] / abs_val);
+        }
+      
+      solve_col(xi.memptr());
+      
+      j_old = j;
+      
+      T best = T(-1);
+      
+      for(uword i=0; i < n; ++i)
+        {
+        const T val = std::abs(access::tmp_real(xi[i]));
+        
+        if(val > best)  { best = val; j = i; }
+        }
+      
+      if( (iter > 1) && (std::abs(access::tmp_real(xi[j_old])) == best) )  { break; }
+      }
+    
+    // alternative estimate, guarding against matrices on which the iteration performs poorly
+    
+    for(uword i=0; i < n; ++i)
+      {
+      const T val = T(1) + T(i) / T(n-1);
+      
+      x[i] = eT( (i % 2) ? -val : val );
+      }
+    
+    solve_col(x.memptr());
+    
+    T alt_est = T(0);
+    
+    for(uword i=0; i < n; ++i)  { alt_est += std::abs(x[i]); }
+    
+    alt_est = T(2) * alt_est / T(3*n);
+    
+    est = (std::max)(est, alt_est);
+    }
+  
+  if( (est == T(0)) || (arma_isfinite(est) == false) )  { return T(0); }
+  
+  return (T(1) / est) / A_norm1;
+  }
+
+
+
+//! solve for a single column, given and returned in the permuted order
+template<typename eT>
+inline
+void
+spchol_worker<eT>::solve_col(eT* y) const
+  {
+  arma_debug_sigprint();
+  
+  // L z = y
+  
+  for(uword s=0; s < n_super; ++s)
+    {
+    const uword f  = super_ptrs[s];
+    const uword nc = super_ptrs[s+1] - f;
+    const uword m  = rows_ptrs[s+1]  - rows_ptrs[s];
+    
+    const uword* R = super_rows.memptr() + rows_ptrs[s];
+    const eT*    P = panels.memptr() + vals_ptrs[s];
+    
+    for(uword j=0; j < nc; ++j)
+      {
+      const eT* Pj = P + j*m;
+      
+      if(is_ldl == false)  { y[f+j] /= Pj[j]; }
+      
+      const eT val = y[f+j];
+      
+      if(val == eT(0))  { continue; }
+      
+      for(uword i=j+1; i < m; ++i)  { y[R[i]] -= Pj[i] * val; }
+      }
+    }
+  
+  // D z = y
+  
+  if(is_ldl)
+    {
+    for(uword s=0; s < n_super; ++s)
+      {
+      const uword f  = super_ptrs[s];
+      const uword nc = super_ptrs[s+1] - f;
+      const uword m  = rows_ptrs[s+1]  - rows_ptrs[s];
+      
+      const eT* P = panels.memptr() + vals_ptrs[s];
+      
+      for(uword j=0; j < nc; ++j)  { y[f+j] /= P[j*m + j]; }
+      }
+    }
+  
+  // L^H z = y
+  
+  for(uword ss=n_super; ss > 0; --ss)
+    {
+    const uword s  = ss-1;
+    const uword f  = super_ptrs[s];
+    const uword nc = super_ptrs[s+1] - f;
+    const uword m  = rows_ptrs[s+1]  - rows_ptrs[s];
+    
+    const uword* R = super_rows.memptr() + rows_ptrs[s];
+    const eT*    P = panels.memptr() + vals_ptrs[s];
+    
+    for(uword jj=nc; jj > 0; --jj)
+      {
+      const uword j  = jj-1;
+      const eT*   Pj = P + j*m;
+      
+      eT acc = y[f+j];
+      
+      for(uword i=j+1; i < m; ++i)  { acc -= access::alt_conj(Pj[i]) * y[R[i]]; }
+      
+      if(is_ldl == false)  { acc /= Pj[j]; }
+      
+      y[f+j] = acc;
+      }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spchol_worker<eT>::solve(Mat<eT>& X, const Mat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  if(B.n_rows != n)  { return false; }
+  
+  X.set_size(n, B.n_cols);
+  
+  podarray<eT> y(n);
+  
+  for(uword c=0; c < B.n_cols; ++c)
+    {
+    const eT* B_col = B.colptr(c);
+          eT* X_col = X.colptr(c);
+    
+    for(uword j=0; j < n; ++j)  { y[j] = B_col[perm[j]]; }
+    
+    solve_col(y.memptr());
+    
+    for(uword j=0; j < n; ++j)  { X_col[perm[j]] = y[j]; }
+    }
+  
+  return X.internal_has_nonfinite() == false;
+  }
+
+
+
+//! @}
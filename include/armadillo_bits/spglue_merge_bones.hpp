@@ -36,6 +36,51 @@ class spglue_merge
   
   template<typename eT>
   inline static void diagview_merge(SpMat<eT>& out, const SpMat<eT>& A, const SpMat<eT>& B);
+  
+  template<typename eT>
+  inline static int get_n_threads(const SpMat<eT>& A, const SpMat<eT>& B);
+  
+  template<typename merge_type, typename eT>
+  inline static void elem_merge(SpMat<eT>& out, const SpMat<eT>& A, const SpMat<eT>& B, const int n_threads);
+  
+  template<typename merge_type, const bool do_write, typename eT>
+  inline static uword elem_merge_col(const SpMat<eT>& A, const SpMat<eT>& B, const uword col, uword* out_row_indices, eT* out_values);
+  };
+
+
+
+//! element-wise operations for spglue_merge::elem_merge();
+//! union types keep elements present in only one of the operands, intersection types keep only the elements present in both
+
+struct spglue_merge_plus
+  {
+  static constexpr bool is_union = true;
+  
+  template<typename eT> arma_inline static eT both  (const eT a, const eT b) { return a + b; }
+  template<typename eT> arma_inline static eT a_only(const eT a)             { return a;     }
+  template<typename eT> arma_inline static eT b_only(const eT b)             { return b;     }
+  };
+
+
+
+struct spglue_merge_minus
+  {
+  static constexpr bool is_union = true;
+  
+  template<typename eT> arma_inline static eT both  (const eT a, const eT b) { return a - b; }
+  template<typename eT> arma_inline static eT a_only(const eT a)             { return  a;    }
+  template<typename eT> arma_inline static eT b_only(const eT b)             { return -b;    }
+  };
+
+
+
+struct spglue_merge_schur
+  {
+  static constexpr bool is_union = false;
+  
+  template<typename eT> arma_inline static eT both  (const eT a, const eT b) { return a * b; }
+  template<typename eT> arma_inline static eT a_only(const eT a)             { return a;     }
+  template<typename eT> arma_inline static eT b_only(const eT b)             { return b;     }
   };
 
 
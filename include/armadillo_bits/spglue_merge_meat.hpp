@@ -551,4 +551,154 @@ spglue_merge::diagview_merge(SpMat<eT>& out, const SpMat<eT>& A, const SpMat<eT>
 
 
 
+template<typename eT>
+inline
+int
+spglue_merge::get_n_threads(const SpMat<eT>& A, const SpMat<eT>& B)
+  {
+  return ( (A.n_cols > 1) && mp_gate<eT>::eval_loop(A.n_nonzero + B.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  }
+
+
+
+//! column-partitioned element-wise merge of A and B;
+//! the number of elements in each column of the output is counted first,
+//! so that the columns can be written in parallel into memory of the exact size
+template<typename merge_type, typename eT>
+inline
+void
+spglue_merge::elem_merge(SpMat<eT>& out, const SpMat<eT>& A, const SpMat<eT>& B, const int n_threads)
+  {
+  arma_debug_sigprint();
+  
+  arma_conform_assert_same_size(A.n_rows, A.n_cols, B.n_rows, B.n_cols, "element-wise operation");
+  
+  A.sync();
+  B.sync();
+  
+  const uword n_cols = A.n_cols;
+  
+  // work for each column, in terms of the number of elements of A and B
+  podarray<uword> work(n_cols + 1);
+  
+  uword* work_mem = work.memptr();
+  
+  for(uword col=0; col <= n_cols; ++col)  { work_mem[col] = A.col_ptrs[col] + B.col_ptrs[col]; }
+  
+  podarray<uword> counts(n_cols + 1);
+  
+  uword* counts_mem = counts.memptr();
+  
+  counts_mem[0] = 0;
+  
+  const auto count_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col=start; col < endp1; ++col)
+      {
+      counts_mem[col + 1] = spglue_merge::elem_merge_col<merge_type, false>(A, B, col, nullptr, static_cast<eT*>(nullptr));
+      }
+    };
+  
+  mp_loop::run_weighted(n_cols, work_mem, n_threads, count_worker);
+  
+  for(uword col=0; col < n_cols; ++col)  { counts_mem[col + 1] += counts_mem[col]; }
+  
+  out.reserve(A.n_rows, n_cols, counts_mem[n_cols]);
+  
+  if(out.n_nonzero == 0)  { return; }
+  
+  arrayops::copy(access::rwp(out.col_ptrs), counts_mem, n_cols + 1);
+  
+  uword* out_row_indices = access::rwp(out.row_indices);
+  eT*    out_values      = access::rwp(out.values);
+  
+  const auto write_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col=start; col < endp1; ++col)
+      {
+      const uword offset = counts_mem[col];
+      
+      spglue_merge::elem_merge_col<merge_type, true>(A, B, col, &(out_row_indices[offset]), &(out_values[offset]));
+      }
+    };
+  
+  mp_loop::run_weighted(n_cols, work_mem, n_threads, write_worker);
+  }
+
+
+
+//! merge one column of A and B, optionally writing the result;
+//! returns the number of non-zero elements in the merged column
+template<typename merge_type, const bool do_write, typename eT>
+inline
+uword
+spglue_merge::elem_merge_col(const SpMat<eT>& A, const SpMat<eT>& B, const uword col, uword* out_row_indices, eT* out_values)
+  {
+  const uword* A_row_indices = A.row_indices;
+  const uword* B_row_indices = B.row_indices;
+  
+  const eT* A_values = A.values;
+  const eT* B_values = B.values;
+  
+  uword A_i = A.col_ptrs[col];
+  uword B_i = B.col_ptrs[col];
+  
+  const uword A_endp1 = A.col_ptrs[col + 1];
+  const uword B_endp1 = B.col_ptrs[col + 1];
+  
+  uword count = 0;
+  
+  while( (A_i < A_endp1) || (B_i < B_endp1) )
+    {
+    const uword A_row = (A_i < A_endp1) ? A_row_indices[A_i] : A.n_rows;
+    const uword B_row = (B_i < B_endp1) ? B_row_indices[B_i] : B.n_rows;
+    
+    uword row;
+    eT    val;
+    
+    if(A_row == B_row)
+      {
+      row = A_row;
+      val = merge_type::both(A_values[A_i], B_values[B_i]);
+      
+      ++A_i;
+      ++B_i;
+      }
+    else
+    if(A_row < B_row)
+      {
+      if(merge_type::is_union == false)  { ++A_i; continue; }
+      
+      row = A_row;
+      val = merge_type::a_only(A_values[A_i]);
+      
+      ++A_i;
+      }
+    else
+      {
+      if(merge_type::is_union == false)  { ++B_i; continue; }
+      
+      row = B_row;
+      val = merge_type::b_only(B_values[B_i]);
+      
+      ++B_i;
+      }
+    
+    if(val != eT(0))
+      {
+      if(do_write)
+        {
+        out_row_indices[count] = row;
+        out_values[count]      = val;
+        }
+      
+      ++count;
+      }
+    }
+  
+  return count;
+  }
+
+
+
 //! @}
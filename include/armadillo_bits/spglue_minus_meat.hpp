@@ -63,6 +63,16 @@ spglue_minus::apply_noalias(SpMat<eT>& out, const SpProxy<T1>& pa, const SpProxy
   if(pa.get_n_nonzero() == 0)  { out = pb.Q; out *= eT(-1); return; }
   if(pb.get_n_nonzero() == 0)  { out = pa.Q;                return; }
   
+  if( is_SpMat<typename SpProxy<T1>::stored_type>::value && is_SpMat<typename SpProxy<T2>::stored_type>::value )
+    {
+    const unwrap_spmat<typename SpProxy<T1>::stored_type> UA(pa.Q);
+    const unwrap_spmat<typename SpProxy<T2>::stored_type> UB(pb.Q);
+    
+    const int n_threads = spglue_merge::get_n_threads(UA.M, UB.M);
+    
+    if(n_threads > 1)  { spglue_merge::elem_merge<spglue_merge_minus>(out, UA.M, UB.M, n_threads); return; }
+    }
+  
   const uword max_n_nonzero = pa.get_n_nonzero() + pb.get_n_nonzero();
   
   // Resize memory to upper bound
@@ -41,6 +41,66 @@ class spglue_times
   
   template<typename eT>
   inline static void apply_noalias(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y);
+  
+  // two-phase Gustavson algorithm:
+  // the symbolic phase determines the number of elements in each column of the output and allocates memory,
+  // and the numeric phase computes the row indices and values;
+  // both phases process contiguous ranges of columns in parallel, with the ranges chosen to have a similar number of multiply-adds
+  
+  template<typename eT>
+  inline static void apply_symbolic(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y, const int n_threads);
+  
+  template<typename eT>
+  inline static bool apply_numeric(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y, const bool has_structure, const int n_threads);
+  
+  template<typename eT>
+  inline static int get_n_threads(const SpMat<eT>& x, const SpMat<eT>& y);
+  
+  template<typename eT, typename functor>
+  inline static void run_balanced(const SpMat<eT>& x, const SpMat<eT>& y, const int n_threads, const functor& F);
+  };
+
+
+
+//! accumulator for one column of the output of sparse matrix multiplication;
+//! columns with few multiply-adds relative to the number of rows use a hash table, which fits in cache;
+//! other columns use dense arrays, indexed by row
+template<typename eT>
+class spglue_times_accumulator
+  {
+  public:
+  
+  inline explicit spglue_times_accumulator(const uword in_n_rows);
+  
+  inline void begin(const uword max_n_entries);
+  
+  arma_inline void insert(const uword row);
+  arma_inline void add(const uword row, const eT val);
+  arma_inline eT   get(const uword row) const;
+  
+  arma_inline uword        get_n_entries() const;
+  arma_inline const uword* get_rows()      const;
+  
+  
+  private:
+  
+  const uword n_rows;
+  
+  bool use_hash = false;
+  
+  podarray<uword> rows;           // rows inserted since the last call to begin()
+  uword           n_entries = 0;
+  
+  podarray<uword> dense_mark;     // dense_mark[row] == dense_stamp indicates that row has been inserted
+  podarray<eT>    dense_vals;
+  uword           dense_stamp = 0;
+  
+  podarray<uword> hash_keys;      // n_rows indicates an empty slot
+  podarray<eT>    hash_vals;
+  uword           hash_mask  = 0;
+  uword           hash_shift = 0;
+  
+  arma_inline uword hash_locate(const uword row) const;
   };
 
 
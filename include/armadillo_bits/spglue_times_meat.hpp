@@ -90,208 +90,410 @@ spglue_times::apply_noalias(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y
   {
   arma_debug_sigprint();
   
-  const uword x_n_rows = x.n_rows;
-  const uword x_n_cols = x.n_cols;
-  const uword y_n_rows = y.n_rows;
-  const uword y_n_cols = y.n_cols;
+  arma_conform_assert_mul_size(x.n_rows, x.n_cols, y.n_rows, y.n_cols, "matrix multiplication");
   
-  arma_conform_assert_mul_size(x_n_rows, x_n_cols, y_n_rows, y_n_cols, "matrix multiplication");
+  c.zeros(x.n_rows, y.n_cols);
   
-  // First we must determine the structure of the new matrix (column pointers).
-  // This follows the algorithm described in 'Sparse Matrix Multiplication
-  // Package (SMMP)' (R.E. Bank and C.C. Douglas, 2001).  Their description of
-  // "SYMBMM" does not include anything about memory allocation.  In addition it
-  // does not consider that there may be elements which space may be allocated
-  // for but which evaluate to zero anyway.  So we have to modify the algorithm
-  // to work that way.  For the "SYMBMM" implementation we will not determine
-  // the row indices but instead just the column pointers.
+  if( (x.n_nonzero == 0) || (y.n_nonzero == 0) )  { return; }
   
-  //SpMat<typename T1::elem_type> c(x_n_rows, y_n_cols); // Initializes col_ptrs to 0.
-  c.zeros(x_n_rows, y_n_cols);
+  const int n_threads = spglue_times::get_n_threads(x, y);
   
-  //if( (x.n_elem == 0) || (y.n_elem == 0) )  { return; }
-  if( (x.n_nonzero == 0) || (y.n_nonzero == 0) )  { return; }
+  spglue_times::apply_symbolic(c, x, y, n_threads);
+  
+  const bool has_zeros = spglue_times::apply_numeric(c, x, y, false, n_threads);
+  
+  if(has_zeros)  { c.remove_zeros(); }
+  }
+
+
+
+//! determine the number of elements in each column of c = x*y (including elements which may evaluate to zero),
+//! and allocate memory for the elements; c must have been set to zeros of the correct size
+template<typename eT>
+inline
+void
+spglue_times::apply_symbolic(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y, const int n_threads)
+  {
+  arma_debug_sigprint();
   
-  // Auxiliary storage which denotes when items have been found.
-  podarray<uword> index(x_n_rows);
-  index.fill(x_n_rows); // Fill with invalid links.
+  const uword  x_n_rows      = x.n_rows;
+  const uword  y_n_cols      = y.n_cols;
+  const uword* x_col_ptrs    = x.col_ptrs;
+  const uword* x_row_indices = x.row_indices;
+  const uword* y_col_ptrs    = y.col_ptrs;
+  const uword* y_row_indices = y.row_indices;
   
-  typename SpMat<eT>::const_iterator y_it  = y.begin();
-  typename SpMat<eT>::const_iterator y_end = y.end();
+  uword* c_col_ptrs = access::rwp(c.col_ptrs);
   
-  // SYMBMM: calculate column pointers for resultant matrix to obtain a good
-  // upper bound on the number of nonzero elements.
-  uword cur_col_length = 0;
-  uword last_ind = x_n_rows + 1;
-  do
+  const auto worker = [&](const uword start, const uword endp1)
     {
-    const uword y_it_row = y_it.row();
-    
-    // Look through the column that this point (*y_it) could affect.
-    typename SpMat<eT>::const_iterator x_it = x.begin_col_no_sync(y_it_row);
+    spglue_times_accumulator<eT> acc(x_n_rows);
     
-    while(x_it.col() == y_it_row)
+    for(uword col=start; col < endp1; ++col)
       {
-      const uword x_it_row = x_it.row();
+      const uword y_start = y_col_ptrs[col    ];
+      const uword y_endp1 = y_col_ptrs[col + 1];
       
-      // A point at x(i, j) and y(j, k) implies a point at c(i, k).
-      if(index[x_it_row] == x_n_rows)
+      uword n_flops = 0;
+      
+      for(uword i=y_start; i < y_endp1; ++i)
         {
-        index[x_it_row] = last_ind;
-        last_ind = x_it_row;
-        ++cur_col_length;
+        const uword k = y_row_indices[i];
+        
+        n_flops += x_col_ptrs[k + 1] - x_col_ptrs[k];
         }
       
-      ++x_it;
-      }
-    
-    const uword old_col = y_it.col();
-    ++y_it;
-    
-    // See if column incremented.
-    if(old_col != y_it.col())
-      {
-      // Set column pointer (this is not a cumulative count; that is done later).
-      access::rw(c.col_ptrs[old_col + 1]) = cur_col_length;
-      cur_col_length = 0;
+      if(n_flops == 0)  { continue; }
       
-      // Return index markers to zero.  Use last_ind for traversal.
-      while(last_ind != x_n_rows + 1)
+      acc.begin(n_flops);
+      
+      for(uword i=y_start; i < y_endp1; ++i)
         {
-        const uword tmp = index[last_ind];
-        index[last_ind] = x_n_rows;
-        last_ind = tmp;
+        const uword k = y_row_indices[i];
+        
+        const uword x_endp1 = x_col_ptrs[k + 1];
+        
+        for(uword j=x_col_ptrs[k]; j < x_endp1; ++j)  { acc.insert(x_row_indices[j]); }
         }
+      
+      // not a cumulative count; that is done below
+      c_col_ptrs[col + 1] = acc.get_n_entries();
       }
-    }
-  while(y_it != y_end);
+    };
   
-  // Accumulate column pointers.
-  for(uword i = 0; i < c.n_cols; ++i)
-    {
-    access::rw(c.col_ptrs[i + 1]) += c.col_ptrs[i];
-    }
+  spglue_times::run_balanced(x, y, n_threads, worker);
+  
+  for(uword col=0; col < y_n_cols; ++col)  { c_col_ptrs[col + 1] += c_col_ptrs[col]; }
   
-  // Now that we know a decent bound on the number of nonzero elements,
-  // allocate the memory and fill it.
+  c.mem_resize(c_col_ptrs[y_n_cols]);
+  }
+
+
+
+//! compute the row indices and values of c = x*y, using the column pointers obtained by apply_symbolic();
+//! if has_structure is true, the row indices are also taken as given, and are expected to be sorted within each column;
+//! elements which evaluate to zero are kept; the return value indicates whether there are any such elements
+template<typename eT>
+inline
+bool
+spglue_times::apply_numeric(SpMat<eT>& c, const SpMat<eT>& x, const SpMat<eT>& y, const bool has_structure, const int n_threads)
+  {
+  arma_debug_sigprint();
   
-  const uword max_n_nonzero = c.col_ptrs[c.n_cols];
+  if(c.n_nonzero == 0)  { return false; }
   
-  c.mem_resize(max_n_nonzero);
+  const uword  x_n_rows      = x.n_rows;
+  const uword* x_col_ptrs    = x.col_ptrs;
+  const uword* x_row_indices = x.row_indices;
+  const eT*    x_values      = x.values;
+  const uword* y_col_ptrs    = y.col_ptrs;
+  const uword* y_row_indices = y.row_indices;
+  const eT*    y_values      = y.values;
   
-  // Now the implementation of the NUMBMM algorithm.
-  uword cur_pos = 0; // Current position in c matrix.
-  podarray<eT> sums(x_n_rows); // Partial sums.
-  sums.zeros();
+  const uword* c_col_ptrs    = c.col_ptrs;
+        uword* c_row_indices = access::rwp(c.row_indices);
+        eT*    c_values      = access::rwp(c.values);
   
-  podarray<uword> sorted_indices(x_n_rows);  // upper bound
+  std::atomic<bool> has_zeros(false);
   
-  // last_ind is already set to x_n_rows, and cur_col_length is already set to 0.
-  // We will loop through all columns as necessary.
-  uword cur_col = 0;
-  while(cur_col < c.n_cols)
+  const auto worker = [&](const uword start, const uword endp1)
     {
-    // Skip to next column with elements in it.
-    while((cur_col < c.n_cols) && (c.col_ptrs[cur_col] == c.col_ptrs[cur_col + 1]))
-      {
-      // Update current column pointer to actual number of nonzero elements up
-      // to this point.
-      access::rw(c.col_ptrs[cur_col]) = cur_pos;
-      ++cur_col;
-      }
+    spglue_times_accumulator<eT> acc(x_n_rows);
     
-    if(cur_col == c.n_cols)  { break; }
+    bool local_has_zeros = false;
     
-    // Update current column pointer.
-    access::rw(c.col_ptrs[cur_col]) = cur_pos;
-    
-    // Check all elements in this column.
-    typename SpMat<eT>::const_iterator y_col_it = y.begin_col_no_sync(cur_col);
-    
-    while(y_col_it.col() == cur_col)
+    for(uword col=start; col < endp1; ++col)
       {
-      const uword y_col_it_row = y_col_it.row();
+      const uword c_start = c_col_ptrs[col];
+      const uword c_count = c_col_ptrs[col + 1] - c_start;
+      
+      if(c_count == 0)  { continue; }
       
-      // Check all elements in the column of the other matrix corresponding to
-      // the row of this column.
-      typename SpMat<eT>::const_iterator x_col_it = x.begin_col_no_sync(y_col_it_row);
+      acc.begin(c_count);
       
-      const eT y_value = (*y_col_it);
+      const uword y_endp1 = y_col_ptrs[col + 1];
       
-      while(x_col_it.col() == y_col_it_row)
+      for(uword i=y_col_ptrs[col]; i < y_endp1; ++i)
         {
-        const uword x_col_it_row = x_col_it.row();
+        const uword k     = y_row_indices[i];
+        const eT    y_val = y_values[i];
         
-        // A point at x(i, j) and y(j, k) implies a point at c(i, k).
-        // Add to partial sum.
-        const eT x_value = (*x_col_it);
-        sums[x_col_it_row] += (x_value * y_value);
+        const uword x_endp1 = x_col_ptrs[k + 1];
         
-        // Add point if it hasn't already been marked.
-        if(index[x_col_it_row] == x_n_rows)
-          {
-          index[x_col_it_row] = last_ind;
-          last_ind = x_col_it_row;
-          }
+        for(uword j=x_col_ptrs[k]; j < x_endp1; ++j)  { acc.add(x_row_indices[j], x_values[j] * y_val); }
+        }
+      
+      uword* col_rows = &(c_row_indices[c_start]);
+      eT*    col_vals = &(c_values[c_start]);
+      
+      if(has_structure == false)
+        {
+        arrayops::copy(col_rows, acc.get_rows(), c_count);
         
-        ++x_col_it;
+        op_sort::direct_sort_ascending(col_rows, c_count);
         }
       
-      ++y_col_it;
+      for(uword i=0; i < c_count; ++i)
+        {
+        const eT val = acc.get(col_rows[i]);
+        
+        col_vals[i] = val;
+        
+        if(val == eT(0))  { local_has_zeros = true; }
+        }
       }
     
-    // Now sort the indices that were used in this column.
-    uword cur_index = 0;
-    while(last_ind != x_n_rows + 1)
+    if(local_has_zeros)  { has_zeros = true; }
+    };
+  
+  spglue_times::run_balanced(x, y, n_threads, worker);
+  
+  return bool(has_zeros);
+  }
+
+
+
+template<typename eT>
+inline
+int
+spglue_times::get_n_threads(const SpMat<eT>& x, const SpMat<eT>& y)
+  {
+  // each element of y requires a pass through one column of x
+  return ( (y.n_cols > 1) && mp_gate<eT>::eval_loop(x.n_nonzero + y.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
+  }
+
+
+
+//! split the columns of y into contiguous ranges with a similar number of multiply-adds, and call F(start, endp1) for each range
+template<typename eT, typename functor>
+inline
+void
+spglue_times::run_balanced(const SpMat<eT>& x, const SpMat<eT>& y, const int n_threads, const functor& F)
+  {
+  arma_debug_sigprint();
+  
+  const uword y_n_cols = y.n_cols;
+  
+  if( (n_threads <= 1) || (y_n_cols <= 1) )  { F(uword(0), y_n_cols); return; }
+  
+  const uword* x_col_ptrs    = x.col_ptrs;
+  const uword* y_col_ptrs    = y.col_ptrs;
+  const uword* y_row_indices = y.row_indices;
+  
+  // cumulative number of multiply-adds up to each column
+  podarray<uword> flops(y_n_cols + 1);
+  
+  uword* flops_mem = flops.memptr();
+  
+  flops_mem[0] = 0;
+  
+  const auto flops_worker = [&](const uword start, const uword endp1)
+    {
+    for(uword col=start; col < endp1; ++col)
       {
-      const uword tmp = last_ind;
+      const uword y_endp1 = y_col_ptrs[col + 1];
+      
+      uword n_flops = 0;
       
-      // Check that it wasn't a "fake" nonzero element.
-      if(sums[tmp] != eT(0))
+      for(uword i=y_col_ptrs[col]; i < y_endp1; ++i)
         {
-        // Assign to next open position.
-        sorted_indices[cur_index] = tmp;
-        ++cur_index;
+        const uword k = y_row_indices[i];
+        
+        n_flops += x_col_ptrs[k + 1] - x_col_ptrs[k];
         }
-
-      last_ind = index[tmp];
-      index[tmp] = x_n_rows;
+      
+      // add one to account for the overhead of each column
+      flops_mem[col + 1] = n_flops + 1;
       }
+    };
+  
+  mp_loop::run_chunked(y_n_cols, n_threads, flops_worker);
+  
+  for(uword col=0; col < y_n_cols; ++col)  { flops_mem[col + 1] += flops_mem[col]; }
+  
+  // the executor balances the load dynamically, so it benefits from more tasks
+  const uword n_tasks_wanted = uword(n_threads) * ( (mp_executor::is_active()) ? uword(4) : uword(1) );
+  
+  const uword n_tasks = (std::min)(n_tasks_wanted, y_n_cols);
+  
+  const double total_flops = double(flops_mem[y_n_cols]);
+  
+  podarray<uword> bounds(n_tasks + 1);
+  
+  bounds[0]       = 0;
+  bounds[n_tasks] = y_n_cols;
+  
+  for(uword t=1; t < n_tasks; ++t)
+    {
+    const uword target = uword( (total_flops * double(t)) / double(n_tasks) );
     
-    // Now sort the indices.
-    if(cur_index != 0)
-      {
-      op_sort::direct_sort_ascending(sorted_indices.memptr(), cur_index);
+    bounds[t] = uword( std::lower_bound(flops_mem, flops_mem + y_n_cols + 1, target) - flops_mem );
+    
+    bounds[t] = (std::min)( (std::max)(bounds[t], bounds[t-1]), y_n_cols );
+    }
+  
+  const auto task_worker = [&](const uword t)
+    {
+    if(bounds[t] < bounds[t+1])  { F(bounds[t], bounds[t+1]); }
+    };
+  
+  mp_loop::run(n_tasks, n_threads, task_worker);
+  }
 
-      for(uword k = 0; k < cur_index; ++k)
-        {
-        const uword row = sorted_indices[k];
-        access::rw(c.row_indices[cur_pos]) = row;
-        access::rw(c.values[cur_pos]) = sums[row];
-        sums[row] = eT(0);
-        ++cur_pos;
-        }
-      }
 
-    // Move to next column.
-    ++cur_col;
-    }
+
+// 
+// 
+// 
+
+
+
+template<typename eT>
+inline
+spglue_times_accumulator<eT>::spglue_times_accumulator(const uword in_n_rows)
+  : n_rows(in_n_rows)
+  {
+  arma_debug_sigprint();
+  }
+
+
+
+//! prepare for a new column with at most max_n_entries distinct rows
+template<typename eT>
+inline
+void
+spglue_times_accumulator<eT>::begin(const uword max_n_entries)
+  {
+  n_entries = 0;
   
-  // Update last column pointer and resize to actual memory size.
+  rows.set_min_size(max_n_entries);
   
-  // access::rw(c.col_ptrs[c.n_cols]) = cur_pos;
-  // c.mem_resize(cur_pos);
+  use_hash = (max_n_entries < (n_rows / uword(16)));
   
-  access::rw(c.col_ptrs[c.n_cols]) = cur_pos;
+  if(use_hash)
+    {
+    // table is at most half full
+    uword n_slots = 16;
+    uword n_bits  = 4;
+    
+    while(n_slots < (uword(2) * max_n_entries))  { n_slots *= 2; ++n_bits; }
+    
+    hash_keys.set_min_size(n_slots);
+    hash_vals.set_min_size(n_slots);
+    
+    arrayops::inplace_set(hash_keys.memptr(), n_rows, n_slots);
+    
+    hash_mask  = n_slots - 1;
+    hash_shift = uword(64) - n_bits;
+    }
+  else
+    {
+    if(dense_mark.n_elem == 0)
+      {
+      dense_mark.zeros(n_rows);
+      dense_vals.set_size(n_rows);
+      }
+    
+    ++dense_stamp;
+    }
+  }
+
+
+
+template<typename eT>
+arma_inline
+uword
+spglue_times_accumulator<eT>::hash_locate(const uword row) const
+  {
+  uword i = uword( (u64(row) * u64(0x9E3779B97F4A7C15ULL)) >> hash_shift );
+  
+  while( (hash_keys[i] != row) && (hash_keys[i] != n_rows) )  { i = (i + 1) & hash_mask; }
+  
+  return i;
+  }
+
+
+
+template<typename eT>
+arma_inline
+void
+spglue_times_accumulator<eT>::insert(const uword row)
+  {
+  if(use_hash)
+    {
+    const uword i = hash_locate(row);
+    
+    if(hash_keys[i] != row)  { hash_keys[i] = row; rows[n_entries] = row; ++n_entries; }
+    }
+  else
+    {
+    if(dense_mark[row] != dense_stamp)  { dense_mark[row] = dense_stamp; rows[n_entries] = row; ++n_entries; }
+    }
+  }
+
+
+
+template<typename eT>
+arma_inline
+void
+spglue_times_accumulator<eT>::add(const uword row, const eT val)
+  {
+  if(use_hash)
+    {
+    const uword i = hash_locate(row);
+    
+    if(hash_keys[i] != row)  { hash_keys[i] = row; hash_vals[i] = val; rows[n_entries] = row; ++n_entries; }
+    else                     { hash_vals[i] += val; }
+    }
+  else
+    {
+    if(dense_mark[row] != dense_stamp)  { dense_mark[row] = dense_stamp; dense_vals[row] = val; rows[n_entries] = row; ++n_entries; }
+    else                                { dense_vals[row] += val; }
+    }
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+spglue_times_accumulator<eT>::get(const uword row) const
+  {
+  if(use_hash)
+    {
+    const uword i = hash_locate(row);
+    
+    return (hash_keys[i] == row) ? hash_vals[i] : eT(0);
+    }
   
-  if(cur_pos < max_n_nonzero)  { c.mem_resize(cur_pos); }
+  return (dense_mark[row] == dense_stamp) ? dense_vals[row] : eT(0);
   }
 
 
 
-//
-//
-//
+template<typename eT>
+arma_inline
+uword
+spglue_times_accumulator<eT>::get_n_entries() const
+  {
+  return n_entries;
+  }
+
+
+
+template<typename eT>
+arma_inline
+const uword*
+spglue_times_accumulator<eT>::get_rows() const
+  {
+  return rows.memptr();
+  }
+
+
+
+// 
+// 
+// 
 
 
 
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup spmul_plan
+//! @{
+
+
+
+//! sparse matrix multiplication which reuses the structure of the result
+//! when the operands have the same structure as in the previous multiplication
+class spmul_plan
+  {
+  private:
+  
+  uword A_n_rows = 0;
+  uword A_n_cols = 0;
+  uword B_n_cols = 0;
+  
+  bool has_plan  = false;
+  bool is_reused = false;
+  
+  uvec A_col_ptrs;
+  uvec A_row_indices;
+  uvec B_col_ptrs;
+  uvec B_row_indices;
+  
+  uvec C_col_ptrs;     // structure of the result, including elements which may evaluate to zero
+  uvec C_row_indices;
+  
+  template<typename eT> inline bool same_structure(const SpMat<eT>& A, const SpMat<eT>& B) const;
+  
+  template<typename eT> inline void store_structure(const SpMat<eT>& A, const SpMat<eT>& B, const SpMat<eT>& C);
+  
+  
+  public:
+  
+  inline spmul_plan();
+  
+  inline void reset();
+  
+  inline bool reused() const;
+  
+  template<typename T1, typename T2> inline void mul(SpMat<typename T1::elem_type>& C, const SpBase<typename T1::elem_type,T1>& A_expr, const SpBase<typename T1::elem_type,T2>& B_expr);
+  
+  inline      spmul_plan(const spmul_plan&) = delete;
+  inline void operator= (const spmul_plan&) = delete;
+  };
+
+
+
+//! @}
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+//! \addtogroup spmul_plan
+//! @{
+
+
+
+inline
+spmul_plan::spmul_plan()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+inline
+void
+spmul_plan::reset()
+  {
+  arma_debug_sigprint();
+  
+  A_n_rows = 0;
+  A_n_cols = 0;
+  B_n_cols = 0;
+  
+  has_plan  = false;
+  is_reused = false;
+  
+  A_col_ptrs.reset();
+  A_row_indices.reset();
+  B_col_ptrs.reset();
+  B_row_indices.reset();
+  
+  C_col_ptrs.reset();
+  C_row_indices.reset();
+  }
+
+
+
+//! true if the last call to mul() skipped the symbolic phase
+inline
+bool
+spmul_plan::reused() const
+  {
+  return is_reused;
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+void
+spmul_plan::mul(SpMat<typename T1::elem_type>& C, const SpBase<typename T1::elem_type,T1>& A_expr, const SpBase<typename T1::elem_type,T2>& B_expr)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_spmat<T1> UA(A_expr.get_ref());
+  const unwrap_spmat<T2> UB(B_expr.get_ref());
+  
+  const SpMat<eT>& A = UA.M;
+  const SpMat<eT>& B = UB.M;
+  
+  arma_conform_assert_mul_size(A.n_rows, A.n_cols, B.n_rows, B.n_cols, "spmul_plan::mul()");
+  
+  const bool is_alias = (UA.is_alias(C) || UB.is_alias(C));
+  
+  SpMat<eT>  tmp;
+  SpMat<eT>& out = (is_alias) ? tmp : C;
+  
+  is_reused = same_structure(A, B);
+  
+  out.zeros(A.n_rows, B.n_cols);
+  
+  const int n_threads = spglue_times::get_n_threads(A, B);
+  
+  bool has_zeros = false;
+  
+  if(is_reused)
+    {
+    out.mem_resize(C_row_indices.n_elem);
+    
+    arrayops::copy(access::rwp(out.col_ptrs),    C_col_ptrs.memptr(),    C_col_ptrs.n_elem   );
+    arrayops::copy(access::rwp(out.row_indices), C_row_indices.memptr(), C_row_indices.n_elem);
+    
+    has_zeros = spglue_times::apply_numeric(out, A, B, true, n_threads);
+    }
+  else
+    {
+    if( (A.n_nonzero > 0) && (B.n_nonzero > 0) )
+      {
+      spglue_times::apply_symbolic(out, A, B, n_threads);
+      
+      has_zeros = spglue_times::apply_numeric(out, A, B, false, n_threads);
+      }
+    
+    store_structure(A, B, out);
+    }
+  
+  if(has_zeros)  { out.remove_zeros(); }
+  
+  if(is_alias)  { C.steal_mem(tmp); }
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spmul_plan::same_structure(const SpMat<eT>& A, const SpMat<eT>& B) const
+  {
+  arma_debug_sigprint();
+  
+  if(has_plan == false)  { return false; }
+  
+  if( (A.n_rows != A_n_rows) || (A.n_cols != A_n_cols) || (B.n_cols != B_n_cols) )  { return false; }
+  
+  if( (A.n_nonzero != A_row_indices.n_elem) || (B.n_nonzero != B_row_indices.n_elem) )  { return false; }
+  
+  const bool same_A = (std::memcmp(A.col_ptrs,    A_col_ptrs.memptr(),    (A.n_cols+1) * sizeof(uword)) == 0) && (std::memcmp(A.row_indices, A_row_indices.memptr(), A.n_nonzero * sizeof(uword)) == 0);
+  const bool same_B = (std::memcmp(B.col_ptrs,    B_col_ptrs.memptr(),    (B.n_cols+1) * sizeof(uword)) == 0) && (std::memcmp(B.row_indices, B_row_indices.memptr(), B.n_nonzero * sizeof(uword)) == 0);
+  
+  return (same_A && same_B);
+  }
+
+
+
+template<typename eT>
+inline
+void
+spmul_plan::store_structure(const SpMat<eT>& A, const SpMat<eT>& B, const SpMat<eT>& C)
+  {
+  arma_debug_sigprint();
+  
+  A_n_rows = A.n_rows;
+  A_n_cols = A.n_cols;
+  B_n_cols = B.n_cols;
+  
+  A_col_ptrs    = uvec(A.col_ptrs,    A.n_cols + 1);
+  A_row_indices = uvec(A.row_indices, A.n_nonzero );
+  B_col_ptrs    = uvec(B.col_ptrs,    B.n_cols + 1);
+  B_row_indices = uvec(B.row_indices, B.n_nonzero );
+  C_col_ptrs    = uvec(C.col_ptrs,    C.n_cols + 1);
+  C_row_indices = uvec(C.row_indices, C.n_nonzero );
+  
+  has_plan = true;
+  }
+
+
+
+//! @}
@@ -75,53 +75,51 @@ spop_normalise::apply_direct(SpMat<eT>& out, const SpMat<eT>& X, const uword p)
   
   SpMat<eT> tmp(arma_reserve_indicator(), X.n_rows, X.n_cols, X.n_nonzero);
   
-  bool has_zero = false;
+  // the result has the same structure as X, so each column can be normalised independently
+  arrayops::copy(access::rwp(tmp.col_ptrs),    X.col_ptrs,    X.n_cols + 1);
+  arrayops::copy(access::rwp(tmp.row_indices), X.row_indices, X.n_nonzero );
   
-  podarray<T> norm_vals(X.n_cols);
+  eT* tmp_values = access::rwp(tmp.values);
   
-  T* norm_vals_mem = norm_vals.memptr();
+  std::atomic<bool> has_zero(false);
   
-  for(uword col=0; col < X.n_cols; ++col)
+  const auto worker = [&](const uword start, const uword endp1)
     {
-    const uword      col_offset = X.col_ptrs[col    ];
-    const uword next_col_offset = X.col_ptrs[col + 1];
+    bool local_has_zero = false;
     
-    const eT* start_ptr = &X.values[     col_offset];
-    const eT*   end_ptr = &X.values[next_col_offset];
+    for(uword col=start; col < endp1; ++col)
+      {
+      const uword      col_offset = X.col_ptrs[col    ];
+      const uword next_col_offset = X.col_ptrs[col + 1];
+      
+      const eT* start_ptr = &X.values[     col_offset];
+      const eT*   end_ptr = &X.values[next_col_offset];
+      
+      const uword n_elem = end_ptr - start_ptr;
+      
+      const Col<eT> fake_vec(const_cast<eT*>(start_ptr), n_elem, false, false);
+      
+      const T norm_val = norm(fake_vec, p);
+      
+      const T norm_div = (norm_val != T(0)) ? norm_val : T(1);
+      
+      for(uword i=col_offset; i < next_col_offset; ++i)
+        {
+        const eT val = X.values[i] / norm_div;
+        
+        if(val == eT(0))  { local_has_zero = true; }
+        
+        tmp_values[i] = val;
+        }
+      }
     
-    const uword n_elem = end_ptr - start_ptr;
-    
-    const Col<eT> fake_vec(const_cast<eT*>(start_ptr), n_elem, false, false);
-    
-    const T norm_val = norm(fake_vec, p);
-    
-    norm_vals_mem[col] = (norm_val != T(0)) ? norm_val : T(1);
-    }
+    if(local_has_zero)  { has_zero = true; }
+    };
   
-  const uword N = X.n_nonzero;
-  
-  typename SpMat<eT>::const_iterator it = X.begin();
-  
-  for(uword i=0; i < N; ++i)
-    {
-    const uword row = it.row();
-    const uword col = it.col();
-    
-    const eT val = (*it) / norm_vals_mem[col];
-    
-    if(val == eT(0))  { has_zero = true; }
-    
-    access::rw(tmp.values[i])      = val;
-    access::rw(tmp.row_indices[i]) = row;
-    access::rw(tmp.col_ptrs[col + 1])++;
-    
-    ++it;
-    }
+  const int n_threads = ( (X.n_cols > 1) && mp_gate<eT>::eval_loop(X.n_nonzero) ) ? mp_thread_limit::get_loop() : int(1);
   
-  for(uword c=0; c < tmp.n_cols; ++c)
-    {
-    access::rw(tmp.col_ptrs[c + 1]) += tmp.col_ptrs[c];
-    }
+  if(n_threads > 1)  { mp_loop::run_weighted(X.n_cols, X.col_ptrs, n_threads, worker); }
+  else               { worker(uword(0), X.n_cols); }
   
   if(has_zero)  { tmp.remove_zeros(); }
   
@@ -32,6 +32,25 @@ spop_strans::apply_noalias(SpMat<eT>& B, const SpMat<eT>& A)
   
   if(A.n_nonzero == 0)  { return; }
   
+  const typename SpMat<eT>::trans_index_type* ti = A.get_trans_index();
+  
+  if(ti != nullptr)
+    {
+    arma_debug_print("spop_strans::apply_noalias(): using transposed index");
+    
+    arrayops::copy(access::rwp(B.col_ptrs),    ti->row_ptrs.memptr(),    A.n_rows + 1);
+    arrayops::copy(access::rwp(B.row_indices), ti->col_indices.memptr(), A.n_nonzero );
+    
+    const eT*    A_values = A.values;
+    const uword* csc_pos  = ti->csc_pos.memptr();
+    
+    eT* B_values = access::rwp(B.values);
+    
+    for(uword i=0; i < A.n_nonzero; ++i)  { B_values[i] = A_values[csc_pos[i]]; }
+    
+    return;
+    }
+  
   // This follows the TRANSP algorithm described in
   // 'Sparse Matrix Multiplication Package (SMMP)'
   // (R.E. Bank and C.C. Douglas, 2001)
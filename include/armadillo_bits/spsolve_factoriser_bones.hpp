@@ -27,6 +27,7 @@ class spsolve_factoriser
   
   void_ptr worker_ptr          = nullptr;
   uword    elem_type_indicator = 0;
+  uword    solver_indicator    = 0;  // 1: SuperLU, 2: built-in sparse Cholesky / LDL
   uword    n_rows              = 0;
   double   rcond_value         = double(0);
   
@@ -34,6 +35,8 @@ class spsolve_factoriser
   
   inline void cleanup();
   
+  template<typename eT, typename worker_type, typename opts_type> inline bool factorise_worker(const SpMat<eT>& A, const opts_type& opts);
+  
   
   public:
   
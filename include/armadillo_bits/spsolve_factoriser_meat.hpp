@@ -46,17 +46,29 @@ spsolve_factoriser::cleanup()
   {
   arma_debug_sigprint();
   
+  if(solver_indicator == 2)
+    {
+         if(elem_type_indicator == 1)  { delete_worker< spchol_worker<    float> >(); }
+    else if(elem_type_indicator == 2)  { delete_worker< spchol_worker<   double> >(); }
+    else if(elem_type_indicator == 3)  { delete_worker< spchol_worker< cx_float> >(); }
+    else if(elem_type_indicator == 4)  { delete_worker< spchol_worker<cx_double> >(); }
+    }
+  
   #if defined(ARMA_USE_SUPERLU)
     {
-         if(elem_type_indicator == 1)  { delete_worker< superlu_worker<    float> >(); }
-    else if(elem_type_indicator == 2)  { delete_worker< superlu_worker<   double> >(); }
-    else if(elem_type_indicator == 3)  { delete_worker< superlu_worker< cx_float> >(); }
-    else if(elem_type_indicator == 4)  { delete_worker< superlu_worker<cx_double> >(); }
+    if(solver_indicator == 1)
+      {
+           if(elem_type_indicator == 1)  { delete_worker< superlu_worker<    float> >(); }
+      else if(elem_type_indicator == 2)  { delete_worker< superlu_worker<   double> >(); }
+      else if(elem_type_indicator == 3)  { delete_worker< superlu_worker< cx_float> >(); }
+      else if(elem_type_indicator == 4)  { delete_worker< superlu_worker<cx_double> >(); }
+      }
     }
   #endif
   
   worker_ptr          = nullptr;
   elem_type_indicator = 0;
+  solver_indicator    = 0;
   n_rows              = 0;
   rcond_value         = double(0);
   }
@@ -103,6 +115,67 @@ spsolve_factoriser::rcond() const
 
 
 
+template<typename eT, typename worker_type, typename opts_type>
+inline
+bool
+spsolve_factoriser::factorise_worker(const SpMat<eT>& A, const opts_type& opts)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  if(A.is_square() == false)
+    {
+    arma_warn(1, "spsolve_factoriser::factorise(): solving under-determined / over-determined systems is currently not supported");
+    return false;
+    }
+  
+  n_rows = A.n_rows;
+  
+  //
+  
+  worker_ptr = new(std::nothrow) worker_type;
+  
+  if(worker_ptr == nullptr)
+    {
+    arma_warn(3, "spsolve_factoriser::factorise(): could not construct worker object");
+    return false;
+    }
+  
+  //
+  
+       if(    is_float<eT>::value)  { elem_type_indicator = 1; }
+  else if(   is_double<eT>::value)  { elem_type_indicator = 2; }
+  else if( is_cx_float<eT>::value)  { elem_type_indicator = 3; }
+  else if(is_cx_double<eT>::value)  { elem_type_indicator = 4; }
+  
+  solver_indicator = (is_same_type< worker_type, spchol_worker<eT> >::yes) ? uword(2) : uword(1);
+  
+  //
+  
+  worker_type* local_worker_ptr = reinterpret_cast<worker_type*>(worker_ptr);
+  worker_type& local_worker_ref = (*local_worker_ptr);
+  
+  //
+  
+  T local_rcond_value = T(0);
+  
+  const bool status = local_worker_ref.factorise(local_rcond_value, A, opts);
+  
+  rcond_value = double(local_rcond_value);
+  
+  if( (status == false) || arma_isnan(local_rcond_value) || ((opts.allow_ugly == false) && (local_rcond_value < std::numeric_limits<T>::epsilon())) )
+    {
+    arma_warn(3, "spsolve_factoriser::factorise(): factorisation failed; rcond: ", local_rcond_value);
+    delete_worker<worker_type>();
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
 template<typename T1>
 inline
 bool
@@ -116,31 +189,34 @@ spsolve_factoriser::factorise
   arma_debug_sigprint();
   arma_ignore(junk);
   
-  #if defined(ARMA_USE_SUPERLU)
+  typedef typename T1::elem_type eT;
+  
+  cleanup();
+  
+  if(settings.id == 2)
     {
-    typedef typename T1::elem_type            eT;
-    typedef typename get_pod_type<eT>::result  T;
-    
-    typedef superlu_worker<eT> worker_type;
-    
-    //
-    
-    cleanup();
-    
-    //
-    
     const unwrap_spmat<T1> U(A_expr.get_ref());
     const SpMat<eT>& A =   U.M;
     
-    if(A.is_square() == false)
+    if((arma_config::check_conform) && (A.is_square()) && (sp_auxlib::rudimentary_sym_check(A) == false))
       {
-      arma_warn(1, "spsolve_factoriser::factorise(): solving under-determined / over-determined systems is currently not supported");
-      return false;
+      if(is_cx<eT>::no )  { arma_warn(1, "spsolve_factoriser::factorise(): given matrix is not symmetric"); }
+      if(is_cx<eT>::yes)  { arma_warn(1, "spsolve_factoriser::factorise(): given matrix is not hermitian"); }
       }
     
-    n_rows = A.n_rows;
+    if(arma_config::check_nonfinite && A.internal_has_nonfinite())
+      {
+      arma_warn(3, "spsolve_factoriser::factorise(): detected non-finite elements");
+      return false;
+      }
     
-    //
+    return factorise_worker< eT, spchol_worker<eT> >(A, static_cast<const spchol_opts&>(settings));
+    }
+  
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    const unwrap_spmat<T1> U(A_expr.get_ref());
+    const SpMat<eT>& A =   U.M;
     
     superlu_opts superlu_opts_default;
     
@@ -152,50 +228,12 @@ spsolve_factoriser::factorise
       return false;
       }
     
-    //
-    
-    worker_ptr = new(std::nothrow) worker_type;
-    
-    if(worker_ptr == nullptr)
-      {
-      arma_warn(3, "spsolve_factoriser::factorise(): could not construct worker object");
-      return false;
-      }
-    
-    //
-    
-         if(    is_float<eT>::value)  { elem_type_indicator = 1; }
-    else if(   is_double<eT>::value)  { elem_type_indicator = 2; }
-    else if( is_cx_float<eT>::value)  { elem_type_indicator = 3; }
-    else if(is_cx_double<eT>::value)  { elem_type_indicator = 4; }
-    
-    //
-    
-    worker_type* local_worker_ptr = reinterpret_cast<worker_type*>(worker_ptr);
-    worker_type& local_worker_ref = (*local_worker_ptr);
-    
-    //
-    
-    T local_rcond_value = T(0);
-    
-    const bool status = local_worker_ref.factorise(local_rcond_value, A, opts);
-    
-    rcond_value = double(local_rcond_value);
-    
-    if( (status == false) || arma_isnan(local_rcond_value) || ((opts.allow_ugly == false) && (local_rcond_value < std::numeric_limits<T>::epsilon())) )
-      {
-      arma_warn(3, "spsolve_factoriser::factorise(): factorisation failed; rcond: ", local_rcond_value);
-      delete_worker<worker_type>();
-      return false;
-      }
-    
-    return true;
+    return factorise_worker< eT, superlu_worker<eT> >(A, opts);
     }
   #else
     {
     arma_ignore(A_expr);
-    arma_ignore(settings);
-    arma_stop_logic_error("spsolve_factoriser::factorise(): use of SuperLU must be enabled");
+    arma_stop_logic_error("spsolve_factoriser::factorise(): use of SuperLU must be enabled, or spchol_opts must be given");
     return false;
     }
   #endif
@@ -216,72 +254,74 @@ spsolve_factoriser::solve
   arma_debug_sigprint();
   arma_ignore(junk);
   
-  #if defined(ARMA_USE_SUPERLU)
+  typedef typename T1::elem_type eT;
+  
+  if(worker_ptr == nullptr)
     {
-    typedef typename T1::elem_type eT;
-    
-    typedef superlu_worker<eT> worker_type;
-    
-    if(worker_ptr == nullptr)
-      {
-      arma_warn(2, "spsolve_factoriser::solve(): no factorisation available");
-      X.soft_reset();
-      return false;
-      }
-    
-    bool type_mismatch = false;
-    
-         if(    (is_float<eT>::value) && (elem_type_indicator != 1) )  { type_mismatch = true; }
-    else if(   (is_double<eT>::value) && (elem_type_indicator != 2) )  { type_mismatch = true; }
-    else if( (is_cx_float<eT>::value) && (elem_type_indicator != 3) )  { type_mismatch = true; }
-    else if((is_cx_double<eT>::value) && (elem_type_indicator != 4) )  { type_mismatch = true; }
-    
-    if(type_mismatch)
-      {
-      arma_warn(1, "spsolve_factoriser::solve(): matrix type mismatch");
-      X.soft_reset();
-      return false;
-      }
-    
-    const quasi_unwrap<T1> U(B_expr.get_ref());
-    const Mat<eT>& B     = U.M;
-    
-    if(n_rows != B.n_rows)
-      {
-      arma_warn(1, "spsolve_factoriser::solve(): matrix size mismatch");
-      X.soft_reset();
-      return false;
-      }
-
-    const bool is_alias = U.is_alias(X);
-    
-    Mat<eT>  tmp;
-    Mat<eT>& out = is_alias ? tmp : X;
-    
-    worker_type* local_worker_ptr = reinterpret_cast<worker_type*>(worker_ptr);
-    worker_type& local_worker_ref = (*local_worker_ptr);
-    
-    const bool status = local_worker_ref.solve(out,B);
-    
-    if(is_alias)  { X.steal_mem(tmp); }
+    arma_warn(2, "spsolve_factoriser::solve(): no factorisation available");
+    X.soft_reset();
+    return false;
+    }
+  
+  bool type_mismatch = false;
+  
+       if(    (is_float<eT>::value) && (elem_type_indicator != 1) )  { type_mismatch = true; }
+  else if(   (is_double<eT>::value) && (elem_type_indicator != 2) )  { type_mismatch = true; }
+  else if( (is_cx_float<eT>::value) && (elem_type_indicator != 3) )  { type_mismatch = true; }
+  else if((is_cx_double<eT>::value) && (elem_type_indicator != 4) )  { type_mismatch = true; }
+  
+  if(type_mismatch)
+    {
+    arma_warn(1, "spsolve_factoriser::solve(): matrix type mismatch");
+    X.soft_reset();
+    return false;
+    }
+  
+  const quasi_unwrap<T1> U(B_expr.get_ref());
+  const Mat<eT>& B     = U.M;
+  
+  if(n_rows != B.n_rows)
+    {
+    arma_warn(1, "spsolve_factoriser::solve(): matrix size mismatch");
+    X.soft_reset();
+    return false;
+    }
+  
+  const bool is_alias = U.is_alias(X);
+  
+  Mat<eT>  tmp;
+  Mat<eT>& out = is_alias ? tmp : X;
+  
+  bool status = false;
+  
+  if(solver_indicator == 2)
+    {
+    const spchol_worker<eT>* local_worker_ptr = reinterpret_cast< const spchol_worker<eT>* >(worker_ptr);
     
-    if(status == false)
+    status = local_worker_ptr->solve(out,B);
+    }
+  
+  #if defined(ARMA_USE_SUPERLU)
+    {
+    if(solver_indicator == 1)
       {
-      arma_warn(3, "spsolve_factoriser::solve(): solution not found");
-      X.soft_reset();
-      return false;
+      superlu_worker<eT>* local_worker_ptr = reinterpret_cast< superlu_worker<eT>* >(worker_ptr);
+      
+      status = local_worker_ptr->solve(out,B);
       }
-    
-    return true;
     }
-  #else
+  #endif
+  
+  if(is_alias)  { X.steal_mem(tmp); }
+  
+  if(status == false)
     {
-    arma_ignore(X);
-    arma_ignore(B_expr);
-    arma_stop_logic_error("spsolve_factoriser::solve(): use of SuperLU must be enabled");
+    arma_warn(3, "spsolve_factoriser::solve(): solution not found");
+    X.soft_reset();
     return false;
     }
-  #endif
+  
+  return true;
   }
 
 
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup spsolve_iterative
+//! @{
+
+
+
+//! preconditioner and work vectors for spsolve_iterative(), which are kept between calls to avoid reallocation
+template<typename eT>
+class spsolve_iter_workspace
+  {
+  public:
+  
+  spsolve_iter_info info;  //!< details of the last solve
+  
+  inline ~spsolve_iter_workspace();
+  inline  spsolve_iter_workspace();
+  
+  inline void reset();
+  
+  
+  private:
+  
+  uword           pc_type = 0;  // 0: none, 1: Jacobi, 2: ILU(0), 3: IC(0)
+  uword           pc_n    = 0;
+  Col<eT>         pc_diag;      // inverse of the diagonal for Jacobi
+  SpMat<eT>       pc_F;         // ILU(0) / IC(0) factors; column i holds row i of the factors
+  podarray<uword> pc_diag_pos;  // position of the diagonal element in each column of pc_F
+  
+  Col<eT> r, z, p, q, s, t, u, v, w;
+  
+  Mat<eT> V;  // Krylov basis for GMRES
+  Mat<eT> H;  // Hessenberg matrix for GMRES
+  Col<eT> g;
+  Col<eT> y;
+  Col<eT> sn;
+  
+  inline void init(const uword n);
+  
+  friend class spsolve_iter;
+  };
+
+
+
+class spsolve_iter
+  {
+  public:
+  
+  template<typename eT>
+  inline static bool apply(Mat<eT>& X, spsolve_iter_workspace<eT>& ws, const SpMat<eT>& A, const Mat<eT>& B, const char* method, const spsolve_iter_opts& opts);
+  
+  
+  private:
+  
+  template<typename eT>
+  inline static bool build_precond(spsolve_iter_workspace<eT>& ws, const SpMat<eT>& A, const uword type);
+  
+  template<typename eT>
+  inline static void apply_precond(Col<eT>& out, const Col<eT>& in, const spsolve_iter_workspace<eT>& ws);
+  
+  template<typename eT>
+  inline static bool cg(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter);
+  
+  template<typename eT>
+  inline static bool minres(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter);
+  
+  template<typename eT>
+  inline static bool bicgstab(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter);
+  
+  template<typename eT>
+  inline static bool gmres(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter, const uword restart);
+  };
+
+
+
+//! @}
@@ -0,0 +1,838 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2008-2016 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2008-2016 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+//! \addtogroup spsolve_iterative
+//! @{
+
+
+
+template<typename eT>
+inline
+spsolve_iter_workspace<eT>::~spsolve_iter_workspace()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+spsolve_iter_workspace<eT>::spsolve_iter_workspace()
+  {
+  arma_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+void
+spsolve_iter_workspace<eT>::reset()
+  {
+  arma_debug_sigprint();
+  
+  info = spsolve_iter_info();
+  
+  pc_type = 0;
+  pc_n    = 0;
+  
+  pc_diag.reset();
+  pc_F.reset();
+  pc_diag_pos.reset();
+  
+  r.reset();  z.reset();  p.reset();
+  q.reset();  s.reset();  t.reset();
+  u.reset();  v.reset();  w.reset();
+  
+  V.reset();
+  H.reset();
+  g.reset();
+  y.reset();
+  sn.reset();
+  }
+
+
+
+template<typename eT>
+inline
+void
+spsolve_iter_workspace<eT>::init(const uword n)
+  {
+  arma_debug_sigprint();
+  
+  // set_size() keeps the existing memory if the size is unchanged
+  
+  r.set_size(n);  z.set_size(n);  p.set_size(n);
+  q.set_size(n);  s.set_size(n);  t.set_size(n);
+  u.set_size(n);  v.set_size(n);  w.set_size(n);
+  }
+
+
+
+// 
+
+
+
+template<typename eT>
+inline
+bool
+spsolve_iter::build_precond(spsolve_iter_workspace<eT>& ws, const SpMat<eT>& A, const uword type)
+  {
+  arma_debug_sigprint();
+  
+  const uword n = A.n_rows;
+  
+  ws.pc_type = 0;
+  ws.pc_n    = 0;
+  
+  if(type == 0)  { return true; }
+  
+  if(type == 1)
+    {
+    ws.pc_diag = A.diag();
+    
+    eT* mem = ws.pc_diag.memptr();
+    
+    for(uword i=0; i < n; ++i)
+      {
+      if(mem[i] == eT(0))  { return false; }
+      
+      mem[i] = eT(1) / mem[i];
+      }
+    }
+  else
+    {
+    // the columns of pc_F hold the rows of A (ILU(0)), or the rows of the lower triangle of A (IC(0))
+    
+    if(type == 2)  { ws.pc_F = strans(A);          }
+    if(type == 3)  { ws.pc_F = trimatu(strans(A)); }
+    
+    const SpMat<eT>& F = ws.pc_F;
+    
+    const uword* F_col_ptrs    = F.col_ptrs;
+    const uword* F_row_indices = F.row_indices;
+          eT*    F_values      = access::rwp(F.values);
+    
+    ws.pc_diag_pos.set_size(n);
+    
+    uword* diag_pos = ws.pc_diag_pos.memptr();
+    
+    for(uword i=0; i < n; ++i)
+      {
+      const uword* start = F_row_indices + F_col_ptrs[i  ];
+      const uword* endp1 = F_row_indices + F_col_ptrs[i+1];
+      
+      const uword* loc = std::lower_bound(start, endp1, i);
+      
+      if( (loc == endp1) || (*loc != i) )  { return false; }
+      
+      diag_pos[i] = uword(loc - F_row_indices);
+      }
+    
+    if(type == 2)
+      {
+      // ILU(0): Gaussian elimination restricted to the pattern of A, row by row
+      
+      podarray<uword> pos(n);
+      
+      pos.fill(F.n_nonzero);
+      
+      for(uword i=0; i < n; ++i)
+        {
+        const uword i_start = F_col_ptrs[i  ];
+        const uword i_endp1 = F_col_ptrs[i+1];
+        
+        for(uword k=i_start; k < i_endp1; ++k)  { pos[F_row_indices[k]] = k; }
+        
+        for(uword k=i_start; k < diag_pos[i]; ++k)
+          {
+          const uword j = F_row_indices[k];
+          
+          const eT L_ij = F_values[k] / F_values[diag_pos[j]];
+          
+          F_values[k] = L_ij;
+          
+          for(uword kk=diag_pos[j]+1; kk < F_col_ptrs[j+1]; ++kk)
+            {
+            const uword loc = pos[F_row_indices[kk]];
+            
+            if(loc != F.n_nonzero)  { F_values[loc] -= L_ij * F_values[kk]; }
+            }
+          }
+        
+        for(uword k=i_start; k < i_endp1; ++k)  { pos[F_row_indices[k]] = F.n_nonzero; }
+        
+        const eT d = F_values[diag_pos[i]];
+        
+        if( (d == eT(0)) || arma_isnan(d) )  { return false; }
+        }
+      }
+    else
+      {
+      // IC(0): Cholesky factorisation restricted to the pattern of the lower triangle of A;
+      // L(i,j) = (A(i,j) - sum_{m<j} L(i,m) conj(L(j,m))) / L(j,j), where both rows are traversed in sorted order
+      
+      typedef typename get_pod_type<eT>::result T;
+      
+      for(uword i=0; i < n; ++i)
+        {
+        const uword i_start = F_col_ptrs[i];
+        
+        for(uword k=i_start; k <= diag_pos[i]; ++k)
+          {
+          const uword j = F_row_indices[k];
+          
+          eT acc = F_values[k];
+          
+          uword a     = i_start;
+          uword b     = F_col_ptrs[j];
+          uword b_end = diag_pos[j];
+          
+          while( (a < k) && (b < b_end) )
+            {
+            const uword ra = F_row_indices[a];
+            const uword rb = F_row_indices[b];
+            
+                 if(ra < rb)  { ++a; }
+            else if(rb < ra)  { ++b; }
+            else              { acc -= F_values[a] * access::alt_conj(F_values[b]); ++a; ++b; }
+            }
+          
+          if(j < i)
+            {
+            F_values[k] = acc / F_values[diag_pos[j]];
+            }
+          else
+            {
+            const T d = access::tmp_real(acc);
+            
+            if( (d <= T(0)) || arma_isnan(d) )  { return false; }
+            
+            F_values[k] = eT( std::sqrt(d) );
+            }
+          }
+        }
+      }
+    }
+  
+  ws.pc_type = type;
+  ws.pc_n    = n;
+  
+  return true;
+  }
+
+
+
+template<typename eT>
+inline
+void
+spsolve_iter::apply_precond(Col<eT>& out, const Col<eT>& in, const spsolve_iter_workspace<eT>& ws)
+  {
+  arma_debug_sigprint();
+  
+  const uword n = in.n_elem;
+  
+  if(ws.pc_type == 0)  { out = in; return; }
+  
+  if(ws.pc_type == 1)  { out = in % ws.pc_diag; return; }
+  
+  out = in;
+  
+  eT* out_mem = out.memptr();
+  
+  const SpMat<eT>& F = ws.pc_F;
+  
+  const uword* F_col_ptrs    = F.col_ptrs;
+  const uword* F_row_indices = F.row_indices;
+  const eT*    F_values      = F.values;
+  const uword* diag_pos      = ws.pc_diag_pos.memptr();
+  
+  if(ws.pc_type == 2)
+    {
+    // L has a unit diagonal; U includes the diagonal
+    
+    for(uword i=0; i < n; ++i)
+      {
+      eT acc = out_mem[i];
+      
+      for(uword k=F_col_ptrs[i]; k < diag_pos[i]; ++k)  { acc -= F_values[k] * out_mem[F_row_indices[k]]; }
+      
+      out_mem[i] = acc;
+      }
+    
+    for(uword ii=n; ii > 0; --ii)
+      {
+      const uword i = ii-1;
+      
+      eT acc = out_mem[i];
+      
+      for(uword k=diag_pos[i]+1; k < F_col_ptrs[i+1]; ++k)  { acc -= F_values[k] * out_mem[F_row_indices[k]]; }
+      
+      out_mem[i] = acc / F_values[diag_pos[i]];
+      }
+    }
+  else
+    {
+    // L y = in, followed by L^H out = y
+    
+    for(uword i=0; i < n; ++i)
+      {
+      eT acc = out_mem[i];
+      
+      for(uword k=F_col_ptrs[i]; k < diag_pos[i]; ++k)  { acc -= F_values[k] * out_mem[F_row_indices[k]]; }
+      
+      out_mem[i] = acc / F_values[diag_pos[i]];
+      }
+    
+    for(uword ii=n; ii > 0; --ii)
+      {
+      const uword i = ii-1;
+      
+      const eT val = out_mem[i] / F_values[diag_pos[i]];
+      
+      out_mem[i] = val;
+      
+      for(uword k=F_col_ptrs[i]; k < diag_pos[i]; ++k)  { out_mem[F_row_indices[k]] -= access::alt_conj(F_values[k]) * val; }
+      }
+    }
+  }
+
+
+
+//! preconditioned conjugate gradient, for hermitian positive definite matrices
+template<typename eT>
+inline
+bool
+spsolve_iter::cg(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  Col<eT>& r = ws.r;
+  Col<eT>& z = ws.z;
+  Col<eT>& p = ws.p;
+  Col<eT>& q = ws.q;
+  
+  const T b_norm = norm(b);
+  
+  q = A * x;
+  r = b - q;
+  
+  if(norm(r) <= tol * b_norm)  { return true; }
+  
+  apply_precond(z, r, ws);
+  
+  p = z;
+  
+  eT rz = cdot(r, z);
+  
+  while(n_iter < max_iter)
+    {
+    q = A * p;
+    
+    const eT pq = cdot(p, q);
+    
+    if(pq == eT(0))  { return false; }
+    
+    const eT alpha = rz / pq;
+    
+    x += alpha * p;
+    r -= alpha * q;
+    
+    ++n_iter;
+    
+    if(norm(r) <= tol * b_norm)  { return true; }
+    
+    apply_precond(z, r, ws);
+    
+    const eT rz_new = cdot(r, z);
+    
+    const eT beta = rz_new / rz;
+    
+    rz = rz_new;
+    
+    p = z + beta * p;
+    }
+  
+  return false;
+  }
+
+
+
+//! preconditioned MINRES, for hermitian matrices which may be indefinite; the preconditioner must be positive definite
+template<typename eT>
+inline
+bool
+spsolve_iter::minres(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  Col<eT>& r1 = ws.r;
+  Col<eT>& r2 = ws.s;
+  Col<eT>& y  = ws.z;
+  Col<eT>& v  = ws.p;
+  Col<eT>& w  = ws.w;
+  Col<eT>& w1 = ws.t;
+  Col<eT>& w2 = ws.u;
+  
+  // the recurrences give the residual in the norm induced by the inverse of the preconditioner
+  
+  apply_precond(y, b, ws);
+  
+  const T b_norm_M = std::sqrt( (std::max)( T(0), access::tmp_real(cdot(b, y)) ) );
+  
+  r1 = A * x;
+  r1 = b - r1;
+  
+  apply_precond(y, r1, ws);
+  
+  T beta1 = access::tmp_real(cdot(r1, y));
+  
+  if(beta1 < T(0))  { return false; }  // preconditioner is not positive definite
+  
+  beta1 = std::sqrt(beta1);
+  
+  if(beta1 <= tol * b_norm_M)  { return true; }
+  
+  T oldb   = T(0);
+  T beta   = beta1;
+  T dbar   = T(0);
+  T epsln  = T(0);
+  T phibar = beta1;
+  T cs     = T(-1);
+  T sn     = T(0);
+  
+  w.zeros();
+  w2.zeros();
+  
+  r2 = r1;
+  
+  while(n_iter < max_iter)
+    {
+    // Lanczos step
+    
+    v = y / beta;
+    
+    y = A * v;
+    
+    if(n_iter > 0)  { y -= (beta / oldb) * r1; }
+    
+    const T alfa = access::tmp_real(cdot(v, y));
+    
+    y -= (alfa / beta) * r2;
+    
+    r1.swap(r2);  // r1 = r2
+    r2.swap(y);   // r2 = y
+    
+    apply_precond(y, r2, ws);
+    
+    oldb = beta;
+    beta = access::tmp_real(cdot(r2, y));
+    
+    if(beta < T(0))  { return false; }
+    
+    beta = std::sqrt(beta);
+    
+    // apply the previous rotation, then form and apply a new one
+    
+    const T oldeps = epsln;
+    const T delta  = cs*dbar + sn*alfa;
+    const T gbar   = sn*dbar - cs*alfa;
+    
+    epsln = sn*beta;
+    dbar  = -cs*beta;
+    
+    const T gamma = (std::max)( std::sqrt(gbar*gbar + beta*beta), std::numeric_limits<T>::epsilon() );
+    
+    cs = gbar / gamma;
+    sn = beta / gamma;
+    
+    const T phi = cs * phibar;
+    
+    phibar = sn * phibar;
+    
+    // update the solution
+    
+    w1.swap(w2);  // w1 = w2
+    w2.swap(w);   // w2 = w
+    
+    w = (v - oldeps*w1 - delta*w2) / gamma;
+    
+    x += phi * w;
+    
+    ++n_iter;
+    
+    if(phibar <= tol * b_norm_M)  { return true; }
+    }
+  
+  return false;
+  }
+
+
+
+//! BiCGSTAB with right preconditioning, for general square matrices
+template<typename eT>
+inline
+bool
+spsolve_iter::bicgstab(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  Col<eT>& r    = ws.r;
+  Col<eT>& rhat = ws.u;
+  Col<eT>& p    = ws.p;
+  Col<eT>& v    = ws.v;
+  Col<eT>& phat = ws.z;
+  Col<eT>& s    = ws.s;
+  Col<eT>& shat = ws.w;
+  Col<eT>& t    = ws.t;
+  
+  const T b_norm = norm(b);
+  
+  r = A * x;
+  r = b - r;
+  
+  if(norm(r) <= tol * b_norm)  { return true; }
+  
+  rhat = r;
+  
+  eT rho   = eT(1);
+  eT alpha = eT(1);
+  eT omega = eT(1);
+  
+  p.zeros();
+  v.zeros();
+  
+  while(n_iter < max_iter)
+    {
+    const eT rho_new = cdot(rhat, r);
+    
+    if(rho_new == eT(0))  { return false; }
+    
+    const eT beta = (rho_new / rho) * (alpha / omega);
+    
+    rho = rho_new;
+    
+    p = r + beta * (p - omega * v);
+    
+    apply_precond(phat, p, ws);
+    
+    v = A * phat;
+    
+    const eT rv = cdot(rhat, v);
+    
+    if(rv == eT(0))  { return false; }
+    
+    alpha = rho / rv;
+    
+    s = r - alpha * v;
+    
+    ++n_iter;
+    
+    if(norm(s) <= tol * b_norm)  { x += alpha * phat; return true; }
+    
+    apply_precond(shat, s, ws);
+    
+    t = A * shat;
+    
+    const T tt = access::tmp_real(cdot(t, t));
+    
+    if(tt == T(0))  { x += alpha * phat; return false; }
+    
+    omega = cdot(t, s) / tt;
+    
+    x += alpha * phat + omega * shat;
+    
+    r = s - omega * t;
+    
+    if(norm(r) <= tol * b_norm)  { return true; }
+    
+    if(omega == eT(0))  { return false; }
+    }
+  
+  return false;
+  }
+
+
+
+//! restarted GMRES with right preconditioning, for general square matrices
+template<typename eT>
+inline
+bool
+spsolve_iter::gmres(uword& n_iter, Col<eT>& x, const Col<eT>& b, const SpMat<eT>& A, spsolve_iter_workspace<eT>& ws, const typename get_pod_type<eT>::result tol, const uword max_iter, const uword restart)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const uword n = b.n_elem;
+  const uword m = (std::max)( uword(1), (std::min)(restart, n) );
+  
+  Col<eT>& r  = ws.r;
+  Col<eT>& z  = ws.z;
+  Col<eT>& w  = ws.w;
+  Mat<eT>& V  = ws.V;
+  Mat<eT>& H  = ws.H;
+  Col<eT>& g  = ws.g;
+  Col<eT>& y  = ws.y;
+  Col<eT>& sn = ws.sn;
+  
+  V.set_size(n, m+1);
+  H.set_size(m+1, m);
+  g.set_size(m+1);
+  y.set_size(m);
+  sn.set_size(m);
+  
+  podarray<T> cs(m);
+  
+  const T b_norm = norm(b);
+  
+  while(true)
+    {
+    r = A * x;
+    r = b - r;
+    
+    const T beta = norm(r);
+    
+    if(beta <= tol * b_norm)  { return true; }
+    
+    if(n_iter >= max_iter)  { return false; }
+    
+    V.col(0) = r / beta;
+    
+    g.zeros();
+    
+    g[0] = eT(beta);
+    
+    uword k = 0;
+    
+    while( (k < m) && (n_iter < max_iter) )
+      {
+      // Arnoldi step with modified Gram-Schmidt
+      
+      const Col<eT> V_k(V.colptr(k), n, false, true);
+      
+      apply_precond(z, V_k, ws);
+      
+      w = A * z;
+      
+      for(uword i=0; i <= k; ++i)
+        {
+        const Col<eT> V_i(V.colptr(i), n, false, true);
+        
+        const eT h = cdot(V_i, w);
+        
+        H.at(i,k) = h;
+        
+        w -= h * V_i;
+        }
+      
+      const T h_next = norm(w);
+      
+      H.at(k+1,k) = eT(h_next);
+      
+      if(h_next > T(0))  { V.col(k+1) = w / h_next; }
+      
+      // apply the previous Givens rotations to the new column of H
+      
+      for(uword i=0; i < k; ++i)
+        {
+        const eT a = H.at(i,  k);
+        const eT c = H.at(i+1,k);
+        
+        H.at(i,  k) =  cs[i] * a + sn[i] * c;
+        H.at(i+1,k) = -access::alt_conj(sn[i]) * a + cs[i] * c;
+        }
+      
+      // new rotation, which zeros H(k+1,k)
+      
+      const eT a = H.at(k,  k);
+      const eT c = H.at(k+1,k);
+      
+      const T a_abs = std::abs(a);
+      const T rho   = std::sqrt(a_abs*a_abs + std::abs(c)*std::abs(c));
+      
+      if(a_abs == T(0))
+        {
+        cs[k] = T(0);
+        sn[k] = eT(1);
+        }
+      else
+        {
+        cs[k] = a_abs / rho;
+        sn[k] = (a / a_abs) * access::alt_conj(c) / rho;
+        }
+      
+      H.at(k,  k) = cs[k] * a + sn[k] * c;
+      H.at(k+1,k) = eT(0);
+      
+      g[k+1] = -access::alt_conj(sn[k]) * g[k];
+      g[k  ] = cs[k] * g[k];
+      
+      ++k;
+      ++n_iter;
+      
+      if( (std::abs(g[k]) <= tol * b_norm) || (h_next == T(0)) )  { break; }
+      }
+    
+    // solve the triangular system H(0:k-1,0:k-1) y = g(0:k-1), then update the solution
+    
+    for(uword ii=k; ii > 0; --ii)
+      {
+      const uword i = ii-1;
+      
+      eT acc = g[i];
+      
+      for(uword j=i+1; j < k; ++j)  { acc -= H.at(i,j) * y[j]; }
+      
+      if(H.at(i,i) == eT(0))  { return false; }
+      
+      y[i] = acc / H.at(i,i);
+      }
+    
+    w.zeros();
+    
+    for(uword j=0; j < k; ++j)
+      {
+      const Col<eT> V_j(V.colptr(j), n, false, true);
+      
+      w += y[j] * V_j;
+      }
+    
+    apply_precond(z, w, ws);
+    
+    x += z;
+    }
+  }
+
+
+
+template<typename eT>
+inline
+bool
+spsolve_iter::apply(Mat<eT>& X, spsolve_iter_workspace<eT>& ws, const SpMat<eT>& A, const Mat<eT>& B, const char* method, const spsolve_iter_opts& opts)
+  {
+  arma_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const char sig = (method != nullptr) ? method[0] : char(0);
+  
+  arma_conform_check( ((sig != 'c') && (sig != 'm') && (sig != 'b') && (sig != 'g')), "spsolve_iterative(): unknown method" );
+  
+  arma_conform_check( (A.is_square() == false), "spsolve_iterative(): matrix A must be square sized" );
+  
+  arma_conform_check( (A.n_rows != B.n_rows), "spsolve_iterative(): number of rows in the given objects must be the same" );
+  
+  ws.info = spsolve_iter_info();
+  
+  const uword n = A.n_rows;
+  
+  if( (sig == 'c') || (sig == 'm') )
+    {
+    if((arma_config::check_conform) && (sp_auxlib::rudimentary_sym_check(A) == false))
+      {
+      if(is_cx<eT>::no )  { arma_warn(1, "spsolve_iterative(): given matrix is not symmetric"); }
+      if(is_cx<eT>::yes)  { arma_warn(1, "spsolve_iterative(): given matrix is not hermitian"); }
+      }
+    }
+  
+  uword pc_type = 0;
+  
+  switch(opts.precond)
+    {
+    case spsolve_iter_opts::JACOBI:  pc_type = 1;  break;
+    case spsolve_iter_opts::ILU0:    pc_type = 2;  break;
+    case spsolve_iter_opts::IC0:     pc_type = 3;  break;
+    default:                         pc_type = 0;
+    }
+  
+  const bool reuse = (opts.reuse_precond) && (ws.pc_type == pc_type) && (ws.pc_n == n);
+  
+  if(reuse == false)
+    {
+    if(build_precond(ws, A, pc_type) == false)
+      {
+      arma_warn(1, "spsolve_iterative(): construction of preconditioner failed");
+      X.soft_reset();
+      return false;
+      }
+    }
+  
+  ws.init(n);
+  
+  if( (opts.warm_start == false) || (X.n_rows != n) || (X.n_cols != B.n_cols) )  { X.zeros(n, B.n_cols); }
+  
+  const T tol = (opts.tol > double(0)) ? T(opts.tol) : std::sqrt(std::numeric_limits<T>::epsilon());
+  
+  const uword max_iter = uword(opts.maxiter);
+  
+  bool all_converged = true;
+  
+  uword max_n_iter   = 0;
+  T     max_residual = T(0);
+  
+  for(uword c=0; c < B.n_cols; ++c)
+    {
+          Col<eT> x(X.colptr(c), n, false, true);
+    const Col<eT> b(const_cast<eT*>(B.colptr(c)), n, false, true);
+    
+    const T b_norm = norm(b);
+    
+    if(b_norm == T(0))  { x.zeros(); continue; }
+    
+    uword n_iter    = 0;
+    bool  converged = false;
+    
+    switch(sig)
+      {
+      case 'c':  converged = cg      (n_iter, x, b, A, ws, tol, max_iter);                       break;
+      case 'm':  converged = minres  (n_iter, x, b, A, ws, tol, max_iter);                       break;
+      case 'b':  converged = bicgstab(n_iter, x, b, A, ws, tol, max_iter);                       break;
+      case 'g':  converged = gmres   (n_iter, x, b, A, ws, tol, max_iter, uword(opts.restart)); break;
+      default:   ;
+      }
+    
+    ws.r = A * x;
+    ws.r = b - ws.r;
+    
+    const T residual = norm(ws.r) / b_norm;
+    
+    all_converged = all_converged && converged && arma_isfinite(residual);
+    
+    max_n_iter   = (std::max)(max_n_iter,   n_iter);
+    max_residual = (std::max)(max_residual, residual);
+    }
+  
+  ws.info.n_iter    = (unsigned int)(max_n_iter);
+  ws.info.residual  = double(max_residual);
+  ws.info.converged = all_converged;
+  
+  return all_converged;
+  }
+
+
+
+//! @}
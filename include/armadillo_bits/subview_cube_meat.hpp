@@ -150,11 +150,57 @@ subview_cube<eT>::inplace_op(const BaseCube<eT,T1>& in, const char* identifier)
   
   arma_conform_assert_same_size(t, P, identifier);
   
-  const bool use_mp      = arma_config::openmp && ProxyCube<T1>::use_mp && mp_gate<eT>::eval(t.n_elem);
+  const bool use_mp      = arma_config::mp && ProxyCube<T1>::use_mp && mp_gate<eT, false, mp_expr_cost_mp<T1>::value>::eval_loop(t.n_elem);
   const bool has_overlap = P.has_overlap(t);
   
   if(has_overlap)  { arma_debug_print("aliasing or overlap detected"); }
   
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
+    {
+    if( (use_mp) && (has_overlap == false) && (is_Cube<typename ProxyCube<T1>::stored_type>::value == false) )
+      {
+      // evaluate the expression directly into the subcube, without a temporary cube;
+      // the columns of all slices are distributed among the threads
+      
+      arma_debug_print("subview_cube::inplace_op(): parallel evaluation");
+      
+      const int n_threads = mp_thread_limit::get_loop();
+      
+      typename ProxyCube<T1>::ea_type Pea = P.get_ea();
+      
+      const uword t_n_elem_slice = t.n_elem_slice;
+      
+      const auto worker = [&](const uword start, const uword endp1)
+        {
+        for(uword index=start; index < endp1; ++index)
+          {
+          const uword s = index / t_n_cols;
+          const uword c = index % t_n_cols;
+          
+          eT* t_col_data = t.slice_colptr(s,c);
+          
+          const uword offset = s*t_n_elem_slice + c*t_n_rows;
+          
+          for(uword r=0; r < t_n_rows; ++r)
+            {
+            const eT tmp = (ProxyCube<T1>::use_at) ? P.at(r,c,s) : Pea[offset + r];
+            
+            if(is_same_type<op_type, op_internal_equ  >::yes)  { t_col_data[r] =  tmp; }
+            if(is_same_type<op_type, op_internal_plus >::yes)  { t_col_data[r] += tmp; }
+            if(is_same_type<op_type, op_internal_minus>::yes)  { t_col_data[r] -= tmp; }
+            if(is_same_type<op_type, op_internal_schur>::yes)  { t_col_data[r] *= tmp; }
+            if(is_same_type<op_type, op_internal_div  >::yes)  { t_col_data[r] /= tmp; }
+            }
+          }
+        };
+      
+      mp_loop::run_chunked(t_n_slices * t_n_cols, n_threads, worker);
+      
+      return;
+      }
+    }
+  #endif
+  
   if( (is_Cube<typename ProxyCube<T1>::stored_type>::value) || (use_mp) || (has_overlap) )
     {
     const unwrap_cube_check<typename ProxyCube<T1>::stored_type> tmp(P.Q, has_overlap);
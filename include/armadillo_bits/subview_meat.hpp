@@ -151,11 +151,57 @@ subview<eT>::inplace_op(const Base<eT,T1>& in, const char* identifier)
   
   arma_conform_assert_same_size(s, P, identifier);
   
-  const bool use_mp      = arma_config::openmp && Proxy<T1>::use_mp && mp_gate<eT>::eval(s.n_elem);
+  const bool use_mp      = arma_config::mp && Proxy<T1>::use_mp && mp_gate<eT, false, mp_expr_cost_mp<T1>::value>::eval_loop(s.n_elem);
   const bool has_overlap = P.has_overlap(s);
   
   if(has_overlap)  { arma_debug_print("aliasing or overlap detected"); }
   
+  #if defined(ARMA_USE_OPENMP) || defined(ARMA_USE_MP_EXECUTOR)
+    {
+    if( (use_mp) && (has_overlap == false) && (is_Mat<typename Proxy<T1>::stored_type>::value == false) )
+      {
+      // evaluate the expression directly into the subview, without a temporary matrix
+      
+      arma_debug_print("subview::inplace_op(): parallel evaluation");
+      
+      const int n_threads = mp_thread_limit::get_loop();
+      
+      typename Proxy<T1>::ea_type Pea = P.get_ea();
+      
+      // process rows [row_start, row_endp1) of each column in [col_start, col_endp1)
+      const auto worker = [&](const uword col_start, const uword col_endp1, const uword row_start, const uword row_endp1)
+        {
+        for(uword ucol=col_start; ucol < col_endp1; ++ucol)
+          {
+          eT* s_col_data = s.colptr(ucol);
+          
+          for(uword urow=row_start; urow < row_endp1; ++urow)
+            {
+            const eT tmp = (Proxy<T1>::use_at) ? P.at(urow,ucol) : Pea[ucol*s_n_rows + urow];
+            
+            if(is_same_type<op_type, op_internal_equ  >::yes)  { s_col_data[urow] =  tmp; }
+            if(is_same_type<op_type, op_internal_plus >::yes)  { s_col_data[urow] += tmp; }
+            if(is_same_type<op_type, op_internal_minus>::yes)  { s_col_data[urow] -= tmp; }
+            if(is_same_type<op_type, op_internal_schur>::yes)  { s_col_data[urow] *= tmp; }
+            if(is_same_type<op_type, op_internal_div  >::yes)  { s_col_data[urow] /= tmp; }
+            }
+          }
+        };
+      
+      if(s_n_cols < uword(n_threads))
+        {
+        mp_loop::run_chunked(s_n_rows, n_threads, [&](const uword start, const uword endp1) { worker(0, s_n_cols, start, endp1); });
+        }
+      else
+        {
+        mp_loop::run_chunked(s_n_cols, n_threads, [&](const uword start, const uword endp1) { worker(start, endp1, 0, s_n_rows); });
+        }
+      
+      return;
+      }
+    }
+  #endif
+  
   if( (is_Mat<typename Proxy<T1>::stored_type>::value) || (use_mp) || (has_overlap) )
     {
     const unwrap_check<typename Proxy<T1>::stored_type> tmp(P.Q, has_overlap);
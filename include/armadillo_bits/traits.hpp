@@ -616,6 +616,25 @@ struct is_SpMat< SpRow<eT> >
 
 
 
+//! sparse matrices stored in formats other than CSC
+template<typename T>
+struct is_SpMat_alt
+  { static constexpr bool value = false; };
+
+template<typename eT>
+struct is_SpMat_alt< SpMat_csr<eT> >
+  { static constexpr bool value = true; };
+
+template<typename eT>
+struct is_SpMat_alt< SpMat_bsr<eT> >
+  { static constexpr bool value = true; };
+
+template<typename eT>
+struct is_SpMat_alt< SpMat_sell<eT> >
+  { static constexpr bool value = true; };
+
+
+
 template<typename T>
 struct is_SpRow
   { static constexpr bool value = false; };
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+#include <thread>
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("arena_scope_1")
+  {
+  mat A(50, 50, fill::randu);
+  
+  mat B = A.t() * A + 2.0*A.t();
+  
+  mat C;
+  
+    {
+    arena_scope scope;
+    
+    for(uword i=0; i < 10; ++i)
+      {
+      mat tmp = A.t() * A + 2.0*A.t();
+      
+      if(i == 5)  { C = tmp; }
+      }
+    }
+  
+  REQUIRE( arena_scope::is_active() == false );
+  
+  REQUIRE( approx_equal(B, C, "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("arena_scope_2")
+  {
+  sp_mat S = sprandu<sp_mat>(100, 100, 0.05);
+  
+  cube Q(10, 10, 10, fill::randu);
+  
+  double sum_S = 0;
+  double sum_Q = 0;
+  
+    {
+    arena_scope scope_1;
+    
+      {
+      arena_scope scope_2;
+      
+      sp_mat T = S * S.t();
+      cube   R = Q % Q;
+      
+      sum_S = accu(T);
+      sum_Q = accu(R);
+      }
+    }
+  
+  REQUIRE( sum_S == Approx(accu(S * S.t())) );
+  REQUIRE( sum_Q == Approx(accu(Q % Q))     );
+  }
+
+
+
+// the tests below inspect the pool directly;
+// they require ARMA_USE_ARENA_ALLOC to be enabled, eg. via -DARMA_USE_ARENA_ALLOC
+
+#if defined(ARMA_USE_ARENA_ALLOC)
+
+static
+uword
+arena_scope_n_pooled()
+  {
+  const arena_pool::state_type* state = arena_pool::get_state();
+  
+  if(state == nullptr)  { return 0; }
+  
+  uword count = 0;
+  
+  for(uword c=0; c < arena_pool::n_classes; ++c)
+    {
+    for(void* mem = state->free_list[c]; mem != nullptr; mem = *( (void**)(mem) ))  { ++count; }
+    }
+  
+  return count;
+  }
+
+
+
+TEST_CASE("arena_scope_3")
+  {
+  // released blocks are reused by subsequent allocations of the same size class
+  
+  REQUIRE( arena_scope_n_pooled() == 0 );
+  
+    {
+    arena_scope scope;
+    
+    REQUIRE( arena_scope::is_active() == true );
+    
+    const double* ptr_A = nullptr;
+    
+      {
+      mat A(100, 100, fill::randu);
+      
+      ptr_A = A.memptr();
+      }
+    
+    REQUIRE( arena_scope_n_pooled() == 1 );
+    
+    mat B(100, 100, fill::zeros);
+    
+    REQUIRE( B.memptr() == ptr_A );
+    REQUIRE( arena_scope_n_pooled() == 0 );
+    
+    // a slightly smaller size falls into the same class
+    
+    const double* ptr_B = B.memptr();
+    
+    B.reset();
+    
+    mat C(99, 100, fill::ones);
+    
+    REQUIRE( C.memptr() == ptr_B );
+    REQUIRE( accu(C)    == Approx(9900.0) );
+    }
+  
+  REQUIRE( arena_scope::is_active() == false );
+  REQUIRE( arena_scope_n_pooled()   == 0     );
+  }
+
+
+
+TEST_CASE("arena_scope_4")
+  {
+  // the pool is only drained when the outermost scope ends
+  
+    {
+    arena_scope scope_1;
+    
+    const double* ptr_A = nullptr;
+    
+      {
+      arena_scope scope_2;
+      
+      mat A(200, 10, fill::randu);
+      
+      ptr_A = A.memptr();
+      
+      mat B(300, 30, fill::randu);
+      }
+    
+    REQUIRE( arena_scope::is_active() == true );
+    REQUIRE( arena_scope_n_pooled()   == 2    );
+    
+    mat C(200, 10, fill::zeros);
+    
+    REQUIRE( C.memptr() == ptr_A );
+    }
+  
+  REQUIRE( arena_scope::is_active() == false );
+  REQUIRE( arena_scope_n_pooled()   == 0     );
+  
+  // without a scope, memory is not retained
+  
+    {
+    mat D(200, 10, fill::randu);
+    }
+  
+  REQUIRE( arena_scope_n_pooled() == 0 );
+  }
+
+
+
+TEST_CASE("arena_scope_5")
+  {
+  // memory acquired within a scope and released after the scope has ended,
+  // including during thread exit after the pool of the thread has been destroyed
+  
+  mat A;
+  
+    {
+    arena_scope scope;
+    
+    A.set_size(100, 100);
+    A.fill(2.0);
+    }
+  
+  A.reset();
+  
+  REQUIRE( arena_scope_n_pooled() == 0 );
+  
+  double sum = 0;
+  
+  std::thread worker([&]()
+    {
+    // constructed before the pool of the thread, hence destroyed after it
+    static thread_local mat X;
+    
+    static thread_local arena_scope scope;
+    
+    X.set_size(50, 50);
+    X.fill(1.0);
+    
+    sum = accu(X);
+    });
+  
+  worker.join();
+  
+  REQUIRE( sum == Approx(2500.0) );
+  }
+
+
+
+#if defined(ARMA_MEM_HUGEPAGE_THRESHOLD) && defined(ARMA_HAVE_POSIX_MEMALIGN) && !defined(ARMA_ALIEN_MEM_ALLOC_FUNCTION) && !defined(ARMA_USE_TBB_ALLOC) && !defined(ARMA_USE_MKL_ALLOC)
+
+TEST_CASE("arena_scope_6")
+  {
+  // large blocks keep the huge page alignment provided by the underlying allocator,
+  // both when freshly allocated and when reused from the pool
+  
+  const uword n_elem = uword(arma_config::mem_hugepage_threshold / sizeof(double)) + 1000;
+  
+  REQUIRE( n_elem > 0 );
+  
+    {
+    arena_scope scope;
+    
+    const double* ptr_A = nullptr;
+    
+      {
+      vec A(n_elem, fill::ones);
+      
+      ptr_A = A.memptr();
+      
+      REQUIRE( (std::size_t(ptr_A) % memory::hugepage_size) == 0 );
+      REQUIRE( accu(A) == Approx(double(n_elem)) );
+      }
+    
+    vec B(n_elem - 10, fill::zeros);
+    
+    REQUIRE( B.memptr() == ptr_A );
+    REQUIRE( (std::size_t(B.memptr()) % memory::hugepage_size) == 0 );
+    }
+  
+  REQUIRE( arena_scope_n_pooled() == 0 );
+  }
+
+#endif
+
+#endif
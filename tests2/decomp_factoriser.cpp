@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("decomp_chol_factoriser")
+  {
+  const uword n = 40;
+  
+  const mat G(n, n, fill::randn);
+  
+  mat A = G*G.t() + double(n) * eye<mat>(n,n);
+  
+  chol_factoriser<double> F;
+  
+  REQUIRE( F.factorise(A) );
+  
+  const vec x(n, fill::randn);
+  const vec y = 0.5 * x;
+  
+  REQUIRE( F.update(x)   );  A += x*x.t();
+  REQUIRE( F.downdate(y) );  A -= y*y.t();
+  
+  REQUIRE( approx_equal(mat(F.L() * F.L().t()), A, "reldiff", 1e-10) );
+  
+  vec c(n+1, fill::randn);  c(n) = 1000.0;
+  
+  REQUIRE( F.append(c) );
+  
+  A.resize(n+1, n+1);  A.col(n) = c;  A.row(n) = c.t();
+  
+  REQUIRE( F.remove(7) );
+  
+  A.shed_row(7);  A.shed_col(7);
+  
+  REQUIRE( approx_equal(mat(F.L() * F.L().t()), A, "reldiff", 1e-10) );
+  REQUIRE( approx_equal(F.L(), mat(trimatl(F.L())), "absdiff", 0.0) );
+  
+  const mat B(n, 3, fill::randn);
+  
+  mat X;
+  
+  REQUIRE( F.solve(X, B) );
+  
+  REQUIRE( approx_equal(mat(A*X), B, "absdiff", 1e-10) );
+  
+  // downdate producing a matrix which is not positive definite; the factorisation is kept
+  
+  const vec z(n, fill::value(100.0));
+  
+  REQUIRE( F.downdate(z) == false );
+  
+  REQUIRE( approx_equal(mat(F.L() * F.L().t()), A, "reldiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("decomp_qr_factoriser")
+  {
+  mat A(60, 20, fill::randn);
+  
+  qr_factoriser<double> F;
+  
+  REQUIRE( F.factorise(A) );
+  
+  const vec    u(60, fill::randn);
+  const vec    v(20, fill::randn);
+  const rowvec r(20, fill::randn);
+  const vec    c(60, fill::randn);
+  
+  REQUIRE( F.update(u, v)    );  A += u*v.t();
+  REQUIRE( F.append_row(r)   );  A = join_cols(A, r);
+  REQUIRE( F.remove_row(5)   );  A.shed_row(5);
+  REQUIRE( F.append_col(c)   );  A = join_rows(A, c);
+  REQUIRE( F.remove_col(3)   );  A.shed_col(3);
+  
+  REQUIRE( F.n_rows() == 60 );
+  REQUIRE( F.n_cols() == 20 );
+  
+  const mat& Q = F.Q();
+  const mat& R = F.R();
+  
+  REQUIRE( approx_equal(mat(Q*R), A, "absdiff", 1e-10) );
+  
+  REQUIRE( approx_equal(mat(Q.t()*Q), eye<mat>(60,60), "absdiff", 1e-10) );
+  
+  for(uword j=0; j < R.n_cols; ++j)
+    {
+    REQUIRE( all(R.col(j).tail(R.n_rows-j-1) == 0.0) );
+    }
+  
+  const vec b(60, fill::randn);
+  
+  vec x;
+  
+  REQUIRE( F.solve(x, b) );
+  
+  REQUIRE( approx_equal(x, vec(solve(A, b)), "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("decomp_lu_factoriser")
+  {
+  const uword n = 40;
+  
+  mat A(n, n, fill::randn);
+  
+  lu_factoriser<double> F;
+  
+  REQUIRE( F.factorise(A) );
+  
+  REQUIRE( F.rcond() == Approx(rcond(A)) );
+  
+  for(uword i=0; i < 5; ++i)
+    {
+    const vec u(n, fill::randn);
+    const vec v(n, fill::randn);
+    
+    REQUIRE( F.update(u, v) );
+    
+    A += u*v.t();
+    }
+  
+  const vec    c(n+1, fill::randn);
+  const rowvec r(n,   fill::randn);
+  
+  REQUIRE( F.append(c, r) );
+  
+  A.resize(n+1, n+1);  A.col(n) = c;  A.row(n).head(n) = r;
+  
+  mat B(n+1, 2, fill::randn);
+  mat X;
+  
+  REQUIRE( F.solve(X, B) );
+  
+  REQUIRE( norm(A*X - B) <= 1e-8 * norm(B) );
+  
+  REQUIRE( F.remove(4) );
+  
+  A.shed_row(4);  A.shed_col(4);  B.shed_row(4);
+  
+  REQUIRE( F.solve(X, B) );
+  
+  REQUIRE( norm(A*X - B) <= 1e-8 * norm(B) );
+  
+  // singular matrix
+  
+  lu_factoriser<double> G;
+  
+  REQUIRE( G.factorise(zeros<mat>(4,4)) == false );
+  REQUIRE( G.solve(X, B)                == false );
+  }
+
+
+
+TEST_CASE("decomp_lu_factoriser_2")
+  {
+  // diagonally dominant matrices: the updates must succeed without recomputing the decomposition
+  
+  const uword n = 30;
+  
+  mat A = randu<mat>(n, n) + double(n) * eye<mat>(n, n);
+  
+  lu_factoriser<double> F;
+  
+  REQUIRE( F.factorise(A) );
+  
+  REQUIRE( F.was_recomputed() == false );
+  
+  for(uword i=0; i < 10; ++i)
+    {
+    const vec u = 0.1 * randu<vec>(n);
+    const vec v = 0.1 * randu<vec>(n);
+    
+    REQUIRE( F.update(u, v) );
+    
+    REQUIRE( F.was_recomputed() == false );
+    
+    A += u*v.t();
+    }
+  
+  const vec    c = join_cols(0.1 * randu<vec>(n), vec{ double(n) });
+  const rowvec r = 0.1 * randu<rowvec>(n);
+  
+  REQUIRE( F.append(c, r) );
+  
+  REQUIRE( F.was_recomputed() == false );
+  
+  A.resize(n+1, n+1);  A.col(n) = c;  A.row(n).head(n) = r;
+  
+  const vec b(n+1, fill::randu);
+  
+  vec x;
+  
+  REQUIRE( F.solve(x, b) );
+  
+  REQUIRE( norm(A*x - b) <= 1e-10 * norm(b) );
+  
+  REQUIRE( F.rcond() == Approx(rcond(A)) );
+  
+  REQUIRE( F.remove(3) );
+  
+  REQUIRE( F.was_recomputed() == false );
+  
+  A.shed_row(3);  A.shed_col(3);
+  
+  const vec b2(n, fill::randu);
+  
+  REQUIRE( F.solve(x, b2) );
+  
+  REQUIRE( norm(A*x - b2) <= 1e-10 * norm(b2) );
+  
+  // zero pivot: the identity matrix is modified into a permutation matrix, which requires row interchanges
+  
+  lu_factoriser<double> G;
+  
+  REQUIRE( G.factorise(eye<mat>(2,2)) );
+  
+  REQUIRE( G.update(vec{ 1.0, -1.0 }, vec{ -1.0, 1.0 }) );
+  
+  REQUIRE( G.was_recomputed() == false );
+  
+  REQUIRE( G.solve(x, vec{ 2.0, 3.0 }) );
+  
+  REQUIRE( x(0) == Approx(3.0) );
+  REQUIRE( x(1) == Approx(2.0) );
+  }
@@ -53,3 +53,41 @@ TEST_CASE("expr_misc_1")
   
   // REQUIRE_THROWS(  );
   }
+
+
+
+TEST_CASE("expr_misc_2")
+  {
+  // element-wise expressions evaluated into subviews;
+  // the sizes are large enough to enable parallelisation (if available)
+  
+  mat A(300, 200, fill::randu);
+  mat B(300, 200, fill::randu);
+  
+  mat C = A;
+  mat D = A;
+  
+  C.cols(10,19)  = exp(B.cols(20,29)) * 2;
+  C.cols(10,19) += sqrt(B.cols(0,9)) + B.cols(30,39);
+  C.submat(5,50,254,149) %= log(B.submat(10,10,259,109));
+  
+  D.cols(10,19)  = mat( exp(mat(B.cols(20,29))) * 2 );
+  D.cols(10,19) += mat( sqrt(mat(B.cols(0,9))) ) + mat(B.cols(30,39));
+  D.submat(5,50,254,149) %= mat( log(mat(B.submat(10,10,259,109))) );
+  
+  REQUIRE( approx_equal(C, D, "absdiff", 1e-12) );
+  
+  cube P(40, 50, 6, fill::randu);
+  cube Q(40, 50, 6, fill::randu);
+  
+  cube R = P;
+  cube S = P;
+  
+  R.slices(2,2)  = exp(Q.slices(3,3)) + Q.slices(4,4);
+  R.slices(0,1) -= 2 * log(Q.slices(1,2));
+  
+  S.slices(2,2)  = cube( exp(cube(Q.slices(3,3))) ) + cube(Q.slices(4,4));
+  S.slices(0,1) -= cube( 2 * log(cube(Q.slices(1,2))) );
+  
+  REQUIRE( approx_equal(R, S, "absdiff", 1e-12) );
+  }
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+TEST_CASE("fn_batch_1")
+  {
+  // compare against the functions for single matrices; the sizes cover partial groups of matrices and the sizes handled one at a time
+  
+  for(const uword N : { 1, 3, 4, 7, 16, 20 })
+  for(const uword S : { 1, 9, 37 })
+    {
+    cube A(N, N, S, fill::randn);
+    cube B(N, 3, S, fill::randn);
+    cube P(N, N, S);
+    
+    for(uword s=0; s < S; ++s)  { P.slice(s) = A.slice(s) * A.slice(s).t() + double(N) * eye(N,N); }
+    
+    const cube AB = batch_mul(A, B);
+    const cube AF = batch_mul(A, A.slices(0,0));
+    const cube X  = batch_solve(A, B);
+    const cube R  = batch_chol(P);
+    const cube L  = batch_chol(P, "lower");
+    const cube Q  = batch_inv_sympd(P);
+    
+    REQUIRE( AB.n_rows   == N );
+    REQUIRE( AB.n_cols   == 3 );
+    REQUIRE( AB.n_slices == S );
+    REQUIRE( X.n_cols    == 3 );
+    
+    for(uword s=0; s < S; ++s)
+      {
+      REQUIRE( approx_equal(AB.slice(s), mat(A.slice(s) * B.slice(s)),             "absdiff", 1e-10) );
+      REQUIRE( approx_equal(AF.slice(s), mat(A.slice(s) * A.slice(0)),             "absdiff", 1e-10) );
+      REQUIRE( approx_equal(R.slice(s),  mat(chol(P.slice(s))),                    "absdiff", 1e-10) );
+      REQUIRE( approx_equal(L.slice(s),  mat(chol(P.slice(s), "lower")),           "absdiff", 1e-10) );
+      REQUIRE( approx_equal(Q.slice(s),  mat(inv_sympd(P.slice(s))),               "absdiff", 1e-10) );
+      REQUIRE( approx_equal(mat(A.slice(s) * X.slice(s)), B.slice(s),              "absdiff", 1e-8 ) );
+      }
+    }
+  }
+
+
+
+TEST_CASE("fn_batch_2")
+  {
+  // float matrices, integer matrices and complex matrices
+  
+  fcube A(5, 5, 21, fill::randn);
+  fcube B(5, 2, 21, fill::randn);
+  
+  const fcube X = batch_solve(A, B);
+  
+  for(uword s=0; s < A.n_slices; ++s)  { REQUIRE( approx_equal(fmat(A.slice(s) * X.slice(s)), B.slice(s), "absdiff", 1e-3f) ); }
+  
+  const imat  I = randi<imat>(4, 4, distr_param(-10, 10));
+        icube J(4, 4, 11);
+  
+  J.each_slice() = I;
+  
+  const icube K = batch_mul(J, J);
+  
+  REQUIRE( accu(K.slice(10) != I*I) == 0 );
+  
+  cx_cube C(3, 3, 10, fill::randn);
+  cx_cube D(3, 2, 10, fill::randn);
+  
+  const cx_cube Y = batch_solve(C, D);
+  
+  REQUIRE( approx_equal(cx_mat(C.slice(7) * Y.slice(7)), D.slice(7), "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("fn_batch_3")
+  {
+  // failures are reported for the affected matrices only
+  
+  cube A(3, 3, 20, fill::randn);
+  cube B(3, 1, 20, fill::randn);
+  cube P(3, 3, 20);
+  
+  A.slice(5).zeros();
+  
+  P.each_slice() = eye(3,3);
+  
+  P(0,0,7) = -1.0;
+  
+  cube X;
+  cube R;
+  cube Q;
+  
+  REQUIRE( batch_solve(X, A, B) == false );
+  REQUIRE( batch_chol(R, P)     == false );
+  REQUIRE( batch_inv_sympd(Q, P) == false );
+  
+  REQUIRE( X.slice(5).has_nan() );
+  REQUIRE( R.slice(7).has_nan() );
+  REQUIRE( Q.slice(7).has_nan() );
+  
+  REQUIRE( X.slice(4).has_nan() == false );
+  REQUIRE( R.slice(6).has_nan() == false );
+  REQUIRE( Q.slice(6).has_nan() == false );
+  
+  REQUIRE_THROWS( X = batch_solve(A, B) );
+  REQUIRE_THROWS( R = batch_chol(P)     );
+  
+  // size mismatches
+  
+  REQUIRE_THROWS( X = batch_mul(A, cube(4, 3, 20)) );
+  REQUIRE_THROWS( X = batch_mul(A, cube(3, 3, 19)) );
+  REQUIRE_THROWS( X = batch_solve(cube(3, 4, 20), B) );
+  }
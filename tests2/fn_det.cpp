@@ -86,3 +86,43 @@ TEST_CASE("fn_det_3")
   REQUIRE_THROWS( log_det(val, sign, B) );
   }
 
+
+
+
+TEST_CASE("fn_det_4")
+  {
+  // fixed size matrices
+  
+  mat::fixed<6,6> A = toeplitz(linspace(1,5,6));
+  mat::fixed<4,4> B(fill::randn);
+  mat::fixed<9,9> C(fill::randn);
+  
+  fmat::fixed<5,5>    D(fill::randn);
+  cx_mat::fixed<3,3>  E(fill::randn);
+  
+  REQUIRE( det(A) == Approx(-31.45728) );
+  REQUIRE( det(B) == Approx(det(mat(B))) );
+  REQUIRE( det(C) == Approx(det(mat(C))) );
+  REQUIRE( det(D) == Approx(det(fmat(D))).epsilon(0.001) );
+  
+  const cx_double val_E = det(E);
+  const cx_double ref_E = det(cx_mat(E));
+  
+  REQUIRE( val_E.real() == Approx(ref_E.real()) );
+  REQUIRE( val_E.imag() == Approx(ref_E.imag()) );
+  
+  mat::fixed<5,5> F(fill::randn);
+  
+  F.row(3) = 2.0 * F.row(1);
+  
+  REQUIRE( std::abs(det(F)) < 1e-10 );
+  
+  double val = 0.0;
+  
+  REQUIRE( det(val, A) );
+  REQUIRE( val == Approx(-31.45728) );
+  
+  mat::fixed<4,5> G(fill::randu);
+  
+  REQUIRE_THROWS( det(G) );
+  }
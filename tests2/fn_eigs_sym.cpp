@@ -192,3 +192,83 @@ TEST_CASE("fn_eigs_sigma_test")
   
   REQUIRE( count > 0 );
   }
+
+
+
+TEST_CASE("fn_eigs_lobpcg_test")
+  {
+  sp_mat m; m.sprandu(300, 300, 0.05);
+  m = m.t() + m;
+  m.diag() += linspace<vec>(1.0, 30.0, 300);
+  mat d(m);
+  
+  vec eigval;
+  mat eigvec;
+  eig_sym(eigval, eigvec, d);
+  
+  eigs_opts opts;
+  opts.method = eigs_opts::LOBPCG;
+  
+  for(const bool precond : { false, true })
+    {
+    opts.precond = precond;
+    
+    vec sp_eigval_sa;
+    mat sp_eigvec_sa;
+    REQUIRE( eigs_sym(sp_eigval_sa, sp_eigvec_sa, m, 6, "sa", opts) );
+    
+    vec sp_eigval_la;
+    mat sp_eigvec_la;
+    REQUIRE( eigs_sym(sp_eigval_la, sp_eigvec_la, m, 6, "la", opts) );
+    
+    REQUIRE( sp_eigval_sa.n_elem == 6 );
+    REQUIRE( sp_eigval_la.n_elem == 6 );
+    
+    for(uword i = 0; i < 6; ++i)
+      {
+      REQUIRE( sp_eigval_sa(i) == Approx(eigval(i      )).margin(1e-8) );
+      REQUIRE( sp_eigval_la(i) == Approx(eigval(294 + i)).margin(1e-8) );
+      
+      // eigenvectors may be pointed in the opposite direction
+      REQUIRE( std::abs(dot(sp_eigvec_sa.col(i), eigvec.col(i      ))) == Approx(1.0).margin(1e-6) );
+      REQUIRE( std::abs(dot(sp_eigvec_la.col(i), eigvec.col(294 + i))) == Approx(1.0).margin(1e-6) );
+      }
+    }
+  
+  // warm start from the eigenvectors of a nearby matrix
+  
+  sp_mat m2 = m;
+  m2.diag() += 0.01 * randu<vec>(300);
+  
+  vec eigval2 = eig_sym(mat(m2));
+  
+  vec sp_eigval;
+  mat sp_eigvec = eigvec.head_cols(6);
+  
+  opts.precond    = false;
+  opts.warm_start = true;
+  
+  REQUIRE( eigs_sym(sp_eigval, sp_eigvec, m2, 6, "sa", opts) );
+  
+  REQUIRE( approx_equal(sp_eigval, eigval2.head(6), "absdiff", 1e-8) );
+  
+  // the warm start must need fewer iterations than a random start
+  
+  const newarp::SparseGenMatProd<double> op(m2);
+  
+  const double tol = std::pow(std::numeric_limits<double>::epsilon(), 2.0/3.0);
+  
+  newarp::LOBPCGSolver< double, newarp::EigsSelect::SMALLEST_ALGE, newarp::SparseGenMatProd<double> > cold(op, 6, 8);
+  newarp::LOBPCGSolver< double, newarp::EigsSelect::SMALLEST_ALGE, newarp::SparseGenMatProd<double> > warm(op, 6, 8);
+  
+  cold.init();
+  warm.init(eigvec.head_cols(6));
+  
+  REQUIRE( cold.compute(1000, tol) == 6 );
+  REQUIRE( warm.compute(1000, tol) == 6 );
+  
+  REQUIRE( approx_equal(warm.eigenvalues(), eigval2.head(6), "absdiff", 1e-8) );
+  
+  REQUIRE( warm.num_iterations() < cold.num_iterations() );
+  REQUIRE( warm.num_operations() < cold.num_operations() );
+  }
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("fn_matfree_1")
+  {
+  // symmetric and general operators, compared against the corresponding sparse matrices
+  
+  const uword n = 300;
+  
+  sp_mat R = sprandu<sp_mat>(n, n, 0.03);
+  
+  const sp_mat S = R + R.t();
+  
+  const auto S_op = matfree<double>(n, n, [&](const mat& X, mat& Y) { Y = S * X; });
+  const auto R_op = matfree<double>(n, n, [&](const mat& X, mat& Y) { Y = R * X; });
+  
+  const vec eigval_S = eigs_sym(S,    5);
+  const vec eigval_A = eigs_sym(S_op, 5);
+  
+  REQUIRE( approx_equal(eigval_A, eigval_S, "reldiff", 1e-8) );
+  
+  vec eigval;
+  mat eigvec;
+  
+  REQUIRE( eigs_sym(eigval, eigvec, S_op, 4, "sa") );
+  
+  REQUIRE( norm(mat(S * eigvec) - eigvec * diagmat(eigval)) <= 1e-8 * norm(eigval, "inf") );
+  
+  eigs_opts opts;
+  opts.method = eigs_opts::LOBPCG;
+  
+  const vec eigval_L = eigs_sym(S_op, 4, "sa", opts);
+  
+  REQUIRE( approx_equal(eigval_L, eigval, "reldiff", 1e-6) );
+  
+  const cx_vec cx_eigval_R = eigs_gen(R,    4);
+  const cx_vec cx_eigval_A = eigs_gen(R_op, 4);
+  
+  REQUIRE( approx_equal(cx_eigval_A, cx_eigval_R, "reldiff", 1e-8) );
+  }
+
+
+
+TEST_CASE("fn_matfree_2")
+  {
+  // operator given as a Kronecker product, which is never formed
+  
+  const mat K1 = symmatu(mat(12, 12, fill::randn));
+  const mat K2 = symmatu(mat(10, 10, fill::randn));
+  
+  const uword n = K1.n_rows * K2.n_rows;
+  
+  const auto K_op = matfree<double>(n, n, [&](const mat& X, mat& Y)
+    {
+    for(uword j=0; j < X.n_cols; ++j)
+      {
+      const mat x = reshape(X.col(j), K2.n_rows, K1.n_rows);
+      
+      Y.col(j) = vectorise(K2 * x * K1.t());
+      }
+    });
+  
+  const vec eigval_K = eig_sym(kron(K1, K2));
+  
+  const vec eigval = eigs_sym(K_op, 3, "la");
+  
+  REQUIRE( approx_equal(eigval, eigval_K.tail(3), "reldiff", 1e-8) );
+  }
+
+
+
+TEST_CASE("fn_matfree_3")
+  {
+  // singular values via the transposed product
+  
+  sp_mat R = sprandu<sp_mat>(150, 80, 0.1);
+  
+  const auto R_op = matfree<double>(150, 80, [&](const mat& X, mat& Y) { Y = R * X; }, [&](const mat& X, mat& Y) { Y = R.t() * X; });
+  
+  mat U;
+  vec s;
+  mat V;
+  
+  REQUIRE( svds(U, s, V, R_op, 5) );
+  
+  const vec s_full = svd(mat(R));
+  
+  REQUIRE( approx_equal(s, vec(s_full.head(5)), "reldiff", 1e-8) );
+  
+  REQUIRE( norm(mat(R * V) - U * diagmat(s)) <= 1e-8 * s(0) );
+  
+  // no transposed product given; the operator is also not square
+  
+  const auto F_op = matfree<double>(150, 80, [&](const mat& X, mat& Y) { Y = R * X; });
+  
+  REQUIRE_THROWS( s = svds(F_op, 3) );
+  REQUIRE_THROWS( s = eigs_sym(F_op, 3) );
+  }
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("fn_rsvd_1")
+  {
+  // dense matrices of low rank are recovered exactly
+  
+  const mat A = randn<mat>(300, 15) * randn<mat>(15, 200);
+  
+  const vec s_full = svd(A);
+  
+  mat U;
+  vec s;
+  mat V;
+  
+  REQUIRE( rsvd(U, s, V, A, 10) );
+  
+  REQUIRE( s.n_elem == 10 );
+  REQUIRE( U.n_rows == 300 );
+  REQUIRE( U.n_cols == 10  );
+  REQUIRE( V.n_rows == 200 );
+  REQUIRE( V.n_cols == 10  );
+  
+  REQUIRE( approx_equal(s, vec(s_full.head(10)), "reldiff", 1e-8) );
+  
+  REQUIRE( norm(A*V - U*diagmat(s)) <= 1e-8 * s(0) );
+  
+  REQUIRE( approx_equal(U.t()*U, eye<mat>(10,10), "absdiff", 1e-10) );
+  
+  rsvd_opts opts;
+  opts.oversample = 5;
+  opts.power_iter = 0;
+  
+  const vec s2 = rsvd(A, 15, opts);
+  
+  REQUIRE( approx_equal(s2, vec(s_full.head(15)), "reldiff", 1e-8) );
+  
+  const cx_mat C = randn<cx_mat>(120, 8) * randn<cx_mat>(8, 100);
+  
+  const vec cs_full = svd(C);
+  
+  vec cs;
+  
+  REQUIRE( rsvd(cs, C, 6) );
+  
+  REQUIRE( approx_equal(cs, vec(cs_full.head(6)), "reldiff", 1e-8) );
+  }
+
+
+
+TEST_CASE("fn_rsvd_2")
+  {
+  // sparse matrices
+  
+  const sp_mat A = sprandu<sp_mat>(400, 8, 0.5) * sprandu<sp_mat>(8, 300, 0.5);
+  
+  const vec s_full = svd(mat(A));
+  
+  mat U;
+  vec s;
+  mat V;
+  
+  REQUIRE( rsvd(U, s, V, A, 5) );
+  
+  REQUIRE( approx_equal(s, vec(s_full.head(5)), "reldiff", 1e-8) );
+  
+  REQUIRE( norm(mat(A*V) - U*diagmat(s)) <= 1e-8 * s(0) );
+  
+  // more singular values than the rank of the matrix
+  
+  const vec s2 = rsvd(A, 12);
+  
+  REQUIRE( s2.n_elem == 12 );
+  
+  REQUIRE( approx_equal(s2.head(8), vec(s_full.head(8)), "reldiff", 1e-8) );
+  
+  REQUIRE( max(s2.tail(4)) <= 1e-8 * s2(0) );
+  }
+
+
+
+TEST_CASE("fn_rsvd_3")
+  {
+  // single pass over chunks of columns
+  
+  const mat A = randn<mat>(250, 12) * randn<mat>(12, 180);
+  
+  const sp_mat B = sprandu<sp_mat>(250, 6, 0.5) * sprandu<sp_mat>(6, 180, 0.5);
+  
+  const vec sA_full = svd(A);
+  const vec sB_full = svd(mat(B));
+  
+  rsvd_stream<double> streamA(250, 180, 8);
+  rsvd_stream<double> streamB(250, 180, 4);
+  
+  for(uword c=0; c < 180; c += 50)
+    {
+    const uword c_end = (std::min)(c + 49, uword(179));
+    
+    streamA.add(A.cols(c, c_end));
+    streamB.add(B.cols(c, c_end));
+    }
+  
+  REQUIRE( streamA.n_cols_added() == 180 );
+  
+  mat U;
+  vec s;
+  mat V;
+  
+  REQUIRE( streamA.finish(U, s, V) );
+  
+  REQUIRE( approx_equal(s, vec(sA_full.head(8)), "reldiff", 1e-6) );
+  
+  REQUIRE( norm(A*V - U*diagmat(s)) <= 1e-6 * s(0) );
+  
+  REQUIRE( streamB.finish(s) );
+  
+  REQUIRE( approx_equal(s, vec(sB_full.head(4)), "reldiff", 1e-6) );
+  
+  // incorrect use
+  
+  rsvd_stream<double> streamC(250, 180, 8);
+  
+  REQUIRE_THROWS( streamC.add(mat(200, 10)) );
+  
+  streamC.add(A.cols(0, 99));
+  
+  REQUIRE_THROWS( streamC.add(A) );
+  REQUIRE_THROWS( streamC.finish(s) );
+  }
+
+
+
+TEST_CASE("fn_rsvd_4")
+  {
+  // slowly decaying spectrum: the approximation error is bounded below by the (k+1)-th singular value;
+  // power iterations are required to get close to this bound
+  
+  mat QU;
+  mat QV;
+  mat R;
+  
+  qr_econ(QU, R, randn<mat>(300, 200));
+  qr_econ(QV, R, randn<mat>(200, 200));
+  
+  const vec sigma = 1.0 / sqrt(regspace<vec>(1, 200));
+  
+  const mat A = QU * diagmat(sigma) * QV.t();
+  
+  const uword k = 10;
+  
+  const double err_optimal = sigma(k);
+  
+  rsvd_opts opts_0;
+  rsvd_opts opts_2;
+  
+  opts_0.power_iter = 0;
+  opts_2.power_iter = 2;
+  
+  mat U0, V0, U2, V2;
+  vec s0, s2;
+  
+  REQUIRE( rsvd(U0, s0, V0, A, k, opts_0) );
+  REQUIRE( rsvd(U2, s2, V2, A, k, opts_2) );
+  
+  const double err_0 = norm(A - U0 * diagmat(s0) * V0.t());
+  const double err_2 = norm(A - U2 * diagmat(s2) * V2.t());
+  
+  REQUIRE( err_2 >= (1.0 - 1e-10) * err_optimal );
+  REQUIRE( err_2 <= 1.1 * err_optimal );
+  
+  REQUIRE( err_0 > 1.2 * err_2 );
+  }
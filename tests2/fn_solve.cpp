@@ -145,3 +145,172 @@ TEST_CASE("fn_solve_3")
   REQUIRE( X1(4) == Approx(-1.602040603621000) );
   REQUIRE( X1(5) == Approx(-5.985543296434588) );
   }
+
+
+
+TEST_CASE("fn_solve_4")
+  {
+  // fixed size matrices
+  
+  mat::fixed<6,6> A(fill::randu);  A.diag() += 6.0;
+  mat::fixed<6,3> B(fill::randu);
+  vec::fixed<6>   b(fill::randu);
+  
+  const mat A_ref = A;
+  const mat B_ref = B;
+  const vec b_ref = b;
+  
+  const mat X_ref = solve(A_ref, B_ref);
+  const vec x_ref = solve(A_ref, b_ref);
+  
+  mat::fixed<6,3> X = solve(A, B);
+  vec::fixed<6>   x = solve(A, b);
+  
+  REQUIRE( approx_equal(X, X_ref, "reldiff", 1e-10) );
+  REQUIRE( approx_equal(x, x_ref, "reldiff", 1e-10) );
+  
+  mat X2;
+  
+  REQUIRE( solve(X2, A, B) );
+  REQUIRE( approx_equal(X2, X_ref, "reldiff", 1e-10) );
+  
+  REQUIRE( approx_equal(mat(inv(A) * B), X_ref, "reldiff", 1e-10) );
+  REQUIRE( approx_equal(mat(inv(A)), mat(inv(A_ref)), "reldiff", 1e-10) );
+  
+  // aliasing
+  
+  x = solve(A, x);
+  
+  REQUIRE( approx_equal(x, solve(A_ref, x_ref), "reldiff", 1e-10) );
+  
+  mat::fixed<6,6> Y = A;
+  
+  Y = inv(Y);
+  
+  REQUIRE( approx_equal(Y, inv(A_ref), "reldiff", 1e-10) );
+  
+  // complex elements
+  
+  cx_mat::fixed<4,4> C(fill::randu);  C.diag() += cx_double(4.0, 1.0);
+  cx_vec::fixed<4>   c(fill::randu);
+  
+  REQUIRE( approx_equal(cx_vec(solve(C, c)), solve(cx_mat(C), cx_vec(c)), "reldiff", 1e-10) );
+  REQUIRE( approx_equal(cx_mat(inv(C)),      inv(cx_mat(C)),              "reldiff", 1e-10) );
+  
+  // singular matrices are handled by the general code
+  
+  mat::fixed<6,6> S(fill::randu);  S.row(2).zeros();
+  
+  mat::fixed<6,6> T;
+  
+  REQUIRE_THROWS( T = inv(S) );
+  
+  vec Z;
+  
+  REQUIRE( solve(Z, S, b) );
+  REQUIRE( approx_equal(Z, solve(mat(S), b_ref), "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("solve_factoriser_1")
+  {
+  // the structure of each matrix is detected once; the solutions must match solve()
+  
+  const uword N = 100;
+  
+  const mat G(N, N, fill::randn);
+  
+  mat D(N, N, fill::zeros);
+  
+  D.diag().randn();  D.diag() += 10.0;
+  D.diag( 1).randn();
+  D.diag(-2).randn();
+  
+  const mat A_gen = G;
+  const mat A_spd = G*G.t() + double(N) * eye(N,N);
+  const mat A_tru = trimatu(G) + double(N) * eye(N,N);
+  const mat A_trl = trimatl(G) + double(N) * eye(N,N);
+  
+  const mat*  A_list[] = { &A_gen, &A_spd, &D,      &A_tru,    &A_trl     };
+  const char* methods[] = { "lu",   "chol", "band", "trimatu", "trimatl" };
+  
+  for(uword i=0; i < 5; ++i)
+    {
+    const mat& A = *(A_list[i]);
+    
+    solve_factoriser SF;
+    
+    REQUIRE( SF.factorise(A) );
+    
+    REQUIRE( std::string(SF.method()) == std::string(methods[i]) );
+    
+    REQUIRE( SF.rcond() == Approx(rcond(A)) );
+    
+    for(uword k=0; k < 3; ++k)
+      {
+      const mat B(N, 4, fill::randn);
+      
+      mat X;
+      
+      REQUIRE( SF.solve(X, B) );
+      
+      REQUIRE( approx_equal(X, mat(solve(A, B)), "reldiff", 1e-8) );
+      }
+    }
+  
+  // complex matrix
+  
+  const cx_mat C(N, N, fill::randn);
+  const cx_mat E(N, 2, fill::randn);
+  
+  solve_factoriser SC;
+  
+  cx_mat Y;
+  
+  REQUIRE( SC.factorise(C) );
+  REQUIRE( SC.solve(Y, E)  );
+  
+  REQUIRE( approx_equal(cx_mat(C*Y), E, "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("solve_factoriser_2")
+  {
+  const mat A(20, 20, fill::randn);
+        mat B(20,  3, fill::randn);
+  
+  const mat B_ref = B;
+  
+  solve_factoriser SF;
+  
+  mat X;
+  
+  REQUIRE( SF.solve(X, B) == false );  // no factorisation
+  
+  REQUIRE( SF.factorise(A, solve_opts::no_sympd + solve_opts::no_band) );
+  
+  // aliasing
+  
+  REQUIRE( SF.solve(B, B) );
+  
+  REQUIRE( approx_equal(mat(A*B), B_ref, "absdiff", 1e-10) );
+  
+  // size and type mismatches
+  
+  fmat F;
+  
+  REQUIRE( SF.solve(X, mat(21, 3, fill::randn)) == false );
+  REQUIRE( SF.solve(F, fmat(20, 3, fill::randn)) == false );
+  
+  // singular and non-square matrices
+  
+  mat Z(20, 20, fill::randn);
+  
+  Z.col(3) = Z.col(4);
+  
+  REQUIRE( SF.factorise(Z)                == false );
+  REQUIRE( SF.factorise(mat(20, 21))      == false );
+  REQUIRE( SF.solve(X, B_ref)             == false );
+  }
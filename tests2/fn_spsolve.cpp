@@ -958,3 +958,187 @@ TEST_CASE("spsolve_factoriser_test")
   }
 
 #endif
+
+
+
+TEST_CASE("fn_spsolve_native_test")
+  {
+  // built-in sparse Cholesky and LDL factorisations; does not require SuperLU
+  for(const uword size : { 1, 7, 60, 250 })
+    {
+    sp_mat R;
+    R.sprandu(size, size, (std::min)(1.0, 4.0 / double(size)));
+
+    const sp_mat A = R * R.t() + speye<sp_mat>(size, size);
+
+    const mat B(size, 3, fill::randu);
+
+    const mat dX = solve(mat(A), B);
+
+    spchol_opts opts;
+
+    for(const spchol_opts::permutation_type permutation : { spchol_opts::NATURAL, spchol_opts::AMD })
+    for(const spchol_opts::factor_type      factor      : { spchol_opts::LLT,     spchol_opts::LDLT })
+      {
+      opts.permutation = permutation;
+      opts.factor      = factor;
+
+      mat X;
+      bool status = spsolve(X, A, B, "native", opts);
+
+      REQUIRE( status );
+      REQUIRE( approx_equal(X, dX, "reldiff", 1e-8) );
+      }
+    }
+
+  // symmetric indefinite matrix: the LL^T factorisation fails, the LDL^T factorisation succeeds
+  sp_mat A(4, 4);
+  A.diag() = vec{ 2.0, -3.0, 4.0, -5.0 };
+  A(0,1) = 1.0;  A(1,0) = 1.0;
+  A(2,3) = 1.0;  A(3,2) = 1.0;
+
+  const vec b(4, fill::randu);
+
+  vec x;
+  spchol_opts opts;
+
+  REQUIRE( spsolve(x, A, b, "native", opts) == false );
+
+  opts.factor = spchol_opts::LDLT;
+
+  REQUIRE( spsolve(x, A, b, "native", opts) );
+  REQUIRE( approx_equal(vec(A*x), b, "absdiff", 1e-12) );
+
+  // complex hermitian and float matrices
+  sp_cx_mat C;
+  C.sprandu(80, 80, 0.05);
+  C = C * C.t() + speye<sp_cx_mat>(80, 80);
+
+  const cx_mat D(80, 2, fill::randu);
+
+  REQUIRE( approx_equal(cx_mat(C * spsolve(C, D, "native")), D, "absdiff", 1e-10) );
+
+  sp_fmat F;
+  F.sprandu(50, 50, 0.05);
+  F = F * F.t() + speye<sp_fmat>(50, 50);
+
+  const fvec g(50, fill::randu);
+
+  REQUIRE( approx_equal(fvec(F * spsolve(F, g, "native")), g, "absdiff", 1e-4f) );
+  }
+
+
+
+TEST_CASE("spsolve_factoriser_native_test")
+  {
+  sp_mat R;
+  R.sprandu(300, 300, 0.01);
+
+  const sp_mat A = R * R.t() + speye<sp_mat>(300, 300);
+
+  spsolve_factoriser SF;
+
+  bool status = SF.factorise(A, spchol_opts());
+  REQUIRE( status );
+
+  REQUIRE( SF.rcond() > 0.0 );
+
+  // factorise once, solve many times
+  for(uword i=0; i < 3; ++i)
+    {
+    const mat B(300, 2, fill::randu);
+
+    mat X;
+    status = SF.solve(X, B);
+
+    REQUIRE( status );
+    REQUIRE( approx_equal(mat(A*X), B, "absdiff", 1e-10) );
+    }
+
+  // aliasing
+  const vec b(300, fill::randu);
+
+  vec x = b;
+  status = SF.solve(x, x);
+
+  REQUIRE( status );
+  REQUIRE( approx_equal(vec(A*x), b, "absdiff", 1e-10) );
+
+  // matrix which is not positive definite
+  status = SF.factorise(sp_mat(-A), spchol_opts());
+  REQUIRE( status == false );
+
+  status = SF.solve(x, b);
+  REQUIRE( status == false );
+
+  spchol_opts opts;
+  opts.factor = spchol_opts::LDLT;
+
+  status = SF.factorise(sp_mat(-A), opts);
+  REQUIRE( status );
+
+  status = SF.solve(x, b);
+  REQUIRE( status );
+  REQUIRE( approx_equal(vec(A*x), vec(-b), "absdiff", 1e-10) );
+
+  // size mismatch
+  vec c(301, fill::randu);
+
+  status = SF.solve(x, c);
+  REQUIRE( status == false );
+  REQUIRE( x.n_elem == 0 );
+  }
+
+
+
+TEST_CASE("spsolve_factoriser_native_rcond")
+  {
+  // 1D Laplacian: well-behaved pivots, but ill-conditioned
+  const uword N = 400;
+
+  sp_mat A(N, N);
+  A.diag()   .fill( 2.0);
+  A.diag(-1) .fill(-1.0);
+  A.diag( 1) .fill(-1.0);
+
+  const double dense_rcond = rcond(mat(A));
+
+  spchol_opts opts;
+
+  for(const spchol_opts::factor_type factor : { spchol_opts::LLT, spchol_opts::LDLT })
+    {
+    opts.factor = factor;
+
+    spsolve_factoriser SF;
+
+    REQUIRE( SF.factorise(A, opts) );
+
+    // the estimate is a lower bound of norm(inv(A),1), so rcond is never underestimated
+    REQUIRE( SF.rcond() >= 0.99 * dense_rcond );
+    REQUIRE( SF.rcond() <= 3.0  * dense_rcond );
+    }
+
+  // indefinite and complex hermitian matrices
+  sp_mat R;
+  R.sprandu(100, 100, 0.05);
+
+  const sp_mat B = R + R.t() - 2.0 * speye<sp_mat>(100, 100);
+
+  opts.factor = spchol_opts::LDLT;
+
+  spsolve_factoriser SF;
+
+  if(SF.factorise(B, opts))
+    {
+    REQUIRE( SF.rcond() >= 0.99 * rcond(mat(B)) );
+    REQUIRE( SF.rcond() <= 10.0 * rcond(mat(B)) );
+    }
+
+  sp_cx_mat C;
+  C.sprandu(100, 100, 0.05);
+  C = C * C.t() + speye<sp_cx_mat>(100, 100);
+
+  REQUIRE( SF.factorise(C, spchol_opts()) );
+  REQUIRE( SF.rcond() >= 0.99 * rcond(cx_mat(C)) );
+  REQUIRE( SF.rcond() <= 10.0 * rcond(cx_mat(C)) );
+  }
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+TEST_CASE("fn_spsolve_iterative_1")
+  {
+  // each method with each applicable preconditioner
+  
+  const uword n = 200;
+  
+  sp_mat R = sprandu<sp_mat>(n, n, 0.02);
+  
+  const sp_mat S = R * R.t() + 2.0 * speye<sp_mat>(n, n);
+  const sp_mat N = R + 3.0 * speye<sp_mat>(n, n);
+  
+  const mat B(n, 3, fill::randn);
+  
+  spsolve_iter_opts opts;
+  
+  opts.tol = 1e-10;
+  
+  for(const auto pc : { spsolve_iter_opts::NONE, spsolve_iter_opts::JACOBI, spsolve_iter_opts::ILU0, spsolve_iter_opts::IC0 })
+    {
+    opts.precond = pc;
+    
+    for(const char* method : { "cg", "minres" })
+      {
+      mat X;
+      
+      REQUIRE( spsolve_iterative(X, S, B, method, opts) );
+      
+      REQUIRE( norm(mat(S*X) - B) <= 1e-8 * norm(B) );
+      }
+    
+    if(pc == spsolve_iter_opts::IC0)  { continue; }
+    
+    for(const char* method : { "bicgstab", "gmres" })
+      {
+      mat X;
+      
+      REQUIRE( spsolve_iterative(X, N, B, method, opts) );
+      
+      REQUIRE( norm(mat(N*X) - B) <= 1e-8 * norm(B) );
+      }
+    }
+  }
+
+
+
+TEST_CASE("fn_spsolve_iterative_2")
+  {
+  // complex hermitian and non-hermitian matrices
+  
+  const uword n = 150;
+  
+  const sp_cx_mat C(sprandu<sp_mat>(n, n, 0.02), sprandu<sp_mat>(n, n, 0.02));
+  
+  const sp_cx_mat H = C * C.t() + 2.0 * speye<sp_cx_mat>(n, n);
+  const sp_cx_mat N = C + 3.0 * speye<sp_cx_mat>(n, n);
+  
+  const cx_mat B(n, 2, fill::randn);
+  
+  spsolve_iter_opts opts;
+  
+  opts.tol     = 1e-10;
+  opts.precond = spsolve_iter_opts::IC0;
+  
+  const cx_mat X1 = spsolve_iterative(H, B, "cg",     opts);
+  const cx_mat X2 = spsolve_iterative(H, B, "minres", opts);
+  
+  opts.precond = spsolve_iter_opts::ILU0;
+  
+  const cx_mat X3 = spsolve_iterative(N, B, "bicgstab", opts);
+  const cx_mat X4 = spsolve_iterative(N, B, "gmres",    opts);
+  
+  REQUIRE( norm(cx_mat(H*X1) - B) <= 1e-8 * norm(B) );
+  REQUIRE( norm(cx_mat(H*X2) - B) <= 1e-8 * norm(B) );
+  REQUIRE( norm(cx_mat(N*X3) - B) <= 1e-8 * norm(B) );
+  REQUIRE( norm(cx_mat(N*X4) - B) <= 1e-8 * norm(B) );
+  }
+
+
+
+TEST_CASE("fn_spsolve_iterative_3")
+  {
+  // workspace, warm start, indefinite matrix and failure
+  
+  const uword n = 200;
+  
+  sp_mat A = sprandu<sp_mat>(n, n, 0.02);
+  
+  A = A + A.t();
+  
+  A.diag() += linspace<vec>(-3.0, 3.0, n);
+  
+  const vec b(n, fill::randn);
+  
+  spsolve_iter_opts opts;
+  
+  opts.tol     = 1e-10;
+  opts.maxiter = 5000;
+  
+  spsolve_iter_workspace<double> ws;
+  
+  vec x;
+  
+  REQUIRE( spsolve_iterative(x, A, b, "minres", opts, ws) );
+  
+  REQUIRE( ws.info.converged );
+  REQUIRE( ws.info.n_iter > 0 );
+  REQUIRE( ws.info.residual <= 1e-9 );
+  
+  opts.warm_start = true;
+  
+  REQUIRE( spsolve_iterative(x, A, b, "minres", opts, ws) );
+  
+  REQUIRE( ws.info.n_iter == 0 );
+  
+  opts.warm_start = false;
+  opts.maxiter    = 3;
+  
+  REQUIRE( spsolve_iterative(x, A, b, "minres", opts, ws) == false );
+  
+  REQUIRE( ws.info.converged == false );
+  REQUIRE( ws.info.n_iter == 3 );
+  REQUIRE( x.n_elem == n );
+  
+  // IC(0) needs a positive definite matrix
+  
+  opts.precond = spsolve_iter_opts::IC0;
+  
+  REQUIRE( spsolve_iterative(x, A, b, "cg", opts, ws) == false );
+  
+  REQUIRE_THROWS( x = spsolve_iterative(A, b, "cg", opts) );
+  REQUIRE_THROWS( x = spsolve_iterative(A, vec(n+1, fill::randn)) );
+  }
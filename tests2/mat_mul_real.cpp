@@ -927,3 +927,94 @@ TEST_CASE("mat_mul_real_6")
 
 
 
+
+
+
+TEST_CASE("mat_mul_real_7")
+  {
+  // emulated gemm(), gemv() and syrk(), which are used for integer matrices and when BLAS is not available;
+  // the sizes cover the edges of the blocks used by gemm_emul_blocked
+  
+  for(const uword M : { 1, 7, 16, 37, 300 })
+  for(const uword N : { 1, 5, 64, 130 })
+  for(const uword K : { 3, 16, 300 })
+    {
+    const mat A(M, K, fill::randu);
+    const mat B(K, N, fill::randu);
+    const mat C(M, N, fill::randu);
+    
+    const mat At = A.t();
+    const mat Bt = B.t();
+    
+    const double alpha = 2.0;
+    const double beta  = 3.0;
+    
+    mat X(M, N);
+    
+    X = C;  gemm_emul<false, false, false, false>::apply(X, A,  B );               REQUIRE( approx_equal(X, A*B,                  "reldiff", 1e-10) );
+    X = C;  gemm_emul<true,  false, true,  false>::apply(X, At, B,  alpha);        REQUIRE( approx_equal(X, alpha*A*B,            "reldiff", 1e-10) );
+    X = C;  gemm_emul<false, true,  false, true >::apply(X, A,  Bt, alpha, beta);  REQUIRE( approx_equal(X, A*B + beta*C,         "reldiff", 1e-10) );
+    X = C;  gemm_emul<true,  true,  true,  true >::apply(X, At, Bt, alpha, beta);  REQUIRE( approx_equal(X, alpha*A*B + beta*C,   "reldiff", 1e-10) );
+    
+    const vec x  = B.col(0);
+    const vec xt = C.col(0);
+    
+    vec y = C.col(0);  gemv_emul<false, true, true>::apply(y.memptr(), A, x.memptr(),  alpha, beta);  REQUIRE( approx_equal(y, vec(alpha*A*x      + beta*C.col(0)), "reldiff", 1e-10) );
+    vec z = B.col(0);  gemv_emul<true,  true, true>::apply(z.memptr(), A, xt.memptr(), alpha, beta);  REQUIRE( approx_equal(z, vec(alpha*A.t()*xt + beta*B.col(0)), "reldiff", 1e-10) );
+    
+    mat S(M, M);  syrk_emul<false, false, false>::apply(S, A);         REQUIRE( approx_equal(S, mat(A*A.t()),       "reldiff", 1e-10) );
+    mat T(K, K);  syrk_emul<true,  true,  false>::apply(T, A, alpha);  REQUIRE( approx_equal(T, mat(alpha*A.t()*A), "reldiff", 1e-10) );
+    }
+  
+  const imat P = randi<imat>(150, 200, distr_param(-10, 10));
+  const imat Q = randi<imat>(200, 170, distr_param(-10, 10));
+  
+  const imat R = conv_to<imat>::from( conv_to<mat>::from(P) * conv_to<mat>::from(Q) );
+  
+  REQUIRE( accu(P*Q != R) == 0 );
+  }
+
+
+
+TEST_CASE("mat_mul_real_8")
+  {
+  // products of fixed size matrices and vectors
+  
+  mat::fixed<6,6>  A(fill::randu);
+  mat::fixed<7,5>  B(fill::randu);
+  vec::fixed<6>    x(fill::randu);
+  vec::fixed<5>    y(fill::randu);
+  rowvec::fixed<7> z(fill::randu);
+  
+  const mat A_ref = A;
+  const mat B_ref = B;
+  const vec x_ref = x;
+  const vec y_ref = y;
+  const rowvec z_ref = z;
+  
+  REQUIRE( approx_equal(vec(A*x),         vec(A_ref*x_ref),         "reldiff", 1e-12) );
+  REQUIRE( approx_equal(vec(A.t()*x),     vec(A_ref.t()*x_ref),     "reldiff", 1e-12) );
+  REQUIRE( approx_equal(vec(B*y),         vec(B_ref*y_ref),         "reldiff", 1e-12) );
+  REQUIRE( approx_equal(vec(2.0*B*y),     vec(2.0*B_ref*y_ref),     "reldiff", 1e-12) );
+  REQUIRE( approx_equal(rowvec(z*B),      rowvec(z_ref*B_ref),      "reldiff", 1e-12) );
+  REQUIRE( approx_equal(rowvec(x.t()*A),  rowvec(x_ref.t()*A_ref),  "reldiff", 1e-12) );
+  REQUIRE( approx_equal(rowvec(y.t()*B.t()), rowvec(y_ref.t()*B_ref.t()), "reldiff", 1e-12) );
+  
+  // aliasing
+  
+  x = A*x;
+  
+  REQUIRE( approx_equal(vec(x), vec(A_ref*x_ref), "reldiff", 1e-12) );
+  
+  // complex elements
+  
+  cx_mat::fixed<5,5> C(fill::randu);
+  cx_vec::fixed<5>   c(fill::randu);
+  
+  const cx_mat C_ref = C;
+  const cx_vec c_ref = c;
+  
+  REQUIRE( approx_equal(cx_vec(C*c),     cx_vec(C_ref*c_ref),     "reldiff", 1e-12) );
+  REQUIRE( approx_equal(cx_vec(C.t()*c), cx_vec(C_ref.t()*c_ref), "reldiff", 1e-12) );
+  REQUIRE( approx_equal(cx_rowvec(c.t()*C), cx_rowvec(c_ref.t()*C_ref), "reldiff", 1e-12) );
+  }
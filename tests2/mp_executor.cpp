@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+TEST_CASE("mp_executor_1")
+  {
+  REQUIRE( mp_executor::is_active() == false );
+  
+  uvec counts(100, fill::zeros);
+  
+  mp_executor::run(counts.n_elem, [&](const uword i) { counts(i) += 1; });
+  
+  REQUIRE( all(counts == 1) );
+  
+  #if !defined(ARMA_USE_MP_EXECUTOR)
+    {
+    REQUIRE_THROWS( mp_executor::set_pool(2) );
+    
+    REQUIRE( mp_executor::is_active() == false );
+    }
+  #endif
+  }
+
+
+
+#if defined(ARMA_USE_MP_EXECUTOR)
+
+TEST_CASE("mp_executor_2")
+  {
+  mat  A(500, 500, fill::randu);
+  cube Q(100, 100, 8, fill::randu);
+  
+  mat    B_ref   = exp(A) + 2.0*A;
+  double sum_ref = accu(A % A);
+  cube   Q_ref   = Q;
+  
+  Q_ref.each_slice( [](mat& X) { X = 2.0*X + 1.0; } );
+  
+  mp_executor::set_pool(4);
+  
+  REQUIRE( mp_executor::is_active() == true );
+  
+  mat    B   = exp(A) + 2.0*A;
+  double sum = accu(A % A);
+  
+  Q.each_slice( [](mat& X) { X = 2.0*X + 1.0; }, true );
+  
+  REQUIRE_THROWS( mp_executor::run(100, [](const uword i) { if(i == 37) { throw std::runtime_error("mp_executor_2"); } }) );
+  
+  mp_executor::reset();
+  
+  REQUIRE( mp_executor::is_active() == false );
+  
+  REQUIRE( approx_equal(B, B_ref, "absdiff", 1e-12) );
+  REQUIRE( sum == Approx(sum_ref) );
+  REQUIRE( approx_equal(Q, Q_ref, "absdiff", 1e-12) );
+  }
+
+#endif
+
+
+
+#if defined(ARMA_USE_MP_EXECUTOR)
+
+TEST_CASE("mp_executor_3")
+  {
+  // replacing the executor while other threads are running tasks
+  
+  std::atomic<bool> done(false);
+  
+  std::thread runner([&]()
+    {
+    for(uword iter=0; iter < 200; ++iter)
+      {
+      uvec counts(64, fill::zeros);
+      
+      mp_executor::run(counts.n_elem, [&](const uword i) { counts(i) += 1; });
+      
+      if(any(counts != 1))  { done.store(true); return; }
+      }
+    });
+  
+  for(uword iter=0; iter < 20; ++iter)
+    {
+    mp_executor::set_pool(3);
+    mp_executor::set([](const uword n_tasks, const std::function<void(const uword)>& task) { for(uword i=0; i < n_tasks; ++i) { task(i); } }, 2);
+    mp_executor::reset();
+    }
+  
+  runner.join();
+  
+  REQUIRE( done.load() == false );
+  
+  // code which is parallelised directly via OpenMP keeps the check for nested parallel regions
+  
+  mp_executor::set_pool(2);
+  
+  REQUIRE( mp_thread_limit::get_loop() == 2 );
+  
+  #if defined(ARMA_USE_OPENMP)
+    {
+    bool gate_omp  = true;
+    bool gate_loop = false;
+    
+    #pragma omp parallel num_threads(2)
+      {
+      #pragma omp master
+        {
+        gate_omp  = mp_gate<double, false, mp_op_cost::heavy>::eval     (uword(1000000));
+        gate_loop = mp_gate<double, false, mp_op_cost::heavy>::eval_loop(uword(1000000));
+        }
+      }
+    
+    REQUIRE( gate_omp  == false );
+    REQUIRE( gate_loop == true  );
+    }
+  #endif
+  
+  mp_executor::reset();
+  }
+
+#endif
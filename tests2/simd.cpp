@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+// compare the results of element-wise operations with all available instruction sets,
+// including the scalar code (isa_none); the sizes cover the remainders of all vector widths
+
+template<typename eT>
+static
+void
+simd_check_ops(const uword isa)
+  {
+  typedef Mat<eT> mat_type;
+  
+  const eT k = eT(1.5);
+  
+  for(uword N=0; N <= 70; N += 3)
+    {
+    const mat_type A(N, 1, fill::randn);
+    const mat_type B(N, 1, fill::randu);
+    
+    // evaluate the expression with the given instruction set and with the scalar code
+    const auto check = [&](const std::function<mat_type()>& F) -> bool
+      {
+      REQUIRE( simd::set_isa(isa) );
+      
+      const mat_type C = F();
+      
+      REQUIRE( simd::set_isa(simd::isa_none) );
+      
+      const mat_type D = F();
+      
+      return approx_equal(C, D, "absdiff", 0);
+      };
+    
+    REQUIRE( check([&]() -> mat_type { return A + B;                        }) );
+    REQUIRE( check([&]() -> mat_type { return A - B;                        }) );
+    REQUIRE( check([&]() -> mat_type { return A % B;                        }) );
+    REQUIRE( check([&]() -> mat_type { return A / B;                        }) );
+    REQUIRE( check([&]() -> mat_type { return k - A;                        }) );
+    REQUIRE( check([&]() -> mat_type { return k / A;                        }) );
+    REQUIRE( check([&]() -> mat_type { return abs(A);                       }) );
+    REQUIRE( check([&]() -> mat_type { return sqrt(B);                      }) );
+    REQUIRE( check([&]() -> mat_type { return square(A);                    }) );
+    REQUIRE( check([&]() -> mat_type { return -A;                           }) );
+    REQUIRE( check([&]() -> mat_type { return clamp(A, eT(-0.5), eT(0.5)); }) );
+    
+    REQUIRE( check([&]() -> mat_type { mat_type C = A; C += B; C *= k; C -= k; C /= B; return C; }) );
+    
+    REQUIRE( simd::set_isa(simd::isa_none) );
+    
+    const eT acc = accu(A);
+    
+    REQUIRE( simd::set_isa(isa) );
+    
+    REQUIRE( accu(A) == Approx(acc).epsilon(0.001).margin(0.001) );
+    }
+  }
+
+
+
+TEST_CASE("simd_1")
+  {
+  const uword default_isa = simd::get_isa();
+  
+  REQUIRE( simd::has_isa(simd::isa_none) );
+  REQUIRE( simd::has_isa(default_isa) );
+  
+  if(arma_config::simd == false)  { REQUIRE( default_isa == simd::isa_none ); }
+  
+  for(const uword isa : { simd::isa_none, simd::isa_sse2, simd::isa_avx2, simd::isa_avx512, simd::isa_neon })
+    {
+    if(simd::has_isa(isa) == false)  { REQUIRE( simd::set_isa(isa) == false ); continue; }
+    
+    simd_check_ops<float >(isa);
+    simd_check_ops<double>(isa);
+    }
+  
+  REQUIRE( simd::set_isa(default_isa) );
+  }
+
+
+
+TEST_CASE("simd_2")
+  {
+  const uword default_isa = simd::get_isa();
+  
+  // unaligned memory, complex numbers, and propagation of NaN by clamp()
+  
+  mat A(101, 1, fill::randn);
+  
+  A(7)  = datum::nan;
+  A(50) = datum::nan;
+  
+  const vec a = A.col(0);
+  
+  vec b = a.subvec(1, 100);
+  vec c = clamp(a.subvec(1, 100), -0.5, 0.5);
+  
+  b.clamp(-0.5, 0.5);
+  
+  REQUIRE( std::isnan(b(6))  );
+  REQUIRE( std::isnan(b(49)) );
+  REQUIRE( std::isnan(c(6))  );
+  REQUIRE( std::isnan(c(49)) );
+  
+  for(uword i=0; i < b.n_elem; ++i)
+    {
+    if(std::isnan(a(i+1)) == false)
+      {
+      const double val = (std::min)(0.5, (std::max)(-0.5, a(i+1)));
+      
+      REQUIRE( b(i) == val );
+      REQUIRE( c(i) == val );
+      }
+    }
+  
+  cx_vec X(37, fill::randn);
+  cx_vec Y(37, fill::randn);
+  
+  cx_vec Z = X + Y;
+  cx_vec W = -X;
+  
+  cx_double acc = cx_double(0);
+  
+  for(uword i=0; i < X.n_elem; ++i)
+    {
+    REQUIRE( Z(i) == X(i) + Y(i) );
+    REQUIRE( W(i) == -X(i) );
+    
+    acc += X(i);
+    }
+  
+  const cx_double acc_X = accu(X);
+  
+  REQUIRE( acc_X.real() == Approx(acc.real()).margin(1e-10) );
+  REQUIRE( acc_X.imag() == Approx(acc.imag()).margin(1e-10) );
+  
+  REQUIRE( simd::get_isa() == default_isa );
+  }
+
+
+
+// polynomial approximations of exp() and log(); the results must be within 1 ULP of the standard library,
+// and special values must be handled in the same way as by the standard library
+
+template<typename eT>
+static
+void
+simd_check_approx(const uword isa)
+  {
+  typedef Col<eT> vec_type;
+  
+  const eT eps = std::numeric_limits<eT>::epsilon();
+  
+  const auto check = [&](const vec_type& X, const vec_type& Y, eT (*fn)(eT)) -> bool
+    {
+    for(uword i=0; i < X.n_elem; ++i)
+      {
+      const eT ref = fn(X(i));
+      
+      if(std::isnan(ref) || std::isinf(ref) || (ref == eT(0)))
+        {
+        if( (std::isnan(ref) != std::isnan(Y(i))) || ((std::isnan(ref) == false) && (ref != Y(i))) )  { return false; }
+        }
+      else
+        {
+        if(std::abs(Y(i) - ref) > eps * std::abs(ref))  { return false; }
+        }
+      }
+    
+    return true;
+    };
+  
+  const eT exp_max = std::log(std::numeric_limits<eT>::max());
+  
+  vec_type X = (eT(2) * exp_max) * (vec_type(1003, fill::randu) - eT(0.5));
+  vec_type L = exp(vec_type(1003, fill::randn) * eT(20));
+  
+  X.head(6) = vec_type({ eT(0), eT(1), -Datum<eT>::inf, Datum<eT>::inf, Datum<eT>::nan, eT(3) * exp_max });
+  L.head(6) = vec_type({ eT(0), eT(1), eT(-1),          Datum<eT>::inf, Datum<eT>::nan, std::numeric_limits<eT>::denorm_min() });
+  
+  vec_type Y(X.n_elem);
+  
+  REQUIRE( simd::set_isa(isa) );
+  
+  for(const uword N : { uword(16), uword(37), X.n_elem })
+    {
+    const vec_type XX = X.head(N);
+    const vec_type LL = L.head(N);
+    
+    REQUIRE( simd::unary<simd_op::exp>(Y.memptr(), XX.memptr(), N, eT(0)) );
+    REQUIRE( check(XX, Y.head(N), [](eT x) -> eT { return std::exp(x); }) );
+    
+    REQUIRE( simd::unary<simd_op::trunc_exp>(Y.memptr(), XX.memptr(), N, eT(0)) );
+    REQUIRE( check(XX, Y.head(N), [](eT x) -> eT { return trunc_exp(x); }) );
+    
+    REQUIRE( simd::unary<simd_op::log>(Y.memptr(), LL.memptr(), N, eT(0)) );
+    REQUIRE( check(LL, Y.head(N), [](eT x) -> eT { return std::log(x); }) );
+    }
+  }
+
+
+
+TEST_CASE("simd_3")
+  {
+  const uword default_isa = simd::get_isa();
+  
+  for(const uword isa : { simd::isa_sse2, simd::isa_avx2, simd::isa_avx512, simd::isa_neon })
+    {
+    if(simd::has_isa(isa) == false)  { continue; }
+    
+    simd_check_approx<float >(isa);
+    simd_check_approx<double>(isa);
+    }
+  
+  REQUIRE( simd::set_isa(default_isa) );
+  }
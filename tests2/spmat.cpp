@@ -3188,3 +3188,407 @@ TEST_CASE("spmat_vectorise_dimension_alias")
     REQUIRE(m(i) == Approx(n(i)));
     }
   }
+
+
+
+// Random element-wise modifications, including erasing elements by setting them
+// to zero; the result must match the same modifications on a dense matrix.
+TEST_CASE("spmat_random_element_access")
+  {
+  const uword n_rows = 97;
+  const uword n_cols = 53;
+
+  arma_rng::set_seed(123);
+
+  sp_mat A(n_rows, n_cols);
+  mat    B(n_rows, n_cols, fill::zeros);
+
+  for (uword k = 0; k < 20000; ++k)
+    {
+    const uword r = randi<uword>(distr_param(0, n_rows - 1));
+    const uword c = randi<uword>(distr_param(0, n_cols - 1));
+    const uword op = k % 5;
+
+    // integer values, so that the results are exact
+    const double val = double(randi<sword>(distr_param(1, 4)));
+
+    if (op == 0) { A(r, c) += val; B(r, c) += val; }
+    if (op == 1) { A(r, c) -= val; B(r, c) -= val; }
+    if (op == 2) { A(r, c) *= val; B(r, c) *= val; }
+    if (op == 3) { A(r, c)  = val; B(r, c)  = val; }
+    if (op == 4) { A(r, c)  = 0.0; B(r, c)  = 0.0; }
+
+    if ((k % 1000) == 0)
+      {
+      REQUIRE( accu(abs(mat(A) - B)) == 0.0 );
+      }
+    }
+
+  REQUIRE( A.n_nonzero == accu(B != 0.0) );
+  REQUIRE( accu(abs(mat(A) - B)) == 0.0 );
+
+  // CSC structure must have sorted row indices within each column
+  for (uword c = 0; c < n_cols; ++c)
+    {
+    for (uword i = A.col_ptrs[c] + 1; i < A.col_ptrs[c + 1]; ++i)
+      {
+      REQUIRE( A.row_indices[i - 1] < A.row_indices[i] );
+      }
+    }
+
+  cx_mat C(n_rows, n_cols, fill::zeros);
+  sp_cx_mat D(n_rows, n_cols);
+
+  for (uword k = 0; k < 5000; ++k)
+    {
+    const uword r = randi<uword>(distr_param(0, n_rows - 1));
+    const uword c = randi<uword>(distr_param(0, n_cols - 1));
+    const cx_double val(double(k % 3), double(k % 2));
+
+    C(r, c) += val;
+    D(r, c) += val;
+    }
+
+  REQUIRE( accu(abs(cx_mat(D) - C)) == 0.0 );
+  }
+
+
+
+TEST_CASE("spmat_mul_accumulators")
+  {
+  // tall matrices with few elements per column use the hashed accumulator; the others use the dense accumulator
+  const sp_mat A = sprandu<sp_mat>(3000,  200, 0.005);
+  const sp_mat B = sprandu<sp_mat>( 200,  300, 0.02 );
+  const sp_mat C = sprandu<sp_mat>( 200,  200, 0.3  );
+
+  const sp_mat AB = A * B;
+  const sp_mat CC = C * C;
+  const sp_mat CB = C.t() * B;
+
+  REQUIRE( approx_equal(mat(AB), mat(A) * mat(B),     "absdiff", 1e-10) );
+  REQUIRE( approx_equal(mat(CC), mat(C) * mat(C),     "absdiff", 1e-10) );
+  REQUIRE( approx_equal(mat(CB), mat(C).t() * mat(B), "absdiff", 1e-10) );
+
+  // CSC structure must have sorted row indices within each column
+  for (uword c = 0; c < AB.n_cols; ++c)
+    {
+    for (uword i = AB.col_ptrs[c] + 1; i < AB.col_ptrs[c + 1]; ++i)
+      {
+      REQUIRE( AB.row_indices[i - 1] < AB.row_indices[i] );
+      }
+    }
+
+  // elements which cancel out must not be stored
+  const imat X = randi<imat>(300, 40, distr_param(-1, 1));
+  const imat Y = randi<imat>( 40, 50, distr_param(-1, 1));
+
+  const sp_imat Z = sp_imat(X) * sp_imat(Y);
+
+  REQUIRE( Z.n_nonzero == accu(X * Y != 0) );
+  REQUIRE( accu(imat(Z) != X * Y) == 0 );
+
+  const sp_cx_mat D = sprandu<sp_cx_mat>(1000, 100, 0.01);
+
+  REQUIRE( approx_equal(cx_mat(D.t() * D), cx_mat(D).t() * cx_mat(D), "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("spmat_mul_plan")
+  {
+  sp_mat A = sprandu<sp_mat>(500, 400, 0.01);
+  sp_mat B = sprandu<sp_mat>(400, 300, 0.01);
+
+  spmul_plan plan;
+
+  sp_mat C;
+
+  plan.mul(C, A, B);
+
+  REQUIRE( plan.reused() == false );
+  REQUIRE( approx_equal(mat(C), mat(A) * mat(B), "absdiff", 1e-10) );
+
+  // same structure, different values
+  A.transform( [](double val) { return val * 2.0 - 1.0; } );
+  B.transform( [](double val) { return val + 3.0;       } );
+
+  plan.mul(C, A, B);
+
+  REQUIRE( plan.reused() == true );
+  REQUIRE( approx_equal(mat(C), mat(A) * mat(B), "absdiff", 1e-10) );
+
+  // values which lead to cancellation; the structure is still reused afterwards
+  sp_mat X(2, 2);
+  sp_mat Y(2, 2);
+
+  X(0, 0) = 1.0;  X(0, 1) = 1.0;
+  Y(0, 0) = 1.0;  Y(1, 0) = 1.0;
+
+  plan.mul(C, X, Y);
+
+  REQUIRE( plan.reused() == false );
+  REQUIRE( C.n_nonzero == 1 );
+
+  Y(1, 0) = -1.0;
+
+  plan.mul(C, X, Y);
+
+  REQUIRE( plan.reused() == true );
+  REQUIRE( C.n_nonzero == 0 );
+
+  Y(1, 0) = 2.0;
+
+  plan.mul(C, X, Y);
+
+  REQUIRE( plan.reused() == true );
+  REQUIRE( C.n_nonzero == 1 );
+  REQUIRE( C(0, 0) == 3.0 );
+
+  // different structure
+  B(0, 0) = (B(0, 0) != 0.0) ? 0.0 : 1.0;
+
+  plan.mul(C, A, B);
+
+  REQUIRE( plan.reused() == false );
+  REQUIRE( approx_equal(mat(C), mat(A) * mat(B), "absdiff", 1e-10) );
+
+  // output is an alias of an operand
+  const sp_mat B2 = B;
+
+  plan.mul(B, A.t() * A, B);
+
+  REQUIRE( plan.reused() == false );
+  REQUIRE( approx_equal(mat(B), mat(A).t() * mat(A) * mat(B2), "absdiff", 1e-10) );
+
+  REQUIRE_THROWS( plan.mul(C, A, A) );
+
+  plan.reset();
+
+  plan.mul(C, A, B2);
+
+  REQUIRE( plan.reused() == false );
+  }
+
+
+
+TEST_CASE("spmat_dense_mul_blocked")
+  {
+  // the numbers of dense columns cover full and partial blocks of columns
+  const sp_mat A = sprandu<sp_mat>(300, 200, 0.05);
+  const mat    M(A);
+
+  for (const uword n_cols : { 1, 2, 3, 4, 5, 7, 8, 9, 17 })
+    {
+    const mat B(200, n_cols, fill::randu);
+    const mat C(300, n_cols, fill::randu);
+
+    REQUIRE( approx_equal(mat(A * B),     M * B,     "absdiff", 1e-10) );
+    REQUIRE( approx_equal(mat(A.t() * C), M.t() * C, "absdiff", 1e-10) );
+    }
+
+  const sp_cx_mat X = sprandu<sp_cx_mat>(100, 80, 0.1);
+  const cx_mat    Y(80, 6, fill::randu);
+  const cx_mat    Z(100, 6, fill::randu);
+
+  REQUIRE( approx_equal(cx_mat(X * Y),        cx_mat(X) * Y,        "absdiff", 1e-10) );
+  REQUIRE( approx_equal(cx_mat(X.st() * Z),   cx_mat(X).st() * Z,   "absdiff", 1e-10) );
+  REQUIRE( approx_equal(cx_mat(X.t() * Z),    cx_mat(X).t() * Z,    "absdiff", 1e-10) );
+
+  // output is an alias of the dense operand
+  mat D(200, 200, fill::randu);
+  const mat E = D;
+
+  D = A.t() * A * D;
+
+  REQUIRE( approx_equal(D, M.t() * M * E, "absdiff", 1e-10) );
+
+  const sp_mat S(300, 200);
+
+  REQUIRE( accu(abs(mat(S * E))) == 0.0 );
+  REQUIRE( mat(A * mat(200, 0)).n_cols == 0 );
+  }
+
+
+
+TEST_CASE("spmat_trans_cache")
+  {
+  sp_mat A = sprandu<sp_mat>(60, 45, 0.1);
+
+  A.row(5).zeros();
+  A.row(59).zeros();
+
+  A.use_trans_cache();
+
+  mat M(A);
+
+  // row-wise iteration visits the elements in row-major order
+  mat  X(60, 45, fill::zeros);
+  uword count = 0;
+  uword last  = 0;
+  bool  order_ok = true;
+
+  for (sp_mat::const_row_iterator it = A.begin_row(); it != A.end_row(); ++it)
+    {
+    const uword linear = it.row() * 45 + it.col();
+
+    if ((count > 0) && (linear <= last))  { order_ok = false; }
+
+    X(it.row(), it.col()) = (*it);
+    last = linear;
+    ++count;
+    }
+
+  REQUIRE( order_ok );
+  REQUIRE( count == A.n_nonzero );
+  REQUIRE( approx_equal(X, M, "absdiff", 0.0) );
+
+  // row extraction, transposes and transposed products
+  for (uword r = 0; r < 60; ++r)
+    {
+    REQUIRE( approx_equal(mat(sp_rowvec(A.row(r))), M.row(r), "absdiff", 0.0) );
+    REQUIRE( A.row(r).n_nonzero == uword(accu(M.row(r) != 0.0)) );
+    }
+
+  REQUIRE( approx_equal(mat(sp_mat(A.t())),   M.t(),           "absdiff", 0.0  ) );
+  REQUIRE( approx_equal(mat(A.t() * A),       M.t() * M,       "absdiff", 1e-10) );
+  REQUIRE( approx_equal(mat(A.cols(3,20).t()), M.cols(3,20).t(), "absdiff", 0.0 ) );
+
+  // modifications discard the transposed index
+  A(5, 7) = 3.0;
+  A *= 2.0;
+  A.col(2).zeros();
+
+  M(5, 7) = 3.0;
+  M *= 2.0;
+  M.col(2).zeros();
+
+  REQUIRE( approx_equal(mat(sp_mat(A.t())),            M.t(),      "absdiff", 0.0) );
+  REQUIRE( approx_equal(mat(sp_rowvec(A.row(5))),      M.row(5),   "absdiff", 0.0) );
+  REQUIRE( approx_equal(mat(sp_rowvec(A.row(9).cols(4,30))), M.row(9).cols(4,30), "absdiff", 0.0) );
+
+  sp_mat::const_row_iterator it = A.begin_row(5);
+
+  REQUIRE( it.row() == 5 );
+  REQUIRE( it.col() == 7 );
+  REQUIRE( (*it) == 6.0 );
+
+  A = sprandu<sp_mat>(30, 20, 0.2);
+
+  REQUIRE( approx_equal(mat(sp_mat(A.t())), mat(A).t(), "absdiff", 0.0) );
+
+  A.use_trans_cache(false);
+
+  REQUIRE( A.get_trans_index() == nullptr );
+
+  // conjugate transpose of complex matrices
+  sp_cx_mat C = sprandu<sp_cx_mat>(40, 30, 0.1);
+
+  C.use_trans_cache();
+
+  const cx_vec y(40, fill::randu);
+
+  REQUIRE( approx_equal(cx_mat(sp_cx_mat(C.t())), cx_mat(C).t(), "absdiff", 0.0  ) );
+  REQUIRE( approx_equal(cx_mat(C.t() * y),        cx_mat(C).t() * y, "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("spmat_elem_parallel")
+  {
+  // sizes large enough for the column-partitioned code paths
+  sp_mat A = sprandu<sp_mat>(500, 300, 0.03);
+  sp_mat B = sprandu<sp_mat>(500, 300, 0.03);
+
+  A.col(10).zeros();
+  B.cols(20,25).zeros();
+
+  const mat Ad(A);
+  const mat Bd(B);
+
+  const sp_mat C1 = A + B;
+  const sp_mat C2 = A - B;
+  const sp_mat C3 = A % B;
+  const sp_mat C4 = A - A;
+  const sp_mat C5 = 2.0*A + B.t().t();
+
+  REQUIRE( approx_equal(mat(C1), Ad + Bd, "absdiff", 1e-12) );
+  REQUIRE( approx_equal(mat(C2), Ad - Bd, "absdiff", 1e-12) );
+  REQUIRE( approx_equal(mat(C3), Ad % Bd, "absdiff", 1e-12) );
+  REQUIRE( approx_equal(mat(C5), 2.0*Ad + Bd, "absdiff", 1e-12) );
+
+  // no explicitly stored zeros
+  REQUIRE( C1.n_nonzero == uword(accu(mat(C1) != 0.0)) );
+  REQUIRE( C3.n_nonzero == uword(accu(Ad % Bd != 0.0)) );
+  REQUIRE( C4.n_nonzero == 0 );
+
+  // reductions
+  REQUIRE( approx_equal(mat(sum(A,0)),  sum(Ad,0),  "absdiff", 1e-10) );
+  REQUIRE( approx_equal(mat(sum(A,1)),  sum(Ad,1),  "absdiff", 1e-10) );
+  REQUIRE( approx_equal(mat(mean(A,0)), mean(Ad,0), "absdiff", 1e-12) );
+  REQUIRE( approx_equal(mat(mean(A,1)), mean(Ad,1), "absdiff", 1e-12) );
+
+  REQUIRE( approx_equal(mat(vecnorm(A,1,0)), vecnorm(Ad,1,0), "absdiff", 1e-10) );
+  REQUIRE( approx_equal(mat(vecnorm(A,2,1)), vecnorm(Ad,2,1), "absdiff", 1e-10) );
+  REQUIRE( approx_equal(mat(vecnorm(A,"inf",0)), vecnorm(Ad,"inf",0), "absdiff", 1e-12) );
+
+  REQUIRE( approx_equal(mat(normalise(A,2,0)), normalise(Ad,2,0), "absdiff", 1e-12) );
+  REQUIRE( approx_equal(mat(normalise(A,1,1)), normalise(Ad,1,1), "absdiff", 1e-12) );
+
+  // complex matrices
+  sp_cx_mat X = sprandu<sp_cx_mat>(400, 200, 0.03);
+  sp_cx_mat Y = sprandu<sp_cx_mat>(400, 200, 0.03);
+
+  REQUIRE( approx_equal(cx_mat(X + Y), cx_mat(X) + cx_mat(Y), "absdiff", 1e-12) );
+  REQUIRE( approx_equal(cx_mat(X % Y), cx_mat(X) % cx_mat(Y), "absdiff", 1e-12) );
+  REQUIRE( approx_equal(cx_mat(sum(X,1)), sum(cx_mat(X),1), "absdiff", 1e-10) );
+  }
+
+
+
+TEST_CASE("spmat_submat_fast")
+  {
+  // long columns use the binary search for the row bounds, short columns use the linear scan
+  for(const double density : { 0.002, 0.2 })
+    {
+    sp_mat A = sprandu<sp_mat>(2000, 300, density);
+    const mat Ad(A);
+
+    const sp_mat S1 = A.submat(150, 20, 1700, 250);
+    const sp_mat S2 = A.rows(900, 999);
+    const sp_mat S3 = A.cols(100, 180);
+
+    REQUIRE( approx_equal(mat(S1), Ad.submat(150, 20, 1700, 250), "absdiff", 1e-12) );
+    REQUIRE( approx_equal(mat(S2), Ad.rows(900, 999),             "absdiff", 1e-12) );
+    REQUIRE( approx_equal(mat(S3), Ad.cols(100, 180),             "absdiff", 1e-12) );
+
+    REQUIRE( S1.n_nonzero == A.submat(150, 20, 1700, 250).n_nonzero );
+
+    // forward and reverse iteration
+    const SpSubview<double> V = A.submat(150, 20, 1700, 250);
+
+    uword count = 0;
+    double acc  = 0.0;
+
+    for(SpSubview<double>::const_iterator it = V.begin(); it != V.end(); ++it)  { ++count; acc += (*it) * double(it.row() + 1); }
+
+    REQUIRE( count == S1.n_nonzero );
+
+    uword rcount = 0;
+
+    SpSubview<double>::const_iterator it = V.end();
+
+    while(it != V.begin())  { --it; ++rcount; }
+
+    REQUIRE( rcount == count );
+    REQUIRE( acc == Approx(accu(S1 % repmat(regspace(1, double(S1.n_rows)), 1, S1.n_cols))) );
+
+    // products use the block in place
+    const mat B(231, 4, fill::randu);
+    const mat C(1551, 3, fill::randu);
+
+    REQUIRE( approx_equal(mat(A.submat(150, 20, 1700, 250) * B),              Ad.submat(150, 20, 1700, 250) * B,              "absdiff", 1e-10) );
+    REQUIRE( approx_equal(mat(A.submat(150, 20, 1700, 250).t() * C),          Ad.submat(150, 20, 1700, 250).t() * C,          "absdiff", 1e-10) );
+    REQUIRE( approx_equal(vec(A.submat(150, 20, 1700, 250).t() * C.col(0)),   vec(Ad.submat(150, 20, 1700, 250).t() * C.col(0)), "absdiff", 1e-10) );
+    REQUIRE( approx_equal(mat(A.cols(20, 250) * B),                          Ad.cols(20, 250) * B,                          "absdiff", 1e-10) );
+    }
+  }
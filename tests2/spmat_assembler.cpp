@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+TEST_CASE("spmat_assembler_1")
+  {
+  // compare against element-wise accumulation; the values are integers, so that the sums are exact
+  
+  const uword n_rows = 60;
+  const uword n_cols = 40;
+  const uword N      = 20000;
+  
+  const umat locs = join_cols( randi<urowvec>(N, distr_param(0, n_rows-1)), randi<urowvec>(N, distr_param(0, n_cols-1)) );
+  const vec  vals = conv_to<vec>::from( randi<ivec>(N, distr_param(-3, 3)) );
+  
+  mat X(n_rows, n_cols, fill::zeros);
+  
+  for(uword i=0; i < N; ++i)  { X(locs(0,i), locs(1,i)) += vals(i); }
+  
+  SpMat_assembler<double> asmb(n_rows, n_cols);
+  
+  REQUIRE( asmb.n_rows == n_rows );
+  REQUIRE( asmb.n_cols == n_cols );
+  
+  #if defined(ARMA_USE_OPENMP)
+    #pragma omp parallel for
+  #endif
+  for(uword i=0; i < N; ++i)  { asmb.add(locs(0,i), locs(1,i), vals(i)); }
+  
+  REQUIRE( asmb.get_n_triplets() == uword(accu(vals != 0.0)) );
+  
+  sp_mat A = asmb.finalise();
+  
+  REQUIRE( A.n_rows    == n_rows );
+  REQUIRE( A.n_cols    == n_cols );
+  REQUIRE( A.n_nonzero == uword(accu(X != 0.0)) );
+  
+  REQUIRE( accu(abs(mat(A) - X)) == 0.0 );
+  
+  // row indices must be sorted within each column
+  
+  for(uword c=0; c < A.n_cols; ++c)
+  for(uword i=A.col_ptrs[c]+1; i < A.col_ptrs[c+1]; ++i)
+    {
+    REQUIRE( A.row_indices[i-1] < A.row_indices[i] );
+    }
+  
+  // the assembler is empty after finalise()
+  
+  REQUIRE( asmb.get_n_triplets() == 0 );
+  
+  asmb.add(2, 3, 1.5);
+  asmb.add(2, 3, 2.5);
+  asmb.add(0, 0, 1.0);
+  asmb.add(0, 0, -1.0);
+  
+  sp_mat B;
+  
+  asmb.finalise(B);
+  
+  REQUIRE( B.n_nonzero == 1 );
+  REQUIRE( B(2,3)      == Approx(4.0) );
+  
+  sp_mat C = asmb.finalise();
+  
+  REQUIRE( C.n_rows    == n_rows );
+  REQUIRE( C.n_nonzero == 0      );
+  
+  REQUIRE_THROWS( asmb.add(n_rows, 0, 1.0) );
+  }
+
+
+
+TEST_CASE("spmat_assembler_2")
+  {
+  // complex elements; reset() discards buffered triplets
+  
+  SpMat_assembler<cx_double> asmb( SizeMat(5,6) );
+  
+  asmb.reserve(10);
+  
+  asmb.add(1, 1, cx_double(1.0, 2.0));
+  asmb.add(4, 5, cx_double(3.0, 0.0));
+  asmb.reset();
+  
+  REQUIRE( asmb.get_n_triplets() == 0 );
+  
+  asmb.add(4, 5, cx_double(3.0, -1.0));
+  asmb.add(0, 2, cx_double(0.0,  1.0));
+  asmb.add(4, 5, cx_double(1.0,  1.0));
+  
+  const sp_cx_mat A = asmb.finalise();
+  
+  REQUIRE( A.n_nonzero == 2 );
+  
+  REQUIRE( std::real(cx_double(A(4,5))) == Approx(4.0) );
+  REQUIRE( std::imag(cx_double(A(4,5))) == Approx(0.0).margin(1e-12) );
+  REQUIRE( std::imag(cx_double(A(0,2))) == Approx(1.0) );
+  }
+
+
+
+TEST_CASE("spmat_assembler_3")
+  {
+  // two assemblers filled in an interleaved manner by the same threads must produce independent results
+  
+  const uword n_rows = 50;
+  const uword n_cols = 30;
+  const uword N      = 4000;
+  
+  const umat locs = join_cols( randi<urowvec>(N, distr_param(0, n_rows-1)), randi<urowvec>(N, distr_param(0, n_cols-1)) );
+  const vec  vals = conv_to<vec>::from( randi<ivec>(N, distr_param(1, 5)) );
+  
+  mat X(n_rows, n_cols, fill::zeros);
+  
+  for(uword i=0; i < N; ++i)  { X(locs(0,i), locs(1,i)) += vals(i); }
+  
+  SpMat_assembler<double> asmb_a(n_rows, n_cols);
+  SpMat_assembler<double> asmb_b(n_rows, n_cols);
+  
+  #if defined(ARMA_USE_OPENMP)
+    #pragma omp parallel for
+  #endif
+  for(uword i=0; i < N; ++i)
+    {
+    asmb_a.add(locs(0,i), locs(1,i),     vals(i));
+    asmb_b.add(locs(0,i), locs(1,i), 2.0*vals(i));
+    }
+  
+  REQUIRE( asmb_a.get_n_triplets() == N );
+  REQUIRE( asmb_b.get_n_triplets() == N );
+  
+  const sp_mat A = asmb_a.finalise();
+  const sp_mat B = asmb_b.finalise();
+  
+  REQUIRE( accu(abs(mat(A) -     X)) == 0.0 );
+  REQUIRE( accu(abs(mat(B) - 2.0*X)) == 0.0 );
+  }
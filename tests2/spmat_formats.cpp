@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+// 
+// Copyright 2015 Conrad Sanderson (http://conradsanderson.id.au)
+// Copyright 2015 National ICT Australia (NICTA)
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ------------------------------------------------------------------------
+
+
+
+
+#include <armadillo>
+#include "catch.hpp"
+
+using namespace arma;
+
+
+
+TEST_CASE("spmat_formats_1")
+  {
+  // conversion, multiplication and element access for each format; the sizes are not multiples of the block and chunk sizes
+  
+  sp_mat A;
+  A.sprandu(53, 38, 0.2);
+  
+  A.row(4).zeros();
+  
+  const mat D(A);
+  const mat B(38, 3, fill::randu);
+  const mat C(53, 2, fill::randu);
+  
+  const SpMat_csr<double> X(A);
+  
+  REQUIRE( X.n_nonzero == A.n_nonzero );
+  REQUIRE( approx_equal(mat(X * B),       D * B,             "reldiff", 1e-10) );
+  REQUIRE( approx_equal(mat(C.t() * X),   C.t() * D,         "reldiff", 1e-10) );
+  REQUIRE( approx_equal(mat(X.to_spmat()),     D,            "absdiff", 0.0  ) );
+  REQUIRE( approx_equal(mat(X.t().to_spmat()), mat(D.t()),   "absdiff", 0.0  ) );
+  REQUIRE( X(7,11) == D(7,11) );
+  
+  for(const uword bs : { 1, 2, 3, 4, 5 })
+    {
+    const SpMat_bsr<double> Y(A, bs);
+    
+    REQUIRE( Y.block_size == bs );
+    REQUIRE( approx_equal(mat(Y * B),            D * B,       "reldiff", 1e-10) );
+    REQUIRE( approx_equal(mat(C.t() * Y),        C.t() * D,   "reldiff", 1e-10) );
+    REQUIRE( approx_equal(mat(Y.to_spmat()),     D,           "absdiff", 0.0  ) );
+    REQUIRE( approx_equal(mat(Y.t().to_spmat()), mat(D.t()),  "absdiff", 0.0  ) );
+    REQUIRE( Y(7,11) == D(7,11) );
+    }
+  
+  for(const uword cs : { 1, 4, 8, 5 })
+  for(const uword sigma : { 1, 16, 256 })
+    {
+    const SpMat_sell<double> Z(A, cs, sigma);
+    
+    REQUIRE( Z.n_nonzero == A.n_nonzero );
+    REQUIRE( Z.get_n_padded() >= A.n_nonzero );
+    REQUIRE( approx_equal(mat(Z * B),            D * B,       "reldiff", 1e-10) );
+    REQUIRE( approx_equal(mat(C.t() * Z),        C.t() * D,   "reldiff", 1e-10) );
+    REQUIRE( approx_equal(mat(Z.to_spmat()),     D,           "absdiff", 0.0  ) );
+    REQUIRE( approx_equal(mat(Z.t().to_spmat()), mat(D.t()),  "absdiff", 0.0  ) );
+    REQUIRE( Z(7,11) == D(7,11) );
+    }
+  
+  REQUIRE_THROWS( SpMat_sell<double>(A, 0) );
+  REQUIRE_THROWS( SpMat_bsr<double>(A, 0)  );
+  }
+
+
+
+TEST_CASE("spmat_formats_2")
+  {
+  // the iterators visit each non-zero element once
+  
+  sp_cx_mat A;
+  A.sprandu(30, 25, 0.1);
+  
+  const cx_mat D(A);
+  
+  const SpMat_csr<cx_double>  X(A);
+  const SpMat_bsr<cx_double>  Y(A, 3);
+  const SpMat_sell<cx_double> Z(A, 4, 8);
+  
+  cx_mat DX(30, 25, fill::zeros);
+  cx_mat DY(30, 25, fill::zeros);
+  cx_mat DZ(30, 25, fill::zeros);
+  
+  uword count_X = 0;
+  uword count_Y = 0;
+  uword count_Z = 0;
+  
+  for(auto it = X.begin(); it != X.end(); ++it)  { DX(it.row(), it.col()) = (*it); ++count_X; }
+  for(auto it = Y.begin(); it != Y.end(); ++it)  { DY(it.row(), it.col()) = (*it); ++count_Y; }
+  for(auto it = Z.begin(); it != Z.end(); ++it)  { DZ(it.row(), it.col()) = (*it); ++count_Z; }
+  
+  REQUIRE( count_X == A.n_nonzero );
+  REQUIRE( count_Y == A.n_nonzero );
+  REQUIRE( count_Z == A.n_nonzero );
+  
+  REQUIRE( approx_equal(DX, D, "absdiff", 0.0) );
+  REQUIRE( approx_equal(DY, D, "absdiff", 0.0) );
+  REQUIRE( approx_equal(DZ, D, "absdiff", 0.0) );
+  
+  // the conjugate transpose
+  
+  REQUIRE( approx_equal(cx_mat(X.t().to_spmat()), cx_mat(D.t()), "absdiff", 0.0) );
+  REQUIRE( approx_equal(cx_mat(Z.t().to_spmat()), cx_mat(D.t()), "absdiff", 0.0) );
+  }
+
+
+
+TEST_CASE("spmat_formats_3")
+  {
+  // CSR view of existing memory; the CSC storage of a sparse matrix is the CSR storage of its transpose
+  
+  sp_mat A;
+  A.sprandu(20, 30, 0.2);
+  
+  A.sync();
+  
+  const mat B(20, 4, fill::randu);
+  
+  SpMat_csr<double> X(A.col_ptrs, A.row_indices, A.values, A.n_cols, A.n_rows, false);
+  
+  REQUIRE( X.is_view() );
+  REQUIRE( X.values == A.values );
+  REQUIRE( approx_equal(mat(X * B), mat(A.t() * B), "reldiff", 1e-10) );
+  
+  const SpMat_csr<double> Y(X);
+  
+  REQUIRE( Y.is_view() == false );
+  REQUIRE( approx_equal(mat(Y.to_spmat()), mat(A.t()), "absdiff", 0.0) );
+  
+  X.reset();
+  
+  REQUIRE( X.n_nonzero == 0 );
+  REQUIRE( X.is_view() == false );
+  }